@@ -0,0 +1,199 @@
+/**
+ * @file main.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "pricingbenchmark.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSysInfo>
+#include <QTextStream>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Write benchmark results as CSV.
+QByteArray toCsv( const PricingBenchmark& bench )
+{
+    QByteArray result;
+
+    QTextStream stream( &result );
+    stream << "method,operation,ops,nsPerOp,allocsPerOp,maxError,rmsError,failures\n";
+
+    foreach ( const PricingBenchmark::Result& r, bench.results() )
+        stream << QString::fromStdString( r.method ) << ","
+               << QString::fromStdString( PricingBenchmark::operationName( r.operation ) ) << ","
+               << r.numOps << ","
+               << QString::number( r.nsPerOp, 'f', 1 ) << ","
+               << QString::number( r.allocsPerOp, 'f', 3 ) << ","
+               << QString::number( r.maxError, 'g', 6 ) << ","
+               << QString::number( r.rmsError, 'g', 6 ) << ","
+               << r.numFailures << "\n";
+
+    stream.flush();
+
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Write benchmark results as JSON.
+QByteArray toJson( const PricingBenchmark& bench )
+{
+    QJsonArray expiryDays;
+    QJsonArray moneyness;
+    QJsonArray results;
+
+    for ( double v : bench.expiryDays() )
+        expiryDays.append( v );
+
+    for ( double v : bench.moneyness() )
+        moneyness.append( v );
+
+    foreach ( const PricingBenchmark::Result& r, bench.results() )
+    {
+        QJsonObject obj;
+        obj["method"] = QString::fromStdString( r.method );
+        obj["operation"] = QString::fromStdString( PricingBenchmark::operationName( r.operation ) );
+        obj["ops"] = (qint64) r.numOps;
+        obj["nsPerOp"] = r.nsPerOp;
+        obj["allocsPerOp"] = r.allocsPerOp;
+        obj["maxError"] = r.maxError;
+        obj["rmsError"] = r.rmsError;
+        obj["failures"] = (qint64) r.numFailures;
+
+        results.append( obj );
+    }
+
+    QJsonObject grid;
+    grid["spot"] = PricingBenchmark::SPOT;
+    grid["rate"] = PricingBenchmark::RATE;
+    grid["volatility"] = PricingBenchmark::SIGMA;
+    grid["expiryDays"] = expiryDays;
+    grid["moneyness"] = moneyness;
+
+    QJsonObject doc;
+    doc["timestamp"] = QDateTime::currentDateTimeUtc().toString( Qt::ISODate );
+    doc["cpu"] = QSysInfo::currentCpuArchitecture();
+    doc["os"] = QSysInfo::prettyProductName();
+    doc["minTime"] = bench.minTime();
+    doc["grid"] = grid;
+    doc["results"] = results;
+
+    return QJsonDocument( doc ).toJson();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Application entry point.
+int main( int argc, char *argv[] )
+{
+    QCoreApplication a( argc, argv );
+    a.setApplicationName( "mofobench" );
+
+    QTextStream err( stderr );
+
+    const QCommandLineOption formatOption( QStringList() << "f" << "format", "Output format, json or csv.", "format", "json" );
+    const QCommandLineOption listOption( QStringList() << "l" << "list", "List pricing methods and exit." );
+    const QCommandLineOption methodOption( QStringList() << "m" << "method", "Only benchmark pricing method <name>.", "name" );
+    const QCommandLineOption outputOption( QStringList() << "o" << "output", "Write results to <file> instead of stdout.", "file" );
+    const QCommandLineOption timeOption( QStringList() << "t" << "min-time", "Minimum time spent timing each operation.", "seconds", "0.25" );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Option pricing benchmark suite." );
+    parser.addHelpOption();
+    parser.addOption( formatOption );
+    parser.addOption( listOption );
+    parser.addOption( methodOption );
+    parser.addOption( outputOption );
+    parser.addOption( timeOption );
+    parser.process( a );
+
+    if ( parser.isSet( listOption ) )
+    {
+        QTextStream out( stdout );
+
+        for ( const std::string& name : PricingBenchmark::methodNames() )
+            out << QString::fromStdString( name ) << "\n";
+
+        return 0;
+    }
+
+    const QString format( parser.value( formatOption ).toLower() );
+
+    if (( "json" != format ) && ( "csv" != format ))
+    {
+        err << "unknown format " << format << "\n";
+        return -1;
+    }
+
+    bool okay;
+
+    const double minTime( parser.value( timeOption ).toDouble( &okay ) );
+
+    if (( !okay ) || ( minTime < 0.0 ))
+    {
+        err << "bad minimum time " << parser.value( timeOption ) << "\n";
+        return -1;
+    }
+
+    // run!
+    PricingBenchmark bench( minTime );
+
+    if ( !bench.run( parser.value( methodOption ).toStdString() ) )
+    {
+        err << "unknown pricing method " << parser.value( methodOption ) << "\n";
+        return -1;
+    }
+
+    const QByteArray data( ("csv" == format) ? toCsv( bench ) : toJson( bench ) );
+
+    // write results
+    QFile f;
+
+    if ( parser.isSet( outputOption ) )
+    {
+        f.setFileName( parser.value( outputOption ) );
+
+        if ( !f.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+        {
+            err << "failed to open " << f.fileName() << "\n";
+            return -1;
+        }
+    }
+    else if ( !f.open( stdout, QIODevice::WriteOnly ) )
+    {
+        err << "failed to open stdout\n";
+        return -1;
+    }
+
+    if ( data.size() != f.write( data ) )
+    {
+        err << "failed to write " << f.fileName() << "\n";
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+QT       += core
+QT       -= gui
+
+CONFIG += c++17
+CONFIG += console
+CONFIG -= app_bundle
+
+TARGET = mofobench
+
+INCLUDEPATH += ..
+
+# The following define makes your compiler emit warnings if you use
+# any Qt feature that has been marked deprecated (the exact warnings
+# depend on your compiler). Please consult the documentation of the
+# deprecated API in order to know how to port your code away from it.
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    main.cpp \
+    pricingbenchmark.cpp \
+    ../util/abstractoptionpricing.cpp \
+    ../util/alttrinomial.cpp \
+    ../util/baroneadesiwhaley.cpp \
+    ../util/binomial.cpp \
+    ../util/bjerksundstensland02.cpp \
+    ../util/bjerksundstensland93.cpp \
+    ../util/blackscholes.cpp \
+    ../util/cbnd.cpp \
+    ../util/cnd.cpp \
+    ../util/coxrossrubinstein.cpp \
+    ../util/equalprobbinomial.cpp \
+    ../util/kamradritchken.cpp \
+    ../util/latticeworkspace.cpp \
+    ../util/montecarlo.cpp \
+    ../util/phelimboyle.cpp \
+    ../util/philox.cpp \
+    ../util/quasimontecarlo.cpp \
+    ../util/rollgeskewhaley.cpp \
+    ../util/sobol.cpp \
+    ../util/trinomial.cpp
+
+HEADERS += \
+    pricingbenchmark.h
@@ -0,0 +1,538 @@
+/**
+ * @file pricingbenchmark.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pricingbenchmark.h"
+
+#include "util/altbisection.h"
+#include "util/alttrinomial.h"
+#include "util/baroneadesiwhaley.h"
+#include "util/bjerksundstensland02.h"
+#include "util/bjerksundstensland93.h"
+#include "util/blackscholes.h"
+#include "util/coxrossrubinstein.h"
+#include "util/equalprobbinomial.h"
+#include "util/kamradritchken.h"
+#include "util/montecarlo.h"
+#include "util/newtonraphson.h"
+#include "util/phelimboyle.h"
+#include "util/quasimontecarlo.h"
+#include "util/rollgeskewhaley.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+
+#include <QtGlobal>
+
+// depths used by the calculators
+static constexpr size_t BINOMIAL_DEPTH = 256;
+static constexpr size_t TRINOMIAL_DEPTH = 128;
+static constexpr size_t MONTE_CARLO_SIMULATIONS = 4*1024;
+
+static std::atomic<size_t> allocations( 0 );
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void *operator new( std::size_t size )
+{
+    ++allocations;
+
+    if ( void *p = std::malloc( size ? size : 1 ) )
+        return p;
+
+    throw std::bad_alloc();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void operator delete( void *p ) noexcept
+{
+    std::free( p );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void operator delete( void *p, std::size_t ) noexcept
+{
+    std::free( p );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static AbstractOptionPricing *createAlternativeTrinomialTree( double S, double r, double b, double sigma, double T )
+{
+    return new AlternativeTrinomialTree( S, r, b, sigma, T, TRINOMIAL_DEPTH );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static AbstractOptionPricing *createBaroneAdesiWhaley( double S, double r, double b, double sigma, double T )
+{
+    return new BaroneAdesiWhaley( S, r, b, sigma, T );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static AbstractOptionPricing *createBjerksundStensland1993( double S, double r, double b, double sigma, double T )
+{
+    return new BjerksundStensland1993( S, r, b, sigma, T );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static AbstractOptionPricing *createBjerksundStensland2002( double S, double r, double b, double sigma, double T )
+{
+    return new BjerksundStensland2002( S, r, b, sigma, T );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static AbstractOptionPricing *createBlackScholes( double S, double r, double b, double sigma, double T )
+{
+    return new BlackScholes( S, r, b, sigma, T );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static AbstractOptionPricing *createCoxRossRubinstein( double S, double r, double b, double sigma, double T )
+{
+    return new CoxRossRubinstein( S, r, b, sigma, T, BINOMIAL_DEPTH );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static AbstractOptionPricing *createEqualProbBinomialTree( double S, double r, double b, double sigma, double T )
+{
+    return new EqualProbBinomialTree( S, r, b, sigma, T, BINOMIAL_DEPTH );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static AbstractOptionPricing *createKamradRitchken( double S, double r, double b, double sigma, double T )
+{
+    return new KamradRitchken( S, r, b, sigma, T, TRINOMIAL_DEPTH );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static AbstractOptionPricing *createMonteCarlo( double S, double r, double b, double sigma, double T )
+{
+    // fixed seed so every run prices the same paths
+    return new MonteCarlo( S, r, b, sigma, T, MONTE_CARLO_SIMULATIONS, MonteCarlo::rng_engine_type() );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static AbstractOptionPricing *createPhelimBoyle( double S, double r, double b, double sigma, double T )
+{
+    return new PhelimBoyle( S, r, b, sigma, T, TRINOMIAL_DEPTH );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static AbstractOptionPricing *createQuasiMonteCarlo( double S, double r, double b, double sigma, double T )
+{
+    // fixed seed so every run uses the same scrambles
+    return new QuasiMonteCarlo( S, r, b, sigma, T, MONTE_CARLO_SIMULATIONS, MonteCarlo::rng_engine_type() );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static AbstractOptionPricing *createRollGeskeWhaley( double S, double r, double b, double sigma, double T )
+{
+    Q_UNUSED( b )
+
+    // no dividend
+    return new RollGeskeWhaley( S, r, sigma, T, 0.0, T );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+PricingBenchmark::PricingBenchmark( double minTime ) :
+    minTime_( minTime )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+PricingBenchmark::~PricingBenchmark()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool PricingBenchmark::run( const std::string& filter )
+{
+    const std::vector<Method>& m( methods() );
+
+    bool found( false );
+
+    for ( size_t i( 0 ); i < m.size(); ++i )
+    {
+        if (( filter.size() ) && ( filter != m[i].name ))
+            continue;
+
+        // reference prices are expensive, only build them when needed
+        if ( grid_.empty() )
+            buildGrid();
+
+        for ( int op( 0 ); op < _NUM_OPERATIONS; ++op )
+        {
+            if (( CHAIN_PARTIALS == op ) || ( CHAIN_BATCH_PRICE == op ))
+                results_.push_back( measureChain( m[i], static_cast<Operation>( op ) ) );
+            else
+                results_.push_back( measure( m[i], static_cast<Operation>( op ) ) );
+        }
+
+        found = true;
+    }
+
+    return found;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+std::vector<std::string> PricingBenchmark::methodNames()
+{
+    const std::vector<Method>& m( methods() );
+
+    std::vector<std::string> result;
+
+    for ( size_t i( 0 ); i < m.size(); ++i )
+        result.push_back( m[i].name );
+
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+size_t PricingBenchmark::numAllocations()
+{
+    return allocations;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+std::string PricingBenchmark::operationName( Operation op )
+{
+    switch ( op )
+    {
+    case PRICE:
+        return "price";
+    case PARTIALS:
+        return "partials";
+    case IMPL_VOL_NEWTON_RAPHSON:
+        return "implVolNewtonRaphson";
+    case IMPL_VOL_ALT_BISECTION:
+        return "implVolAltBisection";
+    case CHAIN_PARTIALS:
+        return "chainPartials";
+    case CHAIN_BATCH_PRICE:
+        return "chainBatchPrice";
+    default:
+        break;
+    }
+
+    return std::string();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+const std::vector<PricingBenchmark::Method>& PricingBenchmark::methods()
+{
+    static const std::vector<Method> m =
+    {
+        {"AlternativeTrinomialTree", createAlternativeTrinomialTree, false},
+        {"BaroneAdesiWhaley", createBaroneAdesiWhaley, false},
+        {"BjerksundStensland1993", createBjerksundStensland1993, false},
+        {"BjerksundStensland2002", createBjerksundStensland2002, false},
+        {"BlackScholes", createBlackScholes, false},
+        {"CoxRossRubinstein", createCoxRossRubinstein, false},
+        {"EqualProbBinomialTree", createEqualProbBinomialTree, false},
+        {"KamradRitchken", createKamradRitchken, false},
+        {"MonteCarlo", createMonteCarlo, false},
+        {"PhelimBoyle", createPhelimBoyle, false},
+        {"QuasiMonteCarlo", createQuasiMonteCarlo, false},
+        {"RollGeskeWhaley", createRollGeskeWhaley, true},
+    };
+
+    return m;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void PricingBenchmark::buildGrid()
+{
+    expiryDays_ = {7.0, 30.0, 90.0, 180.0, 365.0};
+    moneyness_ = {0.80, 0.90, 0.95, 1.00, 1.05, 1.10, 1.20};
+
+    grid_.clear();
+
+    for ( size_t e( 0 ); e < expiryDays_.size(); ++e )
+    {
+        const double T( timeToExpiry( e ) );
+
+        CoxRossRubinstein american( SPOT, RATE, RATE, SIGMA, T, REFERENCE_DEPTH );
+        BlackScholes european( SPOT, RATE, RATE, SIGMA, T );
+
+        for ( size_t i( 0 ); i < moneyness_.size(); ++i )
+            for ( OptionType type : {OptionType::Call, OptionType::Put} )
+            {
+                double gamma, theta, vega, rho;
+
+                GridPoint g;
+                g.expiry = e;
+                g.type = type;
+                g.X = SPOT * moneyness_[i];
+
+                g.american = american.optionPrice( type, g.X );
+                american.partials( type, g.X, g.americanDelta, gamma, theta, vega, rho );
+
+                g.european = european.optionPrice( type, g.X );
+                european.partials( type, g.X, g.europeanDelta, gamma, theta, vega, rho );
+
+                grid_.push_back( g );
+            }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+PricingBenchmark::Result PricingBenchmark::measure( const Method& m, Operation op ) const
+{
+    using clock_type = std::chrono::steady_clock;
+
+    const bool implVol(( IMPL_VOL_NEWTON_RAPHSON == op ) || ( IMPL_VOL_ALT_BISECTION == op ));
+
+    Result result = {m.name, op, 0, 0.0, 0.0, 0.0, 0.0, 0};
+
+    // implied volatility is solved against the price of the method itself, so solver error is
+    // not mixed up with pricing error
+    std::vector<double> targets( grid_.size(), 0.0 );
+
+    if ( implVol )
+    {
+        AbstractOptionPricing *p( nullptr );
+        size_t expiry( expiryDays_.size() );
+
+        for ( size_t i( 0 ); i < grid_.size(); ++i )
+        {
+            if ( grid_[i].expiry != expiry )
+            {
+                expiry = grid_[i].expiry;
+
+                delete p;
+                p = m.create( SPOT, RATE, RATE, SIGMA, timeToExpiry( expiry ) );
+            }
+
+            const GridPoint& g( grid_[i] );
+
+            // without time value there is no volatility to solve for
+            const double intrinsic( (OptionType::Call == g.type) ? SPOT - g.X : g.X - SPOT );
+            const double price( p->optionPrice( g.type, g.X ) );
+
+            if ( IMPL_VOL_MIN_TIME_VALUE <= price - std::fmax( intrinsic, 0.0 ) )
+                targets[i] = price;
+        }
+
+        delete p;
+    }
+
+    // reserve up front so the first pass does not count towards allocations
+    std::vector<double> errors;
+    errors.reserve( grid_.size() );
+
+    const size_t allocs( numAllocations() );
+    const clock_type::time_point start( clock_type::now() );
+
+    double elapsed;
+
+    for ( bool first( true );; first = false )
+    {
+        AbstractOptionPricing *p( nullptr );
+        size_t expiry( expiryDays_.size() );
+
+        for ( size_t i( 0 ); i < grid_.size(); ++i )
+        {
+            const GridPoint& g( grid_[i] );
+
+            if (( m.callsOnly ) && ( OptionType::Call != g.type ))
+                continue;
+            else if (( implVol ) && ( 0.0 == targets[i] ))
+                continue;
+
+            // one pricing object per expiry, the same way the calculators use them
+            if ( g.expiry != expiry )
+            {
+                expiry = g.expiry;
+
+                delete p;
+                p = m.create( SPOT, RATE, RATE, SIGMA, timeToExpiry( expiry ) );
+            }
+
+            double value( 0.0 );
+            double expected( 0.0 );
+
+            bool okay( true );
+
+            if ( PRICE == op )
+            {
+                value = p->optionPrice( g.type, g.X );
+                expected = p->isEuropean() ? g.european : g.american;
+            }
+            else if ( PARTIALS == op )
+            {
+                double gamma, theta, vega, rho;
+
+                p->optionPrice( g.type, g.X );
+                p->partials( g.type, g.X, value, gamma, theta, vega, rho );
+
+                okay = (std::isfinite( value ) && std::isfinite( gamma ) && std::isfinite( theta ) && std::isfinite( vega ) && std::isfinite( rho ));
+                expected = p->isEuropean() ? g.europeanDelta : g.americanDelta;
+            }
+            else
+            {
+                if ( IMPL_VOL_NEWTON_RAPHSON == op )
+                    value = NewtonRaphson::calcImplVol( p, g.type, g.X, targets[i], &okay );
+                else
+                    value = AlternativeBisection::calcImplVol( p, g.type, g.X, targets[i], &okay );
+
+                expected = SIGMA;
+            }
+
+            ++result.numOps;
+
+            // score first pass only
+            if ( !first )
+                continue;
+            else if (( !okay ) || ( !std::isfinite( value ) ))
+                ++result.numFailures;
+            else
+                errors.push_back( value - expected );
+        }
+
+        delete p;
+
+        elapsed = std::chrono::duration<double>( clock_type::now() - start ).count();
+
+        if (( minTime_ <= elapsed ) || ( !result.numOps ))
+            break;
+    }
+
+    if ( result.numOps )
+    {
+        result.nsPerOp = 1e9 * elapsed / result.numOps;
+        result.allocsPerOp = (double)(numAllocations() - allocs) / result.numOps;
+    }
+
+    score( errors, result );
+
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+PricingBenchmark::Result PricingBenchmark::measureChain( const Method& m, Operation op ) const
+{
+    using clock_type = std::chrono::steady_clock;
+
+    Result result = {m.name, op, 0, 0.0, 0.0, 0.0, 0.0, 0};
+
+    // ladder of call strikes from half to one and a half times spot
+    const std::vector<OptionType> types( CHAIN_STRIKES, OptionType::Call );
+
+    std::vector<double> strikes( CHAIN_STRIKES );
+    std::vector<double> prices( CHAIN_STRIKES );
+
+    for ( size_t i( 0 ); i < CHAIN_STRIKES; ++i )
+        strikes[i] = SPOT * (0.5 + 0.005 * i);
+
+    // batch prices should match pricing each strike on its own
+    std::vector<double> expected;
+
+    if ( CHAIN_BATCH_PRICE == op )
+    {
+        expected.resize( expiryDays_.size() * CHAIN_STRIKES );
+
+        for ( size_t e( 0 ); e < expiryDays_.size(); ++e )
+        {
+            AbstractOptionPricing *p( m.create( SPOT, RATE, RATE, SIGMA, timeToExpiry( e ) ) );
+
+            for ( size_t i( 0 ); i < CHAIN_STRIKES; ++i )
+                expected[e * CHAIN_STRIKES + i] = p->optionPrice( types[i], strikes[i] );
+
+            delete p;
+        }
+    }
+
+    // reserve up front so the first pass does not count towards allocations
+    std::vector<double> errors;
+    errors.reserve( expected.size() );
+
+    const size_t allocs( numAllocations() );
+    const clock_type::time_point start( clock_type::now() );
+
+    double elapsed;
+
+    for ( bool first( true );; first = false )
+    {
+        for ( size_t e( 0 ); e < expiryDays_.size(); ++e )
+        {
+            AbstractOptionPricing *p( m.create( SPOT, RATE, RATE, SIGMA, timeToExpiry( e ) ) );
+
+            if ( CHAIN_BATCH_PRICE == op )
+                p->batchOptionPrice( types.data(), strikes.data(), prices.data(), CHAIN_STRIKES );
+            else
+            {
+                for ( size_t i( 0 ); i < CHAIN_STRIKES; ++i )
+                {
+                    double delta, gamma, theta, vega, rho;
+
+                    prices[i] = p->optionPrice( types[i], strikes[i] );
+                    p->partials( types[i], strikes[i], delta, gamma, theta, vega, rho );
+
+                    if (( first ) && ( !(std::isfinite( delta ) && std::isfinite( gamma ) && std::isfinite( theta ) && std::isfinite( vega ) && std::isfinite( rho )) ))
+                        ++result.numFailures;
+                }
+            }
+
+            delete p;
+
+            result.numOps += CHAIN_STRIKES;
+
+            // score first pass only
+            if (( !first ) || ( CHAIN_BATCH_PRICE != op ))
+                continue;
+
+            for ( size_t i( 0 ); i < CHAIN_STRIKES; ++i )
+            {
+                if ( !std::isfinite( prices[i] ) )
+                    ++result.numFailures;
+                else
+                    errors.push_back( prices[i] - expected[e * CHAIN_STRIKES + i] );
+            }
+        }
+
+        elapsed = std::chrono::duration<double>( clock_type::now() - start ).count();
+
+        if ( minTime_ <= elapsed )
+            break;
+    }
+
+    result.nsPerOp = 1e9 * elapsed / result.numOps;
+    result.allocsPerOp = (double)(numAllocations() - allocs) / result.numOps;
+
+    score( errors, result );
+
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void PricingBenchmark::score( const std::vector<double>& errors, Result& result )
+{
+    double sum( 0.0 );
+
+    for ( size_t i( 0 ); i < errors.size(); ++i )
+    {
+        result.maxError = std::fmax( result.maxError, std::fabs( errors[i] ) );
+        sum += errors[i] * errors[i];
+    }
+
+    if ( errors.size() )
+        result.rmsError = std::sqrt( sum / errors.size() );
+}
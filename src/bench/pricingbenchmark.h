@@ -0,0 +1,258 @@
+/**
+ * @file pricingbenchmark.h
+ * Option pricing benchmark suite.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRICINGBENCHMARK_H
+#define PRICINGBENCHMARK_H
+
+#include "util/optiontype.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class AbstractOptionPricing;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Option pricing benchmark suite.
+/**
+ * Times every pricing method, and both implied volatility solvers, over one grid of moneyness and
+ * expiry values. Prices and deltas are scored against a reference for the same grid point, american
+ * methods against a deep Cox-Ross-Rubinstein tree and european methods against Black-Scholes.
+ * Implied volatility is solved for the price each method gives at SIGMA, and scored against SIGMA.
+ *
+ * A ladder of call strikes is also priced at every expiry, one strike at a time with partials and
+ * all strikes in one batch. Batch prices are scored against the method's own single strike prices.
+ */
+class PricingBenchmark
+{
+    using _Myt = PricingBenchmark;
+
+public:
+
+    /// Benchmark operations.
+    enum Operation
+    {
+        PRICE,                                      ///< Option price.
+        PARTIALS,                                   ///< Option price and partials.
+        IMPL_VOL_NEWTON_RAPHSON,                    ///< Implied volatility using Newton-Raphson.
+        IMPL_VOL_ALT_BISECTION,                     ///< Implied volatility using alternative bisection.
+        CHAIN_PARTIALS,                             ///< Option price and partials of every strike in a ladder.
+        CHAIN_BATCH_PRICE,                          ///< Option prices of a ladder in one batch.
+        _NUM_OPERATIONS,
+    };
+
+    /// Benchmark result.
+    struct Result
+    {
+        std::string method;                         ///< Pricing method.
+        Operation operation;                        ///< Operation timed.
+
+        size_t numOps;                              ///< Number of operations timed.
+
+        double nsPerOp;                             ///< Nanoseconds per operation.
+        double allocsPerOp;                         ///< Heap allocations per operation.
+
+        double maxError;                            ///< Maximum absolute error against reference.
+        double rmsError;                            ///< Root mean square error against reference.
+
+        size_t numFailures;                         ///< Number of operations that failed.
+    };
+
+    /// Result list type.
+    using ResultList = std::vector<Result>;
+
+    /// Factory method for creation of Option Pricing Methods.
+    using factory_method_type = AbstractOptionPricing *(*)( double S, double r, double b, double sigma, double T );
+
+    // ========================================================================
+    // CTOR / DTOR
+    // ========================================================================
+
+    /// Constructor.
+    /**
+     * @param[in] minTime  minimum time to spend timing each operation (seconds)
+     */
+    PricingBenchmark( double minTime = 0.25 );
+
+    /// Destructor.
+    ~PricingBenchmark();
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// Retrieve expiry grid.
+    /**
+     * @return  days to expiration
+     */
+    const std::vector<double>& expiryDays() const {return expiryDays_;}
+
+    /// Retrieve moneyness grid.
+    /**
+     * @return  strike price over spot price
+     */
+    const std::vector<double>& moneyness() const {return moneyness_;}
+
+    /// Retrieve minimum time to spend timing each operation.
+    /**
+     * @return  time (seconds)
+     */
+    double minTime() const {return minTime_;}
+
+    /// Retrieve benchmark results.
+    /**
+     * @return  results
+     */
+    const ResultList& results() const {return results_;}
+
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Run benchmarks.
+    /**
+     * @param[in] filter  pricing method to run, empty for all
+     * @return  @c true if any pricing method matched @a filter, @c false otherwise
+     */
+    bool run( const std::string& filter = std::string() );
+
+    // ========================================================================
+    // Static Methods
+    // ========================================================================
+
+    /// Retrieve pricing method names.
+    /**
+     * @return  names
+     */
+    static std::vector<std::string> methodNames();
+
+    /// Retrieve number of heap allocations made by this process.
+    /**
+     * @return  number of allocations
+     */
+    static size_t numAllocations();
+
+    /// Retrieve operation name.
+    /**
+     * @param[in] op  operation
+     * @return  name
+     */
+    static std::string operationName( Operation op );
+
+    static constexpr double SPOT = 100.0;           ///< Underlying price of every grid point.
+    static constexpr double RATE = 0.03;            ///< Risk-free interest rate of every grid point.
+    static constexpr double SIGMA = 0.30;           ///< Volatility of every grid point.
+
+private:
+
+    static constexpr size_t REFERENCE_DEPTH = 4096;
+    static constexpr double IMPL_VOL_MIN_TIME_VALUE = 0.05;
+    static constexpr size_t CHAIN_STRIKES = 200;
+
+    /// Pricing method.
+    struct Method
+    {
+        const char *name;                           ///< Name.
+        factory_method_type create;                 ///< Factory method.
+        bool callsOnly;                             ///< Method only prices calls.
+    };
+
+    /// Grid point.
+    struct GridPoint
+    {
+        size_t expiry;                              ///< Expiry index.
+
+        OptionType type;                            ///< Option type.
+        double X;                                   ///< Strike price.
+
+        double american;                            ///< American reference price.
+        double americanDelta;                       ///< American reference delta.
+
+        double european;                            ///< European reference price.
+        double europeanDelta;                       ///< European reference delta.
+    };
+
+    using GridPointList = std::vector<GridPoint>;
+
+    double minTime_;
+
+    std::vector<double> expiryDays_;
+    std::vector<double> moneyness_;
+
+    GridPointList grid_;
+
+    ResultList results_;
+
+    /// Retrieve pricing methods.
+    static const std::vector<Method>& methods();
+
+    /// Build grid and reference prices.
+    void buildGrid();
+
+    /// Time one operation of a pricing method over the grid.
+    /**
+     * @param[in] m  pricing method
+     * @param[in] op  operation
+     * @return  result
+     */
+    Result measure( const Method& m, Operation op ) const;
+
+    /// Time one operation of a pricing method over a ladder of strikes.
+    /**
+     * @param[in] m  pricing method
+     * @param[in] op  operation
+     * @return  result
+     */
+    Result measureChain( const Method& m, Operation op ) const;
+
+    /// Score errors against reference.
+    /**
+     * @param[in] errors  errors
+     * @param[in,out] result  result
+     */
+    static void score( const std::vector<double>& errors, Result& result );
+
+    /// Retrieve time to expiration.
+    /**
+     * @param[in] expiry  expiry index
+     * @return  time to expiration (years)
+     */
+    double timeToExpiry( size_t expiry ) const {return expiryDays_[expiry] / 365.0;}
+
+    // not implemented
+    PricingBenchmark( const _Myt& ) = delete;
+
+    // not implemented
+    PricingBenchmark( const _Myt&& ) = delete;
+
+    // not implemented
+    _Myt& operator = ( const _Myt& ) = delete;
+
+    // not implemented
+    _Myt& operator = ( const _Myt&& ) = delete;
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // PRICINGBENCHMARK_H
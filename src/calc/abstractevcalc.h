@@ -26,6 +26,7 @@
 #include "expectedvaluecalc.h"
 
 #include "util/altbisection.h"
+#include "util/batchnewtonraphson.h"
 #include "util/newtonraphson.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -52,9 +53,10 @@ public:
      * @param[in] underlying  underlying price (i.e. mark)
      * @param[in] chains  chains to evaluate
      * @param[in] results  results
+     * @param[in] context  market data for underlying
      */
-    AbstractExpectedValueCalculator( double underlying, const table_model_type *chains, item_model_type *results ) :
-        _Mybase( underlying, chains, results ) {}
+    AbstractExpectedValueCalculator( double underlying, const table_model_type *chains, item_model_type *results, const QSharedPointer<const market_context_type>& context ) :
+        _Mybase( underlying, chains, results, context ) {}
 
     /// Destructor.
     ~AbstractExpectedValueCalculator() {}
@@ -97,6 +99,58 @@ protected:
         return vi;
     }
 
+    /// Calculate implied volatilities.
+    /**
+     * Options are priced against the underlying, each option with its own time to expiration.
+     * @param[in] r  risk-free interest rate
+     * @param[in] types  option types
+     * @param[in] X  strike prices
+     * @param[in] T  times to expiration (years)
+     * @param[in] prices  option prices
+     * @param[out] vi  implied volatilities
+     * @param[out] okay  @c true if calculation okay, @c false otherwise
+     * @param[in] n  number of options
+     */
+    virtual void calcImplVol( double r, const OptionType *types, const double *X, const double *T, const double *prices, double *vi, bool *okay, size_t n ) const override
+    {
+        static constexpr bool closedForm( std::is_same<BlackScholes, pricing_method_type>::value && std::is_same<NewtonRaphson, implied_volatility_method_type>::value );
+        static constexpr bool altMethod( !std::is_same<AlternativeBisection, implied_volatility_method_type>::value );
+
+        // closed form model solves every option together
+        if ( closedForm )
+            BatchNewtonRaphson::calcImplVolBlackScholes( this->underlying_, r, r - this->dividendYield(), types, X, T, prices, vi, okay, n );
+
+        pricing_method_type *p( nullptr );
+
+        for ( size_t i( 0 ); i < n; ++i )
+        {
+            if (( closedForm ) && ( okay[i] ))
+                continue;
+
+            // options of same expiration share pricing method
+            if (( !p ) || ( T[i] != p->timeToExpiry() ))
+            {
+                destroyPricingMethod( p );
+                p = dynamic_cast<pricing_method_type*>( this->createPricingMethod( this->underlying_, r, r, 0.0, T[i], this->divTimes_, this->div_ ) );
+            }
+
+            // primary method
+            if ( !closedForm )
+            {
+                if ( std::is_same<NewtonRaphson, implied_volatility_method_type>::value )
+                    vi[i] = NewtonRaphson::calcImplVol( p, types[i], X[i], prices[i], BatchNewtonRaphson::calcImplVolSeedValue( p, types[i], X[i], prices[i] ), &okay[i] );
+                else
+                    vi[i] = implied_volatility_method_type::calcImplVol( p, types[i], X[i], prices[i], &okay[i] );
+            }
+
+            // alt method for VI calculation (if applicable)
+            if (( altMethod ) && ( !okay[i] ))
+                vi[i] = AlternativeBisection::calcImplVol( p, types[i], X[i], prices[i], &okay[i] );
+        }
+
+        destroyPricingMethod( p );
+    }
+
     /// Factory method for destruction of Option Pricing Methods.
     /**
      * @param[in] doomed  pricing method to destroy
@@ -60,9 +60,10 @@ public:
      * @param[in] underlying  underlying price (i.e. mark)
      * @param[in] chains  chains to evaluate
      * @param[in] results  results
+     * @param[in] context  market data for underlying
      */
-    BasicCalculator( double underlying, const table_model_type *chains, item_model_type *results ) :
-        _Mybase( underlying, chains, results ) {}
+    BasicCalculator( double underlying, const table_model_type *chains, item_model_type *results, const QSharedPointer<const market_context_type>& context ) :
+        _Mybase( underlying, chains, results, context ) {}
 
     /// Destructor.
     ~BasicCalculator() {}
@@ -29,30 +29,32 @@
 
 #include "util/abstractoptionpricing.h"
 
+#include <algorithm>
+
 #include <QObject>
 
 // uncomment to debug calculations
 //#define DEBUG_CALC
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-ExpectedValueCalculator::ExpectedValueCalculator( double underlying, const table_model_type *chains, item_model_type *results ) :
-    _Mybase( underlying, chains, results )
+ExpectedValueCalculator::ExpectedValueCalculator( double underlying, const table_model_type *chains, item_model_type *results, const QSharedPointer<const market_context_type>& context ) :
+    _Mybase( underlying, chains, results, context )
 {
-    const QDateTime now( AppDatabase::instance()->currentDateTime() );
+    const qint64 now( AppDatabase::instance()->currentDateTime().toMSecsSinceEpoch() );
 
     // separate strikes into ascending and descending lists
-    for ( int row( 0 ); row < chains_->rowCount(); ++row )
+    for ( int row( 0 ); row < snapshot_->rowCount(); ++row )
     {
         // ignore non-standard options
         if ( isNonStandard( row ) )
             continue;
         // ignore expired options
-        else if ( chains->tableData( row, table_model_type::CALL_EXPIRY_DATE ).toDateTime() < now )
+        else if ( snapshot_->calls().expiryTime[row] < now )
             continue;
-        else if ( chains->tableData( row, table_model_type::PUT_EXPIRY_DATE ).toDateTime() < now )
+        else if ( snapshot_->puts().expiryTime[row] < now )
             continue;
 
-        const double strike( chains_->tableData( row, table_model_type::STRIKE_PRICE ).toDouble() );
+        const double strike( snapshot_->strike( row ) );
 
         asc_.append( strike );
         desc_.prepend( strike );
@@ -130,7 +132,7 @@ void ExpectedValueCalculator::analyzeSingle( bool call, bool put ) const
     if ( call )
     {
         // analyze!
-        for ( int row( chains_->rowCount() ); row--; )
+        for ( int row( snapshot_->rowCount() ); row--; )
         {
             if ( isFilteredOut( row, true ) )
                 continue;
@@ -142,7 +144,7 @@ void ExpectedValueCalculator::analyzeSingle( bool call, bool put ) const
     if ( put )
     {
         // analyze!
-        for ( int row( chains_->rowCount() ); row--; )
+        for ( int row( snapshot_->rowCount() ); row--; )
         {
             if ( isFilteredOut( row, false ) )
                 continue;
@@ -156,7 +158,7 @@ void ExpectedValueCalculator::analyzeSingle( bool call, bool put ) const
 void ExpectedValueCalculator::analyzeVertBearCalls() const
 {
     // analyze!
-    for ( int rowLong( chains_->rowCount() ); rowLong--; )
+    for ( int rowLong( snapshot_->rowCount() ); rowLong--; )
         for ( int rowShort( qMax( 0, rowLong - f_.verticalDepth() ) ); rowShort < rowLong; ++rowShort )
         {
             if (( isFilteredOut( rowLong, true ) ) || ( isFilteredOut( rowShort, true )))
@@ -170,7 +172,7 @@ void ExpectedValueCalculator::analyzeVertBearCalls() const
 void ExpectedValueCalculator::analyzeVertBullPuts() const
 {
     // analyze!
-    for ( int rowShort( chains_->rowCount() ); rowShort--; )
+    for ( int rowShort( snapshot_->rowCount() ); rowShort--; )
         for ( int rowLong( qMax( 0, rowShort - f_.verticalDepth() ) ); rowLong < rowShort; ++rowLong )
         {
             if (( isFilteredOut( rowLong, false ) ) || ( isFilteredOut( rowShort, false )))
@@ -188,13 +190,13 @@ bool ExpectedValueCalculator::generateGreeks()
 
     // calculate greeks
     // iterate over all options
-    for ( int row( 0 ); row < chains_->rowCount(); ++row )
+    for ( int row( 0 ); row < snapshot_->rowCount(); ++row )
     {
         // ignore non-standard options
         if ( isNonStandard( row ) )
             continue;
 
-        const double strike( chains_->tableData( row, table_model_type::STRIKE_PRICE ).toDouble() );
+        const double strike( snapshot_->strike( row ) );
 
         if (( !generateGreeks( row, strike, true ) ) ||     // calls
             ( !generateGreeks( row, strike, false ) ))      // puts
@@ -204,6 +206,10 @@ bool ExpectedValueCalculator::generateGreeks()
         }
     }
 
+    // solve vi of each side together
+    generateImplVols( greeksCall_, true );
+    generateImplVols( greeksPut_, false );
+
     return true;
 }
 
@@ -377,6 +383,8 @@ bool ExpectedValueCalculator::generateProbCurve()
     // save option curve info
     const QString stamp( chains_->data0( table_model_type::STAMP ).toString() );
 
+    freezeProbCurve();
+
     LOG_DEBUG << "set option chain curve " << qPrintable( chains_->symbol() ) << " " << qPrintable( chains_->expirationDate().toString() ) << " " << qPrintable( stamp );
 
     SymbolDatabases::instance()->setOptionChainCurves(
@@ -404,7 +412,7 @@ AbstractOptionPricing *ExpectedValueCalculator::createPricingMethod( double S, d
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void ExpectedValueCalculator::analyzeSingleCall( int row ) const
 {
-    const double strike( chains_->tableData( row, table_model_type::STRIKE_PRICE ).toDouble() );
+    const double strike( snapshot_->strike( row ) );
 
     const QString optionType( QObject::tr( "Call" ) );
 
@@ -518,7 +526,7 @@ void ExpectedValueCalculator::analyzeSingleCall( int row ) const
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void ExpectedValueCalculator::analyzeSinglePut( int row ) const
 {
-    const double strike( chains_->tableData( row, table_model_type::STRIKE_PRICE ).toDouble() );
+    const double strike( snapshot_->strike( row ) );
 
     const QString optionType( QObject::tr( "Put" ) );
 
@@ -624,8 +632,8 @@ void ExpectedValueCalculator::analyzeSinglePut( int row ) const
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void ExpectedValueCalculator::analyzeVertBearCall( int rowLong, int rowShort ) const
 {
-    const double strikeLong( chains_->tableData( rowLong, table_model_type::STRIKE_PRICE ).toDouble() );
-    const double strikeShort( chains_->tableData( rowShort, table_model_type::STRIKE_PRICE ).toDouble() );
+    const double strikeLong( snapshot_->strike( rowLong ) );
+    const double strikeShort( snapshot_->strike( rowShort ) );
 
     const QString optionType( QObject::tr( "Vertical Bear Call" ) );
 
@@ -746,8 +754,8 @@ void ExpectedValueCalculator::analyzeVertBearCall( int rowLong, int rowShort ) c
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void ExpectedValueCalculator::analyzeVertBullPut( int rowLong, int rowShort ) const
 {
-    const double strikeLong( chains_->tableData( rowLong, table_model_type::STRIKE_PRICE ).toDouble() );
-    const double strikeShort( chains_->tableData( rowShort, table_model_type::STRIKE_PRICE ).toDouble() );
+    const double strikeLong( snapshot_->strike( rowLong ) );
+    const double strikeShort( snapshot_->strike( rowShort ) );
 
     const QString optionType( QObject::tr( "Vertical Bull Put" ) );
 
@@ -870,16 +878,16 @@ bool ExpectedValueCalculator::generateGreeks( int row, double strike, bool isCal
 {
     static const double SECONDS_PER_DAY = 86400;
 
-    const QDateTime quoteTime( chains_->tableData( row, isCall ? table_model_type::CALL_QUOTE_TIME : table_model_type::PUT_QUOTE_TIME ).toDateTime() );
-    const QDateTime expiryDate( chains_->tableData( row, isCall ? table_model_type::CALL_EXPIRY_DATE : table_model_type::PUT_EXPIRY_DATE ).toDateTime() );
+    const OptionChainSnapshot::Side& side( snapshot_->side( isCall ) );
 
-    if (( quoteTime.isValid() ) && ( expiryDate.isValid() ) && ( quoteTime < expiryDate ))
-    {
-        const double bid( chains_->tableData( row, isCall ? table_model_type::CALL_BID_PRICE : table_model_type::PUT_BID_PRICE ).toDouble() );
-        const double ask( chains_->tableData( row, isCall ? table_model_type::CALL_ASK_PRICE : table_model_type::PUT_ASK_PRICE ).toDouble() );
-        const double mark( chains_->tableData( row, isCall ? table_model_type::CALL_MARK : table_model_type::PUT_MARK ).toDouble() );
+    const qint64 quoteTime( side.quoteTime[row] );
+    const qint64 expiryDate( side.expiryTime[row] );
 
-        const OptionType type( isCall ? OptionType::Call : OptionType::Put );
+    if (( OptionChainSnapshot::INVALID_TIME != quoteTime ) && ( OptionChainSnapshot::INVALID_TIME != expiryDate ) && ( quoteTime < expiryDate ))
+    {
+        const double bid( side.bid[row] );
+        const double ask( side.ask[row] );
+        const double mark( side.mark[row] );
 
         Greeks result = {};
         result.spread = ask - bid;
@@ -890,7 +898,7 @@ bool ExpectedValueCalculator::generateGreeks( int row, double strike, bool isCal
         result.mark = mark;
 
         // calc expiry time in years
-        result.timeToExpiry = quoteTime.secsTo( expiryDate );
+        result.timeToExpiry = (expiryDate - quoteTime) / 1000;
         result.timeToExpiry /= SECONDS_PER_DAY;
         result.timeToExpiry /= AppDatabase::instance()->numDays();
 
@@ -899,25 +907,6 @@ bool ExpectedValueCalculator::generateGreeks( int row, double strike, bool isCal
         // get risk free interest rate
         result.riskFreeRate = riskFreeRate_;
 
-        // generate VI for bid, ask, mark prices
-        AbstractOptionPricing *o( createPricingMethod( underlying_, result.riskFreeRate, result.riskFreeRate, 0.0, result.timeToExpiry, divTimes_, div_ ) );
-
-        result.bidvi = calcImplVol( o, type, strike, bid );
-        result.askvi = calcImplVol( o, type, strike, ask );
-        result.markvi = calcImplVol( o, type, strike, mark );
-
-        // check for unrealistic volatility
-        if ( 0.0 < result.askvi )
-        {
-            if (( 0.0 < result.bidvi ) && ( result.askvi < result.bidvi ))
-                result.bidvi = 0.0;
-
-            if (( 0.0 < result.markvi ) && ( result.askvi < result.markvi ))
-                result.markvi = 0.0;
-        }
-
-        destroyPricingMethod( o );
-
         if ( isCall )
             greeksCall_[strike] = result;
         else
@@ -929,6 +918,55 @@ bool ExpectedValueCalculator::generateGreeks( int row, double strike, bool isCal
     return false;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ExpectedValueCalculator::generateImplVols( OptionGreeks& greeks, bool isCall )
+{
+    // bid, ask, mark for every strike
+    const size_t n( 3 * greeks.size() );
+
+    ivTypes_.assign( n, isCall ? OptionType::Call : OptionType::Put );
+    ivStrikes_.resize( n );
+    ivTimeToExpiry_.resize( n );
+    ivPrices_.resize( n );
+    ivVi_.resize( n );
+    ivOkay_.resize( n );
+
+    size_t i( 0 );
+
+    for ( OptionGreeks::const_iterator g( greeks.constBegin() ); g != greeks.constEnd(); ++g )
+    {
+        const double prices[] = { g->bid, g->ask, g->mark };
+
+        for ( size_t k( 0 ); k < 3; ++k, ++i )
+        {
+            ivStrikes_[i] = g.key();
+            ivTimeToExpiry_[i] = g->timeToExpiry;
+            ivPrices_[i] = prices[k];
+        }
+    }
+
+    calcImplVol( riskFreeRate_, ivTypes_.data(), ivStrikes_.data(), ivTimeToExpiry_.data(), ivPrices_.data(), ivVi_.data(), ivOkay_.data(), n );
+
+    i = 0;
+
+    for ( OptionGreeks::iterator g( greeks.begin() ); g != greeks.end(); ++g )
+    {
+        g->bidvi = ivVi_[i++];
+        g->askvi = ivVi_[i++];
+        g->markvi = ivVi_[i++];
+
+        // check for unrealistic volatility
+        if ( 0.0 < g->askvi )
+        {
+            if (( 0.0 < g->bidvi ) && ( g->askvi < g->bidvi ))
+                g->bidvi = 0.0;
+
+            if (( 0.0 < g->markvi ) && ( g->askvi < g->markvi ))
+                g->markvi = 0.0;
+        }
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool ExpectedValueCalculator::calcProbCurve( OptionProbCurve& curve, const QList<double>& direction, bool isCall ) const
 {
@@ -1235,30 +1273,69 @@ bool ExpectedValueCalculator::calcGreeks( AbstractOptionPricing *o, double theoO
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-double ExpectedValueCalculator::calcProbInTheMoney( double price, bool isCall ) const
+void ExpectedValueCalculator::freezeProbCurve()
 {
-    // check if this price is in curve (i.e. strike price)
-    if ( probCurve_.contains( price ) )
-        return ( isCall ? probCurve_[price] : (1.0 - probCurve_[price]) );
+    const size_t n( probCurve_.size() );
+
+    probStrikes_.resize( n );
+    probITM_.resize( n );
+    probLossSum_.resize( n );
 
     double prevStrike( 0.0 );
+    double prevProb( 0.0 );
+
+    double sum( 0.0 );
+
+    size_t i( 0 );
 
-    // find strike above and below price
-    foreach ( const double& s, asc_ )
+    for ( QMap<double, double>::const_iterator it( probCurve_.constBegin() ); it != probCurve_.constEnd(); ++it, ++i )
     {
-        if (( prevStrike < price ) && ( price <= s ))
-        {
-            const double itmProbMin( isCall ? probCurve_[prevStrike] : (1.0 - probCurve_[prevStrike]) );
-            const double itmProbMax( isCall ? probCurve_[s] : (1.0 - probCurve_[s]) );
+        const double strike( it.key() );
+        const double prob( 1.0 - it.value() );
 
-            // interpolate
-            return ( itmProbMin + ((double)(price - prevStrike) / (double)(s - prevStrike)) * (itmProbMax - itmProbMin) );
-        }
+        // price at this possibility is midway from previous strike
+        const double floor( qMax( underlyingMin_, prevStrike ) );
+        const double price( floor + ((strike - floor) / 2.0) );
+
+        sum += (prob - prevProb) * price;
+
+        probStrikes_[i] = strike;
+        probITM_[i] = it.value();
+        probLossSum_[i] = sum;
 
-        prevStrike = s;
+        prevStrike = strike;
+        prevProb = prob;
     }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+double ExpectedValueCalculator::calcProbInTheMoney( double price, bool isCall ) const
+{
+    // find strike at or above price
+    const std::vector<double>::const_iterator it( std::lower_bound( probStrikes_.begin(), probStrikes_.end(), price ) );
+
+    if ( probStrikes_.end() == it )
+        return 0.0;
+
+    const size_t i( it - probStrikes_.begin() );
+
+    const double itmProbMax( isCall ? probITM_[i] : (1.0 - probITM_[i]) );
+
+    // check if this price is in curve (i.e. strike price)
+    if ( price == probStrikes_[i] )
+        return itmProbMax;
+
+    // strike below price (zero when price is below all strikes)
+    const double prevStrike( i ? probStrikes_[i-1] : 0.0 );
+
+    if ( price <= prevStrike )
+        return 0.0;
 
-    return 0.0;
+    const double prevProb( i ? probITM_[i-1] : 0.0 );
+    const double itmProbMin( isCall ? prevProb : (1.0 - prevProb) );
+
+    // interpolate
+    return ( itmProbMin + ((double)(price - prevStrike) / (double)(probStrikes_[i] - prevStrike)) * (itmProbMax - itmProbMin) );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1267,43 +1344,39 @@ double ExpectedValueCalculator::calcExpectedLoss( double multiplier, double pric
     // when call flag set we are buying at probability and selling at cost basis
     const double z( isCall ? -1.0 : 1.0 );
 
-    bool done( false );
+    const size_t n( probStrikes_.size() );
 
-    double prevStrike( 0.0 );
-    double prevProb( 0.0 );
+    // first strike above min price
+    const size_t first( std::upper_bound( probStrikes_.begin(), probStrikes_.end(), priceMin ) - probStrikes_.begin() );
 
-    double loss( 0.0 );
+    // last strike, first one at or above max price
+    const size_t last( qMax( first, (size_t)(std::lower_bound( probStrikes_.begin(), probStrikes_.end(), priceMax ) - probStrikes_.begin()) ) );
 
-    // iterate each strike price
-    foreach ( const double& strike, asc_ )
-    {
-        const double prob( calcProbInTheMoney( strike, false ) );
+    // probability and probability weighted price prior to first strike
+    const double probBefore( first ? (1.0 - probITM_[first-1]) : 0.0 );
+    const double sumBefore( first ? probLossSum_[first-1] : 0.0 );
 
-        // check this strike within our min/max
-        if ( priceMin < strike )
-        {
-            const double probDelta( prob - prevProb );
-
-            const double floor( qMax( underlyingMin_, prevStrike ) );
-            const double price( floor + ((strike - floor) / 2.0) );
+    double loss( 0.0 );
 
-            assert( 0.0 <= probDelta );
+    // accumulate loss at each strike within our min/max
+    if ( first < n )
+    {
+        const size_t end( qMin( last, n - 1 ) );
 
-            // accumulate loss at this possibility
-            loss += multiplier * probDelta * z * (costBasis - price);
-            totalProb += probDelta;
+        const double probDelta( (1.0 - probITM_[end]) - probBefore );
 
-            if ( (done = (priceMax <= strike)) )
-                break;
-        }
+        assert( 0.0 <= probDelta );
 
-        prevStrike = strike;
-        prevProb = prob;
+        loss += multiplier * z * ((probDelta * costBasis) - (probLossSum_[end] - sumBefore));
+        totalProb += probDelta;
     }
 
     // last strike was below max price... add in remaining loss at max price
-    if ( !done )
+    if ( n <= last )
     {
+        const double prevStrike( n ? probStrikes_[n-1] : 0.0 );
+        const double prevProb( n ? (1.0 - probITM_[n-1]) : 0.0 );
+
         const double probDelta( 1.0 - prevProb );
 
         const double floor( qMax( underlyingMin_, prevStrike ) );
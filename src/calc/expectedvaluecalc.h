@@ -67,8 +67,9 @@ protected:
      * @param[in] underlying  underlying price (i.e. mark)
      * @param[in] chains  chains to evaluate
      * @param[in] results  results
+     * @param[in] context  market data for underlying
      */
-    ExpectedValueCalculator( double underlying, const table_model_type *chains, item_model_type *results );
+    ExpectedValueCalculator( double underlying, const table_model_type *chains, item_model_type *results, const QSharedPointer<const market_context_type>& context );
 
     // ========================================================================
     // Methods
@@ -110,6 +111,20 @@ protected:
      */
     virtual double calcImplVol( AbstractOptionPricing *pricing, OptionType type, double X, double price, bool *okay = nullptr ) const = 0;
 
+    /// Calculate implied volatilities.
+    /**
+     * Options are priced against the underlying, each option with its own time to expiration.
+     * @param[in] r  risk-free interest rate
+     * @param[in] types  option types
+     * @param[in] X  strike prices
+     * @param[in] T  times to expiration (years)
+     * @param[in] prices  option prices
+     * @param[out] vi  implied volatilities
+     * @param[out] okay  @c true if calculation okay, @c false otherwise
+     * @param[in] n  number of options
+     */
+    virtual void calcImplVol( double r, const OptionType *types, const double *X, const double *T, const double *prices, double *vi, bool *okay, size_t n ) const = 0;
+
     /// Factory method for creation of Option Pricing Methods.
     /**
      * @param[in] S  underlying (spot) price
@@ -180,6 +195,13 @@ private:
     OptionGreeks greeksCall_;
     OptionGreeks greeksPut_;
 
+    std::vector<OptionType> ivTypes_;
+    std::vector<double> ivStrikes_;
+    std::vector<double> ivTimeToExpiry_;
+    std::vector<double> ivPrices_;
+    std::vector<double> ivVi_;
+    QVector<bool> ivOkay_;
+
     struct ProbCurve
     {
         double min;
@@ -204,6 +226,10 @@ private:
 
     QMap<double, double> probCurve_;
 
+    std::vector<double> probStrikes_;
+    std::vector<double> probITM_;
+    std::vector<double> probLossSum_;
+
     double underlyingMin_;
     double underlyingMax_;
 
@@ -221,10 +247,16 @@ private:
 
     /// Generate greeks.
     /**
-     * Parse chain row data and calculate vi and greeks.
+     * Parse chain row data.
      */
     bool generateGreeks( int row, double strike, bool isCall );
 
+    /// Generate implied volatilities.
+    /**
+     * Calculate bid, ask, and mark vi of every option on one side of the chain together.
+     */
+    void generateImplVols( OptionGreeks& greeks, bool isCall );
+
     /// Calculate probability curve.
     /**
      * Iterate over probability curve data and adjust min/max vi for fitting.
@@ -249,6 +281,13 @@ private:
      */
     bool generateProbCurveParity( double strike, bool isCall );
 
+    /// Freeze probability curve.
+    /**
+     * Copies curve into sorted strike and probability arrays, along with prefix sums of
+     * probability weighted prices, for fast probability and expected loss calculations.
+     */
+    void freezeProbCurve();
+
     /// Calculate greeks for option.
     bool calcGreeks( AbstractOptionPricing *o, double theoOptionValue, double strike, bool isCall, Greeks& result ) const;
 
@@ -1,6 +1,6 @@
 /**
  * @file montecarlocalc.h
- * Monte Carlo simulaions based option profit calculator.
+ * Monte Carlo simulaions based option profit calculator (template class).
  *
  * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
  *
@@ -27,17 +27,33 @@
 
 #include "util/altbisection.h"
 #include "util/montecarlo.h"
+#include "util/quasimontecarlo.h"
+
+#include <random>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// Monte Carlo simulaions based option profit calculator.
-class MonteCarloCalculator : public AbstractExpectedValueCalculator<MonteCarlo, AlternativeBisection>
+/// Monte Carlo simulaions based option profit calculator (template class).
+/**
+ * Every pricing method created by one calculator shares the same random number generator key, so
+ * strikes are priced over the same paths.
+ * @tparam C  option pricing method
+ * @tparam VI  implied volatility calculation method
+ */
+template <class C, class VI = AlternativeBisection>
+class MonteCarloCalculator : public AbstractExpectedValueCalculator<C, VI>
 {
-    using _Myt = MonteCarloCalculator;
-    using _Mybase = AbstractExpectedValueCalculator<MonteCarlo, AlternativeBisection>;
+    using _Myt = MonteCarloCalculator<C, VI>;
+    using _Mybase = AbstractExpectedValueCalculator<C, VI>;
 
 public:
 
+    /// Table model type.
+    using table_model_type = typename _Mybase::table_model_type;
+
+    /// Item model type.
+    using item_model_type = typename _Mybase::item_model_type;
+
     // ========================================================================
     // CTOR / DTOR
     // ========================================================================
@@ -47,14 +63,20 @@ public:
      * @param[in] underlying  underlying price (i.e. mark)
      * @param[in] chains  chains to evaluate
      * @param[in] results  results
+     * @param[in] context  market data for underlying
      */
-    MonteCarloCalculator( double underlying, const table_model_type *chains, item_model_type *results );
+    MonteCarloCalculator( double underlying, const table_model_type *chains, item_model_type *results, const QSharedPointer<const market_context_type>& context ) :
+        _Mybase( underlying, chains, results, context ),
+        rng_( std::random_device{}() ) {}
 
     /// Destructor.
-    ~MonteCarloCalculator();
+    ~MonteCarloCalculator() {}
 
 protected:
 
+    /// Option pricing method type.
+    using pricing_method_type = typename _Mybase::pricing_method_type;
+
     // ========================================================================
     // Methods
     // ========================================================================
@@ -69,13 +91,18 @@ protected:
      * @param[in] european  @c true for european style option (exercise at expiry only), @c false for american style (exercise any time)
      * @return  pointer to pricing method
      */
-    virtual AbstractOptionPricing *createPricingMethod( double S, double r, double b, double sigma, double T, bool european = false ) const override;
+    virtual AbstractOptionPricing *createPricingMethod( double S, double r, double b, double sigma, double T, bool european = false ) const override
+    {
+        Q_UNUSED( european )
+
+        return new pricing_method_type( S, r, b, sigma, T, NUM_SIMULATIONS, rng_ );
+    }
 
 private:
 
     static constexpr int NUM_SIMULATIONS = 4*1024;
 
-    pricing_method_type::rng_engine_type rng_;
+    typename pricing_method_type::rng_engine_type rng_;
 
     // not implemented
     MonteCarloCalculator( const _Myt& ) = delete;
@@ -59,9 +59,10 @@ public:
      * @param[in] underlying  underlying price (i.e. mark)
      * @param[in] chains  chains to evaluate
      * @param[in] results  results
+     * @param[in] context  market data for underlying
      */
-    TrinomialCalculator( double underlying, const table_model_type *chains, item_model_type *results ) :
-        _Mybase( underlying, chains, results ) {}
+    TrinomialCalculator( double underlying, const table_model_type *chains, item_model_type *results, const QSharedPointer<const market_context_type>& context ) :
+        _Mybase( underlying, chains, results, context ) {}
 
     /// Destructor.
     ~TrinomialCalculator() {}
@@ -182,9 +182,10 @@ void ConfigurationDialog::translate()
     optionCalcMethod_->setItemText( 4, tr( "Bjerksund and Stensland (2002)" ) );
     optionCalcMethod_->setItemText( 5, tr( "Black Scholes" ) );
     optionCalcMethod_->setItemText( 6, tr( "Monte Carlo" ) );
-    optionCalcMethod_->setItemText( 7, tr( "Trinomial Tree (Phelim Boyle)" ) );
-    optionCalcMethod_->setItemText( 8, tr( "Trinomial Tree (Alternative)" ) );
-    optionCalcMethod_->setItemText( 9, tr( "Trinomial Tree (Kamrad Ritchken)" ) );
+    optionCalcMethod_->setItemText( 7, tr( "Monte Carlo (Quasi Random Sobol)" ) );
+    optionCalcMethod_->setItemText( 8, tr( "Trinomial Tree (Phelim Boyle)" ) );
+    optionCalcMethod_->setItemText( 9, tr( "Trinomial Tree (Alternative)" ) );
+    optionCalcMethod_->setItemText( 10, tr( "Trinomial Tree (Kamrad Ritchken)" ) );
     optionCalcMethod_->setToolTip( tr( "Which option pricing methodology to use for analysis." ) );
 
     optionAnalysisFilterLabel_->setText( tr( "Option Analysis Filtering Method" ) );
@@ -334,6 +335,7 @@ void ConfigurationDialog::initialize()
     optionCalcMethod_->addItem( QString(), "BJERKSUNDSTENSLAND02" );
     optionCalcMethod_->addItem( QString(), "BLACKSCHOLES" );
     optionCalcMethod_->addItem( QString(), "MONTECARLO" );
+    optionCalcMethod_->addItem( QString(), "MONTECARLO_QMC" );
     optionCalcMethod_->addItem( QString(), "TRINOM" );
     optionCalcMethod_->addItem( QString(), "TRINOM_ALT" );
     optionCalcMethod_->addItem( QString(), "TRINOM_KR" );
@@ -106,6 +106,10 @@ AppDatabase::AppDatabase() :
     goodFriday_.append( QDate( 2028,  4, 14 ) );
     goodFriday_.append( QDate( 2029,  3, 30 ) );
 
+    // build calendar and rates
+    refreshTradingCalendar();
+    refreshRiskFreeRates();
+
 #if defined( QT_DEBUG )
     foreach ( const QDate& d, goodFriday_ )
         assert( 5 == d.dayOfWeek() );
@@ -334,6 +338,11 @@ QStringList AppDatabase::filters() const
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool AppDatabase::isMarketOpen( const QDateTime& dt, const QString& marketType, const QString& product, bool *isExtended ) const
 {
+    const QSharedPointer<const TradingCalendar> calendar( tradingCalendar() );
+
+    if ( calendar->hasMarketHours( dt.date() ) )
+        return calendar->isMarketOpen( dt, marketType, product, isExtended );
+
     QString sql( "SELECT isOpen, product FROM marketHours WHERE DATE(date)=DATE(:date) AND marketType=:marketType" );
 
     if ( product.length() )
@@ -383,6 +392,11 @@ bool AppDatabase::isMarketOpen( const QDateTime& dt, const QString& marketType,
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool AppDatabase::marketHoursExist( const QDate& date, const QString& marketType ) const
 {
+    const QSharedPointer<const TradingCalendar> calendar( tradingCalendar() );
+
+    if ( calendar->hasMarketHours( date ) )
+        return calendar->marketHoursExist( date, marketType );
+
     QString sql( "SELECT isOpen FROM marketHours WHERE DATE(date)=DATE(:date)" );
 
     if ( marketType.length() )
@@ -594,57 +608,7 @@ void AppDatabase::removeWidgetState( WidgetType type, const QString& groupName,
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 double AppDatabase::riskFreeRate( double term ) const
 {
-    const QString sql( "SELECT * FROM riskFreeInterestRates WHERE "
-        "DATE(:dateMin)<=DATE(date) AND "
-        "DATE(date)<= DATE(:dateMax) AND "
-        "source='" + DB_TREAS_YIELD_CURVE + "' "
-            "ORDER BY DATE(date) DESC, term ASC" );
-
-    const QDate dateMax( currentDateTime().date() );
-    const QDate dateMin( dateMax.addDays( -7 ) );
-
-    double rate( 0.0 );
-
-    double lowerTerm( 0.0 );
-    double lowerRate( 0.0 );
-
-    QSqlQuery query( connection() );
-    query.setForwardOnly( true );
-    query.prepare( sql );
-
-    query.bindValue( ":dateMin", dateMin.toString( Qt::ISODate ) );
-    query.bindValue( ":dateMax", dateMax.toString( Qt::ISODate ) );
-
-    // exec sql
-    if ( !query.exec() )
-    {
-        const QSqlError e( query.lastError() );
-
-        LOG_ERROR << "error during select " << e.type() << " " << qPrintable( e.text() );
-    }
-    else
-    {
-        while ( query.next() )
-        {
-            const QSqlRecord rec( query.record() );
-
-            const double upperTerm( rec.value( "term" ).toDouble() );
-            const double upperRate( rec.value( "rate" ).toDouble() );
-
-            if ( term <= upperTerm )
-            {
-                const double ratio = (term - lowerTerm) / (upperTerm - lowerTerm);
-
-                rate = lowerRate + ratio * (upperRate - lowerRate);
-                break;
-            }
-
-            lowerTerm = upperTerm;
-            lowerRate = upperRate;
-        }
-    }
-
-    return rate;
+    return yieldCurve()->rate( term );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -652,35 +616,14 @@ void AppDatabase::riskFreeRates( double term, RiskFreeRatesMap& rates ) const
 {
     static const double EPSILON = 0.0001;
 
-    const QString sql( "SELECT * FROM riskFreeInterestRates WHERE "
-        ":termMin<=term AND "
-        "term<=:termMax AND "
-        "source='" + DB_TREAS_YIELD_CURVE + "' " );
-
-    QSqlQuery query( connection() );
-    query.setForwardOnly( true );
-    query.prepare( sql );
+    QMutexLocker guard( &ratesMutex_ );
 
-    query.bindValue( ":termMin", term - EPSILON );
-    query.bindValue( ":termMax", term + EPSILON );
-
-    // exec sql
-    if ( !query.exec() )
-    {
-        const QSqlError e( query.lastError() );
-
-        LOG_ERROR << "error during select " << e.type() << " " << qPrintable( e.text() );
-    }
-    else
+    for ( QMap<QDate, QMap<double, double>>::const_iterator i( yieldCurveRates_.constBegin() ); i != yieldCurveRates_.constEnd(); ++i )
     {
-        while ( query.next() )
-        {
-            const QSqlRecord rec( query.record() );
-
-            const QDate d( QDate::fromString( rec.value( "date" ).toString(), Qt::ISODate ) );
+        const QMap<double, double>::const_iterator r( i->lowerBound( term - EPSILON ) );
 
-            rates[d] = rec.value( "rate" ).toDouble();
-        }
+        if (( i->constEnd() != r ) && ( r.key() <= term + EPSILON ))
+            rates[i.key()] = r.value();
     }
 }
 
@@ -901,6 +844,45 @@ void AppDatabase::setWidgetState( WidgetType type, const QString& groupName, con
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QSharedPointer<const TradingCalendar> AppDatabase::tradingCalendar() const
+{
+    QMutexLocker guard( &calendarMutex_ );
+    return calendar_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QSharedPointer<const YieldCurve> AppDatabase::yieldCurve() const
+{
+    const QDate dateMax( currentDateTime().date() );
+    const QDate dateMin( dateMax.addDays( -7 ) );
+
+    QMutexLocker guard( &ratesMutex_ );
+
+    if (( yieldCurve_ ) && ( yieldCurve_->date() == dateMax ))
+        return yieldCurve_;
+
+    std::vector<double> terms;
+    std::vector<double> rates;
+
+    // latest rates within the last week
+    QMap<QDate, QMap<double, double>>::const_iterator i( yieldCurveRates_.upperBound( dateMax ) );
+
+    if (( yieldCurveRates_.constBegin() != i ) && ( dateMin <= (--i).key() ))
+    {
+        for ( QMap<double, double>::const_iterator r( i->constBegin() ); r != i->constEnd(); ++r )
+        {
+            terms.push_back( r.key() );
+            rates.push_back( r.value() );
+        }
+    }
+
+    // curve is dated for the day it serves, not the day of the rates
+    yieldCurve_.reset( new YieldCurve( dateMax, terms, rates ) );
+
+    return yieldCurve_;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void AppDatabase::treasuryYieldCurveDateRange( QDate& start, QDate& end ) const
 {
@@ -1173,117 +1155,7 @@ int AppDatabase::numTradingDaysBetween( const QDate& d0, const QDate& d ) const
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 double AppDatabase::numTradingDaysBetween( const QDateTime& dt0, const QDateTime& dt ) const
 {
-    // make sure dates are ordered correctly
-    assert( dt0 <= dt );
-
-    QDate now( dt0.date() );
-
-    double days( 0 );
-
-    do
-    {
-        // check day of week
-        // 6 = sat
-        // 7 = sun
-        if ( now.dayOfWeek() < 6 )
-        {
-            const bool isMonday( 1 == now.dayOfWeek() );
-            const bool isFriday( 5 == now.dayOfWeek() );
-            const int nthDayOfWeek( std::ceil( now.day() / 7.0 ) );
-
-            const int m( now.month() );
-            const int d( now.day() );
-
-            bool valid( true );
-
-            // new years day
-            if ((  1 == m &&  1 == d ) ||
-                ( 12 == m && 31 == d && isFriday ) ||
-                (  1 == m &&  2 == d && isMonday ))
-                valid = false;
-
-            // martin luther king jr
-            // third monday in january
-            if ( 1 == m && isMonday && 3 == nthDayOfWeek )
-                valid = false;
-
-            // presidents day
-            // third monday in february
-            if ( 2 == m && isMonday && 3 == nthDayOfWeek )
-                valid = false;
-
-            // good friday
-            if ( isFriday )
-                if ( goodFriday_.contains( now ) )
-                    valid = false;
-
-            // memorial day
-            // last monday in may
-            if ( 5 == m && isMonday && 6 == now.addDays( 7 ).month() )
-                valid = false;
-
-            // juneteenth
-            if (( 6 == m && 19 == d ) ||
-                ( 6 == m && 18 == d && isFriday ) ||
-                ( 6 == m && 20 == d && isMonday ))
-            {
-                if ( 2022 <= now.year() )
-                    valid = false;
-            }
-
-            // independance day
-            if (( 7 == m && 4 == d ) ||
-                ( 7 == m && 3 == d && isFriday ) ||
-                ( 7 == m && 5 == d && isMonday ))
-                valid = false;
-
-            // labor day
-            // first monday in september
-            if ( 9 == m && isMonday && 1 == nthDayOfWeek )
-                valid = false;
-
-            // thanksgiving day
-            // fourth thursday in november
-            if ( 11 == m && 4 == now.dayOfWeek() && 4 == nthDayOfWeek )
-                valid = false;
-
-            // christmas day
-            if (( 12 == m && 25 == d ) ||
-                ( 12 == m && 24 == d && isFriday ) ||
-                ( 12 == m && 26 == d && isMonday ))
-                valid = false;
-
-            if ( valid )
-            {
-                // TODO: check market hours table for closure
-
-                // check for partial day
-                if ( now < dt.date() )
-                    days += 1.0;
-                else
-                {
-                    double hoursRemain( dt0.secsTo( dt ) );
-                    hoursRemain /= 3600.0;
-
-                    hoursRemain -= 24.0 * std::floor( hoursRemain / 24.0 );
-
-                    // TODO: early closures?
-
-                    // 6.5 hours in a trading day
-                    if ( 6.5 <= hoursRemain )
-                        days += 1.0;
-                    else
-                        days += (hoursRemain / 6.5);
-                }
-            }
-        }
-
-        // increment current day
-        now = now.addDays( 1 );
-
-    } while ( now <= dt.date() );
-
-    return days;
+    return tradingCalendar()->numTradingDaysBetween( dt0, dt );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1436,7 +1308,14 @@ bool AppDatabase::processData( const QJsonObject& obj )
         emit accountsChanged();
 
     if ( marketHoursProcessed )
+    {
+        refreshTradingCalendar();
+
         emit marketHoursChanged();
+    }
+
+    if (( treasBillRatesProcessed ) || ( treasYieldCurveRatesProcessed ))
+        refreshRiskFreeRates();
 
     if ( treasBillRatesProcessed )
         emit treasuryBillRatesChanged();
@@ -1939,6 +1818,106 @@ bool AppDatabase::parseAccountPositions( const QDateTime& stamp, const QString&
     return true;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void AppDatabase::refreshRiskFreeRates()
+{
+    const QString sql( "SELECT date, term, rate FROM riskFreeInterestRates WHERE "
+        "source='" + DB_TREAS_YIELD_CURVE + "'" );
+
+    QMap<QDate, QMap<double, double>> rates;
+
+    if ( isReady() )
+    {
+        QSqlQuery query( connection() );
+        query.setForwardOnly( true );
+        query.prepare( sql );
+
+        if ( !query.exec() )
+        {
+            const QSqlError e( query.lastError() );
+
+            LOG_ERROR << "error during select " << e.type() << " " << qPrintable( e.text() );
+        }
+        else
+        {
+            while ( query.next() )
+                rates[QDate::fromString( query.value( 0 ).toString(), Qt::ISODate )][query.value( 1 ).toDouble()] = query.value( 2 ).toDouble();
+        }
+    }
+
+    QMutexLocker guard( &ratesMutex_ );
+
+    yieldCurveRates_ = rates;
+    yieldCurve_.reset();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void AppDatabase::refreshTradingCalendar()
+{
+    static const QString sqlMarketHours( "SELECT date, marketType, product, isOpen FROM marketHours "
+        "WHERE DATE(:start)<=DATE(date)" );
+
+    static const QString sqlSessionHours( "SELECT s.date, s.marketType, s.product, s.start, s.end, t.isExtendedHours FROM sessionHours s "
+        "LEFT JOIN sessionHoursType t ON s.sessionHoursType=t.type "
+            "WHERE DATE(:start)<=DATE(s.date)" );
+
+    // only recent market hours are kept in memory, older dates are queried
+    const QDate start( currentDateTime().date().addDays( -7 ) );
+
+    QSharedPointer<TradingCalendar> calendar( new TradingCalendar( goodFriday_, start ) );
+
+    if ( isReady() )
+    {
+        QSqlQuery query( connection() );
+        query.setForwardOnly( true );
+
+        // market hours
+        query.prepare( sqlMarketHours );
+        query.bindValue( ":start", start.toString( Qt::ISODate ) );
+
+        if ( !query.exec() )
+        {
+            const QSqlError e( query.lastError() );
+
+            LOG_ERROR << "error during select " << e.type() << " " << qPrintable( e.text() );
+        }
+        else
+        {
+            while ( query.next() )
+                calendar->addMarketHours(
+                    QDate::fromString( query.value( 0 ).toString(), Qt::ISODate ),
+                    query.value( 1 ).toString(),
+                    query.value( 2 ).toString(),
+                    query.value( 3 ).toBool() );
+        }
+
+        // session hours
+        query.prepare( sqlSessionHours );
+        query.bindValue( ":start", start.toString( Qt::ISODate ) );
+
+        if ( !query.exec() )
+        {
+            const QSqlError e( query.lastError() );
+
+            LOG_ERROR << "error during select " << e.type() << " " << qPrintable( e.text() );
+        }
+        else
+        {
+            while ( query.next() )
+                calendar->addSessionHours(
+                    QDate::fromString( query.value( 0 ).toString(), Qt::ISODate ),
+                    query.value( 1 ).toString(),
+                    query.value( 2 ).toString(),
+                    QDateTime::fromString( query.value( 3 ).toString(), Qt::ISODate ),
+                    QDateTime::fromString( query.value( 4 ).toString(), Qt::ISODate ),
+                    query.value( 5 ).toBool() );
+        }
+    }
+
+    QMutexLocker guard( &calendarMutex_ );
+    calendar_ = calendar;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool AppDatabase::parseSessionHours( const QDate& date, const QString& marketType, const QString& product, const QJsonObject& obj )
 {
@@ -25,6 +25,9 @@
 
 #include "marketproducthours.h"
 #include "sqldb.h"
+#include "tradingcalendar.h"
+
+#include "../util/yieldcurve.h"
 
 #include <QColor>
 #include <QDate>
@@ -33,6 +36,7 @@
 #include <QList>
 #include <QMap>
 #include <QMutex>
+#include <QSharedPointer>
 #include <QStringList>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -275,6 +279,21 @@ public:
      */
     virtual void setWidgetState( WidgetType type, const QString& groupName, const QString& name, const QByteArray& state );
 
+    /// Retrieve treasury yield curve.
+    /**
+     * Curve holds the latest rates on or up to a week before the current date. Curve is immutable
+     * so a caller can hold on to it for consistent rates across many calculations.
+     * @return  yield curve
+     */
+    virtual QSharedPointer<const YieldCurve> yieldCurve() const;
+
+    /// Retrieve trading calendar.
+    /**
+     * Calendar is immutable and can be used from any thread without touching the database.
+     * @return  calendar
+     */
+    virtual QSharedPointer<const TradingCalendar> tradingCalendar() const;
+
     /// Retrieve treasury yield curve date range.
     /**
      * @param[out] start  start date
@@ -525,6 +544,13 @@ private:
 
     QList<QDate> goodFriday_;
 
+    mutable QMutex calendarMutex_;
+    QSharedPointer<const TradingCalendar> calendar_;
+
+    mutable QMutex ratesMutex_;
+    QMap<QDate, QMap<double, double>> yieldCurveRates_;
+    mutable QSharedPointer<const YieldCurve> yieldCurve_;
+
     /// Constructor.
     AppDatabase();
 
@@ -534,6 +560,12 @@ private:
     /// Read settings from database.
     void readSettings();
 
+    /// Reload risk free interest rates from database.
+    void refreshRiskFreeRates();
+
+    /// Rebuild trading calendar from database.
+    void refreshTradingCalendar();
+
     /// Parse account balances.
     bool parseAccountBalances( const QDateTime& stamp, const QString& accountId, const QJsonObject& obj );
 
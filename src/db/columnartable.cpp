@@ -0,0 +1,512 @@
+/**
+ * @file columnartable.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "columnartable.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QDate>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Functor class for comparing double values.
+class LessThanDouble
+{
+public:
+
+    /// Constructor.
+    LessThanDouble( const std::vector<double>& values ) : values_( values ) {}
+
+    /// Comparison functor, NaN values come first.
+    bool operator()( int a, int b ) const {
+        if ( std::isnan( values_[a] ) )
+            return !std::isnan( values_[b] );
+        else if ( std::isnan( values_[b] ) )
+            return false;
+
+        return values_[a] < values_[b];
+    }
+
+private:
+
+    const std::vector<double>& values_;
+
+};
+
+/// Functor class for comparing integer values.
+class LessThanInteger
+{
+public:
+
+    /// Constructor.
+    LessThanInteger( const std::vector<qint64>& values ) : values_( values ) {}
+
+    /// Comparison functor.
+    bool operator()( int a, int b ) const {return values_[a] < values_[b];}
+
+private:
+
+    const std::vector<qint64>& values_;
+
+};
+
+/// Functor class for comparing interned strings by rank.
+class LessThanRank
+{
+public:
+
+    /// Constructor.
+    LessThanRank( const std::vector<qint64>& ids, const std::vector<int>& rank ) : ids_( ids ), rank_( rank ) {}
+
+    /// Comparison functor.
+    bool operator()( int a, int b ) const {return rank_[ids_[a]] < rank_[ids_[b]];}
+
+private:
+
+    const std::vector<qint64>& ids_;
+    const std::vector<int>& rank_;
+
+};
+
+/// Functor class for comparing variant values.
+class LessThanVariant
+{
+public:
+
+    /// Constructor.
+    LessThanVariant( const std::vector<QVariant>& values ) : values_( values ) {}
+
+    /// Comparison functor.
+    bool operator()( int a, int b ) const {
+#if QT_VERSION_CHECK( 6, 0, 0 ) <= QT_VERSION
+        return (QPartialOrdering::Less == QVariant::compare( values_[a], values_[b] ));
+#else
+        return values_[a] < values_[b];
+#endif
+    }
+
+private:
+
+    const std::vector<QVariant>& values_;
+
+};
+
+/// Functor class for comparing interned string ids.
+class LessThanString
+{
+public:
+
+    /// Constructor.
+    LessThanString( const QVector<QString>& strings ) : strings_( strings ) {}
+
+    /// Comparison functor.
+    bool operator()( int a, int b ) const {return strings_[a] < strings_[b];}
+
+private:
+
+    const QVector<QString>& strings_;
+
+};
+
+/// Functor class for sorting rows by column value.
+template <class LessThan>
+class SortByColumnValue
+{
+public:
+
+    /// Constructor.
+    SortByColumnValue( const std::vector<bool>& valid, const LessThan& lessThan, bool ascending ) : valid_( valid ), lessThan_( lessThan ), ascending_( ascending ) {}
+
+    /// Sorting functor, rows without a value come first.
+    bool operator()( int a, int b ) const {
+        if ( !ascending_ )
+            std::swap( a, b );
+
+        if ( valid_[a] != valid_[b] )
+            return !valid_[a];
+        else if ( !valid_[a] )
+            return false;
+
+        return lessThan_( a, b );
+    }
+
+private:
+
+    const std::vector<bool>& valid_;
+    LessThan lessThan_;
+
+    bool ascending_;
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+ColumnarTable::ColumnarTable( int columns ) :
+    numRows_( 0 )
+{
+    columns_.resize( columns );
+
+    for ( Column& c : columns_ )
+    {
+        c.storage = Storage::Empty;
+        c.type = QMetaType::UnknownType;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+ColumnarTable::~ColumnarTable()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+size_t ColumnarTable::memoryUsage() const
+{
+    size_t result( 0 );
+
+    for ( const Column& c : columns_ )
+    {
+        result += c.valid.capacity() / 8;
+        result += c.doubles.capacity() * sizeof( double );
+        result += c.ints.capacity() * sizeof( qint64 );
+        result += c.variants.capacity() * sizeof( QVariant );
+    }
+
+    for ( const QString& s : strings_ )
+        result += sizeof( QString ) + s.capacity() * sizeof( QChar );
+
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ColumnarTable::setValue( int row, int col, const QVariant& value )
+{
+    if (( row < 0 ) || ( numRows_ <= row ) || ( col < 0 ) || ( columnCount() <= col ))
+        return;
+
+    Column& c( columns_[col] );
+
+    // clear value
+    if ( !value.isValid() )
+    {
+        if ( Storage::Variant == c.storage )
+            c.variants[row] = QVariant();
+
+        c.valid[row] = false;
+        return;
+    }
+
+    const int type( value.userType() );
+
+    // first value determines storage
+    if ( Storage::Empty == c.storage )
+    {
+        c.storage = storageForType( type );
+        c.type = type;
+
+        resize( c );
+    }
+
+    // type changed, fallback to variants
+    else if (( Storage::Variant != c.storage ) && ( type != c.type ))
+    {
+        convertToVariant( c );
+    }
+
+    switch ( c.storage )
+    {
+    case Storage::Double:
+        c.doubles[row] = value.toDouble();
+        break;
+    case Storage::Integer:
+        c.ints[row] = value.toLongLong();
+        break;
+    case Storage::String:
+        c.ints[row] = intern( value.toString() );
+        break;
+    case Storage::Date:
+        c.ints[row] = value.toDate().toJulianDay();
+        break;
+    case Storage::Variant:
+        c.variants[row] = value;
+        break;
+    default:
+        return;
+    }
+
+    c.valid[row] = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QVariant ColumnarTable::value( int row, int col ) const
+{
+    if (( row < 0 ) || ( numRows_ <= row ) || ( col < 0 ) || ( columnCount() <= col ))
+        return QVariant();
+
+    return value( columns_[col], row );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ColumnarTable::appendRows( int count )
+{
+    if ( count <= 0 )
+        return;
+
+    numRows_ += count;
+
+    for ( Column& c : columns_ )
+        resize( c );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ColumnarTable::appendRow( const QVector<QVariant>& values )
+{
+    const int row( numRows_ );
+
+    appendRows( 1 );
+
+    const int cols( qMin( values.size(), columnCount() ) );
+
+    for ( int col( 0 ); col < cols; ++col )
+        if ( values[col].isValid() )
+            setValue( row, col, values[col] );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ColumnarTable::clear()
+{
+    numRows_ = 0;
+
+    for ( Column& c : columns_ )
+    {
+        c.storage = Storage::Empty;
+        c.type = QMetaType::UnknownType;
+
+        std::vector<bool>().swap( c.valid );
+        std::vector<double>().swap( c.doubles );
+        std::vector<qint64>().swap( c.ints );
+        std::vector<QVariant>().swap( c.variants );
+    }
+
+    stringIds_.clear();
+    strings_.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+ColumnarTable::RowIndexList ColumnarTable::removeRows( const std::vector<bool>& doomed )
+{
+    RowIndexList result( numRows_, -1 );
+
+    int rows( 0 );
+
+    for ( int row( 0 ); row < numRows_; ++row )
+        if (( doomed.size() <= (size_t) row ) || ( !doomed[row] ))
+            result[row] = rows++;
+
+    // nothing removed
+    if ( rows == numRows_ )
+        return result;
+
+    // compact
+    for ( Column& c : columns_ )
+    {
+        for ( int row( 0 ); row < numRows_; ++row )
+        {
+            const int to( result[row] );
+
+            if (( to < 0 ) || ( to == row ))
+                continue;
+
+            c.valid[to] = c.valid[row];
+
+            if ( Storage::Double == c.storage )
+                c.doubles[to] = c.doubles[row];
+            else if ( Storage::Variant == c.storage )
+                c.variants[to] = std::move( c.variants[row] );
+            else if ( Storage::Empty != c.storage )
+                c.ints[to] = c.ints[row];
+        }
+    }
+
+    numRows_ = rows;
+
+    for ( Column& c : columns_ )
+        resize( c );
+
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ColumnarTable::sort( RowIndexList& index, int col, bool ascending ) const
+{
+    if (( col < 0 ) || ( columnCount() <= col ))
+        return;
+
+    const Column& c( columns_[col] );
+
+    switch ( c.storage )
+    {
+    case Storage::Double:
+        std::stable_sort( index.begin(), index.end(), SortByColumnValue<LessThanDouble>( c.valid, LessThanDouble( c.doubles ), ascending ) );
+        break;
+
+    case Storage::Integer:
+    case Storage::Date:
+        std::stable_sort( index.begin(), index.end(), SortByColumnValue<LessThanInteger>( c.valid, LessThanInteger( c.ints ), ascending ) );
+        break;
+
+    case Storage::String:
+        {
+            // rank interned strings once, rows then compare by rank
+            std::vector<int> ids( strings_.size() );
+
+            for ( int i( 0 ); i < strings_.size(); ++i )
+                ids[i] = i;
+
+            std::sort( ids.begin(), ids.end(), LessThanString( strings_ ) );
+
+            std::vector<int> rank( ids.size() );
+
+            for ( size_t i( 0 ); i < ids.size(); ++i )
+                rank[ids[i]] = i;
+
+            std::stable_sort( index.begin(), index.end(), SortByColumnValue<LessThanRank>( c.valid, LessThanRank( c.ints, rank ), ascending ) );
+        }
+        break;
+
+    case Storage::Variant:
+        std::stable_sort( index.begin(), index.end(), SortByColumnValue<LessThanVariant>( c.valid, LessThanVariant( c.variants ), ascending ) );
+        break;
+
+    default:
+        break;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ColumnarTable::convertToVariant( Column& c ) const
+{
+    std::vector<QVariant> variants( numRows_ );
+
+    for ( int row( 0 ); row < numRows_; ++row )
+        variants[row] = value( c, row );
+
+    c.storage = Storage::Variant;
+    c.type = QMetaType::UnknownType;
+
+    c.variants.swap( variants );
+
+    std::vector<double>().swap( c.doubles );
+    std::vector<qint64>().swap( c.ints );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int ColumnarTable::intern( const QString& s )
+{
+    QHash<QString, int>::const_iterator i( stringIds_.constFind( s ) );
+
+    if ( i != stringIds_.constEnd() )
+        return i.value();
+
+    const int id( strings_.size() );
+
+    strings_.append( s );
+    stringIds_.insert( s, id );
+
+    return id;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ColumnarTable::resize( Column& c ) const
+{
+    c.valid.resize( numRows_, false );
+
+    if ( Storage::Double == c.storage )
+        c.doubles.resize( numRows_, 0.0 );
+    else if ( Storage::Variant == c.storage )
+        c.variants.resize( numRows_ );
+    else if ( Storage::Empty != c.storage )
+        c.ints.resize( numRows_, 0 );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QVariant ColumnarTable::value( const Column& c, int row ) const
+{
+    if ( !c.valid[row] )
+        return QVariant();
+
+    switch ( c.storage )
+    {
+    case Storage::Double:
+        return QVariant( c.doubles[row] );
+
+    case Storage::Integer:
+        if ( QMetaType::Bool == c.type )
+            return QVariant( (bool) c.ints[row] );
+        else if ( QMetaType::Int == c.type )
+            return QVariant( (int) c.ints[row] );
+        else if ( QMetaType::UInt == c.type )
+            return QVariant( (uint) c.ints[row] );
+
+        return QVariant( (qlonglong) c.ints[row] );
+
+    case Storage::String:
+        return QVariant( strings_[c.ints[row]] );
+
+    case Storage::Date:
+        return QVariant( QDate::fromJulianDay( c.ints[row] ) );
+
+    case Storage::Variant:
+        return c.variants[row];
+
+    default:
+        break;
+    }
+
+    return QVariant();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+ColumnarTable::Storage ColumnarTable::storageForType( int type )
+{
+    switch ( type )
+    {
+    case QMetaType::Double:
+        return Storage::Double;
+
+    case QMetaType::Bool:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+        return Storage::Integer;
+
+    case QMetaType::QString:
+        return Storage::String;
+
+    case QMetaType::QDate:
+        return Storage::Date;
+
+    default:
+        break;
+    }
+
+    return Storage::Variant;
+}
@@ -0,0 +1,203 @@
+/**
+ * @file columnartable.h
+ * Column oriented table of typed values.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef COLUMNARTABLE_H
+#define COLUMNARTABLE_H
+
+#include <vector>
+
+#include <QHash>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Column oriented table of typed values.
+/**
+ * Each column stores its values in a single typed array chosen from the first value written to
+ * it. Numeric, boolean and date values are stored unboxed, strings are interned and stored as
+ * ids. Should a value of a different type be written to a column, the column is converted to
+ * hold variants so values always round trip unchanged.
+ */
+class ColumnarTable
+{
+    using _Myt = ColumnarTable;
+
+public:
+
+    /// Row index list.
+    using RowIndexList = QVector<int>;
+
+    // ========================================================================
+    // CTOR / DTOR
+    // ========================================================================
+
+    /// Constructor.
+    /**
+     * @param[in] columns  number of columns
+     */
+    ColumnarTable( int columns );
+
+    /// Destructor.
+    ~ColumnarTable();
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// Retrieve number of columns.
+    /**
+     * @return  number of columns
+     */
+    int columnCount() const {return columns_.size();}
+
+    /// Retrieve approximate memory usage.
+    /**
+     * @return  number of bytes
+     */
+    size_t memoryUsage() const;
+
+    /// Retrieve number of rows.
+    /**
+     * @return  number of rows
+     */
+    int rowCount() const {return numRows_;}
+
+    /// Set value.
+    /**
+     * @param[in] row  row
+     * @param[in] col  column
+     * @param[in] value  value
+     */
+    void setValue( int row, int col, const QVariant& value );
+
+    /// Retrieve value.
+    /**
+     * @param[in] row  row
+     * @param[in] col  column
+     * @return  value
+     */
+    QVariant value( int row, int col ) const;
+
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Append empty rows.
+    /**
+     * @param[in] count  number of rows
+     */
+    void appendRows( int count );
+
+    /// Append row of values.
+    /**
+     * @param[in] values  values indexed by column
+     */
+    void appendRow( const QVector<QVariant>& values );
+
+    /// Remove all rows.
+    void clear();
+
+    /// Remove rows.
+    /**
+     * Remaining rows are compacted and keep their relative order.
+     * @param[in] doomed  rows to remove, indexed by row
+     * @return  new row index indexed by old row index, or -1 for removed rows
+     */
+    RowIndexList removeRows( const std::vector<bool>& doomed );
+
+    /// Sort row index list by column.
+    /**
+     * Only @a index is reordered, table data is untouched. Sort is stable and rows without a
+     * value come first in ascending order.
+     * @param[in,out] index  row index list
+     * @param[in] col  column to sort by
+     * @param[in] ascending  @c true to sort ascending, @c false for descending
+     */
+    void sort( RowIndexList& index, int col, bool ascending ) const;
+
+private:
+
+    /// Column storage type.
+    enum class Storage
+    {
+        Empty,                                      ///< No values written.
+        Double,                                     ///< Double values.
+        Integer,                                    ///< Integer and boolean values.
+        String,                                     ///< Interned string ids.
+        Date,                                       ///< Julian day values.
+        Variant,                                    ///< Anything else.
+    };
+
+    /// Column data.
+    struct Column
+    {
+        Storage storage;                            ///< Storage type.
+        int type;                                   ///< Value type (meta type id).
+
+        std::vector<bool> valid;                    ///< Value is set.
+
+        std::vector<double> doubles;                ///< Double values.
+        std::vector<qint64> ints;                   ///< Integer, string id or julian day values.
+        std::vector<QVariant> variants;             ///< Variant values.
+    };
+
+    QVector<Column> columns_;                       ///< Columns.
+    int numRows_;                                   ///< Number of rows.
+
+    QHash<QString, int> stringIds_;                 ///< Interned string ids.
+    QVector<QString> strings_;                      ///< Interned strings by id.
+
+    /// Convert column into variant storage.
+    void convertToVariant( Column& c ) const;
+
+    /// Intern string.
+    int intern( const QString& s );
+
+    /// Resize column storage to number of rows.
+    void resize( Column& c ) const;
+
+    /// Retrieve value of column.
+    QVariant value( const Column& c, int row ) const;
+
+    /// Determine storage for value type.
+    static Storage storageForType( int type );
+
+    // not implemented
+    ColumnarTable( const _Myt& ) = delete;
+
+    // not implemented
+    ColumnarTable( const _Myt&& ) = delete;
+
+    // not implemented
+    _Myt &operator = ( const _Myt& ) = delete;
+
+    // not implemented
+    _Myt &operator = ( const _Myt&& ) = delete;
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // COLUMNARTABLE_H
@@ -32,9 +32,16 @@ FundamentalsTableModel::FundamentalsTableModel( const QString& symbol, const QDa
     QString filter;
 
     if ( stamp.isValid() )
-        filter += "DATETIME('" + stamp.toString( Qt::ISODateWithMs ) + "')=DATETIME(stamp)";
+    {
+        // match stamp to the second
+        const QDateTime start( stamp.addMSecs( -stamp.time().msec() ) );
+
+        filter += "'" + start.toString( Qt::ISODate ) + "'<=stamp AND stamp<'" + start.addSecs( 1 ).toString( Qt::ISODate ) + "'";
+    }
     else
+    {
         filter += "stamp=(SELECT MAX(stamp) FROM fundamentals)";
+    }
 
     filter += " AND '" + symbol + "'=symbol";
 
@@ -300,38 +300,8 @@ int ItemModel::removeRowsIf( int column, const QVariant& value, RemovalRule rule
 
     // make list of rows to remove
     for ( int row( rows_.count() ); row--; )
-    {
-        const QVariant v( dataImpl( row, column, Qt::UserRole ) );
-
-        bool addToList( false );
-
-#if QT_VERSION_CHECK( 6, 0, 0 ) <= QT_VERSION
-        const QPartialOrdering result( QVariant::compare( v, value ) );
-
-        if ( QPartialOrdering::Equivalent == result )
-            addToList = (( RemovalRule::LessThanEqual == rule ) || ( RemovalRule::Equal == rule ) || ( RemovalRule::GreaterThanEqual == rule ));
-        else if ( QPartialOrdering::Less == result )
-            addToList = (( RemovalRule::LessThan == rule ) || ( RemovalRule::NotEqual == rule ));
-        else if ( QPartialOrdering::Greater == result )
-            addToList = (( RemovalRule::GreaterThan == rule ) || ( RemovalRule::NotEqual == rule ));
-#else
-        if ( RemovalRule::LessThan == rule )
-            addToList = (v < value);
-        else if ( RemovalRule::LessThanEqual == rule )
-            addToList = (v <= value);
-        else if ( RemovalRule::Equal == rule )
-            addToList = (v == value);
-        else if ( RemovalRule::GreaterThanEqual == rule )
-            addToList = (value <= v);
-        else if ( RemovalRule::GreaterThan == rule )
-            addToList = (value < v);
-        else if ( RemovalRule::NotEqual == rule )
-            addToList = (v != value);
-#endif
-
-        if ( addToList )
+        if ( matchesRemovalRule( dataImpl( row, column, Qt::UserRole ), value, rule ) )
             doomed.append( row );
-    }
 
     // remove some rows
     LOG_DEBUG << "removing " << doomed.size() << " rows...";
@@ -514,3 +484,33 @@ QString ItemModel::formatValue( const QVariant& v, int numDecimalPlaces )
 
     return QString::number( doubleValue );
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool ItemModel::matchesRemovalRule( const QVariant& v, const QVariant& value, RemovalRule rule )
+{
+#if QT_VERSION_CHECK( 6, 0, 0 ) <= QT_VERSION
+    const QPartialOrdering result( QVariant::compare( v, value ) );
+
+    if ( QPartialOrdering::Equivalent == result )
+        return (( RemovalRule::LessThanEqual == rule ) || ( RemovalRule::Equal == rule ) || ( RemovalRule::GreaterThanEqual == rule ));
+    else if ( QPartialOrdering::Less == result )
+        return (( RemovalRule::LessThan == rule ) || ( RemovalRule::NotEqual == rule ));
+    else if ( QPartialOrdering::Greater == result )
+        return (( RemovalRule::GreaterThan == rule ) || ( RemovalRule::NotEqual == rule ));
+#else
+    if ( RemovalRule::LessThan == rule )
+        return (v < value);
+    else if ( RemovalRule::LessThanEqual == rule )
+        return (v <= value);
+    else if ( RemovalRule::Equal == rule )
+        return (v == value);
+    else if ( RemovalRule::GreaterThanEqual == rule )
+        return (value <= v);
+    else if ( RemovalRule::GreaterThan == rule )
+        return (value < v);
+    else if ( RemovalRule::NotEqual == rule )
+        return (v != value);
+#endif
+
+    return false;
+}
@@ -384,6 +384,15 @@ protected:
      */
     static QString formatValue( const QVariant& value, int numDecimalPlaces = 0 );
 
+    /// Check if value matches removal rule.
+    /**
+     * @param[in] v  value to check
+     * @param[in] value  value to check against
+     * @param[in] rule  rule to follow
+     * @return  @c true if @a v should be removed, @c false otherwise
+     */
+    static bool matchesRemovalRule( const QVariant& v, const QVariant& value, RemovalRule rule );
+
 private:
 
     static QMutex poolItemMutex_;
@@ -0,0 +1,145 @@
+/**
+ * @file multirowinsert.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "common.h"
+#include "multirowinsert.h"
+
+#include <QSqlError>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+MultiRowInsert::MultiRowInsert( const QSqlDatabase& conn, const QString& head, int columns, int batchRows, const QString& tail ) :
+    conn_( conn ),
+    head_( head ),
+    tail_( tail ),
+    columns_( columns ),
+    batchRows_( qMax( 1, batchRows ) ),
+    batch_( conn ),
+    batchPrepared_( false ),
+    pending_( 0 ),
+    numRows_( 0 )
+{
+    values_.resize( columns_ * batchRows_ );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool MultiRowInsert::addRow( const RowValues& values )
+{
+    Q_ASSERT( columns_ == values.size() );
+
+    QVariant *dest( values_.data() + pending_ * columns_ );
+
+    for ( int i( 0 ); i < columns_; ++i )
+        dest[i] = values[i];
+
+    if ( ++pending_ < batchRows_ )
+        return true;
+
+    // prepare full batch statement once
+    if ( !batchPrepared_ )
+    {
+        if ( !batch_.prepare( sql( head_, columns_, batchRows_, tail_ ) ) )
+        {
+            const QSqlError e( batch_.lastError() );
+
+            LOG_ERROR << "error during prepare " << e.type() << " " << qPrintable( e.text() );
+            return false;
+        }
+
+        batchPrepared_ = true;
+    }
+
+    return exec( batch_, pending_ );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool MultiRowInsert::flush()
+{
+    if ( !pending_ )
+        return true;
+
+    // remaining rows
+    QSqlQuery query( conn_ );
+
+    if ( !query.prepare( sql( head_, columns_, pending_, tail_ ) ) )
+    {
+        const QSqlError e( query.lastError() );
+
+        LOG_ERROR << "error during prepare " << e.type() << " " << qPrintable( e.text() );
+        return false;
+    }
+
+    return exec( query, pending_ );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QString MultiRowInsert::sql( const QString& head, int columns, int rows, const QString& tail )
+{
+    // (?,?,...,?)
+    QString row( "(" );
+
+    for ( int i( 0 ); i < columns; ++i )
+        row.append( i ? ",?" : "?" );
+
+    row.append( ")" );
+
+    // head VALUES (...),(...) tail
+    QString result( head );
+    result.reserve( head.length() + tail.length() + rows * (row.length() + 1) + 16 );
+    result.append( " VALUES " );
+
+    for ( int r( 0 ); r < rows; ++r )
+    {
+        if ( r )
+            result.append( ',' );
+
+        result.append( row );
+    }
+
+    if ( tail.length() )
+        result.append( ' ' ).append( tail );
+
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool MultiRowInsert::exec( QSqlQuery& query, int rows )
+{
+    const int n( rows * columns_ );
+
+    for ( int i( 0 ); i < n; ++i )
+        query.bindValue( i, values_[i] );
+
+    pending_ = 0;
+
+    // exec sql
+    if ( !query.exec() )
+    {
+        const QSqlError e( query.lastError() );
+
+        LOG_ERROR << "error during insert " << e.type() << " " << qPrintable( e.text() );
+        return false;
+    }
+
+    numRows_ += rows;
+
+    return true;
+}
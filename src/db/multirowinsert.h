@@ -0,0 +1,155 @@
+/**
+ * @file multirowinsert.h
+ * Multi-row insert statement.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MULTIROWINSERT_H
+#define MULTIROWINSERT_H
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Multi-row insert statement.
+/**
+ * Rows are buffered and written with a single prepared statement containing many rows of
+ * positional placeholders. Values are bound by column index, so no placeholder names are built
+ * or looked up per value.
+ */
+class MultiRowInsert
+{
+    using _Myt = MultiRowInsert;
+
+public:
+
+    /// Row values.
+    using RowValues = QVector<QVariant>;
+
+    // ========================================================================
+    // CTOR / DTOR
+    // ========================================================================
+
+    /// Constructor.
+    /**
+     * Statement is formed as @a head followed by rows of placeholders and then @a tail. For
+     * example a head of "INSERT INTO t (a,b)" with two columns and two rows becomes
+     * "INSERT INTO t (a,b) VALUES (?,?),(?,?)".
+     * @param[in] conn  database connection
+     * @param[in] head  statement text before values
+     * @param[in] columns  number of columns per row
+     * @param[in] batchRows  maximum number of rows per statement
+     * @param[in] tail  statement text after values
+     */
+    MultiRowInsert( const QSqlDatabase& conn, const QString& head, int columns, int batchRows, const QString& tail = QString() );
+
+    /// Destructor.
+    ~MultiRowInsert() {}
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// Retrieve number of columns.
+    /**
+     * @return  columns per row
+     */
+    int columns() const {return columns_;}
+
+    /// Retrieve number of rows written.
+    /**
+     * @return  rows
+     */
+    int numRows() const {return numRows_;}
+
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Add row.
+    /**
+     * Statement is executed once enough rows are buffered.
+     * @param[in] values  row values, one per column
+     * @return  @c true upon success, @c false otherwise
+     */
+    bool addRow( const RowValues& values );
+
+    /// Write buffered rows.
+    /**
+     * @return  @c true upon success, @c false otherwise
+     */
+    bool flush();
+
+    // ========================================================================
+    // Static Methods
+    // ========================================================================
+
+    /// Generate statement.
+    /**
+     * @param[in] head  statement text before values
+     * @param[in] columns  number of columns per row
+     * @param[in] rows  number of rows
+     * @param[in] tail  statement text after values
+     * @return  statement
+     */
+    static QString sql( const QString& head, int columns, int rows, const QString& tail = QString() );
+
+private:
+
+    QSqlDatabase conn_;                             ///< Database connection.
+
+    QString head_;                                  ///< Statement text before values.
+    QString tail_;                                  ///< Statement text after values.
+
+    int columns_;                                   ///< Number of columns per row.
+    int batchRows_;                                 ///< Maximum number of rows per statement.
+
+    QSqlQuery batch_;                               ///< Prepared statement for full batch.
+    bool batchPrepared_;                            ///< Full batch statement has been prepared.
+
+    RowValues values_;                              ///< Buffered values.
+    int pending_;                                   ///< Number of buffered rows.
+
+    int numRows_;                                   ///< Number of rows written.
+
+    /// Execute statement.
+    bool exec( QSqlQuery& query, int rows );
+
+    // not implemented
+    MultiRowInsert( const _Myt& ) = delete;
+
+    // not implemented
+    MultiRowInsert( const _Myt&& ) = delete;
+
+    // not implemented
+    _Myt& operator = ( const _Myt& ) = delete;
+
+    // not implemented
+    _Myt& operator = ( const _Myt&& ) = delete;
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // MULTIROWINSERT_H
@@ -0,0 +1,101 @@
+/**
+ * @file optionchainsnapshot.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "optionchainsnapshot.h"
+#include "optionchaintablemodel.h"
+
+/// Convert stored epoch value (ms since epoch).
+static qint64 epoch( const QVariant& value )
+{
+    bool okay( false );
+
+    const qint64 result( value.isNull() ? 0 : value.toLongLong( &okay ) );
+
+    return okay ? result : OptionChainSnapshot::INVALID_TIME;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+OptionChainSnapshot::OptionChainSnapshot( const OptionChainTableModel *chains )
+{
+    const int rows( chains->rowCount() );
+
+    strike_.reserve( rows );
+
+    for ( int row( 0 ); row < rows; ++row )
+        strike_.push_back( chains->tableData( row, OptionChainTableModel::STRIKE_PRICE ).toDouble() );
+
+    copySide( chains, true, calls_ );
+    copySide( chains, false, puts_ );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void OptionChainSnapshot::copySide( const OptionChainTableModel *chains, bool isCall, Side& s )
+{
+    using table_model_type = OptionChainTableModel;
+
+    const int rows( chains->rowCount() );
+
+    s.bid.resize( rows );
+    s.ask.resize( rows );
+    s.mark.resize( rows );
+    s.bidSize.resize( rows );
+    s.askSize.resize( rows );
+    s.volatility.resize( rows );
+    s.delta.resize( rows );
+    s.gamma.resize( rows );
+    s.theta.resize( rows );
+    s.vega.resize( rows );
+    s.rho.resize( rows );
+    s.quoteTime.resize( rows );
+    s.expiryTime.resize( rows );
+    s.flags.resize( rows );
+
+    for ( int row( 0 ); row < rows; ++row )
+    {
+        s.bid[row] = chains->tableData( row, isCall ? table_model_type::CALL_BID_PRICE : table_model_type::PUT_BID_PRICE ).toDouble();
+        s.ask[row] = chains->tableData( row, isCall ? table_model_type::CALL_ASK_PRICE : table_model_type::PUT_ASK_PRICE ).toDouble();
+        s.mark[row] = chains->tableData( row, isCall ? table_model_type::CALL_MARK : table_model_type::PUT_MARK ).toDouble();
+
+        s.bidSize[row] = chains->tableData( row, isCall ? table_model_type::CALL_BID_SIZE : table_model_type::PUT_BID_SIZE ).toInt();
+        s.askSize[row] = chains->tableData( row, isCall ? table_model_type::CALL_ASK_SIZE : table_model_type::PUT_ASK_SIZE ).toInt();
+
+        s.volatility[row] = chains->tableData( row, isCall ? table_model_type::CALL_VOLATILITY : table_model_type::PUT_VOLATILITY ).toDouble();
+        s.delta[row] = chains->tableData( row, isCall ? table_model_type::CALL_DELTA : table_model_type::PUT_DELTA ).toDouble();
+        s.gamma[row] = chains->tableData( row, isCall ? table_model_type::CALL_GAMMA : table_model_type::PUT_GAMMA ).toDouble();
+        s.theta[row] = chains->tableData( row, isCall ? table_model_type::CALL_THETA : table_model_type::PUT_THETA ).toDouble();
+        s.vega[row] = chains->tableData( row, isCall ? table_model_type::CALL_VEGA : table_model_type::PUT_VEGA ).toDouble();
+        s.rho[row] = chains->tableData( row, isCall ? table_model_type::CALL_RHO : table_model_type::PUT_RHO ).toDouble();
+
+        // epoch columns are stored as milliseconds, read them as is
+        s.quoteTime[row] = epoch( chains->rawData( row, isCall ? table_model_type::CALL_QUOTE_TIME : table_model_type::PUT_QUOTE_TIME ) );
+        s.expiryTime[row] = epoch( chains->rawData( row, isCall ? table_model_type::CALL_EXPIRY_DATE : table_model_type::PUT_EXPIRY_DATE ) );
+
+        quint8 flags( 0 );
+
+        if ( chains->tableData( row, isCall ? table_model_type::CALL_IS_IN_THE_MONEY : table_model_type::PUT_IS_IN_THE_MONEY ).toBool() )
+            flags |= IN_THE_MONEY;
+        if ( chains->tableData( row, isCall ? table_model_type::CALL_IS_NON_STANDARD : table_model_type::PUT_IS_NON_STANDARD ).toBool() )
+            flags |= NON_STANDARD;
+
+        s.flags[row] = flags;
+    }
+}
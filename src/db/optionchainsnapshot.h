@@ -0,0 +1,163 @@
+/**
+ * @file optionchainsnapshot.h
+ * Typed snapshot of option chain table data.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OPTIONCHAINSNAPSHOT_H
+#define OPTIONCHAINSNAPSHOT_H
+
+#include <QtGlobal>
+
+#include <limits>
+#include <vector>
+
+class OptionChainTableModel;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Typed snapshot of option chain table data.
+/**
+ * Fields the calculators and filters read per strike are copied out of the table model once, into
+ * contiguous arrays indexed by table row. Snapshot is immutable after construction and can be
+ * shared read-only between threads.
+ */
+class OptionChainSnapshot
+{
+    using _Myt = OptionChainSnapshot;
+
+public:
+
+    /// Option flags.
+    enum Flag
+    {
+        IN_THE_MONEY = 0x01,                        ///< Option is in the money.
+        NON_STANDARD = 0x02,                        ///< Option is non-standard.
+    };
+
+    /// Per side (call or put) values.
+    struct Side
+    {
+        std::vector<double> bid;                    ///< Bid price.
+        std::vector<double> ask;                    ///< Ask price.
+        std::vector<double> mark;                   ///< Mark price.
+
+        std::vector<int> bidSize;                   ///< Bid size.
+        std::vector<int> askSize;                   ///< Ask size.
+
+        std::vector<double> volatility;             ///< Volatility.
+        std::vector<double> delta;                  ///< Delta.
+        std::vector<double> gamma;                  ///< Gamma.
+        std::vector<double> theta;                  ///< Theta.
+        std::vector<double> vega;                   ///< Vega.
+        std::vector<double> rho;                    ///< Rho.
+
+        std::vector<qint64> quoteTime;              ///< Quote time (ms since epoch), or INVALID_TIME.
+        std::vector<qint64> expiryTime;             ///< Expiration time (ms since epoch), or INVALID_TIME.
+
+        std::vector<quint8> flags;                  ///< Option flags.
+    };
+
+    /// Invalid time value.
+    static constexpr qint64 INVALID_TIME = std::numeric_limits<qint64>::min();
+
+    // ========================================================================
+    // CTOR / DTOR
+    // ========================================================================
+
+    /// Constructor.
+    /**
+     * @param[in] chains  option chain to copy
+     */
+    OptionChainSnapshot( const OptionChainTableModel *chains );
+
+    /// Destructor.
+    ~OptionChainSnapshot() {}
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// Retrieve call values.
+    /**
+     * @return  call values
+     */
+    const Side& calls() const {return calls_;}
+
+    /// Check if either side of row is non-standard.
+    /**
+     * @param[in] row  row
+     * @return  @c true if non-standard, @c false otherwise
+     */
+    bool isNonStandard( int row ) const {return ((calls_.flags[row] | puts_.flags[row]) & NON_STANDARD);}
+
+    /// Retrieve put values.
+    /**
+     * @return  put values
+     */
+    const Side& puts() const {return puts_;}
+
+    /// Retrieve number of rows.
+    /**
+     * @return  number of rows
+     */
+    int rowCount() const {return (int) strike_.size();}
+
+    /// Retrieve call or put values.
+    /**
+     * @param[in] isCall  @c true for calls, @c false for puts
+     * @return  values
+     */
+    const Side& side( bool isCall ) const {return isCall ? calls_ : puts_;}
+
+    /// Retrieve strike price.
+    /**
+     * @param[in] row  row
+     * @return  strike price
+     */
+    double strike( int row ) const {return strike_[row];}
+
+private:
+
+    std::vector<double> strike_;                    ///< Strike price.
+
+    Side calls_;                                    ///< Call values.
+    Side puts_;                                     ///< Put values.
+
+    /// Copy one side of chain.
+    void copySide( const OptionChainTableModel *chains, bool isCall, Side& s );
+
+    // not implemented
+    OptionChainSnapshot( const _Myt& ) = delete;
+
+    // not implemented
+    OptionChainSnapshot( const _Myt&& ) = delete;
+
+    // not implemented
+    _Myt &operator = ( const _Myt& ) = delete;
+
+    // not implemented
+    _Myt &operator = ( const _Myt&& ) = delete;
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // OPTIONCHAINSNAPSHOT_H
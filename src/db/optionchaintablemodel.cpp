@@ -36,12 +36,19 @@ OptionChainTableModel::OptionChainTableModel( const QString& symbol, const QDate
     QString filter;
 
     if ( stamp.isValid() )
-        filter += "DATETIME('" + stamp.toString( Qt::ISODateWithMs ) + "')=DATETIME(stamp)";
+    {
+        // match stamp to the second
+        const qint64 start( 1000 * stamp.toSecsSinceEpoch() );
+
+        filter += QString( "%1<=stamp AND stamp<%2" ).arg( start ).arg( start + 1000 );
+    }
     else
-        filter += "stamp=(SELECT MAX(stamp) FROM optionChainView)";
+    {
+        filter += QString( "stamp=(SELECT stamp FROM optionChainLatest WHERE '%1'=underlying AND expirationDate=%2)" ).arg( symbol ).arg( expiryDate.toJulianDay() );
+    }
 
     filter += " AND '" + symbol + "'=underlying";
-    filter += " AND DATE('" + expiryDate.toString( Qt::ISODate ) + "')=DATE(expirationDate)";
+    filter += " AND expirationDate=" + QString::number( expiryDate.toJulianDay() );
 
     // setup view
     setTable( "optionChainView" );
@@ -71,6 +78,16 @@ OptionChainTableModel::OptionChainTableModel( const QString& symbol, const QDate
     columnIsText_[CALL_SETTLEMENT_TYPE] = columnIsText_[PUT_SETTLEMENT_TYPE] = true;
     columnIsText_[CALL_DELIVERABLE_NOTE] = columnIsText_[PUT_DELIVERABLE_NOTE] = true;
 
+    // time columns
+    columnIsEpoch_[STAMP] = true;
+    columnIsJulianDay_[EXPIRY_DATE] = true;
+
+    columnIsEpoch_[CALL_QUOTE_TIME] = columnIsEpoch_[PUT_QUOTE_TIME] = true;
+    columnIsEpoch_[CALL_TRADE_TIME] = columnIsEpoch_[PUT_TRADE_TIME] = true;
+
+    columnIsEpoch_[CALL_EXPIRY_DATE] = columnIsEpoch_[PUT_EXPIRY_DATE] = true;
+    columnIsEpoch_[CALL_LAST_TRADING_DAY] = columnIsEpoch_[PUT_LAST_TRADING_DAY] = true;
+
     // number of decimal places
     numDecimalPlaces_[STRIKE_PRICE] = 2;
 
@@ -417,6 +434,29 @@ OptionChainTableModel::ColumnIndex OptionChainTableModel::mappedColumn( ColumnIn
     return col;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QSharedPointer<const OptionChainSnapshot> OptionChainTableModel::snapshot() const
+{
+    if ( snapshot_ )
+        return snapshot_;
+
+    return QSharedPointer<const OptionChainSnapshot>( new OptionChainSnapshot( this ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool OptionChainTableModel::refreshData()
+{
+    snapshot_.reset();
+
+    if ( !_Mybase::refreshData() )
+        return false;
+
+    // copy out typed values once for calculators
+    snapshot_.reset( new OptionChainSnapshot( this ) );
+
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 Qt::ItemFlags OptionChainTableModel::flags( const QModelIndex& index ) const
 {
@@ -23,9 +23,11 @@
 #ifndef OPTIONCHAINTABLEMODEL_H
 #define OPTIONCHAINTABLEMODEL_H
 
+#include "optionchainsnapshot.h"
 #include "sqltablemodel.h"
 
 #include <QColor>
+#include <QSharedPointer>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -244,6 +246,14 @@ public:
      */
     virtual QString symbol() const {return symbol_;}
 
+    /// Retrieve typed snapshot of table data.
+    /**
+     * Snapshot is built by refreshData(). When the model has not been refreshed a snapshot of the
+     * current rows is built and returned instead.
+     * @return  snapshot
+     */
+    virtual QSharedPointer<const OptionChainSnapshot> snapshot() const;
+
     /// Retrieve table data.
     /**
      * @param[in] row  row
@@ -253,6 +263,18 @@ public:
      */
     virtual QVariant tableData( int row, ColumnIndex col, int role = Qt::DisplayRole ) const {return _Mybase::data( row, col, role );}
 
+public slots:
+
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Refresh data.
+    /**
+     * @return  @c true upon success, @c false otherwise
+     */
+    virtual bool refreshData() override;
+
 protected:
 
     QString symbol_;                                ///< Underlying symbol.
@@ -262,6 +284,8 @@ private:
 
     QMap<int, int> bidAskSize_;
 
+    QSharedPointer<const OptionChainSnapshot> snapshot_;
+
     QColor inTheMoneyColor_;
     QColor strikeColor_;
 
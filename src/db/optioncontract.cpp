@@ -0,0 +1,239 @@
+/**
+ * @file optioncontract.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "optioncontract.h"
+#include "stringsdb.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QVariant OptionContract::value( Field f ) const
+{
+    if ( !has( f ) )
+        return QVariant();
+
+    switch ( f )
+    {
+    case SYMBOL:
+        return symbol;
+    case TYPE:
+        return type;
+    case STRIKE_PRICE:
+        return strikePrice;
+    case DESCRIPTION:
+        return description;
+    case BID_PRICE:
+        return bidPrice;
+    case BID_SIZE:
+        return bidSize;
+    case ASK_PRICE:
+        return askPrice;
+    case ASK_SIZE:
+        return askSize;
+    case LAST_PRICE:
+        return lastPrice;
+    case LAST_SIZE:
+        return lastSize;
+    case INTRINSIC_VALUE:
+        return intrinsicValue;
+    case OPEN_PRICE:
+        return openPrice;
+    case HIGH_PRICE:
+        return highPrice;
+    case LOW_PRICE:
+        return lowPrice;
+    case CLOSE_PRICE:
+        return closePrice;
+    case CHANGE:
+        return change;
+    case PERCENT_CHANGE:
+        return percentChange;
+    case TOTAL_VOLUME:
+        return totalVolume;
+    case QUOTE_TIME:
+        return quoteTime;
+    case TRADE_TIME:
+        return tradeTime;
+    case MARK:
+        return mark;
+    case MARK_CHANGE:
+        return markChange;
+    case MARK_PERCENT_CHANGE:
+        return markPercentChange;
+    case EXCHANGE_NAME:
+        return exchangeName;
+    case VOLATILITY:
+        return volatility;
+    case DELTA:
+        return delta;
+    case GAMMA:
+        return gamma;
+    case THETA:
+        return theta;
+    case VEGA:
+        return vega;
+    case RHO:
+        return rho;
+    case TIME_VALUE:
+        return timeValue;
+    case OPEN_INTEREST:
+        return openInterest;
+    case IS_IN_THE_MONEY:
+        return isInTheMoney;
+    case THEO_OPTION_VALUE:
+        return theoOptionValue;
+    case THEO_VOLATILITY:
+        return theoVolatility;
+    case IS_MINI:
+        return isMini;
+    case IS_NON_STANDARD:
+        return isNonStandard;
+    case IS_INDEX:
+        return isIndex;
+    case IS_WEEKLY:
+        return isWeekly;
+    case IS_QUARTERLY:
+        return isQuarterly;
+    case EXPIRY_DATE:
+        return expiryDate;
+    case EXPIRY_TYPE:
+        return expiryType;
+    case DAYS_TO_EXPIRY:
+        return daysToExpiry;
+    case LAST_TRADING_DAY:
+        return lastTradingDay;
+    case MULTIPLIER:
+        return multiplier;
+    case SETTLEMENT_TYPE:
+        return settlementType;
+    case DELIVERABLE_NOTE:
+        return deliverableNote;
+    default:
+        break;
+    }
+
+    return QVariant();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QString OptionContract::columnName( Field f )
+{
+    switch ( f )
+    {
+    case SYMBOL:
+        return DB_SYMBOL;
+    case TYPE:
+        return DB_TYPE;
+    case STRIKE_PRICE:
+        return DB_STRIKE_PRICE;
+    case DESCRIPTION:
+        return DB_DESC;
+    case BID_PRICE:
+        return DB_BID_PRICE;
+    case BID_SIZE:
+        return DB_BID_SIZE;
+    case ASK_PRICE:
+        return DB_ASK_PRICE;
+    case ASK_SIZE:
+        return DB_ASK_SIZE;
+    case LAST_PRICE:
+        return DB_LAST_PRICE;
+    case LAST_SIZE:
+        return DB_LAST_SIZE;
+    case INTRINSIC_VALUE:
+        return DB_INTRINSIC_VALUE;
+    case OPEN_PRICE:
+        return DB_OPEN_PRICE;
+    case HIGH_PRICE:
+        return DB_HIGH_PRICE;
+    case LOW_PRICE:
+        return DB_LOW_PRICE;
+    case CLOSE_PRICE:
+        return DB_CLOSE_PRICE;
+    case CHANGE:
+        return DB_CHANGE;
+    case PERCENT_CHANGE:
+        return DB_PERCENT_CHANGE;
+    case TOTAL_VOLUME:
+        return DB_TOTAL_VOLUME;
+    case QUOTE_TIME:
+        return DB_QUOTE_TIME;
+    case TRADE_TIME:
+        return DB_TRADE_TIME;
+    case MARK:
+        return DB_MARK;
+    case MARK_CHANGE:
+        return DB_MARK_CHANGE;
+    case MARK_PERCENT_CHANGE:
+        return DB_MARK_PERCENT_CHANGE;
+    case EXCHANGE_NAME:
+        return DB_EXCHANGE_NAME;
+    case VOLATILITY:
+        return DB_VOLATILITY;
+    case DELTA:
+        return DB_DELTA;
+    case GAMMA:
+        return DB_GAMMA;
+    case THETA:
+        return DB_THETA;
+    case VEGA:
+        return DB_VEGA;
+    case RHO:
+        return DB_RHO;
+    case TIME_VALUE:
+        return DB_TIME_VALUE;
+    case OPEN_INTEREST:
+        return DB_OPEN_INTEREST;
+    case IS_IN_THE_MONEY:
+        return DB_IS_IN_THE_MONEY;
+    case THEO_OPTION_VALUE:
+        return DB_THEO_OPTION_VALUE;
+    case THEO_VOLATILITY:
+        return DB_THEO_VOLATILITY;
+    case IS_MINI:
+        return DB_IS_MINI;
+    case IS_NON_STANDARD:
+        return DB_IS_NON_STANDARD;
+    case IS_INDEX:
+        return DB_IS_INDEX;
+    case IS_WEEKLY:
+        return DB_IS_WEEKLY;
+    case IS_QUARTERLY:
+        return DB_IS_QUARTERLY;
+    case EXPIRY_DATE:
+        return DB_EXPIRY_DATE;
+    case EXPIRY_TYPE:
+        return DB_EXPIRY_TYPE;
+    case DAYS_TO_EXPIRY:
+        return DB_DAYS_TO_EXPIRY;
+    case LAST_TRADING_DAY:
+        return DB_LAST_TRADING_DAY;
+    case MULTIPLIER:
+        return DB_MULTIPLIER;
+    case SETTLEMENT_TYPE:
+        return DB_SETTLEMENT_TYPE;
+    case DELIVERABLE_NOTE:
+        return DB_DELIVERABLE_NOTE;
+    default:
+        break;
+    }
+
+    return QString();
+}
@@ -0,0 +1,222 @@
+/**
+ * @file optioncontract.h
+ * Option contract record.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OPTIONCONTRACT_H
+#define OPTIONCONTRACT_H
+
+#include <QString>
+#include <QVariant>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Option contract record.
+/**
+ * Typed values of one option contract as delivered by a market data source, in the order of the
+ * options table. Fields the source did not supply (or supplied as garbage) are flagged as missing
+ * and stored as null. Times are kept as milliseconds since epoch.
+ */
+struct OptionContract
+{
+    /// Fields.
+    enum Field
+    {
+        SYMBOL,
+        TYPE,
+        STRIKE_PRICE,
+        DESCRIPTION,
+        BID_PRICE,
+        BID_SIZE,
+        ASK_PRICE,
+        ASK_SIZE,
+        LAST_PRICE,
+        LAST_SIZE,
+        INTRINSIC_VALUE,
+        OPEN_PRICE,
+        HIGH_PRICE,
+        LOW_PRICE,
+        CLOSE_PRICE,
+        CHANGE,
+        PERCENT_CHANGE,
+        TOTAL_VOLUME,
+        QUOTE_TIME,
+        TRADE_TIME,
+        MARK,
+        MARK_CHANGE,
+        MARK_PERCENT_CHANGE,
+        EXCHANGE_NAME,
+        VOLATILITY,
+        DELTA,
+        GAMMA,
+        THETA,
+        VEGA,
+        RHO,
+        TIME_VALUE,
+        OPEN_INTEREST,
+        IS_IN_THE_MONEY,
+        THEO_OPTION_VALUE,
+        THEO_VOLATILITY,
+        IS_MINI,
+        IS_NON_STANDARD,
+        IS_INDEX,
+        IS_WEEKLY,
+        IS_QUARTERLY,
+        EXPIRY_DATE,
+        EXPIRY_TYPE,
+        DAYS_TO_EXPIRY,
+        LAST_TRADING_DAY,
+        MULTIPLIER,
+        SETTLEMENT_TYPE,
+        DELIVERABLE_NOTE,
+        NUM_FIELDS
+    };
+
+    QString symbol;                                 ///< Option symbol.
+    QString type;                                   ///< Option type (CALL or PUT).
+    double strikePrice;                             ///< Strike price.
+    QString description;                            ///< Description.
+    double bidPrice;                                ///< Bid price.
+    int bidSize;                                    ///< Bid size.
+    double askPrice;                                ///< Ask price.
+    int askSize;                                    ///< Ask size.
+    double lastPrice;                               ///< Last price.
+    int lastSize;                                   ///< Last size.
+    double intrinsicValue;                          ///< Intrinsic value.
+    double openPrice;                               ///< Open price.
+    double highPrice;                               ///< High price.
+    double lowPrice;                                ///< Low price.
+    double closePrice;                              ///< Close price.
+    double change;                                  ///< Net change.
+    double percentChange;                           ///< Percent change.
+    qint64 totalVolume;                             ///< Total volume.
+    qint64 quoteTime;                               ///< Quote time (ms since epoch).
+    qint64 tradeTime;                               ///< Trade time (ms since epoch).
+    double mark;                                    ///< Mark price.
+    double markChange;                              ///< Mark change.
+    double markPercentChange;                       ///< Mark percent change.
+    QString exchangeName;                           ///< Exchange name.
+    double volatility;                              ///< Implied volatility.
+    double delta;                                   ///< Delta.
+    double gamma;                                   ///< Gamma.
+    double theta;                                   ///< Theta.
+    double vega;                                    ///< Vega.
+    double rho;                                     ///< Rho.
+    double timeValue;                               ///< Time value.
+    qint64 openInterest;                            ///< Open interest.
+    bool isInTheMoney;                              ///< In the money.
+    double theoOptionValue;                         ///< Theoretical option value.
+    double theoVolatility;                          ///< Theoretical volatility.
+    bool isMini;                                    ///< Mini option.
+    bool isNonStandard;                             ///< Non-standard option.
+    bool isIndex;                                   ///< Index option.
+    bool isWeekly;                                  ///< Weekly option.
+    bool isQuarterly;                               ///< Quarterly option.
+    qint64 expiryDate;                              ///< Expiration date (ms since epoch).
+    QString expiryType;                             ///< Expiration type.
+    int daysToExpiry;                               ///< Days to expiration.
+    qint64 lastTradingDay;                          ///< Last trading day (ms since epoch).
+    int multiplier;                                 ///< Multiplier.
+    QString settlementType;                         ///< Settlement type.
+    QString deliverableNote;                        ///< Deliverable note.
+
+    quint64 fields;                                 ///< Fields present (bit per field).
+
+    /// Constructor.
+    OptionContract() {clear();}
+
+    /// Remove all fields.
+    void clear() {fields = 0;}
+
+    /// Check if field present.
+    /**
+     * @param[in] f  field
+     * @return  @c true if present, @c false otherwise
+     */
+    bool has( Field f ) const {return (fields & (Q_UINT64_C( 1 ) << f));}
+
+    /// Mark field present.
+    /**
+     * @param[in] f  field
+     */
+    void set( Field f ) {fields |= (Q_UINT64_C( 1 ) << f);}
+
+    /// Mark field missing.
+    /**
+     * @param[in] f  field
+     */
+    void unset( Field f ) {fields &= ~(Q_UINT64_C( 1 ) << f);}
+
+    /// Retrieve field value.
+    /**
+     * Times are returned as milliseconds since epoch.
+     * @param[in] f  field
+     * @return  value or null variant if missing
+     */
+    QVariant value( Field f ) const;
+
+    /// Retrieve database column name of field.
+    /**
+     * @param[in] f  field
+     * @return  column name
+     */
+    static QString columnName( Field f );
+
+    /// Check if field is a time.
+    /**
+     * @param[in] f  field
+     * @return  @c true if time, @c false otherwise
+     */
+    static bool isTime( Field f ) {return (( QUOTE_TIME == f ) || ( TRADE_TIME == f ) || ( EXPIRY_DATE == f ) || ( LAST_TRADING_DAY == f ));}
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Source of option contract records.
+/**
+ * Lets a market data adapter hand contracts to the database one at a time as it decodes them,
+ * so a chain never needs to be held in memory as a whole.
+ */
+class OptionContractReader
+{
+public:
+
+    /// Destructor.
+    virtual ~OptionContractReader() {}
+
+    /// Check for error.
+    /**
+     * @return  @c true if source failed to decode, @c false otherwise
+     */
+    virtual bool hasError() const = 0;
+
+    /// Read next contract.
+    /**
+     * @param[out] contract  contract
+     * @return  @c true if contract read, @c false when no more contracts (or error)
+     */
+    virtual bool readNext( OptionContract& contract ) = 0;
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // OPTIONCONTRACT_H
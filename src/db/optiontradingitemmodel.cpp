@@ -19,6 +19,7 @@
  * not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "common.h"
 #include "optiontradingitemmodel.h"
 
 #include <cmath>
@@ -29,7 +30,9 @@
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 OptionTradingItemModel::OptionTradingItemModel( QObject *parent ) :
-    _Mybase( 0, _NUM_COLUMNS, parent )
+    _Mybase( 0, _NUM_COLUMNS, parent ),
+    pending_( nullptr ),
+    table_( _NUM_COLUMNS )
 {
     // when sorting, use user role data (raw data)
     setSortRole( Qt::UserRole );
@@ -160,6 +163,7 @@ OptionTradingItemModel::OptionTradingItemModel( QObject *parent ) :
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 OptionTradingItemModel::~OptionTradingItemModel()
 {
+    removeAllRows();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -387,189 +391,501 @@ Qt::ItemFlags OptionTradingItemModel::flags( const QModelIndex& index ) const
     return f;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int OptionTradingItemModel::rowCount( const QModelIndex& parent ) const
+{
+    Q_UNUSED( parent )
+
+    int result;
+
+    // see ItemModel::rowCount() for why we check for write lock first
+    if ( lock_.tryLockForWrite() )
+    {
+        result = order_.size();
+        lock_.unlock();
+    }
+    else
+    {
+        QReadLocker guard( &lock_ );
+        result = order_.size();
+    }
+
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool OptionTradingItemModel::setData( int row, int col, const QVariant& value, int role )
+{
+    if ( Qt::UserRole != role )
+        return false;
+
+    QWriteLocker guard( &lock_ );
+
+    if (( row < 0 ) || ( order_.size() <= row ) || ( col < 0 ) || ( columnCount() <= col ))
+        return false;
+
+    table_.setValue( order_[row], col, value );
+
+    // emit
+    const QModelIndex idx( createIndex( row, col ) );
+
+    emit dataChanged( idx, idx );
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void OptionTradingItemModel::appendRow( item_type *items )
+{
+    if ( !items )
+        return;
+
+    ColumnValueRows rows;
+    rows.append( ColumnValueRow( _NUM_COLUMNS ) );
+
+    for ( int col( 0 ); col < _NUM_COLUMNS; ++col )
+        rows[0][col] = items[col].data( Qt::UserRole );
+
+    freeRowItems( items );
+
+    appendRows( rows );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void OptionTradingItemModel::appendRows( ColumnValueRows& rows )
+{
+    if ( rows.isEmpty() )
+        return;
+
+    PendingRows *batch( new PendingRows );
+    batch->rows.swap( rows );
+
+    // push onto stack
+    PendingRows *head;
+
+    do
+    {
+        head = pending_.loadAcquire();
+        batch->next = head;
+
+    } while ( !pending_.testAndSetOrdered( head, batch ) );
+
+    // first batch since last drain, schedule insertion on model thread
+    if ( !head )
+        QMetaObject::invokeMethod( this, "insertPendingRows", Qt::QueuedConnection );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool OptionTradingItemModel::insertRows( int row, int count, const QModelIndex& parent )
+{
+    if ( count <= 0 )
+        return true;
+
+    QWriteLocker guard( &lock_ );
+
+    // verify rows
+    row = qMax( row, 0 );
+    row = qMin( row, order_.size() );
+
+    beginInsertRows( parent, row, (row + count - 1) );
+
+    const int r( table_.rowCount() );
+
+    table_.appendRows( count );
+
+    for ( int i( 0 ); i < count; ++i )
+        order_.insert( row + i, r + i );
+
+    endInsertRows();
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void OptionTradingItemModel::removeAllRows()
+{
+    PendingRows *batch( takePendingRows() );
+
+    while ( batch )
+    {
+        PendingRows *doomed( batch );
+        batch = batch->next;
+
+        delete doomed;
+    }
+
+    QWriteLocker guard( &lock_ );
+
+    const int rows( order_.size() );
+
+    if ( !rows )
+        return;
+
+    LOG_DEBUG << "removing " << rows << " rows...";
+
+    beginRemoveRows( QModelIndex(), 0, (rows - 1) );
+
+    table_.clear();
+    order_.clear();
+
+    endRemoveRows();
+
+    LOG_DEBUG << "removal complete";
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool OptionTradingItemModel::removeRows( int row, int count, const QModelIndex& parent )
+{
+    if ( count <= 0 )
+        return true;
+
+    QWriteLocker guard( &lock_ );
+
+    if (( row < 0 ) || ( order_.size() <= row ))
+        return false;
+
+    // verify count of rows to remove
+    count = qMin( count, (order_.size() - row) );
+
+    beginRemoveRows( parent, row, (row + count - 1) );
+
+    std::vector<bool> doomed( table_.rowCount(), false );
+
+    for ( int i( row ); i < (row + count); ++i )
+        doomed[order_[i]] = true;
+
+    order_.remove( row, count );
+
+    // compact table and remap
+    const ColumnarTable::RowIndexList remap( table_.removeRows( doomed ) );
+
+    for ( int& r : order_ )
+        r = remap[r];
+
+    endRemoveRows();
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int OptionTradingItemModel::removeRowsIf( int column, const QVariant& value, RemovalRule rule )
+{
+    if (( column < 0 ) || ( columnCount() <= column ))
+        return 0;
+
+    QWriteLocker guard( &lock_ );
+
+    // flag table rows to remove
+    std::vector<bool> doomed( table_.rowCount(), false );
+
+    int count( 0 );
+
+    for ( int r( 0 ); r < table_.rowCount(); ++r )
+        if (( doomed[r] = matchesRemovalRule( rawValue( r, column ), value, rule ) ))
+            ++count;
+
+    if ( !count )
+        return 0;
+
+    LOG_DEBUG << "removing " << count << " rows...";
+
+    // remove each contiguous range of view rows, last to first so earlier rows keep their place
+    for ( int row( order_.size() ); row--; )
+    {
+        if ( !doomed[order_[row]] )
+            continue;
+
+        int first( row );
+
+        while (( 0 < first ) && ( doomed[order_[first - 1]] ))
+            --first;
+
+        beginRemoveRows( QModelIndex(), first, row );
+        order_.remove( first, (row - first + 1) );
+        endRemoveRows();
+
+        row = first;
+    }
+
+    // compact table and remap
+    const ColumnarTable::RowIndexList remap( table_.removeRows( doomed ) );
+
+    for ( int& r : order_ )
+        r = remap[r];
+
+    LOG_DEBUG << "removal complete";
+
+    return count;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void OptionTradingItemModel::sort( int column, Qt::SortOrder order )
+{
+    if (( column < 0 ) || ( columnCount() <= column ))
+        return;
+
+    QWriteLocker guard( &lock_ );
+
+    if ( !order_.size() )
+        return;
+
+    LOG_DEBUG << "sorting by column " << column << " order " << order << "...";
+    emit layoutAboutToBeChanged();
+
+    // sort!!
+    table_.sort( order_, column, (Qt::AscendingOrder == order) );
+
+    LOG_DEBUG << "sorting complete";
+    emit layoutChanged();
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void OptionTradingItemModel::addRow( const ColumnValueMap& values )
 {
-    item_type *items( allocRowItems() );
+    ColumnValueRows rows;
+    rows.append( toRow( values ) );
 
-    const bool freeMoney( values[INVESTMENT_AMOUNT].toDouble() < 0.0 );
+    appendRows( rows );
+}
 
-    // populate
-    for ( ColumnValueMap::const_iterator i( values.constBegin() ); i != values.constEnd(); ++i )
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QVariant OptionTradingItemModel::dataImpl( int row, int col, int role ) const
+{
+    if (( row < 0 ) || ( order_.size() <= row ) || ( col < 0 ) || ( columnCount() <= col ))
+        return QVariant();
+
+    const int r( order_[row] );
+
+    const QVariant value( rawValue( r, col ) );
+
+    // no value for this column
+    if ( !value.isValid() )
+        return QVariant();
+
+    switch ( role )
     {
-        item_type *item( &items[i.key()] );
+    case Qt::UserRole:
+        return value;
 
-        // ------------
-        // display role
-        // ------------
+    case Qt::DisplayRole:
+        return displayText( r, col );
 
-        QString text;
+    case Qt::TextAlignmentRole:
+        if ( columnIsText_[col] )
+            return QVariant( Qt::AlignLeft | Qt::AlignVCenter );
 
-        if ( STRATEGY == i.key() )
-            text = strategyText( (Strategy) i->toInt() );
+        return QVariant( Qt::AlignRight | Qt::AlignVCenter );
 
-        // no bid/ask size
-        else if ((( BID_PRICE == i.key() ) && ( 0 == values[BID_SIZE].toInt() )) ||
-                 (( ASK_PRICE == i.key() ) && ( 0 == values[ASK_SIZE].toInt() )))
-            ; // empty string
+    case Qt::BackgroundRole:
+        return backgroundColor( r );
+
+    case Qt::ForegroundRole:
+        return foregroundColor( r, col );
+
+    default:
+        break;
+    }
 
-        // invalid calculated volatility
-        else if ((( CALC_BID_PRICE_VI == i.key() ) || ( CALC_ASK_PRICE_VI == i.key() ) || ( CALC_MARK_VI == i.key() ) ||
-                  ( CALC_THEO_VOLATILITY == i.key() )) &&
-                 ( i.value().toDouble() <= 0.0 ))
-            ; // empty string
+    return QVariant();
+}
 
-        else
-            text = formatValue( i.value(), numDecimalPlaces_[i.key()] );
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void OptionTradingItemModel::insertPendingRows()
+{
+    PendingRows *batch( takePendingRows() );
 
-        item->setData( text, Qt::DisplayRole );
+    if ( !batch )
+        return;
 
-        // -------------------
-        // text alignment role
-        // -------------------
+    // count rows
+    int count( 0 );
 
-        Qt::Alignment align;
+    for ( const PendingRows *b( batch ); b; b = b->next )
+        count += b->rows.size();
 
-        if ( columnIsText_[i.key()] )
-            align = Qt::AlignLeft | Qt::AlignVCenter;
-        else
-            align = Qt::AlignRight | Qt::AlignVCenter;
+    QWriteLocker guard( &lock_ );
 
-        item->setData( QVariant( align ), Qt::TextAlignmentRole );
+    const int row( order_.size() );
 
-        // ---------------
-        // background role
-        // ---------------
+    beginInsertRows( QModelIndex(), row, (row + count - 1) );
 
-        if ( values[IS_IN_THE_MONEY].toBool() )
+    while ( batch )
+    {
+        foreach ( const ColumnValueRow& values, batch->rows )
         {
-            if ( values[IS_OUT_OF_THE_MONEY].toBool() )
-                item->setData( QVariant( mixedMoneyColor_ ), Qt::BackgroundRole );
-            else
-                item->setData( QVariant( inTheMoneyColor_ ), Qt::BackgroundRole );
+            order_.append( table_.rowCount() );
+            table_.appendRow( values );
         }
 
-        // ---------------
-        // foreground role
-        // ---------------
+        PendingRows *doomed( batch );
+        batch = batch->next;
+
+        delete doomed;
+    }
 
-        double v;
+    endInsertRows();
+}
 
-        item->setData( textColor_, Qt::ForegroundRole );
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QVariant OptionTradingItemModel::backgroundColor( int r ) const
+{
+    if ( rawValue( r, IS_IN_THE_MONEY ).toBool() )
+    {
+        if ( rawValue( r, IS_OUT_OF_THE_MONEY ).toBool() )
+            return QVariant( mixedMoneyColor_ );
+
+        return QVariant( inTheMoneyColor_ );
+    }
+
+    return QVariant();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QVariant OptionTradingItemModel::displayText( int r, int col ) const
+{
+    const QVariant value( rawValue( r, col ) );
+
+    if ( STRATEGY == col )
+        return strategyText( (Strategy) value.toInt() );
+
+    // no bid/ask size
+    else if ((( BID_PRICE == col ) && ( 0 == rawValue( r, BID_SIZE ).toInt() )) ||
+             (( ASK_PRICE == col ) && ( 0 == rawValue( r, ASK_SIZE ).toInt() )))
+        return QString();
+
+    // invalid calculated volatility
+    else if ((( CALC_BID_PRICE_VI == col ) || ( CALC_ASK_PRICE_VI == col ) || ( CALC_MARK_VI == col ) ||
+              ( CALC_THEO_VOLATILITY == col )) &&
+             ( value.toDouble() <= 0.0 ))
+        return QString();
+
+    return formatValue( value, numDecimalPlaces_[col] );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QVariant OptionTradingItemModel::foregroundColor( int r, int col ) const
+{
+    const bool freeMoney( rawValue( r, INVESTMENT_AMOUNT ).toDouble() < 0.0 );
+
+    double v;
+
+    switch ( col )
+    {
+    case CALC_THEO_OPTION_VALUE:
+        return calcErrorColor( rawValue( r, THEO_OPTION_VALUE ), rawValue( r, CALC_THEO_OPTION_VALUE ), textColor_ );
+    case CALC_THEO_VOLATILITY:
+        return calcErrorColor( rawValue( r, VOLATILITY ), rawValue( r, CALC_THEO_VOLATILITY ), textColor_ );
+    case CALC_DELTA:
+        return calcErrorColor( rawValue( r, DELTA ), rawValue( r, CALC_DELTA ), textColor_ );
+    case CALC_GAMMA:
+        return calcErrorColor( rawValue( r, GAMMA ), rawValue( r, CALC_GAMMA ), textColor_ );
+    case CALC_THETA:
+        return calcErrorColor( rawValue( r, THETA ), rawValue( r, CALC_THETA ), textColor_ );
+    case CALC_VEGA:
+        return calcErrorColor( rawValue( r, VEGA ), rawValue( r, CALC_VEGA ), textColor_ );
+    case CALC_RHO:
+        return calcErrorColor( rawValue( r, RHO ), rawValue( r, CALC_RHO ), textColor_ );
+
+    case INVESTMENT_OPTION_PRICE:
+    case INVESTMENT_OPTION_PRICE_VS_THEO:
+        v = rawValue( r, INVESTMENT_OPTION_PRICE_VS_THEO ).toDouble();
+        if ( 0.005 <= v )
+            return QColor( Qt::darkGreen );
+        else if ( v < -0.005 )
+            return QColor( Qt::red );
+        break;
 
-        switch ( i.key() )
+    case INVESTMENT_AMOUNT:
+    case MAX_LOSS:
+        if ( rawValue( r, col ).toDouble() < 0.0 )
+            return QColor( Qt::darkGreen );
+        break;
+    case PREMIUM_AMOUNT:
+    case MAX_GAIN:
+        if ( rawValue( r, col ).toDouble() < 0.0 )
+            return QColor( Qt::red );
+        break;
+
+    case ROR:
+    case ROR_WEEK:
+    case ROR_MONTH:
+    case ROR_YEAR:
+        if ( rawValue( r, col ).toDouble() < 0.0 )
+        {
+            if ( freeMoney )
+                return QColor( Qt::darkGreen );
+
+            return QColor( Qt::red );
+        }
+        break;
+
+    case ROI:
+    case ROI_WEEK:
+    case ROI_MONTH:
+    case ROI_YEAR:
+        if ( rawValue( r, col ).toDouble() < 0.0 )
+        {
+            if ( freeMoney )
+                return QColor( Qt::darkGreen );
+
+            return QColor( Qt::red );
+        }
+
+        // make less money than risk free investment (i.e. government bond)
+        else if ( rawValue( r, ROI_YEAR ).toDouble() <= rawValue( r, RISK_FREE_INTEREST_RATE ).toDouble() )
+            return QColor( 255, 165, 0 ); // orange
+        break;
+
+    case EXPECTED_VALUE:
+        v = rawValue( r, col ).toDouble();
+        if ( 0.0 < v )
+            return QColor( Qt::darkGreen );
+        else if ( v < 0.0 )
+            return QColor( Qt::red );
+        break;
+
+    case EXPECTED_VALUE_ROI:
+    case EXPECTED_VALUE_ROI_WEEK:
+    case EXPECTED_VALUE_ROI_MONTH:
+    case EXPECTED_VALUE_ROI_YEAR:
+        v = rawValue( r, col ).toDouble();
+        if ( 0.0 < v )
+            return QColor( Qt::darkGreen );
+        else if ( v < 0.0 )
         {
-        case CALC_THEO_OPTION_VALUE:
-            item->setData( calcErrorColor( values[THEO_OPTION_VALUE], values[CALC_THEO_OPTION_VALUE], textColor_ ), Qt::ForegroundRole );
-            break;
-        case CALC_THEO_VOLATILITY:
-            item->setData( calcErrorColor( values[VOLATILITY], values[CALC_THEO_VOLATILITY], textColor_ ), Qt::ForegroundRole );
-            break;
-        case CALC_DELTA:
-            item->setData( calcErrorColor( values[DELTA], values[CALC_DELTA], textColor_ ), Qt::ForegroundRole );
-            break;
-        case CALC_GAMMA:
-            item->setData( calcErrorColor( values[GAMMA], values[CALC_GAMMA], textColor_ ), Qt::ForegroundRole );
-            break;
-        case CALC_THETA:
-            item->setData( calcErrorColor( values[THETA], values[CALC_THETA], textColor_ ), Qt::ForegroundRole );
-            break;
-        case CALC_VEGA:
-            item->setData( calcErrorColor( values[VEGA], values[CALC_VEGA], textColor_ ), Qt::ForegroundRole );
-            break;
-        case CALC_RHO:
-            item->setData( calcErrorColor( values[RHO], values[CALC_RHO], textColor_ ), Qt::ForegroundRole );
-            break;
-
-        case INVESTMENT_OPTION_PRICE:
-        case INVESTMENT_OPTION_PRICE_VS_THEO:
-            v = values[INVESTMENT_OPTION_PRICE_VS_THEO].toDouble();
-            if ( 0.005 <= v )
-                item->setData( QColor( Qt::darkGreen ), Qt::ForegroundRole );
-            else if ( v < -0.005 )
-                item->setData( QColor( Qt::red ), Qt::ForegroundRole );
-            break;
-
-        case INVESTMENT_AMOUNT:
-        case MAX_LOSS:
-            if ( values[i.key()].toDouble() < 0.0 )
-                item->setData( QColor( Qt::darkGreen ), Qt::ForegroundRole );
-            break;
-        case PREMIUM_AMOUNT:
-        case MAX_GAIN:
-            if ( values[i.key()].toDouble() < 0.0 )
-                item->setData( QColor( Qt::red ), Qt::ForegroundRole );
-            break;
-
-        case ROR:
-        case ROR_WEEK:
-        case ROR_MONTH:
-        case ROR_YEAR:
-            if ( values[i.key()].toDouble() < 0.0 )
-            {
-                if ( freeMoney )
-                    item->setData( QColor( Qt::darkGreen ), Qt::ForegroundRole );
-                else
-                    item->setData( QColor( Qt::red ), Qt::ForegroundRole );
-            }
-            break;
-
-        case ROI:
-        case ROI_WEEK:
-        case ROI_MONTH:
-        case ROI_YEAR:
-            if ( values[i.key()].toDouble() < 0.0 )
-            {
-                if ( freeMoney )
-                    item->setData( QColor( Qt::darkGreen ), Qt::ForegroundRole );
-                else
-                    item->setData( QColor( Qt::red ), Qt::ForegroundRole );
-            }
-            else
-            {
-                // make less money than risk free investment (i.e. government bond)
-                if ( values[ROI_YEAR].toDouble() <= values[RISK_FREE_INTEREST_RATE].toDouble() )
-                    item->setData( QColor( 255, 165, 0 ), Qt::ForegroundRole ); // orange
-            }
-            break;
-
-        case EXPECTED_VALUE:
-            v = values[i.key()].toDouble();
-            if ( 0.0 < v )
-                item->setData( QColor( Qt::darkGreen ), Qt::ForegroundRole );
-            else if ( v < 0.0 )
-                item->setData( QColor( Qt::red ), Qt::ForegroundRole );
-            break;
-
-        case EXPECTED_VALUE_ROI:
-        case EXPECTED_VALUE_ROI_WEEK:
-        case EXPECTED_VALUE_ROI_MONTH:
-        case EXPECTED_VALUE_ROI_YEAR:
-            v = values[i.key()].toDouble();
-            if ( 0.0 < v )
-                item->setData( QColor( Qt::darkGreen ), Qt::ForegroundRole );
-            else if ( v < 0.0 )
-            {
-                if ( freeMoney )
-                    item->setData( QColor( Qt::darkGreen ), Qt::ForegroundRole );
-                else
-                    item->setData( QColor( Qt::red ), Qt::ForegroundRole );
-            }
-            break;
-
-        default:
-            break;
+            if ( freeMoney )
+                return QColor( Qt::darkGreen );
+
+            return QColor( Qt::red );
         }
+        break;
 
-        // ---------
-        // user role
-        // ---------
+    default:
+        break;
+    }
 
-        item->setData( i.value(), Qt::UserRole );
+    return textColor_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+OptionTradingItemModel::PendingRows *OptionTradingItemModel::takePendingRows()
+{
+    PendingRows *head( pending_.fetchAndStoreOrdered( nullptr ) );
+
+    // stack is newest first, reverse to preserve insertion order
+    PendingRows *result( nullptr );
+
+    while ( head )
+    {
+        PendingRows *next( head->next );
+
+        head->next = result;
+        result = head;
+
+        head = next;
     }
 
-    // append row!
-    appendRow( items );
+    return result;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -620,3 +936,15 @@ QString OptionTradingItemModel::strategyText( Strategy strat )
 
     return QString();
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+OptionTradingItemModel::ColumnValueRow OptionTradingItemModel::toRow( const ColumnValueMap& values )
+{
+    ColumnValueRow row( _NUM_COLUMNS );
+
+    for ( ColumnValueMap::const_iterator i( values.constBegin() ); i != values.constEnd(); ++i )
+        if (( 0 <= i.key() ) && ( i.key() < _NUM_COLUMNS ))
+            row[i.key()] = i.value();
+
+    return row;
+}
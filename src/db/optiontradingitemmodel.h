@@ -23,8 +23,10 @@
 #ifndef OPTIONTRADINGITEMMODEL_H
 #define OPTIONTRADINGITEMMODEL_H
 
+#include "columnartable.h"
 #include "itemmodel.h"
 
+#include <QAtomicPointer>
 #include <QColor>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -42,6 +44,12 @@ public:
     /// Map of column values.
     using ColumnValueMap = QMap<int, QVariant>;
 
+    /// Row of column values, indexed by column.
+    using ColumnValueRow = QVector<QVariant>;
+
+    /// List of column value rows.
+    using ColumnValueRows = QVector<ColumnValueRow>;
+
     /// Column index values.
     enum ColumnIndex
     {
@@ -198,6 +206,98 @@ public:
      */
     virtual Qt::ItemFlags flags( const QModelIndex& index ) const override;
 
+    /// Retrieve number of rows.
+    /**
+     * @param[in] parent  parent index
+     * @return  number of rows
+     */
+    virtual int rowCount( const QModelIndex& parent = QModelIndex() ) const override;
+
+    using _Mybase::setData;
+
+    /// Set model data.
+    /**
+     * Only raw values (user role) can be set.
+     * @param[in] row  row
+     * @param[in] col  column
+     * @param[in] value  data
+     * @param[in] role  data role
+     * @return  @c true upon success, @c false otherwise
+     */
+    virtual bool setData( int row, int col, const QVariant& value, int role = Qt::EditRole ) override;
+
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Append row to model.
+    /**
+     * Raw values (user role) of @a items are copied, model will free @a items.
+     * @param[in] items  pointer to array of items
+     */
+    virtual void appendRow( item_type *items ) override;
+
+    /// Append rows to model.
+    /**
+     * Safe to call from any thread without locking the model. Rows are queued on a lock-free
+     * list and inserted in batches on the thread that owns the model.
+     * @param[in,out] rows  rows to append (will be empty upon return)
+     */
+    virtual void appendRows( ColumnValueRows& rows );
+
+    /// Insert model rows.
+    /**
+     * @param[in] row  insert location
+     * @param[in] count  number of rows to insert
+     * @param[in] parent  parent index
+     * @return  @c true upon success, @c false otherwise
+     */
+    virtual bool insertRows( int row, int count, const QModelIndex& parent = QModelIndex() ) override;
+
+    /// Remove all rows from model.
+    /**
+     * Rows queued for insertion are discarded as well.
+     */
+    virtual void removeAllRows() override;
+
+    /// Remove model rows.
+    /**
+     * @param[in] row  remove location
+     * @param[in] count  number of rows to remove
+     * @param[in] parent  parent index
+     * @return  @c true upon success, @c false otherwise
+     */
+    virtual bool removeRows( int row, int count, const QModelIndex& parent = QModelIndex() ) override;
+
+    /// Remove model rows if column value matches rule.
+    /**
+     * Table is compacted once after all matching rows are removed.
+     * @param[in] column  column to check
+     * @param[in] value  value to check against
+     * @param[in] rule  rule to follow
+     * @return  number of rows removed
+     */
+    virtual int removeRowsIf( int column, const QVariant& value, RemovalRule rule = RemovalRule::Equal ) override;
+
+    /// Sort model by @a column in given @a order.
+    /**
+     * Sorts a row index using the typed column values, row data is not moved.
+     * @param[in] column  column to sort by
+     * @param[in] order  order of sort
+     */
+    virtual void sort( int column, Qt::SortOrder order ) override;
+
+    // ========================================================================
+    // Static Methods
+    // ========================================================================
+
+    /// Convert column value map into row.
+    /**
+     * @param[in] values  values
+     * @return  row
+     */
+    static ColumnValueRow toRow( const ColumnValueMap& values );
+
 public slots:
 
     // ========================================================================
@@ -210,13 +310,63 @@ public slots:
      */
     virtual void addRow( const OptionTradingItemModel::ColumnValueMap& values );
 
+protected:
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// Retrieve model data.
+    /**
+     * Only raw values (user role) are stored, in a columnar table. All other roles are
+     * generated on demand.
+     * Implementation, does not lock!
+     * @param[in] row  row
+     * @param[in] col  column
+     * @param[in] role  role
+     * @return  data
+     */
+    virtual QVariant dataImpl( int row, int col, int role = Qt::DisplayRole ) const override;
+
+private slots:
+
+    /// Insert rows queued by appendRows().
+    void insertPendingRows();
+
 private:
 
+    /// Batch of rows pending insertion.
+    struct PendingRows
+    {
+        PendingRows *next;                          ///< Next (older) batch.
+        ColumnValueRows rows;                       ///< Rows.
+    };
+
+    QAtomicPointer<PendingRows> pending_;           ///< Lock-free stack of pending batches.
+
+    ColumnarTable table_;                           ///< Raw (user role) values.
+    ColumnarTable::RowIndexList order_;             ///< Table row for each model row.
+
     QColor inTheMoneyColor_;
     QColor mixedMoneyColor_;
 
     QColor textColor_;
 
+    /// Retrieve background color of table row.
+    QVariant backgroundColor( int r ) const;
+
+    /// Retrieve display text of table row column.
+    QVariant displayText( int r, int col ) const;
+
+    /// Retrieve foreground color of table row column.
+    QVariant foregroundColor( int r, int col ) const;
+
+    /// Retrieve raw (user role) value of table row column.
+    QVariant rawValue( int r, int col ) const {return table_.value( r, col );}
+
+    /// Take all pending batches, oldest first.
+    PendingRows *takePendingRows();
+
     /// Calculate percent error.
     static double calcError( const QVariant& col0, const QVariant& col1, bool &valid );
 
@@ -24,6 +24,7 @@
 
 #include <QApplication>
 #include <QDateTime>
+#include <QDir>
 #include <QFile>
 #include <QJsonObject>
 #include <QSqlError>
@@ -32,15 +33,17 @@
 #include <QThread>
 #include <QVariant>
 
+static QString dbCacheDir( USER_CACHE_DIR );
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 SqlDatabase::SqlDatabase( const QString& name, const QString& version, QObject *parent ) :
     _Mybase( parent ),
 #if QT_VERSION < QT_VERSION_CHECK( 5, 14, 0 )
     writer_( QMutex::Recursive ),
 #endif
-    name_( USER_CACHE_DIR + name ),
+    name_( dbCacheDir + name ),
     version_( version ),
-    backupName_( USER_CACHE_DIR + name + ".old" ),
+    backupName_( dbCacheDir + name + ".old" ),
     ready_( false )
 {
     // this object should only be created by application thread
@@ -61,6 +64,48 @@ QString SqlDatabase::version() const
     return result.toString();
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QString SqlDatabase::cacheDir()
+{
+    return dbCacheDir;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QDateTime SqlDatabase::fromEpoch( const QVariant& value )
+{
+    if ( value.isNull() )
+        return QDateTime();
+
+    return QDateTime::fromMSecsSinceEpoch( value.toLongLong() );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QDate SqlDatabase::fromJulianDay( const QVariant& value )
+{
+    if ( value.isNull() )
+        return QDate();
+
+    return QDate::fromJulianDay( value.toLongLong() );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QVariant SqlDatabase::toEpoch( const QDateTime& value )
+{
+    if ( !value.isValid() )
+        return QVariant();
+
+    return QVariant( value.toMSecsSinceEpoch() );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QVariant SqlDatabase::toJulianDay( const QDate& value )
+{
+    if ( !value.isValid() )
+        return QVariant();
+
+    return QVariant( value.toJulianDay() );
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 QSqlDatabase SqlDatabase::connection() const
 {
@@ -127,6 +172,12 @@ QString SqlDatabase::connectionNameThread() const
         .arg( (quintptr) QThread::currentThreadId() );
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void SqlDatabase::setCacheDir( const QString& dir )
+{
+    dbCacheDir = QDir( dir ).absolutePath() + "/";
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void SqlDatabase::setVersion( const QString &version )
 {
@@ -23,9 +23,12 @@
 #ifndef SQLDB_H
 #define SQLDB_H
 
+#include <QDate>
+#include <QDateTime>
 #include <QMutex>
 #include <QObject>
 #include <QSqlDatabase>
+#include <QVariant>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -57,6 +60,51 @@ public:
      */
     virtual QString version() const;
 
+    // ========================================================================
+    // Static Methods
+    // ========================================================================
+
+    /// Retrieve directory databases are stored in.
+    /**
+     * @return  directory, with trailing separator
+     */
+    static QString cacheDir();
+
+    /// Convert stored epoch value into date time.
+    /**
+     * @param[in] value  milliseconds since epoch
+     * @return  date time, invalid when @a value is null
+     */
+    static QDateTime fromEpoch( const QVariant& value );
+
+    /// Convert stored day number value into date.
+    /**
+     * @param[in] value  julian day number
+     * @return  date, invalid when @a value is null
+     */
+    static QDate fromJulianDay( const QVariant& value );
+
+    /// Set directory databases are stored in.
+    /**
+     * Only affects databases created afterwards, must be called before the first database instance.
+     * @param[in] dir  directory
+     */
+    static void setCacheDir( const QString& dir );
+
+    /// Convert date time into stored epoch value.
+    /**
+     * @param[in] value  date time
+     * @return  milliseconds since epoch, null when @a value is invalid
+     */
+    static QVariant toEpoch( const QDateTime& value );
+
+    /// Convert date into stored day number value.
+    /**
+     * @param[in] value  date
+     * @return  julian day number, null when @a value is invalid
+     */
+    static QVariant toJulianDay( const QDate& value );
+
 protected:
 
 #if QT_VERSION_CHECK( 5, 14, 0 ) <= QT_VERSION
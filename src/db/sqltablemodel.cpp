@@ -31,7 +31,9 @@ SqlTableModel::SqlTableModel( int columns, QObject *parent, QSqlDatabase db ) :
     _Mybase( parent, db ),
     ready_( false ),
     columnIsText_( columns, false ),
-    numDecimalPlaces_( columns, 0 )
+    numDecimalPlaces_( columns, 0 ),
+    columnIsEpoch_( columns, false ),
+    columnIsJulianDay_( columns, false )
 {
     // default to manual submit edit strategy
     setEditStrategy( QSqlTableModel::OnManualSubmit );
@@ -45,13 +47,25 @@ SqlTableModel::~SqlTableModel()
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 QVariant SqlTableModel::data( int row, int col, int role ) const
 {
-    return _Mybase::data( createIndex( row, col ), role );
+    return columnValue( col, _Mybase::data( createIndex( row, col ), role ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QVariant SqlTableModel::data( const QModelIndex& index, int role ) const
+{
+    return columnValue( index.column(), _Mybase::data( index, role ) );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 QVariant SqlTableModel::data0( int col, int role ) const
 {
-    return _Mybase::data( createIndex( 0, col ), role );
+    return columnValue( col, _Mybase::data( createIndex( 0, col ), role ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QVariant SqlTableModel::rawData( int row, int col ) const
+{
+    return _Mybase::data( createIndex( row, col ), Qt::DisplayRole );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -78,6 +92,19 @@ bool SqlTableModel::refreshData()
     return false;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QVariant SqlTableModel::columnValue( int col, const QVariant& value ) const
+{
+    if (( value.isNull() ) || ( col < 0 ) || ( columnIsEpoch_.size() <= col ))
+        return value;
+    else if ( columnIsEpoch_[col] )
+        return QDateTime::fromMSecsSinceEpoch( value.toLongLong() ).toString( Qt::ISODateWithMs );
+    else if ( columnIsJulianDay_[col] )
+        return QDate::fromJulianDay( value.toLongLong() ).toString( Qt::ISODate );
+
+    return value;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 QString SqlTableModel::formatValue( const QVariant& v, int numDecimalPlaces )
 {
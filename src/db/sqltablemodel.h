@@ -102,7 +102,7 @@ public:
      * @param[in] role  role
      * @return  data
      */
-    virtual QVariant data( const QModelIndex& index, int role = Qt::DisplayRole ) const override {return _Mybase::data( index, role );}
+    virtual QVariant data( const QModelIndex& index, int role = Qt::DisplayRole ) const override;
 
     /// Retrieve table data for single row.
     /**
@@ -112,6 +112,15 @@ public:
      */
     virtual QVariant data0( int col, int role = Qt::DisplayRole ) const;
 
+    /// Retrieve stored table data.
+    /**
+     * Unlike data() no conversion is done, epoch and julian day columns are handed out as numbers.
+     * @param[in] row  row
+     * @param[in] col  column
+     * @return  data
+     */
+    virtual QVariant rawData( int row, int col ) const;
+
     /// Check if data is ready.
     /**
      * @return  @c true if data is ready, @c false otherwise
@@ -140,6 +149,22 @@ protected:
     QVector<bool> columnIsText_;                    ///< Column contains text data.
     QVector<int> numDecimalPlaces_;                 ///< Number of decimal places for this column that contains numeric data.
 
+    QVector<bool> columnIsEpoch_;                   ///< Column contains epoch milliseconds.
+    QVector<bool> columnIsJulianDay_;               ///< Column contains julian day number.
+
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Convert stored value for column.
+    /**
+     * Epoch and julian day columns are handed out as ISO date time and date text.
+     * @param[in] col  column
+     * @param[in] value  stored value
+     * @return  value
+     */
+    virtual QVariant columnValue( int col, const QVariant& value ) const;
+
     // ========================================================================
     // Static Methods
     // ========================================================================
@@ -22,22 +22,29 @@
 
 #include "appdb.h"
 #include "common.h"
+#include "multirowinsert.h"
+#include "optioncontract.h"
 #include "stringsdb.h"
 #include "symboldb.h"
 
 #include "../util/stats.h"
+#include "../util/technicalindicators.h"
 
 #include <cmath>
 
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
 #include <QJsonArray>
+#include <QJsonDocument>
 #include <QJsonObject>
+#include <QSet>
 #include <QSqlError>
 #include <QSqlRecord>
 #include <QSqlQuery>
 
 static const QString DB_NAME( "%1.db" );
-static const QString DB_VERSION( "5" );
+static const QString DB_VERSION( "7" );
 
 static const QString CALL( "CALL" );
 static const QString PUT( "PUT" );
@@ -49,36 +56,147 @@ static const QString CUSIP( "cusip" );
 static const QString DESCRIPTION( "description" );
 static const QString LAST_FUNDAMENTAL( "lastFundamental" );
 static const QString LAST_QUOTE_HISTORY( "lastQuoteHistory" );
+static const QString INDICATORS_STATE( "indicatorsState" );
+static const QString INDICATORS_STATE_DATE( "indicatorsStateDate" );
 
-// sql statement for prepared query
-static const QString SQL_OPTION( "REPLACE INTO options (stamp,symbol,"
+// columns of options table, in bind order
+static const QStringList OPTION_COLUMNS( QString( "stamp,symbol,"
     "underlying,type,strikePrice,description,bidAskSize,bidPrice,bidSize,askPrice,askSize,lastPrice,"
     "lastSize,breakEvenPrice,intrinsicValue,openPrice,highPrice,lowPrice,closePrice,change,percentChange,totalVolume,"
     "quoteTime,tradeTime,mark,markChange,markPercentChange,exchangeName,volatility,delta,gamma,theta,"
     "vega,rho,timeValue,openInterest,isInTheMoney,theoreticalOptionValue,theoreticalVolatility,isMini,isNonStandard,isIndex,"
-    "isWeekly,isQuarterly,expirationDate,expirationType,daysToExpiration,lastTradingDay,multiplier,settlementType,deliverableNote) "
-        "VALUES (:stamp,:symbol,"
-            ":underlying,:type,:strikePrice,:description,:bidAskSize,:bidPrice,:bidSize,:askPrice,:askSize,:lastPrice,"
-            ":lastSize,:breakEvenPrice,:intrinsicValue,:openPrice,:highPrice,:lowPrice,:closePrice,:change,:percentChange,:totalVolume,"
-            ":quoteTime,:tradeTime,:mark,:markChange,:markPercentChange,:exchangeName,:volatility,:delta,:gamma,:theta,"
-            ":vega,:rho,:timeValue,:openInterest,:isInTheMoney,:theoreticalOptionValue,:theoreticalVolatility,:isMini,:isNonStandard,:isIndex,"
-            ":isWeekly,:isQuarterly,:expirationDate,:expirationType,:daysToExpiration,:lastTradingDay,:multiplier,:settlementType,:deliverableNote) " );
-
-// sql statement for prepared query
-static const QString SQL_OPTION_CHAIN_STRIKES_CALL( "INSERT INTO optionChainStrikePrices (stamp,underlying,expirationDate,strikePrice,"
-    "callStamp,callSymbol) "
-        "VALUES (:stamp,:underlying,:expirationDate,:strikePrice,"
-            ":optionStamp,:optionSymbol) "
-        "ON CONFLICT (stamp,underlying,expirationDate,strikePrice) DO UPDATE SET "
-            "callStamp=:optionStamp,callSymbol=:optionSymbol " );
-
-// sql statement for prepared query
-static const QString SQL_OPTION_CHAIN_STRIKES_PUT( "INSERT INTO optionChainStrikePrices (stamp,underlying,expirationDate,strikePrice,"
-    "putStamp,putSymbol) "
-        "VALUES (:stamp,:underlying,:expirationDate,:strikePrice,"
-            ":optionStamp,:optionSymbol) "
-        "ON CONFLICT (stamp,underlying,expirationDate,strikePrice) DO UPDATE SET "
-            "putStamp=:optionStamp,putSymbol=:optionSymbol " );
+    "isWeekly,isQuarterly,expirationDate,expirationType,daysToExpiration,lastTradingDay,multiplier,settlementType,deliverableNote" ).split( ',' ) );
+
+/// Map each column name to its bind index.
+static QHash<QString, int> columnIndexes( const QStringList& columns )
+{
+    QHash<QString, int> result;
+
+    for ( int i( 0 ); i < columns.size(); ++i )
+        result[columns[i]] = i;
+
+    return result;
+}
+
+static const QHash<QString, int> OPTION_COLUMN_INDEXES( columnIndexes( OPTION_COLUMNS ) );
+
+static const int OPTION_STAMP_INDEX( OPTION_COLUMNS.indexOf( DB_STAMP ) );
+static const int OPTION_SYMBOL_INDEX( OPTION_COLUMNS.indexOf( DB_SYMBOL ) );
+static const int OPTION_UNDERLYING_INDEX( OPTION_COLUMNS.indexOf( DB_UNDERLYING ) );
+static const int OPTION_TYPE_INDEX( OPTION_COLUMNS.indexOf( DB_TYPE ) );
+static const int OPTION_STRIKE_PRICE_INDEX( OPTION_COLUMNS.indexOf( DB_STRIKE_PRICE ) );
+static const int OPTION_BID_ASK_SIZE_INDEX( OPTION_COLUMNS.indexOf( DB_BID_ASK_SIZE ) );
+static const int OPTION_BREAK_EVEN_PRICE_INDEX( OPTION_COLUMNS.indexOf( DB_BREAK_EVEN_PRICE ) );
+static const int OPTION_QUOTE_TIME_INDEX( OPTION_COLUMNS.indexOf( DB_QUOTE_TIME ) );
+static const int OPTION_EXPIRY_DATE_INDEX( OPTION_COLUMNS.indexOf( DB_EXPIRY_DATE ) );
+
+// columns of options table stored as epoch values
+static const QVector<int> OPTION_TIME_INDEXES( {OPTION_STAMP_INDEX, OPTION_QUOTE_TIME_INDEX, OPTION_COLUMNS.indexOf( DB_TRADE_TIME ),
+    OPTION_EXPIRY_DATE_INDEX, OPTION_COLUMNS.indexOf( DB_LAST_TRADING_DAY )} );
+
+/// Map each option contract field to its bind index.
+static QVector<int> contractColumnIndexes()
+{
+    QVector<int> result( OptionContract::NUM_FIELDS );
+
+    for ( int f( 0 ); f < OptionContract::NUM_FIELDS; ++f )
+        result[f] = OPTION_COLUMN_INDEXES.value( OptionContract::columnName( (OptionContract::Field) f ), -1 );
+
+    return result;
+}
+
+// sql statement for multi-row query
+static const QString SQL_OPTION( "REPLACE INTO options (" + OPTION_COLUMNS.join( ',' ) + ")" );
+
+// sql statement for multi-row query
+static const QString SQL_OPTION_CHAIN_STRIKES( "INSERT INTO optionChainStrikePrices (stamp,underlying,expirationDate,strikePrice,"
+    "%1Stamp,%1Symbol)" );
+
+// sql statement for multi-row query
+static const QString SQL_OPTION_CHAIN_STRIKES_UPSERT( "ON CONFLICT (stamp,underlying,expirationDate,strikePrice) DO UPDATE SET "
+    "%1Stamp=excluded.%1Stamp,%1Symbol=excluded.%1Symbol" );
+
+// rows per multi-row statement, kept under the default sqlite limit of 999 bound values
+static const int OPTION_BATCH_ROWS( 16 );
+static const int OPTION_CHAIN_STRIKES_BATCH_ROWS( 128 );
+
+// sql statement for latest option chain snapshot of each expiration
+static const QString SQL_OPTION_CHAIN_LATEST( "INSERT INTO optionChainLatest (underlying,expirationDate,stamp) "
+    "SELECT DISTINCT underlying,expirationDate,stamp FROM optionChainStrikePrices "
+    "WHERE stamp=:stamp AND underlying=:underlying "
+    "ON CONFLICT (underlying,expirationDate) DO UPDATE SET stamp=excluded.stamp WHERE stamp<excluded.stamp" );
+
+// sql statements for option chain snapshots of an expiration
+static const QString SQL_OPTION_CHAIN_CURVES( "SELECT * FROM optionChainStrikePrices "
+    "WHERE expirationDate=:expirationDate %1 %2 "
+    "ORDER BY stamp DESC" );
+
+static const QString SQL_OPTION_CHAIN_VIEW( "SELECT * FROM optionChainView "
+    "WHERE expirationDate=:expirationDate %1 %2 "
+    "ORDER BY stamp DESC" );
+
+static const QString SQL_STAMP_STARTING( "AND :start<=stamp" );
+static const QString SQL_STAMP_ENDING( "AND stamp<=:end" );
+
+// newest snapshot is a primary key lookup, rather than MAX(stamp) over every strike price
+static const QString SQL_STAMP_NEWEST( "AND underlying=:underlying "
+    "AND stamp=(SELECT stamp FROM optionChainLatest WHERE underlying=:underlying AND expirationDate=:expirationDate)" );
+
+// sql statement for analyzed option chain snapshots
+static const QString SQL_OPTION_CHAIN_CURVE_EXPIRY_DATES( "SELECT DISTINCT stamp, expirationDate FROM optionChainStrikePrices "
+    "WHERE volatility IS NOT NULL %1 %2 "
+    "ORDER BY stamp DESC" );
+
+// sql statement for option expiration dates
+static const QString SQL_OPTION_EXPIRY_DATES( "SELECT DISTINCT expirationDate FROM optionChainStrikePrices "
+    "WHERE :date<=expirationDate AND stamp<=:stamp "
+    "ORDER BY expirationDate ASC" );
+
+/// Add option row and its strike price to chain.
+static bool addOptionChainRow( const MultiRowInsert::RowValues& optionRow, MultiRowInsert::RowValues& strikeRow, MultiRowInsert& queryOption,
+    MultiRowInsert& queryCalls, MultiRowInsert& queryPuts, QSet<QDate>& expiryDatesSeen, QList<QDate>& expiryDates )
+{
+    const QVariant& optionStamp( optionRow[OPTION_STAMP_INDEX] );
+    const QVariant& optionSymbol( optionRow[OPTION_SYMBOL_INDEX] );
+
+    const QVariant& expiryDateVal( optionRow[OPTION_EXPIRY_DATE_INDEX] );
+    const QVariant& strikePrice( optionRow[OPTION_STRIKE_PRICE_INDEX] );
+    const QVariant& typeVal( optionRow[OPTION_TYPE_INDEX] );
+
+    if (( optionStamp.isNull() ) || ( optionSymbol.isNull() ) || ( expiryDateVal.isNull() ) || ( strikePrice.isNull() ) || ( typeVal.isNull() ))
+    {
+        LOG_WARN << "bad or missing value(s)";
+        return false;
+    }
+
+    const QDate expiryDate( SqlDatabase::fromEpoch( expiryDateVal ).date() );
+
+    const QString type( typeVal.toString() );
+
+    // add option
+    if ( !queryOption.addRow( optionRow ) )
+        return false;
+
+    // add strike price to chain
+    strikeRow[2] = SqlDatabase::toJulianDay( expiryDate );
+    strikeRow[3] = strikePrice.toDouble();
+    strikeRow[4] = optionStamp;
+    strikeRow[5] = optionSymbol.toString();
+
+    if (( CALL == type ) && ( !queryCalls.addRow( strikeRow ) ))
+        return false;
+    else if (( PUT == type ) && ( !queryPuts.addRow( strikeRow ) ))
+        return false;
+
+    // track expiry dates for caller
+    if ( !expiryDatesSeen.contains( expiryDate ) )
+    {
+        expiryDatesSeen.insert( expiryDate );
+        expiryDates.append( expiryDate );
+    }
+
+    return true;
+}
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 SymbolDatabase::SymbolDatabase( const QString& symbol, QObject *parent ) :
@@ -241,30 +359,26 @@ void SymbolDatabase::futureVolatility( QMap<QDate, FutureVolatilities>& data, co
 
             // ---- //
 
-            static const QString sql( "SELECT * FROM optionChainView "
-                "WHERE DATE(:expirationDate)=DATE(expirationDate) %1 %2 "
-                "ORDER BY stamp DESC" );
-
-            static const QString starting( "AND DATETIME(:start)<=DATETIME(stamp)" );
-            static const QString ending( "AND DATETIME(stamp)<=DATETIME(:end)" );
-
-            static const QString newest( "AND stamp=(SELECT MAX(stamp) FROM optionChainView)" );
+            const bool newest(( !start.isValid() ) && ( !end.isValid() ));
 
             QSqlQuery query( connection() );
             query.setForwardOnly( true );
 
-            if (( !start.isValid() ) && ( !end.isValid() ))
-                query.prepare( sql.arg( newest, QString() ) );
+            if ( newest )
+                query.prepare( SQL_OPTION_CHAIN_VIEW.arg( SQL_STAMP_NEWEST, QString() ) );
             else
-                query.prepare( sql.arg( start.isValid() ? starting : QString(), end.isValid() ? ending : QString() ) );
+                query.prepare( SQL_OPTION_CHAIN_VIEW.arg( start.isValid() ? SQL_STAMP_STARTING : QString(), end.isValid() ? SQL_STAMP_ENDING : QString() ) );
+
+            query.bindValue( ":" + DB_EXPIRY_DATE, toJulianDay( d ) );
 
-            query.bindValue( ":" + DB_EXPIRY_DATE, d.toString( Qt::ISODate ) );
+            if ( newest )
+                query.bindValue( ":" + DB_UNDERLYING, symbol() );
 
             if ( start.isValid() )
-                query.bindValue( ":start", start.toString( Qt::ISODateWithMs ) );
+                query.bindValue( ":start", toEpoch( start ) );
 
             if ( end.isValid() )
-                query.bindValue( ":end", end.toString( Qt::ISODateWithMs ) );
+                query.bindValue( ":end", toEpoch( end ) );
 
             if ( !query.exec() )
             {
@@ -281,7 +395,7 @@ void SymbolDatabase::futureVolatility( QMap<QDate, FutureVolatilities>& data, co
                 while ( query.next() )
                 {
                     const QSqlRecord rec( query.record() );
-                    const QDateTime recStamp( QDateTime::fromString( rec.value( DB_STAMP ).toString(), Qt::ISODateWithMs ) );
+                    const QDateTime recStamp( fromEpoch( rec.value( DB_STAMP ) ) );
 
                     if ( !future.stamp.isValid() )
                     {
@@ -357,7 +471,7 @@ double SymbolDatabase::historicalVolatility( const QDate& date, int depth ) cons
 void SymbolDatabase::historicalVolatilityRange( const QDate& start, const QDate& end, int depth, double& min, double& max ) const
 {
     static const QString sqlDepths( "SELECT DISTINCT depth FROM historicalVolatility "
-        "WHERE DATE(:start)<=DATE(date) AND DATE(date)<=DATE(:end)" );
+        "WHERE :start<=date AND date<=:end" );
 
     QSqlQuery queryDepths( connection() );
     queryDepths.setForwardOnly( true );
@@ -394,8 +508,8 @@ void SymbolDatabase::historicalVolatilityRange( const QDate& start, const QDate&
     // ---- //
 
     static const QString sql( "SELECT * FROM historicalVolatility "
-        "WHERE DATE(:start)<=DATE(date) AND DATE(date)<=DATE(:end) "
-        "ORDER BY DATE(date)" );
+        "WHERE :start<=date AND date<=:end "
+        "ORDER BY date" );
 
     QSqlQuery query( connection() );
     query.setForwardOnly( true );
@@ -479,8 +593,8 @@ void SymbolDatabase::historicalVolatilityRange( const QDate& start, const QDate&
 void SymbolDatabase::historicalVolatilities( const QDate& start, const QDate& end, QList<HistoricalVolatilities>& data ) const
 {
     static const QString sql( "SELECT * FROM historicalVolatility "
-        "WHERE DATE(:start)<=DATE(date) AND DATE(date)<=DATE(:end) "
-        "ORDER BY DATE(date)" );
+        "WHERE :start<=date AND date<=:end "
+        "ORDER BY date" );
 
     QSqlQuery query( connection() );
     query.setForwardOnly( true );
@@ -563,8 +677,8 @@ QDateTime SymbolDatabase::lastQuoteHistoryProcessed() const
 void SymbolDatabase::movingAverages( const QDate& start, const QDate& end, QList<MovingAverages>& data ) const
 {
     static const QString sql( "SELECT * FROM movingAverage "
-        "WHERE DATE(:start)<=DATE(date) AND DATE(date)<=DATE(:end) "
-        "ORDER BY DATE(date)" );
+        "WHERE :start<=date AND date<=:end "
+        "ORDER BY date" );
 
     QSqlQuery query( connection() );
     query.setForwardOnly( true );
@@ -619,8 +733,8 @@ void SymbolDatabase::movingAverages( const QDate& start, const QDate& end, QList
 void SymbolDatabase::movingAveragesConvergenceDivergence( const QDate& start, const QDate& end, QList<MovingAveragesConvergenceDivergence>& data ) const
 {
     static const QString sql( "SELECT * FROM movingAverageConvergenceDivergence "
-        "WHERE DATE(:start)<=DATE(date) AND DATE(date)<=DATE(:end) "
-        "ORDER BY DATE(date)" );
+        "WHERE :start<=date AND date<=:end "
+        "ORDER BY date" );
 
     QSqlQuery query( connection() );
     query.setForwardOnly( true );
@@ -657,22 +771,15 @@ void SymbolDatabase::movingAveragesConvergenceDivergence( const QDate& start, co
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 QDateTime SymbolDatabase::optionChainCurveExpirationDates( QList<QDate>& expiryDates, const QDateTime& start, const QDateTime& end ) const
 {
-    static const QString sql( "SELECT DISTINCT stamp, expirationDate FROM optionChainStrikePrices "
-        "WHERE volatility IS NOT NULL %1 %2 "
-        "ORDER BY stamp DESC" );
-
-    static const QString starting( "AND DATETIME(:start)<=DATETIME(stamp)" );
-    static const QString ending( "AND DATETIME(stamp)<=DATETIME(:end)" );
-
     QSqlQuery query( connection() );
     query.setForwardOnly( true );
-    query.prepare( sql.arg( start.isValid() ? starting : QString(), end.isValid() ? ending : QString() ) );
+    query.prepare( SQL_OPTION_CHAIN_CURVE_EXPIRY_DATES.arg( start.isValid() ? SQL_STAMP_STARTING : QString(), end.isValid() ? SQL_STAMP_ENDING : QString() ) );
 
     if ( start.isValid() )
-        query.bindValue( ":start", start.toString( Qt::ISODateWithMs ) );
+        query.bindValue( ":start", toEpoch( start ) );
 
     if ( end.isValid() )
-        query.bindValue( ":end", end.toString( Qt::ISODateWithMs ) );
+        query.bindValue( ":end", toEpoch( end ) );
 
     if ( !query.exec() )
     {
@@ -683,60 +790,54 @@ QDateTime SymbolDatabase::optionChainCurveExpirationDates( QList<QDate>& expiryD
     }
 
     // extract data
-    QString result;
+    QDateTime result;
 
     while ( query.next() )
     {
         const QSqlRecord rec( query.record() );
 
-        const QString stamp( rec.value( DB_STAMP ).toString() );
-        const QString expiry( rec.value( DB_EXPIRY_DATE ).toString() );
+        const QDateTime stamp( fromEpoch( rec.value( DB_STAMP ) ) );
+        const QDate d( fromJulianDay( rec.value( DB_EXPIRY_DATE ) ) );
 
-        LOG_TRACE << "found analyzed option chain " << qPrintable( symbol() ) << " " << qPrintable( expiry ) << " " << qPrintable( stamp );
+        LOG_TRACE << "found analyzed option chain " << qPrintable( symbol() ) << " " << qPrintable( d.toString( Qt::ISODate ) ) << " " << qPrintable( stamp.toString( Qt::ISODateWithMs ) );
 
         // fetch all expiration dates from same stamp
-        if ( result.isEmpty() )
+        if ( !result.isValid() )
             result = stamp;
         else if ( stamp != result )
             break;
 
-        const QDate d( QDate::fromString( expiry, Qt::ISODate ) );
-
         expiryDates.append( d );
     }
 
     LOG_DEBUG << "found " << expiryDates.size() << " analyzed option chains for " << qPrintable( symbol() );
 
-    return QDateTime::fromString( result, Qt::ISODateWithMs );
+    return result;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 QDateTime SymbolDatabase::optionChainCurves( const QDate& expiryDate, OptionChainCurves& data, const QDateTime& start, const QDateTime& end ) const
 {
-    static const QString sql( "SELECT * FROM optionChainStrikePrices "
-        "WHERE DATE(:expirationDate)=DATE(expirationDate) %1 %2 "
-        "ORDER BY stamp DESC" );
-
-    static const QString starting( "AND DATETIME(:start)<=DATETIME(stamp)" );
-    static const QString ending( "AND DATETIME(stamp)<=DATETIME(:end)" );
-
-    static const QString newest( "AND stamp=(SELECT MAX(stamp) FROM optionChainView)" );
+    const bool newest(( !start.isValid() ) && ( !end.isValid() ));
 
     QSqlQuery query( connection() );
     query.setForwardOnly( true );
 
-    if (( !start.isValid() ) && ( !end.isValid() ))
-        query.prepare( sql.arg( newest, QString() ) );
+    if ( newest )
+        query.prepare( SQL_OPTION_CHAIN_CURVES.arg( SQL_STAMP_NEWEST, QString() ) );
     else
-        query.prepare( sql.arg( start.isValid() ? starting : QString(), end.isValid() ? ending : QString() ) );
+        query.prepare( SQL_OPTION_CHAIN_CURVES.arg( start.isValid() ? SQL_STAMP_STARTING : QString(), end.isValid() ? SQL_STAMP_ENDING : QString() ) );
+
+    query.bindValue( ":" + DB_EXPIRY_DATE, toJulianDay( expiryDate ) );
 
-    query.bindValue( ":" + DB_EXPIRY_DATE, expiryDate.toString( Qt::ISODate ) );
+    if ( newest )
+        query.bindValue( ":" + DB_UNDERLYING, symbol() );
 
     if ( start.isValid() )
-        query.bindValue( ":start", start.toString( Qt::ISODateWithMs ) );
+        query.bindValue( ":start", toEpoch( start ) );
 
     if ( end.isValid() )
-        query.bindValue( ":end", end.toString( Qt::ISODateWithMs ) );
+        query.bindValue( ":end", toEpoch( end ) );
 
     if ( !query.exec() )
     {
@@ -747,15 +848,15 @@ QDateTime SymbolDatabase::optionChainCurves( const QDate& expiryDate, OptionChai
     }
 
     // extract data
-    QString result;
+    QDateTime result;
 
     while ( query.next() )
     {
         const QSqlRecord rec( query.record() );
 
-        const QString stamp( rec.value( DB_STAMP ).toString() );
+        const QDateTime stamp( fromEpoch( rec.value( DB_STAMP ) ) );
 
-        if ( result.isEmpty() )
+        if ( !result.isValid() )
             result = stamp;
         else if ( stamp != result )
             break;
@@ -770,36 +871,32 @@ QDateTime SymbolDatabase::optionChainCurves( const QDate& expiryDate, OptionChai
         data.otmProbability[strikePrice] = rec.value( DB_OTM_PROBABILITY ).toDouble();
     }
 
-    return QDateTime::fromString( result, Qt::ISODateWithMs );
+    return result;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 QDateTime SymbolDatabase::optionChainOpenInterest( const QDate &expiryDate, OptionChainOpenInterest &data, const QDateTime &start, const QDateTime &end ) const
 {
-    static const QString sql( "SELECT * FROM optionChainView "
-        "WHERE DATE(:expirationDate)=DATE(expirationDate) %1 %2 "
-        "ORDER BY stamp DESC" );
-
-    static const QString starting( "AND DATETIME(:start)<=DATETIME(stamp)" );
-    static const QString ending( "AND DATETIME(stamp)<=DATETIME(:end)" );
-
-    static const QString newest( "AND stamp=(SELECT MAX(stamp) FROM optionChainView)" );
+    const bool newest(( !start.isValid() ) && ( !end.isValid() ));
 
     QSqlQuery query( connection() );
     query.setForwardOnly( true );
 
-    if (( !start.isValid() ) && ( !end.isValid() ))
-        query.prepare( sql.arg( newest, QString() ) );
+    if ( newest )
+        query.prepare( SQL_OPTION_CHAIN_VIEW.arg( SQL_STAMP_NEWEST, QString() ) );
     else
-        query.prepare( sql.arg( start.isValid() ? starting : QString(), end.isValid() ? ending : QString() ) );
+        query.prepare( SQL_OPTION_CHAIN_VIEW.arg( start.isValid() ? SQL_STAMP_STARTING : QString(), end.isValid() ? SQL_STAMP_ENDING : QString() ) );
 
-    query.bindValue( ":" + DB_EXPIRY_DATE, expiryDate.toString( Qt::ISODate ) );
+    query.bindValue( ":" + DB_EXPIRY_DATE, toJulianDay( expiryDate ) );
+
+    if ( newest )
+        query.bindValue( ":" + DB_UNDERLYING, symbol() );
 
     if ( start.isValid() )
-        query.bindValue( ":start", start.toString( Qt::ISODateWithMs ) );
+        query.bindValue( ":start", toEpoch( start ) );
 
     if ( end.isValid() )
-        query.bindValue( ":end", end.toString( Qt::ISODateWithMs ) );
+        query.bindValue( ":end", toEpoch( end ) );
 
     if ( !query.exec() )
     {
@@ -815,7 +912,7 @@ QDateTime SymbolDatabase::optionChainOpenInterest( const QDate &expiryDate, Opti
     while ( query.next() )
     {
         const QSqlRecord rec( query.record() );
-        const QDateTime recStamp( QDateTime::fromString( rec.value( DB_STAMP ).toString(), Qt::ISODateWithMs ) );
+        const QDateTime recStamp( fromEpoch( rec.value( DB_STAMP ) ) );
 
         if ( !stamp.isValid() )
             stamp = recStamp;
@@ -837,7 +934,7 @@ QDateTime SymbolDatabase::optionChainOpenInterest( const QDate &expiryDate, Opti
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void SymbolDatabase::quoteHistoryDateRange( QDate& start, QDate& end ) const
 {
-    const QString sql( "SELECT date FROM quoteHistory ORDER BY DATE(date) %1 LIMIT 5" );
+    const QString sql( "SELECT date FROM quoteHistory ORDER BY date %1 LIMIT 5" );
 
     // end date
     QSqlQuery queryEnd( connection() );
@@ -878,8 +975,8 @@ void SymbolDatabase::quoteHistoryDateRange( QDate& start, QDate& end ) const
 void SymbolDatabase::relativeStrengthIndex( const QDate& start, const QDate& end, QList<RelativeStrengthIndexes>& data ) const
 {
     static const QString sql( "SELECT * FROM relativeStrengthIndex "
-        "WHERE DATE(:start)<=DATE(date) AND DATE(date)<=DATE(:end) "
-        "ORDER BY DATE(date)" );
+        "WHERE :start<=date AND date<=:end "
+        "ORDER BY date" );
 
     QSqlQuery query( connection() );
     query.setForwardOnly( true );
@@ -954,9 +1051,9 @@ void SymbolDatabase::setOptionChainCurves( const QDate& expiryDate, const QDateT
 
     foreach ( const double strike, strikes )
     {
-        query.bindValue( ":" + DB_STAMP, stamp.toString( Qt::ISODateWithMs ) );
+        query.bindValue( ":" + DB_STAMP, toEpoch( stamp ) );
         query.bindValue( ":" + DB_UNDERLYING, symbol() );
-        query.bindValue( ":" + DB_EXPIRY_DATE, expiryDate.toString( Qt::ISODate ) );
+        query.bindValue( ":" + DB_EXPIRY_DATE, toJulianDay( expiryDate ) );
         query.bindValue( ":" + DB_STRIKE_PRICE, strike );
 
         if (( data.volatility.contains( strike ) ) && ( 0.0 < data.volatility[strike] ))
@@ -1065,7 +1162,7 @@ bool SymbolDatabase::processInstrument( const QDateTime& stamp, const QJsonObjec
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-bool SymbolDatabase::processOptionChain( const QDateTime& stamp, const QJsonObject& obj, QList<QDate>& expiryDates )
+bool SymbolDatabase::processOptionChain( const QDateTime& stamp, const QJsonObject& obj, QList<QDate>& expiryDates, OptionContractReader *contracts )
 {
     if ( symbol() != obj[DB_UNDERLYING].toString() )
         return false;
@@ -1088,7 +1185,7 @@ bool SymbolDatabase::processOptionChain( const QDateTime& stamp, const QJsonObje
     bool result( true );
 
     // add option chain
-    result &= addOptionChain( stamp, obj, expiryDates );
+    result &= addOptionChain( stamp, obj, expiryDates, contracts );
 
     // add quotes (optional)
     const QJsonObject::const_iterator quotes( obj.constFind( DB_QUOTES ) );
@@ -1190,17 +1287,8 @@ bool SymbolDatabase::processQuoteHistory( const QJsonObject& obj )
 
         LOG_TRACE << "calc historical...";
 
-        // calculate historical volatility
-        calcHistoricalVolatility();
-
-        // calculate moving averages
-        calcMovingAverage();
-
-        // calculate RSI
-        calcRelativeStrengthIndex();
-
-        // calculate MACD
-        calcMovingAverageConvergenceDivergence();
+        // calculate historical volatility, moving averages, RSI, and MACD
+        calcTechnicalIndicators();
     }
 
     // commit to database
@@ -1314,22 +1402,38 @@ bool SymbolDatabase::addFundamental( const QDateTime& stamp, const QJsonObject&
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool SymbolDatabase::addOption( const QJsonObject& obj )
 {
-    QSqlQuery query( connection() );
-    query.prepare( SQL_OPTION );
+    MultiRowInsert queryOption( connection(), SQL_OPTION, OPTION_COLUMNS.size(), 1 );
 
-    return addOption( obj, query );
+    MultiRowInsert::RowValues values;
+    optionValues( obj, AppDatabase::instance()->optionTradeCost(), values );
+
+    return queryOption.addRow( values );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-bool SymbolDatabase::addOption( const QJsonObject& obj, QSqlQuery& query )
+void SymbolDatabase::optionValues( const QJsonObject& obj, double tradeCost, QVector<QVariant>& values ) const
 {
-    const double strikePrice( obj[DB_STRIKE_PRICE].toDouble() );
-    const QString type( obj[DB_TYPE].toString() );
+    values.fill( QVariant(), OPTION_COLUMNS.size() );
+    values[OPTION_UNDERLYING_INDEX] = symbol();
 
-    // bind values to query
-    query.bindValue( ":" + DB_UNDERLYING, symbol() );
+    // bind json fields by column index
+    for ( QJsonObject::const_iterator f( obj.constBegin() ); f != obj.constEnd(); ++f )
+        if (( f->isBool() ) || ( f->isDouble() ) || ( f->isString() ))
+        {
+            const QHash<QString, int>::const_iterator i( OPTION_COLUMN_INDEXES.constFind( f.key() ) );
 
-    bindQueryValues( query, obj );
+            if ( OPTION_COLUMN_INDEXES.constEnd() != i )
+                values[i.value()] = f->toVariant();
+        }
+
+    // store times as epoch values
+    foreach ( const int i, OPTION_TIME_INDEXES )
+    {
+        const QJsonObject::const_iterator t( obj.constFind( OPTION_COLUMNS[i] ) );
+
+        if (( obj.constEnd() != t ) && ( t->isString() ))
+            values[i] = toEpoch( QDateTime::fromString( t->toString(), Qt::ISODateWithMs ) );
+    }
 
     // calculate break even price
     const QJsonObject::const_iterator theoOptionValueIt( obj.constFind( DB_THEO_OPTION_VALUE ) );
@@ -1337,10 +1441,13 @@ bool SymbolDatabase::addOption( const QJsonObject& obj, QSqlQuery& query )
 
     if (( obj.constEnd() != theoOptionValueIt ) && ( obj.constEnd() != multiplierIt ))
     {
+        const double strikePrice( obj[DB_STRIKE_PRICE].toDouble() );
+        const QString type( obj[DB_TYPE].toString() );
+
         const double theoValue( theoOptionValueIt->toDouble() );
         const int multiplier( multiplierIt->toInt() );
 
-        const double premium( (multiplier * theoValue) - AppDatabase::instance()->optionTradeCost() );
+        const double premium( (multiplier * theoValue) - tradeCost );
 
         double breakEven( strikePrice );
 
@@ -1349,23 +1456,51 @@ bool SymbolDatabase::addOption( const QJsonObject& obj, QSqlQuery& query )
         else if ( PUT == type )
             breakEven -= premium / multiplier;
 
-        query.bindValue( ":" + DB_BREAK_EVEN_PRICE, breakEven );
+        values[OPTION_BREAK_EVEN_PRICE_INDEX] = breakEven;
     }
+}
 
-    // exec sql
-    if ( !query.exec() )
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void SymbolDatabase::optionValues( const OptionContract& contract, double tradeCost, QVector<QVariant>& values ) const
+{
+    static const QVector<int> columns( contractColumnIndexes() );
+
+    values.fill( QVariant(), OPTION_COLUMNS.size() );
+    values[OPTION_UNDERLYING_INDEX] = symbol();
+
+    // bind fields by column index
+    for ( int i( 0 ); i < OptionContract::NUM_FIELDS; ++i )
     {
-        const QSqlError e( query.lastError() );
+        const OptionContract::Field f( (OptionContract::Field) i );
 
-        LOG_ERROR << "error during replace " << e.type() << " " << qPrintable( e.text() );
-        return false;
+        if (( contract.has( f ) ) && ( 0 <= columns[f] ))
+            values[columns[f]] = contract.value( f );
     }
 
-    return true;
+    // option stamp is time of quote
+    values[OPTION_STAMP_INDEX] = values[OPTION_QUOTE_TIME_INDEX];
+
+    values[OPTION_BID_ASK_SIZE_INDEX] = QString::number( contract.has( OptionContract::BID_SIZE ) ? contract.bidSize : 0 ) + " x " +
+        QString::number( contract.has( OptionContract::ASK_SIZE ) ? contract.askSize : 0 );
+
+    // calculate break even price
+    if (( contract.has( OptionContract::THEO_OPTION_VALUE ) ) && ( contract.has( OptionContract::MULTIPLIER ) ) && ( contract.multiplier ))
+    {
+        const double premium( (contract.multiplier * contract.theoOptionValue) - tradeCost );
+
+        double breakEven( contract.strikePrice );
+
+        if ( CALL == contract.type )
+            breakEven += premium / contract.multiplier;
+        else if ( PUT == contract.type )
+            breakEven -= premium / contract.multiplier;
+
+        values[OPTION_BREAK_EVEN_PRICE_INDEX] = breakEven;
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-bool SymbolDatabase::addOptionChain( const QDateTime& stamp, const QJsonObject& obj, QList<QDate>& expiryDates )
+bool SymbolDatabase::addOptionChain( const QDateTime& stamp, const QJsonObject& obj, QList<QDate>& expiryDates, OptionContractReader *contracts )
 {
     static const QString sql( "INSERT INTO optionChains (stamp,underlying,"
         "underlyingPrice,interestRate,isDelayed,isIndex,numberOfContracts,volatility) "
@@ -1377,10 +1512,10 @@ bool SymbolDatabase::addOptionChain( const QDateTime& stamp, const QJsonObject&
     QSqlQuery query( conn );
     query.prepare( sql );
 
-    query.bindValue( ":" + DB_STAMP, stamp.toString( Qt::ISODateWithMs ) );
-
     bindQueryValues( query, obj );
 
+    query.bindValue( ":" + DB_STAMP, toEpoch( stamp ) );
+
     // exec sql
     if ( !query.exec() )
     {
@@ -1390,70 +1525,80 @@ bool SymbolDatabase::addOptionChain( const QDateTime& stamp, const QJsonObject&
         return false;
     }
 
-    // iterate options
-    QJsonObject::const_iterator options( obj.constFind( DB_OPTIONS ) );
+    // iterate options (unless streamed)
+    const QJsonObject::const_iterator options( obj.constFind( DB_OPTIONS ) );
 
-    if ( obj.constEnd() == options )
-        return true;
-    else if ( !options->isArray() )
+    if ( !contracts )
     {
-        LOG_WARN << "object is not an array";
-        return false;
+        if ( obj.constEnd() == options )
+            return true;
+        else if ( !options->isArray() )
+        {
+            LOG_WARN << "object is not an array";
+            return false;
+        }
     }
 
     // prepare query objects
-    QSqlQuery queryOption( conn );
-    queryOption.prepare( SQL_OPTION );
+    MultiRowInsert queryOption( conn, SQL_OPTION, OPTION_COLUMNS.size(), OPTION_BATCH_ROWS );
 
-    QSqlQuery queryOptionChainStrikesCall( conn );
-    queryOptionChainStrikesCall.prepare( SQL_OPTION_CHAIN_STRIKES_CALL );
+    MultiRowInsert queryOptionChainStrikesCall( conn, SQL_OPTION_CHAIN_STRIKES.arg( "call" ), 6, OPTION_CHAIN_STRIKES_BATCH_ROWS, SQL_OPTION_CHAIN_STRIKES_UPSERT.arg( "call" ) );
+    MultiRowInsert queryOptionChainStrikesPut( conn, SQL_OPTION_CHAIN_STRIKES.arg( "put" ), 6, OPTION_CHAIN_STRIKES_BATCH_ROWS, SQL_OPTION_CHAIN_STRIKES_UPSERT.arg( "put" ) );
 
-    QSqlQuery queryOptionChainStrikesPut( conn );
-    queryOptionChainStrikesPut.prepare( SQL_OPTION_CHAIN_STRIKES_PUT );
+    const double tradeCost( AppDatabase::instance()->optionTradeCost() );
 
-    // iterate
-    foreach ( const QJsonValue& v, options->toArray() )
-        if ( v.isObject() )
-        {
-            const QJsonObject option( v.toObject() );
+    // expiry dates already known to caller
+    QSet<QDate> expiryDatesSeen;
 
-            const QJsonObject::const_iterator optionStampIt( option.constFind( DB_STAMP ) );
-            const QJsonObject::const_iterator optionSymbolIt( option.constFind( DB_SYMBOL ) );
+    foreach ( const QDate& d, expiryDates )
+        expiryDatesSeen.insert( d );
 
-            const QJsonObject::const_iterator expiryDateIt( option.constFind( DB_EXPIRY_DATE ) );
-            const QJsonObject::const_iterator strikePriceIt( option.constFind( DB_STRIKE_PRICE ) );
-            const QJsonObject::const_iterator typeIt( option.constFind( DB_TYPE ) );
+    MultiRowInsert::RowValues optionRow;
+    MultiRowInsert::RowValues strikeRow( 6 );
 
-            if (( option.constEnd() == optionStampIt ) ||
-                ( option.constEnd() == optionSymbolIt ) ||
-                ( option.constEnd() == expiryDateIt ) ||
-                ( option.constEnd() == strikePriceIt ) ||
-                ( option.constEnd() == typeIt ))
-            {
-                LOG_WARN << "bad or missing value(s)";
-                return false;
-            }
+    strikeRow[0] = toEpoch( stamp );
+    strikeRow[1] = symbol();
 
-            const QDate expiryDate( QDateTime::fromString( expiryDateIt->toString(), Qt::ISODate ).date() );
+    // stream contracts
+    if ( contracts )
+    {
+        OptionContract contract;
 
-            const QString expiry( expiryDate.toString( Qt::ISODate ) );
-            const QString type( typeIt->toString() );
+        while ( contracts->readNext( contract ) )
+        {
+            optionValues( contract, tradeCost, optionRow );
 
-            // add option
-            if ( !addOption( option, queryOption ) )
+            if ( !addOptionChainRow( optionRow, strikeRow, queryOption, queryOptionChainStrikesCall, queryOptionChainStrikesPut, expiryDatesSeen, expiryDates ) )
                 return false;
+        }
 
-            // add strike price to chain
-            else if (( CALL == type ) && ( !addOptionChainStrikePrice( stamp, optionStampIt->toString(), optionSymbolIt->toString(), expiry, strikePriceIt->toDouble(), queryOptionChainStrikesCall ) ))
-                return false;
-            else if (( PUT == type ) && ( !addOptionChainStrikePrice( stamp, optionStampIt->toString(), optionSymbolIt->toString(), expiry, strikePriceIt->toDouble(), queryOptionChainStrikesPut ) ))
-                return false;
+        if ( contracts->hasError() )
+        {
+            LOG_WARN << "error reading option contracts";
+            return false;
+        }
+    }
+
+    // iterate
+    else
+    {
+        foreach ( const QJsonValue& v, options->toArray() )
+            if ( v.isObject() )
+            {
+                optionValues( v.toObject(), tradeCost, optionRow );
 
-            // track expiry dates for caller
-            if ( !expiryDates.contains( expiryDate ) )
-                expiryDates.append( expiryDate );
+                if ( !addOptionChainRow( optionRow, strikeRow, queryOption, queryOptionChainStrikesCall, queryOptionChainStrikesPut, expiryDatesSeen, expiryDates ) )
+                    return false;
+            }
+    }
+
+    // write remaining rows
+    if (( !queryOption.flush() ) || ( !queryOptionChainStrikesCall.flush() ) || ( !queryOptionChainStrikesPut.flush() ))
+        return false;
 
-        } // for each option
+    // point each expiration at this snapshot
+    if ( !updateOptionChainLatest( stamp ) )
+        return false;
 /*
     // FIXME
     // does this need added back in?
@@ -1468,43 +1613,32 @@ bool SymbolDatabase::addOptionChain( const QDateTime& stamp, const QJsonObject&
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool SymbolDatabase::addOptionChainStrikePrice( const QDateTime& stamp, const QString& optionStamp, const QString& optionSymbol, const QString& type, const QString& expiryDate, double strikePrice )
 {
-    QSqlQuery query( connection() );
+    QString column;
 
     if ( CALL == type )
-        query.prepare( SQL_OPTION_CHAIN_STRIKES_CALL );
+        column = "call";
     else if ( PUT == type )
-        query.prepare( SQL_OPTION_CHAIN_STRIKES_PUT );
+        column = "put";
     else
     {
         LOG_WARN << "unknown type " << qPrintable( type );
         return false;
     }
 
-    return addOptionChainStrikePrice( stamp, optionStamp, optionSymbol, expiryDate, strikePrice, query );
-}
-
-///////////////////////////////////////////////////////////////////////////////////////////////////
-bool SymbolDatabase::addOptionChainStrikePrice( const QDateTime& stamp, const QString& optionStamp, const QString& optionSymbol, const QString& expiryDate, double strikePrice, QSqlQuery& query )
-{
-    // bind values to query
-    query.bindValue( ":" + DB_STAMP, stamp.toString( Qt::ISODateWithMs ) );
-    query.bindValue( ":" + DB_UNDERLYING, symbol() );
-    query.bindValue( ":" + DB_EXPIRY_DATE, expiryDate );
-    query.bindValue( ":" + DB_STRIKE_PRICE, strikePrice );
-
-    query.bindValue( ":optionStamp", optionStamp );
-    query.bindValue( ":optionSymbol", optionSymbol );
+    MultiRowInsert query( connection(), SQL_OPTION_CHAIN_STRIKES.arg( column ), 6, 1, SQL_OPTION_CHAIN_STRIKES_UPSERT.arg( column ) );
 
-    // exec sql
-    if ( !query.exec() )
-    {
-        const QSqlError e( query.lastError() );
+    MultiRowInsert::RowValues values( 6 );
+    values[0] = toEpoch( stamp );
+    values[1] = symbol();
+    values[2] = toJulianDay( QDate::fromString( expiryDate, Qt::ISODate ) );
+    values[3] = strikePrice;
+    values[4] = toEpoch( QDateTime::fromString( optionStamp, Qt::ISODateWithMs ) );
+    values[5] = optionSymbol;
 
-        LOG_ERROR << "error during insert " << e.type() << " " << qPrintable( e.text() );
+    if ( !query.addRow( values ) )
         return false;
-    }
 
-    return true;
+    return updateOptionChainLatest( stamp );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1659,7 +1793,7 @@ void SymbolDatabase::updateOptionChainCurves( const QDateTime& stamp )
     query.setForwardOnly( true );
     query.prepare( sql );
 
-    query.bindValue( ":" + DB_STAMP, stamp.toString( Qt::ISODateWithMs ) );
+    query.bindValue( ":" + DB_STAMP, toEpoch( stamp ) );
 
     if ( !query.exec() )
     {
@@ -1747,22 +1881,38 @@ void SymbolDatabase::updateOptionChainCurves( const QDateTime& stamp )
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-QList<QDate> SymbolDatabase::optionExpirationDates( const QDateTime& dt ) const
+bool SymbolDatabase::updateOptionChainLatest( const QDateTime& stamp )
 {
-    static const QString sql( "SELECT DISTINCT expirationDate FROM optionChainStrikePrices "
-        "WHERE DATE(:date)<=DATE(expirationDate) AND DATETIME(stamp)<=DATETIME(:stamp) "
-        "ORDER BY expirationDate ASC" );
+    QSqlQuery query( connection() );
+    query.prepare( SQL_OPTION_CHAIN_LATEST );
+
+    query.bindValue( ":" + DB_STAMP, toEpoch( stamp ) );
+    query.bindValue( ":" + DB_UNDERLYING, symbol() );
+
+    if ( !query.exec() )
+    {
+        const QSqlError e( query.lastError() );
+
+        LOG_ERROR << "error during insert " << e.type() << " " << qPrintable( e.text() );
+        return false;
+    }
+
+    return true;
+}
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QList<QDate> SymbolDatabase::optionExpirationDates( const QDateTime& dt ) const
+{
     assert( dt.isValid() );
 
     QList<QDate> results;
 
     QSqlQuery query( connection() );
     query.setForwardOnly( true );
-    query.prepare( sql );
+    query.prepare( SQL_OPTION_EXPIRY_DATES );
 
-    query.bindValue( ":date", dt.date().toString( Qt::ISODate ) );
-    query.bindValue( ":stamp", dt.toString( Qt::ISODateWithMs ) );
+    query.bindValue( ":date", toJulianDay( dt.date() ) );
+    query.bindValue( ":stamp", toEpoch( dt ) );
 
     if ( !query.exec() )
     {
@@ -1778,7 +1928,7 @@ QList<QDate> SymbolDatabase::optionExpirationDates( const QDateTime& dt ) const
         {
             const QSqlRecord rec( query.record() );
 
-            results.append( QDate::fromString( rec.value( DB_EXPIRY_DATE ).toString(), Qt::ISODate ) );
+            results.append( fromJulianDay( rec.value( DB_EXPIRY_DATE ) ) );
         }
     }
 
@@ -1786,49 +1936,97 @@ QList<QDate> SymbolDatabase::optionExpirationDates( const QDateTime& dt ) const
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-void SymbolDatabase::calcHistoricalVolatility()
+void SymbolDatabase::calcTechnicalIndicators()
 {
     const double annualized( sqrt( AppDatabase::instance()->numTradingDays() ) );
 
     // records for quote history
-    static const QString quoteSql( "UPDATE quoteHistory "
+    static const QString hvQuoteSql( "UPDATE quoteHistory "
         "SET hvDepth=:hvDepth "
             "WHERE date=:date AND symbol=:symbol" );
 
-    QSqlQuery quoteQuery( connection() );
-    quoteQuery.prepare( quoteSql );
+    static const QString maQuoteSql( "UPDATE quoteHistory "
+        "SET maDepth=:maDepth "
+            "WHERE date=:date AND symbol=:symbol" );
+
+    static const QString rsiQuoteSql( "UPDATE quoteHistory "
+        "SET rsiDepth=:rsiDepth "
+            "WHERE date=:date AND symbol=:symbol" );
+
+    static const QString macdQuoteSql( "UPDATE quoteHistory "
+        "SET macd=:macd "
+            "WHERE date=:date AND symbol=:symbol" );
 
     // records for historic volatility
-    static const QString valuesSql( "REPLACE INTO historicalVolatility (date,symbol,depth,"
+    static const QString hvSql( "REPLACE INTO historicalVolatility (date,symbol,depth,"
         "volatility) "
             "VALUES (:date,:symbol,:depth,"
                 ":volatility) " );
 
-    QSqlQuery valuesQuery( connection() );
-    valuesQuery.prepare( valuesSql );
-
-    // historic volatility days
-    QVector<int> hvd;
-    hvd.append( 5 );        // 5d
-    hvd.append( 10 );       // 10d
-    hvd.append( 20 );       // 20d
-    hvd.append( 30 );       // 1m
-    hvd.append( 60 );       // 2m
-    hvd.append( 90 );       // 3m
-    hvd.append( 120 );      // 4m
-    hvd.append( 240 );      // 8m
-    hvd.append( 480 );      // 16m
+    // records for moving averages
+    static const QString maSql( "REPLACE INTO movingAverage (date,symbol,type,depth,"
+        "average) "
+            "VALUES (:date,:symbol,:type,:depth,"
+                ":average) " );
+
+    // records for rsi
+    static const QString rsiSql( "REPLACE INTO relativeStrengthIndex (date,symbol,depth,"
+        "value) "
+            "VALUES (:date,:symbol,:depth,"
+                ":value) " );
+
+    // records for MACD
+    static const QString macdSql( "REPLACE INTO movingAverageConvergenceDivergence (date,symbol,"
+        "ema12,ema26,value,signalValue,diff) "
+            "VALUES (:date,:symbol,"
+                ":ema12,:ema26,:value,:signalValue,:diff) " );
+
+    const QVector<int>& hvd( TechnicalIndicators::historicalVolatilityDepths() );
+    const QVector<int>& mad( TechnicalIndicators::movingAverageDepths() );
+    const QVector<int>& rsid( TechnicalIndicators::relativeStrengthIndexDepths() );
+
+    // batched writes
+    QMap<QString, QVariantList> hvQuote;
+    QMap<QString, QVariantList> maQuote;
+    QMap<QString, QVariantList> rsiQuote;
+    QMap<QString, QVariantList> macdQuote;
+
+    QMap<QString, QVariantList> hv;
+    QMap<QString, QVariantList> ma;
+    QMap<QString, QVariantList> rsi;
+    QMap<QString, QVariantList> macd;
 
     // ---- //
 
     const int rows( quoteHistoryRowCount() );
 
-    static const QString sql( "SELECT * FROM quoteHistory ORDER BY date ASC" );
+    // force update of last N rows
+    const int forced( rows - FORCED_UPDATE );
+
+    // resume from saved state (if possible)
+    TechnicalIndicators ti;
+
+    QString stateDate;
+    int row( 0 );
+
+    if ( !restoreTechnicalIndicators( ti, stateDate, row ) )
+    {
+        LOG_TRACE << "full calculation";
+
+        ti.clear();
+        stateDate.clear();
+        row = 0;
+    }
+
+    static const QString sql( "SELECT date,closePrice,hvDepth,maDepth,rsiDepth,macd FROM quoteHistory "
+        "WHERE date>:date ORDER BY date ASC" );
 
     QSqlQuery query( connection() );
     query.setForwardOnly( true );
+    query.prepare( sql );
+    query.bindValue( ":" + DB_DATE, stateDate );
 
-    if ( !query.exec( sql ) )
+    if ( !query.exec() )
     {
         const QSqlError e( query.lastError() );
 
@@ -1836,556 +2034,253 @@ void SymbolDatabase::calcHistoricalVolatility()
         return;
     }
 
-    // force update of last N rows
-    const int forced( rows - FORCED_UPDATE );
-
-    // calculate returns
-    QVector<double> r;
-    r.reserve( rows );
-
-    int row( 0 );
-    double prevClose( 0.0 );
+    // state is saved at last row before forced rows
+    QByteArray state;
 
     while ( query.next() )
     {
         const QSqlRecord rec( query.record() );
+        const QVariant date( rec.value( DB_DATE ) );
 
-        const double close( rec.value( DB_CLOSE_PRICE ).toDouble() );
+        ti.add( rec.value( DB_CLOSE_PRICE ).toDouble() );
 
-        if (( row ) && ( 0.0 < close ) && ( 0.0 < prevClose ))
+        // historical volatility
         {
-            // calc log of interday return
-            r.append( log( close / prevClose ) );
-
-            // lookup depth of this record
-            bool update( false );
+            // lookup depth of this record, rows without any depth are marked so they are not revisited
+            bool update( rec.isNull( DB_HV_DEPTH ) );
             int depth( 0 );
 
-            if ( !rec.isNull( DB_HV_DEPTH ) )
+            if ( !update )
                 depth = rec.value( DB_HV_DEPTH ).toInt();
 
-            // calc historical volatility for each depth
-            foreach ( int d, hvd )
+            for ( int i( 0 ); (( ti.hasReturn() ) && ( i < hvd.size() )); ++i )
             {
-                if ( r.length() < d )
+                const int d( hvd[i] );
+
+                if ( ti.numReturns() < d )
                     break;
                 else if (( row < forced ) && ( d <= depth ))
                     continue;
 
-                // update
-                valuesQuery.bindValue( ":" + DB_DATE, rec.value( DB_DATE ) );
-                valuesQuery.bindValue( ":" + DB_SYMBOL, symbol() );
-                valuesQuery.bindValue( ":" + DB_DEPTH, d );
-                valuesQuery.bindValue( ":" + DB_VOLATILITY, annualized * Stats::calcStdDeviation( r.mid( r.length() - d ) ) );
-
-                // exec sql
-                if ( !valuesQuery.exec() )
-                {
-                    const QSqlError e( valuesQuery.lastError() );
-
-                    LOG_ERROR << "error during replace " << e.type() << " " << qPrintable( e.text() );
-                }
+                hv[DB_DATE].append( date );
+                hv[DB_DEPTH].append( d );
+                hv[DB_VOLATILITY].append( annualized * ti.historicalVolatility( i ) );
 
                 update = true;
                 depth = d;
             }
 
-            // update record
             if ( update )
             {
-                quoteQuery.bindValue( ":" + DB_DATE, rec.value( DB_DATE ) );
-                quoteQuery.bindValue( ":" + DB_SYMBOL, symbol() );
-                quoteQuery.bindValue( ":" + DB_HV_DEPTH, depth );
-
-                // exec sql
-                if ( !quoteQuery.exec() )
-                {
-                    const QSqlError e( quoteQuery.lastError() );
-
-                    LOG_ERROR << "error during update " << e.type() << " " << qPrintable( e.text() );
-                }
+                hvQuote[DB_DATE].append( date );
+                hvQuote[DB_HV_DEPTH].append( depth );
             }
         }
 
-        ++row;
-        prevClose = close;
-    }
-}
+        // moving averages
+        if ( ti.hasClose() )
+        {
+            bool update( false );
+            int depth( 0 );
 
-///////////////////////////////////////////////////////////////////////////////////////////////////
-void SymbolDatabase::calcMovingAverage()
-{
-    // records for quote history
-    static const QString quoteSql( "UPDATE quoteHistory "
-        "SET maDepth=:maDepth "
-            "WHERE date=:date AND symbol=:symbol" );
+            if ( !rec.isNull( DB_MA_DEPTH ) )
+                depth = rec.value( DB_MA_DEPTH ).toInt();
 
-    QSqlQuery quoteQuery( connection() );
-    quoteQuery.prepare( quoteSql );
+            for ( int i( 0 ); i < mad.size(); ++i )
+            {
+                const int d( mad[i] );
 
-    // records for moving averages
-    static const QString valuesSql( "REPLACE INTO movingAverage (date,symbol,type,depth,"
-        "average) "
-            "VALUES (:date,:symbol,:type,:depth,"
-                ":average) " );
+                if ( ti.numCloses() < d )
+                    break;
+                else if (( row < forced ) && ( d <= depth ))
+                    continue;
 
-    QSqlQuery valuesQuery( connection() );
-    valuesQuery.prepare( valuesSql );
+                // simple moving average
+                ma[DB_DATE].append( date );
+                ma[DB_TYPE].append( SIMPLE );
+                ma[DB_DEPTH].append( d );
+                ma[DB_AVERAGE].append( ti.simpleMovingAverage( i ) );
 
-    // moving average days
-    QVector<int> mad;
-    mad.append( 5 );        // 5d
-    mad.append( 10 );       // 10d
-    mad.append( 15 );       // 15d
-    mad.append( 20 );       // 20d
-    mad.append( 30 );       // 30d
-    mad.append( 50 );       // 50d
-    mad.append( 100 );      // 100d
-    mad.append( 200 );      // 200d
+                // exponential moving average
+                ma[DB_DATE].append( date );
+                ma[DB_TYPE].append( EXPONENTIAL );
+                ma[DB_DEPTH].append( d );
+                ma[DB_AVERAGE].append( ti.exponentialMovingAverage( i ) );
 
-    // ---- //
+                update = true;
+                depth = d;
+            }
 
-    const int rows( quoteHistoryRowCount() );
+            if ( update )
+            {
+                maQuote[DB_DATE].append( date );
+                maQuote[DB_MA_DEPTH].append( depth );
+            }
+        }
 
-    static const QString sql( "SELECT * FROM quoteHistory ORDER BY date ASC" );
+        // relative strength index
+        if ( ti.hasReturn() )
+        {
+            bool update( false );
+            int depth( 0 );
 
-    QSqlQuery query( connection() );
-    query.setForwardOnly( true );
-
-    if ( !query.exec( sql ) )
-    {
-        const QSqlError e( query.lastError() );
-
-        LOG_ERROR << "error during select " << e.type() << " " << qPrintable( e.text() );
-        return;
-    }
-
-    // force update of last N rows
-    const int forced( rows - FORCED_UPDATE );
-
-    // calculate averages
-    QVector<double> a;
-    a.reserve( rows );
-
-    int row( 0 );
-
-    QMap<int, double> ema;
-
-    while ( query.next() )
-    {
-        const QSqlRecord rec( query.record() );
-
-        const double close( rec.value( DB_CLOSE_PRICE ).toDouble() );
-
-        if ( 0.0 < close )
-        {
-            a.append( close );
-
-            // lookup depth of this record
-            bool update( false );
-            int depth( 0 );
-
-            if ( !rec.isNull( DB_MA_DEPTH ) )
-                depth = rec.value( DB_MA_DEPTH ).toInt();
+            if ( !rec.isNull( DB_RSI_DEPTH ) )
+                depth = rec.value( DB_RSI_DEPTH ).toInt();
 
-            // calc moving average for each depth
-            foreach ( int d, mad )
+            for ( int i( 0 ); i < rsid.size(); ++i )
             {
-                if ( a.length() < d )
-                    break;
-
-                // calc ema
-                if ( !ema.contains( d ) )
-                    ema[d] = Stats::calcMean( a.mid( a.length() - d ) ); // use sma
-                else
-                {
-                    const double w( 2.0 / (1.0 + d) );
+                const int d( rsid[i] );
 
-                    ema[d] = close*w + ema[d]*(1.0 - w);
-                }
-
-                // check if this already exists in db
-                if (( row < forced ) && ( d <= depth ))
+                if ( ti.numReturns() < d )
+                    break;
+                else if (( row < forced ) && ( d <= depth ))
                     continue;
 
-                // simple moving average
-                valuesQuery.bindValue( ":" + DB_DATE, rec.value( DB_DATE ) );
-                valuesQuery.bindValue( ":" + DB_SYMBOL, symbol() );
-                valuesQuery.bindValue( ":" + DB_TYPE, SIMPLE );
-                valuesQuery.bindValue( ":" + DB_DEPTH, d );
-                valuesQuery.bindValue( ":" + DB_AVERAGE, Stats::calcMean( a.mid( a.length() - d ) ) );
-
-                // exec sql
-                if ( !valuesQuery.exec() )
-                {
-                    const QSqlError e( valuesQuery.lastError() );
-
-                    LOG_ERROR << "error during replace " << e.type() << " " << qPrintable( e.text() );
-                }
-
-                // exponential moving average
-                valuesQuery.bindValue( ":" + DB_DATE, rec.value( DB_DATE ) );
-                valuesQuery.bindValue( ":" + DB_SYMBOL, symbol() );
-                valuesQuery.bindValue( ":" + DB_TYPE, EXPONENTIAL );
-                valuesQuery.bindValue( ":" + DB_DEPTH, d );
-                valuesQuery.bindValue( ":" + DB_AVERAGE, ema[d] );
-
-                // exec sql
-                if ( !valuesQuery.exec() )
-                {
-                    const QSqlError e( valuesQuery.lastError() );
-
-                    LOG_ERROR << "error during replace " << e.type() << " " << qPrintable( e.text() );
-                }
+                rsi[DB_DATE].append( date );
+                rsi[DB_DEPTH].append( d );
+                rsi[DB_VALUE].append( ti.relativeStrengthIndex( i ) );
 
                 update = true;
                 depth = d;
             }
 
-            // update record
             if ( update )
             {
-                quoteQuery.bindValue( ":" + DB_DATE, rec.value( DB_DATE ) );
-                quoteQuery.bindValue( ":" + DB_SYMBOL, symbol() );
-                quoteQuery.bindValue( ":" + DB_MA_DEPTH, depth );
-
-                // exec sql
-                if ( !quoteQuery.exec() )
-                {
-                    const QSqlError e( quoteQuery.lastError() );
-
-                    LOG_ERROR << "error during update " << e.type() << " " << qPrintable( e.text() );
-                }
+                rsiQuote[DB_DATE].append( date );
+                rsiQuote[DB_RSI_DEPTH].append( depth );
             }
         }
 
-        ++row;
-    }
-}
-
-///////////////////////////////////////////////////////////////////////////////////////////////////
-void SymbolDatabase::calcRelativeStrengthIndex()
-{
-    // records for quote history
-    static const QString quoteSql( "UPDATE quoteHistory "
-        "SET rsiDepth=:rsiDepth "
-            "WHERE date=:date AND symbol=:symbol" );
-
-    QSqlQuery quoteQuery( connection() );
-    quoteQuery.prepare( quoteSql );
-
-    // records for rsi
-    static const QString valuesSql( "REPLACE INTO relativeStrengthIndex (date,symbol,depth,"
-        "value) "
-            "VALUES (:date,:symbol,:depth,"
-                ":value) " );
-
-    QSqlQuery valuesQuery( connection() );
-    valuesQuery.prepare( valuesSql );
-
-    // rsi days
-    QVector<int> rsid;
-    rsid.append( 2 );       // 2d
-    rsid.append( 3 );       // 3d
-    rsid.append( 4 );       // 4d
-    rsid.append( 5 );       // 5d
-    rsid.append( 6 );       // 6d
-    rsid.append( 10 );      // 10d
-    rsid.append( 14 );      // 14d
-    rsid.append( 20 );      // 20d
-    rsid.append( 50 );      // 50d
-
-    // ---- //
-
-    const int rows( quoteHistoryRowCount() );
-
-    static const QString sql( "SELECT * FROM quoteHistory ORDER BY date ASC" );
-
-    QSqlQuery query( connection() );
-    query.setForwardOnly( true );
-
-    if ( !query.exec( sql ) )
-    {
-        const QSqlError e( query.lastError() );
-
-        LOG_ERROR << "error during select " << e.type() << " " << qPrintable( e.text() );
-        return;
-    }
-
-    // force update of last N rows
-    const int forced( rows - FORCED_UPDATE );
-
-    // calculate returns
-    QVector<double> r;
-    r.reserve( rows );
-
-    int row( 0 );
-    double prevClose( 0.0 );
-
-    QMap<int, double> avgGain;
-    QMap<int, double> avgLoss;
-
-    while ( query.next() )
-    {
-        const QSqlRecord rec( query.record() );
-
-        const double close( rec.value( DB_CLOSE_PRICE ).toDouble() );
-
-        if (( row ) && ( 0.0 < close ) && ( 0.0 < prevClose ))
+        // moving average convergence/divergence
+        if (( ti.hasClose() ) && ( ti.hasMovingAverageConvergenceDivergence() ))
         {
-            const double current( close - prevClose );
-
-            // calc returns
-            r.append( current );
-
-            // lookup depth of this record
-            bool update( false );
-            int depth( 0 );
+            bool exists( false );
 
-            if ( !rec.isNull( DB_RSI_DEPTH ) )
-                depth = rec.value( DB_RSI_DEPTH ).toInt();
+            if ( !rec.isNull( DB_MACD ) )
+                exists = rec.value( DB_MACD ).toBool();
 
-            // calc rsi for each depth
-            foreach ( int d, rsid )
+            if (( forced <= row ) || ( !exists ))
             {
-                if ( r.length() < d )
-                    break;
-
-                // average gain/loss
-                if ( !avgGain.contains( d ) )
-                {
-                    double gains( 0.0 );
-                    double losses( 0.0 );
-
-                    // returns for period
-                    const QVector<double> rp( r.mid( r.length() - d ) );
-
-                    foreach ( const double& v, rp )
-                    {
-                        if ( v < 0.0 )
-                            losses += v;
-                        else
-                            gains += v;
-                    }
-
-                    avgGain[d] = gains / d;
-                    avgLoss[d] = std::fabs( losses ) / d;
-                }
-                else
-                {
-                    // loss
-                    if ( current < 0.0 )
-                    {
-                        avgGain[d] = avgGain[d]*(d-1) / d;
-                        avgLoss[d] = (avgLoss[d]*(d-1) + std::fabs( current )) / d;
-                    }
-                    // gain
-                    else
-                    {
-                        avgGain[d] = (avgGain[d]*(d-1) + current) / d;
-                        avgLoss[d] = avgLoss[d]*(d-1) / d;
-                    }
-                }
-
-                // check if this already exists in db
-                if (( row < forced ) && ( d <= depth ))
-                    continue;
-
-                const double rs( avgGain[d] / std::fmax( avgLoss[d], 1.0e-10 ) );
-
-                double index( 100.0 - 100.0 / (1.0+rs) );
-                index = std::fmin( index, 100.0 );
-                index = std::fmax( index, 0.0 );
-
-                // RSI
-                valuesQuery.bindValue( ":" + DB_DATE, rec.value( DB_DATE ) );
-                valuesQuery.bindValue( ":" + DB_SYMBOL, symbol() );
-                valuesQuery.bindValue( ":" + DB_DEPTH, d );
-                valuesQuery.bindValue( ":" + DB_VALUE, index );
-
-                // exec sql
-                if ( !valuesQuery.exec() )
-                {
-                    const QSqlError e( valuesQuery.lastError() );
-
-                    LOG_ERROR << "error during replace " << e.type() << " " << qPrintable( e.text() );
-                }
-
-                update = true;
-                depth = d;
+                macd[DB_DATE].append( date );
+                macd[DB_EMA12].append( ti.macdFast() );
+                macd[DB_EMA26].append( ti.macdSlow() );
+                macd[DB_VALUE].append( ti.macd() );
+                macd[DB_SIGNAL_VALUE].append( ti.macdSignal() );
+                macd[DB_DIFF].append( ti.macd() - ti.macdSignal() );
+
+                macdQuote[DB_DATE].append( date );
+                macdQuote[DB_MACD].append( true );
             }
+        }
 
-            // update record
-            if ( update )
-            {
-                quoteQuery.bindValue( ":" + DB_DATE, rec.value( DB_DATE ) );
-                quoteQuery.bindValue( ":" + DB_SYMBOL, symbol() );
-                quoteQuery.bindValue( ":" + DB_RSI_DEPTH, depth );
-
-                // exec sql
-                if ( !quoteQuery.exec() )
-                {
-                    const QSqlError e( quoteQuery.lastError() );
-
-                    LOG_ERROR << "error during update " << e.type() << " " << qPrintable( e.text() );
-                }
-            }
+        // save state, rows after this one can still change
+        if ( (forced - 1) == row )
+        {
+            state = ti.saveState();
+            stateDate = date.toString();
         }
 
         ++row;
-        prevClose = close;
     }
-}
 
-///////////////////////////////////////////////////////////////////////////////////////////////////
-void SymbolDatabase::calcMovingAverageConvergenceDivergence()
-{
-    // records for quote history
-    static const QString quoteSql( "UPDATE quoteHistory "
-        "SET macd=:macd "
-            "WHERE date=:date AND symbol=:symbol" );
+    // write
+    execBatch( hvSql, hv );
+    execBatch( hvQuoteSql, hvQuote );
 
-    QSqlQuery quoteQuery( connection() );
-    quoteQuery.prepare( quoteSql );
+    execBatch( maSql, ma );
+    execBatch( maQuoteSql, maQuote );
 
-    // records for MACD
-    static const QString valuesSql( "REPLACE INTO movingAverageConvergenceDivergence (date,symbol,"
-        "ema12,ema26,value,signalValue,diff) "
-            "VALUES (:date,:symbol,"
-                ":ema12,:ema26,:value,:signalValue,:diff) " );
+    execBatch( rsiSql, rsi );
+    execBatch( rsiQuoteSql, rsiQuote );
 
-    QSqlQuery valuesQuery( connection() );
-    valuesQuery.prepare( valuesSql );
+    execBatch( macdSql, macd );
+    execBatch( macdQuoteSql, macdQuote );
 
-    // moving average days
-    QVector<int> mad;
-    mad.append( 12 );       // 12d
-    mad.append( 26 );       // 26d
+    // save state
+    if ( state.size() )
+    {
+        writeSetting( INDICATORS_STATE, QString::fromLatin1( state.toBase64() ) );
+        writeSetting( INDICATORS_STATE_DATE, stateDate );
+    }
+}
 
-    // ---- //
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool SymbolDatabase::restoreTechnicalIndicators( TechnicalIndicators& ti, QString& date, int& row ) const
+{
+    QVariant state;
+    QVariant stateDate;
 
-    const int rows( quoteHistoryRowCount() );
+    if (( !readSetting( INDICATORS_STATE, state ) ) || ( !state.isValid() ) ||
+        ( !readSetting( INDICATORS_STATE_DATE, stateDate ) ) || ( !stateDate.isValid() ))
+        return false;
 
-    static const QString sql( "SELECT * FROM quoteHistory ORDER BY date ASC" );
+    // state must end on an existing row and every row up to it must have been processed, history
+    // inserted before the state date forces a full calculation
+    static const QString sql( "SELECT COUNT(*),SUM(date=:date),SUM(hvDepth IS NULL) FROM quoteHistory "
+        "WHERE date<=:date" );
 
     QSqlQuery query( connection() );
     query.setForwardOnly( true );
+    query.prepare( sql );
+    query.bindValue( ":" + DB_DATE, stateDate.toString() );
 
-    if ( !query.exec( sql ) )
+    if ( !query.exec() )
     {
         const QSqlError e( query.lastError() );
 
         LOG_ERROR << "error during select " << e.type() << " " << qPrintable( e.text() );
-        return;
+        return false;
     }
+    else if ( !query.next() )
+        return false;
 
-    // force update of last N rows
-    const int forced( rows - FORCED_UPDATE );
-
-    // calculate averages
-    QVector<double> a;
-    a.reserve( rows );
+    const QSqlRecord rec( query.record() );
 
-    int row( 0 );
-
-    QMap<int, double> ema;
-    QVector<double> macdVals;
+    if (( 1 != rec.value( 1 ).toInt() ) || ( 0 != rec.value( 2 ).toInt() ))
+        return false;
 
-    while ( query.next() )
+    // restore
+    if ( !ti.restoreState( QByteArray::fromBase64( state.toString().toLatin1() ) ) )
     {
-        const QSqlRecord rec( query.record() );
-
-        const double close( rec.value( DB_CLOSE_PRICE ).toDouble() );
-
-        if ( 0.0 < close )
-        {
-            a.append( close );
-
-            // lookup depth of this record
-            bool exists( false );
-
-            if ( !rec.isNull( DB_MACD ) )
-                exists = rec.value( DB_MACD ).toBool();
-
-            // calc moving average for each depth
-            foreach ( int d, mad )
-            {
-                if ( a.length() < d )
-                    break;
-
-                // calc ema
-                if ( !ema.contains( d ) )
-                    ema[d] = Stats::calcMean( a.mid( a.length() - d ) ); // use sma
-                else
-                {
-                    const double w( 2.0 / (1.0 + d) );
-
-                    ema[d] = close*w + ema[d]*(1.0 - w);
-                }
-            }
-
-            // check we can calc MACD
-            if ( !ema.contains( 26 ) )
-                continue;
-
-            const double macd( ema[12] - ema[26] );
+        LOG_WARN << "bad indicator state";
+        return false;
+    }
 
-            // calc ema9 of macd
-            if ( !ema.contains( 9 ) )
-            {
-                macdVals.append( macd );
+    date = stateDate.toString();
+    row = rec.value( 0 ).toInt();
 
-                if ( 9 == macdVals.size() )
-                    ema[9] = Stats::calcMean( macdVals ); // use sma
-                else
-                {
-                    continue;
-                }
-            }
-            else
-            {
-                const double w( 2.0 / (1.0 + 9.0) );
+    return true;
+}
 
-                ema[9] = macd*w + ema[9]*(1.0 - w);
-            }
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool SymbolDatabase::execBatch( const QString& sql, const QMap<QString, QVariantList>& values ) const
+{
+    if ( values.isEmpty() )
+        return true;
 
-            // check if this already exists in db
-            if (( row < forced ) && ( exists ))
-                continue;
-
-            // MACD
-            valuesQuery.bindValue( ":" + DB_DATE, rec.value( DB_DATE ) );
-            valuesQuery.bindValue( ":" + DB_SYMBOL, symbol() );
-            valuesQuery.bindValue( ":" + DB_EMA12, ema[12] );
-            valuesQuery.bindValue( ":" + DB_EMA26, ema[26] );
-            valuesQuery.bindValue( ":" + DB_VALUE, macd );
-            valuesQuery.bindValue( ":" + DB_SIGNAL_VALUE, ema[9] );
-            valuesQuery.bindValue( ":" + DB_DIFF, macd - ema[9] );
-
-            // exec sql
-            if ( !valuesQuery.exec() )
-            {
-                const QSqlError e( valuesQuery.lastError() );
+    // bind symbol for every statement
+    QVariantList symbols;
 
-                LOG_ERROR << "error during replace " << e.type() << " " << qPrintable( e.text() );
-            }
+    while ( symbols.size() < values.first().size() )
+        symbols.append( symbol() );
 
-            // update record
-            quoteQuery.bindValue( ":" + DB_DATE, rec.value( DB_DATE ) );
-            quoteQuery.bindValue( ":" + DB_SYMBOL, symbol() );
-            quoteQuery.bindValue( ":" + DB_MACD, true );
+    QSqlQuery query( connection() );
+    query.prepare( sql );
+    query.bindValue( ":" + DB_SYMBOL, symbols );
 
-            // exec sql
-            if ( !quoteQuery.exec() )
-            {
-                const QSqlError e( quoteQuery.lastError() );
+    for ( QMap<QString, QVariantList>::const_iterator i( values.constBegin() ); i != values.constEnd(); ++i )
+        query.bindValue( ":" + i.key(), i.value() );
 
-                LOG_ERROR << "error during update " << e.type() << " " << qPrintable( e.text() );
-            }
-        }
+    // exec sql
+    if ( !query.execBatch() )
+    {
+        const QSqlError e( query.lastError() );
 
-        ++row;
+        LOG_ERROR << "error during batch " << e.type() << " " << qPrintable( e.text() );
+        return false;
     }
+
+    return true;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -2483,3 +2378,161 @@ void SymbolDatabase::calcDividendFrequencyFromPayDate( const QJsonValue& newValu
         }
     }
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#if defined( QT_DEBUG )
+
+void SymbolDatabase::optionChainIngestPerf( const QString& filename, int loops )
+{
+    static const QString SCRATCH( "INGESTPERF" );
+
+    QFile f( filename );
+
+    if ( !f.open( QIODevice::ReadOnly ) )
+    {
+        LOG_WARN << "failed to open " << qPrintable( filename );
+        return;
+    }
+
+    QJsonObject chain( QJsonDocument::fromJson( f.readAll() ).object() );
+
+    // recorded transform output wraps the chain
+    const QJsonObject::const_iterator optionChainIt( chain.constFind( DB_OPTION_CHAIN ) );
+
+    if (( chain.constEnd() != optionChainIt ) && ( optionChainIt->isObject() ))
+        chain = optionChainIt->toObject();
+
+    const int contracts( chain[DB_OPTIONS].toArray().size() );
+
+    if ( !contracts )
+    {
+        LOG_WARN << "no contracts in " << qPrintable( filename );
+        return;
+    }
+
+    QString cname;
+    QString fname;
+
+    QElapsedTimer t;
+    qint64 nsecs( 0 );
+
+    int ingested( 0 );
+
+    {
+        // scratch database
+        _Myt db( SCRATCH );
+
+        cname = db.connectionNameThread();
+        fname = db.name_;
+
+        QSqlDatabase conn( db.connection() );
+
+        for ( int n( loops ); n--; )
+        {
+            QMutexLocker guard( &db.writer_ );
+
+            if ( !conn.transaction() )
+            {
+                LOG_WARN << "failed to start transaction";
+                break;
+            }
+
+            QList<QDate> expiryDates;
+
+            t.start();
+            const bool result( db.addOptionChain( AppDatabase::instance()->currentDateTime(), chain, expiryDates ) );
+            nsecs += t.nsecsElapsed();
+
+            conn.rollback();
+
+            if ( !result )
+                break;
+
+            ingested += contracts;
+        }
+    }
+
+    // close connection and remove scratch database
+    QSqlDatabase::removeDatabase( cname );
+
+    QFile::remove( fname );
+    QFile::remove( fname + "-shm" );
+    QFile::remove( fname + "-wal" );
+
+    const double secs( nsecs / 1.0e9 );
+
+    LOG_INFO << "ingested " << ingested << " contracts in " << secs << "s";
+
+    if ( 0.0 < secs )
+        LOG_INFO << "ingest rate " << (ingested / secs) << " contracts/sec";
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void SymbolDatabase::validate()
+{
+    static const QString SCRATCH( "QUERYPLAN" );
+
+    QStringList statements;
+    statements.append( SQL_OPTION_CHAIN_LATEST );
+    statements.append( SQL_OPTION_CHAIN_CURVES.arg( SQL_STAMP_NEWEST, QString() ) );
+    statements.append( SQL_OPTION_CHAIN_CURVES.arg( SQL_STAMP_STARTING, SQL_STAMP_ENDING ) );
+    statements.append( SQL_OPTION_CHAIN_VIEW.arg( SQL_STAMP_NEWEST, QString() ) );
+    statements.append( SQL_OPTION_CHAIN_VIEW.arg( SQL_STAMP_STARTING, SQL_STAMP_ENDING ) );
+    statements.append( SQL_OPTION_CHAIN_CURVE_EXPIRY_DATES.arg( SQL_STAMP_STARTING, SQL_STAMP_ENDING ) );
+    statements.append( SQL_OPTION_EXPIRY_DATES );
+
+    // plans do not depend on bound values
+    QMap<QString, QVariant> placeholders;
+    placeholders[":" + DB_EXPIRY_DATE] = 0;
+    placeholders[":" + DB_UNDERLYING] = SCRATCH;
+    placeholders[":" + DB_STAMP] = 0;
+    placeholders[":date"] = 0;
+    placeholders[":start"] = 0;
+    placeholders[":end"] = 0;
+
+    QString cname;
+    QString fname;
+
+    {
+        // scratch database
+        _Myt db( SCRATCH );
+
+        cname = db.connectionNameThread();
+        fname = db.name_;
+
+        foreach ( const QString& sql, statements )
+        {
+            QSqlQuery query( db.connection() );
+            query.setForwardOnly( true );
+            query.prepare( "EXPLAIN QUERY PLAN " + sql );
+
+            for ( QMap<QString, QVariant>::const_iterator i( placeholders.constBegin() ); i != placeholders.constEnd(); ++i )
+                if ( sql.contains( i.key() ) )
+                    query.bindValue( i.key(), i.value() );
+
+            const bool result( query.exec() );
+            Q_ASSERT( result );
+
+            // every table is searched, or scanned in index order
+            while ( query.next() )
+            {
+                const QString detail( query.value( 3 ).toString() );
+
+                if (( detail.startsWith( "SCAN" ) ) && ( !detail.contains( "INDEX" ) ))
+                {
+                    LOG_WARN << "table scan " << qPrintable( detail ) << " in " << qPrintable( sql );
+                    Q_ASSERT( false );
+                }
+            }
+        }
+    }
+
+    // close connection and remove scratch database
+    QSqlDatabase::removeDatabase( cname );
+
+    QFile::remove( fname );
+    QFile::remove( fname + "-shm" );
+    QFile::remove( fname + "-wal" );
+}
+
+#endif
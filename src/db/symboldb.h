@@ -28,9 +28,15 @@
 #include "sqldb.h"
 
 #include <QDate>
+#include <QMap>
 #include <QMutex>
+#include <QVariant>
 
+class OptionContractReader;
 class SymbolDatabases;
+class TechnicalIndicators;
+
+struct OptionContract;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -252,9 +258,10 @@ public slots:
      * @param[in] stamp  data time
      * @param[in] obj  data
      * @param[out] expiryDates  expiration dates added
+     * @param[in,out] contracts  option contracts to read instead of options array of @a obj
      * @return  @c true upon success, @c false otherwise
      */
-    virtual bool processOptionChain( const QDateTime& stamp, const QJsonObject& obj, QList<QDate>& expiryDates );
+    virtual bool processOptionChain( const QDateTime& stamp, const QJsonObject& obj, QList<QDate>& expiryDates, OptionContractReader *contracts = nullptr );
 
     /// Process quote to database.
     /**
@@ -271,6 +278,28 @@ public slots:
      */
     virtual bool processQuoteHistory( const QJsonObject& obj );
 
+    // ========================================================================
+    // Static Methods
+    // ========================================================================
+
+#if defined( QT_DEBUG )
+    /// Measure option chain ingest performance.
+    /**
+     * Chain is written to a scratch database and rolled back after each loop, the scratch database
+     * is removed afterwards.
+     * @param[in] filename  recorded option chain (json)
+     * @param[in] loops  number of times to ingest chain
+     */
+    static void optionChainIngestPerf( const QString& filename, int loops );
+
+    /// Validate query plans.
+    /**
+     * Option chain queries must not scan a table without an index. Plans are checked against a
+     * scratch database that is removed afterwards.
+     */
+    static void validate();
+#endif
+
 protected:
 
     QString symbol_;                                ///< Stock symbol.
@@ -325,22 +354,17 @@ protected:
      */
     virtual bool addOption( const QJsonObject& obj );
 
-    /// Add option to database using prepared query.
-    /**
-     * @param[in] obj  data
-     * @param[in] query  prepared query
-     * @return  @c true upon success, @c false otherwise
-     */
-    virtual bool addOption( const QJsonObject& obj, QSqlQuery& query );
-
     /// Add option chain to database.
     /**
+     * When @a contracts is passed each contract is written as soon as it is read, so only one
+     * batch of rows is held in memory at a time.
      * @param[in] stamp  date time
      * @param[in] obj  data
      * @param[out] expiryDates  expiration dates added
+     * @param[in,out] contracts  option contracts to read instead of options array of @a obj
      * @return  @c true upon success, @c false otherwise
      */
-    virtual bool addOptionChain( const QDateTime& stamp, const QJsonObject& obj, QList<QDate>& expiryDates );
+    virtual bool addOptionChain( const QDateTime& stamp, const QJsonObject& obj, QList<QDate>& expiryDates, OptionContractReader *contracts = nullptr );
 
     /// Add option chain strike price to database.
     /**
@@ -354,18 +378,6 @@ protected:
      */
     virtual bool addOptionChainStrikePrice( const QDateTime& stamp, const QString& optionStamp, const QString& optionSymbol, const QString& type, const QString& expiryDate, double strikePrice );
 
-    /// Add option chain strike price to database using prepared query
-    /**
-     * @param[in] stamp  date time
-     * @param[in] optionStamp  option date time
-     * @param[in] optionSymbol  option symbol
-     * @param[in] expiryDate  expiration date
-     * @param[in] strikePrice  strike price
-     * @param[in] query  prepared query
-     * @return  @c true upon success, @c false otherwise
-     */
-    virtual bool addOptionChainStrikePrice( const QDateTime& stamp, const QString& optionStamp, const QString& optionSymbol, const QString& expiryDate, double strikePrice, QSqlQuery& query );
-
     /// Add quote information.
     /**
      * @param[in] obj  data
@@ -406,20 +418,57 @@ private:
     /// Update option chain curve data.
     void updateOptionChainCurves( const QDateTime& stamp );
 
+    /// Update latest option chain snapshot of each expiration.
+    /**
+     * @param[in] stamp  option chain timestamp
+     * @return  @c true upon success, @c false otherwise
+     */
+    bool updateOptionChainLatest( const QDateTime& stamp );
+
+    /// Retrieve option values in column order.
+    /**
+     * @param[in] obj  option data
+     * @param[in] tradeCost  option trade cost
+     * @param[out] values  values for each column of options table
+     */
+    void optionValues( const QJsonObject& obj, double tradeCost, QVector<QVariant>& values ) const;
+
+    /// Retrieve option values in column order.
+    /**
+     * @param[in] contract  option contract
+     * @param[in] tradeCost  option trade cost
+     * @param[out] values  values for each column of options table
+     */
+    void optionValues( const OptionContract& contract, double tradeCost, QVector<QVariant>& values ) const;
+
     /// Retrieve list of option expiration dates.
     QList<QDate> optionExpirationDates( const QDateTime& dt ) const;
 
-    /// Calculate historical volatility (standard deviation).
-    void calcHistoricalVolatility();
-
-    /// Calculate moving averages.
-    void calcMovingAverage();
+    /// Calculate technical indicators.
+    /**
+     * Historical volatility, moving averages, relative strength index and moving average
+     * convergence/divergence (MACD) are calculated in a single pass over quote history. Indicator
+     * state is saved so the next pass resumes from where this one left off.
+     */
+    void calcTechnicalIndicators();
 
-    /// Calculate relative strength index.
-    void calcRelativeStrengthIndex();
+    /// Restore technical indicator state.
+    /**
+     * @param[out] ti  indicators
+     * @param[out] date  date of last bar in state
+     * @param[out] row  row index of first bar after state
+     * @return  @c true if restored, @c false otherwise
+     */
+    bool restoreTechnicalIndicators( TechnicalIndicators& ti, QString& date, int& row ) const;
 
-    /// Calculate moving average convergence/divergence (MACD).
-    void calcMovingAverageConvergenceDivergence();
+    /// Execute batch of statements.
+    /**
+     * The symbol placeholder is bound automatically.
+     * @param[in] sql  statement
+     * @param[in] values  values to bind by placeholder
+     * @return  @c true upon success, @c false otherwise
+     */
+    bool execBatch( const QString& sql, const QMap<QString, QVariantList>& values ) const;
 
     /// Calculate dividend frequency.
     void calcDividendFrequencyFromDate( const QJsonValue& date );
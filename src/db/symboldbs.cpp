@@ -519,6 +519,34 @@ bool SymbolDatabases::processData( const QJsonObject& obj )
     return result;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool SymbolDatabases::processOptionChain( const QJsonObject& obj, OptionContractReader *contracts )
+{
+    const QDateTime now( AppDatabase::instance()->currentDateTime() );
+
+    const QString symbol( obj[DB_UNDERLYING].toString() );
+
+    QList<QDate> expiryDates;
+
+    bool result( true );
+
+    SymbolDatabase *child( findSymbol( symbol ) );
+
+    if ( child )
+    {
+        SymbolDatabaseRemoveRef deref( symbol );
+        result &= child->processOptionChain( now, obj, expiryDates, contracts );
+    }
+
+    if ( result )
+        emit optionChainChanged( symbol, expiryDates );
+
+    // remove app database connection
+    AppDatabase::instance()->removeConnection();
+
+    return result;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void SymbolDatabases::onTimeout()
 {
@@ -34,6 +34,7 @@
 #include <QObject>
 #include <QSqlDatabase>
 
+class OptionContractReader;
 class SymbolDatabase;
 
 class QJsonObject;
@@ -292,6 +293,15 @@ public slots:
      */
     bool processData( const QJsonObject& obj );
 
+    /// Process option chain to database.
+    /**
+     * Contracts are written as they are read from @a contracts.
+     * @param[in] obj  option chain data (without options)
+     * @param[in,out] contracts  option contracts
+     * @return  @c true upon success, @c false otherwise
+     */
+    bool processOptionChain( const QJsonObject& obj, OptionContractReader *contracts );
+
 private slots:
 
     /// Slot for timeout.
@@ -0,0 +1,114 @@
+/**
+ * @file symbolmarketcontext.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "appdb.h"
+#include "symboldbs.h"
+#include "symbolmarketcontext.h"
+
+#include "../util/yieldcurve.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+SymbolMarketContext::SymbolMarketContext( const QString& symbol, const QList<QDate>& expiryDates, const QSharedPointer<const YieldCurve>& curve ) :
+    symbol_( symbol ),
+    divAmount_( 0.0 ),
+    divFreq_( 0.0 ),
+    divYield_( 0.0 ),
+    numLookups_( 0 )
+{
+    AppDatabase *app( AppDatabase::instance() );
+    SymbolDatabases *dbs( SymbolDatabases::instance() );
+
+    date_ = app->currentDateTime().date();
+
+    // rates come from one curve so every expiration sees the same snapshot
+    const QSharedPointer<const YieldCurve> rates( curve ? curve : app->yieldCurve() );
+
+    // historical volatility depends only on depth, many expirations share one
+    QMap<int, double> histVolatility;
+
+    foreach ( const QDate& expiryDate, expiryDates )
+    {
+        const double daysToExpiry( date_.daysTo( expiryDate ) );
+
+        // ignore expired options
+        if (( daysToExpiry < 0 ) || ( expiry_.contains( expiryDate ) ))
+            continue;
+
+        ExpiryValues v;
+
+        // historical volatility
+        v.tradingDays = app->numTradingDaysBetween( date_, expiryDate );
+        ++numLookups_;
+
+        if ( !histVolatility.contains( v.tradingDays ) )
+        {
+            histVolatility[v.tradingDays] = dbs->historicalVolatility( symbol_, date_, v.tradingDays );
+            ++numLookups_;
+        }
+
+        v.histVolatility = histVolatility[v.tradingDays];
+
+        // risk free rate
+        v.riskFreeRate = rates->rate( daysToExpiry / app->numDays() );
+
+        expiry_[expiryDate] = v;
+    }
+
+    // dividends
+    divAmount_ = dbs->dividendAmount( symbol_, divDate_, divFreq_ );
+    divYield_ = dbs->dividendYield( symbol_ );
+
+    numLookups_ += 2;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void SymbolMarketContext::dividendSchedule( double timeToExpiryYears, std::vector<double>& divTimes, std::vector<double>& divYields, double& totalDivAmount, double& totalDivYield ) const
+{
+    if (( !divDate_.isValid() ) || ( divFreq_ <= 0.0 ) || ( divYield_ <= 0.0 ))
+        return;
+
+    double timeToDivYears = date_.daysTo( divDate_ );
+    timeToDivYears /= AppDatabase::instance()->numDays();
+
+    // make dividend payment in the future
+    if ( timeToDivYears < 0.0 )
+        timeToDivYears += divFreq_;
+
+    if ( timeToDivYears < 0.0 )
+        return;
+
+    // make list of dividend payment dates and yields
+    while ( timeToDivYears < timeToExpiryYears )
+    {
+        const double yield( divYield_ * divFreq_ );
+
+        divTimes.push_back( timeToDivYears );
+        divYields.push_back( yield );
+
+        // accumulate dividend
+        totalDivAmount += (divAmount_ * divFreq_);
+        totalDivYield += yield;
+
+        // next dividend
+        timeToDivYears += divFreq_;
+    }
+}
@@ -0,0 +1,168 @@
+/**
+ * @file symbolmarketcontext.h
+ * Per symbol market data shared by option calculators.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SYMBOLMARKETCONTEXT_H
+#define SYMBOLMARKETCONTEXT_H
+
+#include <QDate>
+#include <QSharedPointer>
+#include <QList>
+#include <QMap>
+#include <QString>
+
+#include <vector>
+
+class YieldCurve;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Per symbol market data shared by option calculators.
+/**
+ * Holds everything an option calculator needs from the databases that depends only on the
+ * underlying and the expiration date: trading days to expiry, historical volatility by depth,
+ * risk free rates by expiry and the dividend schedule. Context is built once per symbol per scan
+ * and is immutable afterwards, so calculators for every expiration can share it across threads.
+ */
+class SymbolMarketContext
+{
+    using _Myt = SymbolMarketContext;
+
+public:
+
+    /// Number of database lookups one calculator performs without a shared context.
+    static constexpr int LOOKUPS_PER_EXPIRY = 5;
+
+    // ========================================================================
+    // CTOR / DTOR
+    // ========================================================================
+
+    /// Constructor.
+    /**
+     * @param[in] symbol  underlying symbol
+     * @param[in] expiryDates  expiration dates to load data for
+     * @param[in] curve  yield curve for risk free rates, or @c null for current curve
+     */
+    SymbolMarketContext( const QString& symbol, const QList<QDate>& expiryDates, const QSharedPointer<const YieldCurve>& curve = QSharedPointer<const YieldCurve>() );
+
+    /// Destructor.
+    ~SymbolMarketContext() {}
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// Check if context has data for expiration date.
+    /**
+     * @param[in] expiryDate  expiration date
+     * @return  @c true if exists, @c false otherwise
+     */
+    bool contains( const QDate& expiryDate ) const {return expiry_.contains( expiryDate );}
+
+    /// Retrieve date context was built for.
+    /**
+     * @return  date
+     */
+    QDate date() const {return date_;}
+
+    /// Retrieve dividend schedule until expiration.
+    /**
+     * @param[in] timeToExpiryYears  time to expiration (years)
+     * @param[out] divTimes  dividend times (years)
+     * @param[out] divYields  dividend yields
+     * @param[out] totalDivAmount  total dividend amount
+     * @param[out] totalDivYield  total dividend yield
+     */
+    void dividendSchedule( double timeToExpiryYears, std::vector<double>& divTimes, std::vector<double>& divYields, double& totalDivAmount, double& totalDivYield ) const;
+
+    /// Retrieve historical volatility for expiration date.
+    /**
+     * @param[in] expiryDate  expiration date
+     * @return  historical volatility
+     */
+    double historicalVolatility( const QDate& expiryDate ) const {return expiry_.value( expiryDate ).histVolatility;}
+
+    /// Retrieve number of database lookups performed to build context.
+    /**
+     * @return  number of lookups
+     */
+    int numLookups() const {return numLookups_;}
+
+    /// Retrieve risk free rate for expiration date.
+    /**
+     * @param[in] expiryDate  expiration date
+     * @return  interest rate
+     */
+    double riskFreeRate( const QDate& expiryDate ) const {return expiry_.value( expiryDate ).riskFreeRate;}
+
+    /// Retrieve symbol.
+    /**
+     * @return  symbol
+     */
+    QString symbol() const {return symbol_;}
+
+    /// Retrieve number of trading days until expiration date.
+    /**
+     * @param[in] expiryDate  expiration date
+     * @return  number of trading days
+     */
+    int tradingDaysToExpiry( const QDate& expiryDate ) const {return expiry_.value( expiryDate ).tradingDays;}
+
+private:
+
+    /// Values for one expiration date.
+    struct ExpiryValues
+    {
+        int tradingDays = 0;                        ///< Trading days until expiration.
+        double histVolatility = 0.0;                ///< Historical volatility for same period.
+        double riskFreeRate = 0.0;                  ///< Risk free rate for same period.
+    };
+
+    QString symbol_;                                ///< Underlying symbol.
+    QDate date_;                                    ///< Date context was built for.
+
+    QMap<QDate, ExpiryValues> expiry_;              ///< Values by expiration date.
+
+    double divAmount_;                              ///< Dividend amount.
+    QDate divDate_;                                 ///< Dividend date.
+    double divFreq_;                                ///< Dividend frequency (years).
+    double divYield_;                               ///< Dividend yield.
+
+    int numLookups_;                                ///< Number of database lookups performed.
+
+    // not implemented
+    SymbolMarketContext( const _Myt& ) = delete;
+
+    // not implemented
+    SymbolMarketContext( const _Myt&& ) = delete;
+
+    // not implemented
+    _Myt &operator = ( const _Myt& ) = delete;
+
+    // not implemented
+    _Myt &operator = ( const _Myt&& ) = delete;
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SYMBOLMARKETCONTEXT_H
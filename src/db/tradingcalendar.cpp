@@ -0,0 +1,303 @@
+/**
+ * @file tradingcalendar.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "tradingcalendar.h"
+
+#include <cassert>
+#include <cmath>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+TradingCalendar::TradingCalendar( const QList<QDate>& goodFriday, const QDate& marketHoursStart ) :
+    goodFriday_( goodFriday ),
+    marketHoursStart_( marketHoursStart )
+{
+    // index every year with a known good friday
+    foreach ( const QDate& d, goodFriday_ )
+    {
+        const QDate yearStart( d.year(), 1, 1 );
+        const QDate yearEnd( d.year(), 12, 31 );
+
+        if (( !first_.isValid() ) || ( yearStart < first_ ))
+            first_ = yearStart;
+        if (( !last_.isValid() ) || ( last_ < yearEnd ))
+            last_ = yearEnd;
+    }
+
+    if ( !first_.isValid() )
+        return;
+
+    const int numDays( first_.daysTo( last_ ) + 1 );
+
+    numTradingDays_.resize( numDays + 1 );
+    numTradingDays_[0] = 0;
+
+    QDate d( first_ );
+
+    for ( int i( 0 ); i < numDays; ++i, d = d.addDays( 1 ) )
+        numTradingDays_[i+1] = numTradingDays_[i] + (isTradingDayRule( d ) ? 1 : 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool TradingCalendar::isMarketOpen( const QDateTime& dt, const QString& marketType, const QString& product, bool *isExtended ) const
+{
+    const QVector<ProductHours> hours( marketHours_.value( dt.date() ).value( marketType ) );
+
+    bool found( false );
+
+    if ( isExtended )
+        (*isExtended) = false;
+
+    foreach ( const ProductHours& h, hours )
+    {
+        if (( product.length() ) && ( product != h.product ))
+            continue;
+
+        found = true;
+
+        if ( !h.isOpen )
+            return false;
+        else if ( !checkSessionHours( dt, marketType, h.product, isExtended ) )
+            return false;
+    }
+
+    return found;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool TradingCalendar::isTradingDay( const QDate& date ) const
+{
+    if (( first_.isValid() ) && ( first_ <= date ) && ( date <= last_ ))
+    {
+        const int i( first_.daysTo( date ) );
+
+        return (numTradingDays_[i] < numTradingDays_[i+1]);
+    }
+
+    return isTradingDayRule( date );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool TradingCalendar::marketHoursExist( const QDate& date, const QString& marketType ) const
+{
+    const QHash<QDate, QHash<QString, QVector<ProductHours>>>::const_iterator i( marketHours_.constFind( date ) );
+
+    if ( marketHours_.constEnd() == i )
+        return false;
+    else if ( marketType.isEmpty() )
+        return !i->isEmpty();
+
+    return i->contains( marketType );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void TradingCalendar::addMarketHours( const QDate& date, const QString& marketType, const QString& product, bool isOpen )
+{
+    ProductHours h;
+    h.product = product;
+    h.isOpen = isOpen;
+
+    marketHours_[date][marketType].append( h );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void TradingCalendar::addSessionHours( const QDate& date, const QString& marketType, const QString& product, const QDateTime& start, const QDateTime& end, bool isExtended )
+{
+    if (( !start.isValid() ) || ( !end.isValid() ))
+        return;
+
+    Session s;
+    s.start = start.toMSecsSinceEpoch();
+    s.end = end.toMSecsSinceEpoch();
+    s.isExtended = isExtended;
+
+    sessionHours_[sessionKey( date, marketType, product )].append( s );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+double TradingCalendar::numTradingDaysBetween( const QDateTime& dt0, const QDateTime& dt ) const
+{
+    // make sure dates are ordered correctly
+    assert( dt0 <= dt );
+
+    // whole days
+    double days( countTradingDays( dt0.date(), dt.date() ) );
+
+    // check for partial day
+    if ( isTradingDay( dt.date() ) )
+    {
+        double hoursRemain( dt0.secsTo( dt ) );
+        hoursRemain /= 3600.0;
+
+        hoursRemain -= 24.0 * std::floor( hoursRemain / 24.0 );
+
+        // TODO: early closures?
+
+        // 6.5 hours in a trading day
+        if ( 6.5 <= hoursRemain )
+            days += 1.0;
+        else
+            days += (hoursRemain / 6.5);
+    }
+
+    return days;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int TradingCalendar::countTradingDays( const QDate& start, const QDate& end ) const
+{
+    int result( 0 );
+
+    QDate d( start );
+
+    // before index
+    for ( ; ( d < end ) && (( !first_.isValid() ) || ( d < first_ )); d = d.addDays( 1 ) )
+        if ( isTradingDayRule( d ) )
+            ++result;
+
+    // within index
+    if (( d < end ) && ( d <= last_ ))
+    {
+        const QDate indexEnd( qMin( end, last_.addDays( 1 ) ) );
+
+        result += numTradingDays_[first_.daysTo( indexEnd )] - numTradingDays_[first_.daysTo( d )];
+
+        d = indexEnd;
+    }
+
+    // after index
+    for ( ; d < end; d = d.addDays( 1 ) )
+        if ( isTradingDayRule( d ) )
+            ++result;
+
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool TradingCalendar::isTradingDayRule( const QDate& now ) const
+{
+    // check day of week
+    // 6 = sat
+    // 7 = sun
+    if ( 6 <= now.dayOfWeek() )
+        return false;
+
+    const bool isMonday( 1 == now.dayOfWeek() );
+    const bool isFriday( 5 == now.dayOfWeek() );
+    const int nthDayOfWeek( std::ceil( now.day() / 7.0 ) );
+
+    const int m( now.month() );
+    const int d( now.day() );
+
+    // new years day
+    if ((  1 == m &&  1 == d ) ||
+        ( 12 == m && 31 == d && isFriday ) ||
+        (  1 == m &&  2 == d && isMonday ))
+        return false;
+
+    // martin luther king jr
+    // third monday in january
+    if ( 1 == m && isMonday && 3 == nthDayOfWeek )
+        return false;
+
+    // presidents day
+    // third monday in february
+    if ( 2 == m && isMonday && 3 == nthDayOfWeek )
+        return false;
+
+    // good friday
+    if ( isFriday )
+        if ( goodFriday_.contains( now ) )
+            return false;
+
+    // memorial day
+    // last monday in may
+    if ( 5 == m && isMonday && 6 == now.addDays( 7 ).month() )
+        return false;
+
+    // juneteenth
+    if (( 6 == m && 19 == d ) ||
+        ( 6 == m && 18 == d && isFriday ) ||
+        ( 6 == m && 20 == d && isMonday ))
+    {
+        if ( 2022 <= now.year() )
+            return false;
+    }
+
+    // independance day
+    if (( 7 == m && 4 == d ) ||
+        ( 7 == m && 3 == d && isFriday ) ||
+        ( 7 == m && 5 == d && isMonday ))
+        return false;
+
+    // labor day
+    // first monday in september
+    if ( 9 == m && isMonday && 1 == nthDayOfWeek )
+        return false;
+
+    // thanksgiving day
+    // fourth thursday in november
+    if ( 11 == m && 4 == now.dayOfWeek() && 4 == nthDayOfWeek )
+        return false;
+
+    // christmas day
+    if (( 12 == m && 25 == d ) ||
+        ( 12 == m && 24 == d && isFriday ) ||
+        ( 12 == m && 26 == d && isMonday ))
+        return false;
+
+    // TODO: check market hours table for closure
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool TradingCalendar::checkSessionHours( const QDateTime& dt, const QString& marketType, const QString& product, bool *isExtended ) const
+{
+    const qint64 t( dt.toMSecsSinceEpoch() );
+
+    bool found( false );
+
+    // sessions can start the evening before
+    for ( int i( -1 ); i <= 0; ++i )
+    {
+        const QVector<Session> sessions( sessionHours_.value( sessionKey( dt.date().addDays( i ), marketType, product ) ) );
+
+        foreach ( const Session& s, sessions )
+        {
+            if (( t < s.start ) || ( s.end < t ))
+                continue;
+
+            found = true;
+
+            if ( isExtended )
+                (*isExtended) |= s.isExtended;
+        }
+    }
+
+    return found;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QString TradingCalendar::sessionKey( const QDate& date, const QString& marketType, const QString& product )
+{
+    return date.toString( Qt::ISODate ) + "/" + marketType + "/" + product;
+}
@@ -0,0 +1,203 @@
+/**
+ * @file tradingcalendar.h
+ * In-memory trading calendar.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TRADINGCALENDAR_H
+#define TRADINGCALENDAR_H
+
+#include <QDate>
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QVector>
+
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// In-memory trading calendar.
+/**
+ * Trading days are indexed with a prefix sum over every date covered by the good friday list, so
+ * counting trading days between two dates is two array lookups. Dates outside the index fall back
+ * to evaluating the holiday rules day by day.
+ *
+ * Market and session hours are loaded from the application database for dates on or after
+ * marketHoursStart(). Once built the calendar is never modified, so it can be shared read-only
+ * between threads.
+ */
+class TradingCalendar
+{
+    using _Myt = TradingCalendar;
+
+public:
+
+    // ========================================================================
+    // CTOR / DTOR
+    // ========================================================================
+
+    /// Constructor.
+    /**
+     * @param[in] goodFriday  list of good friday dates
+     * @param[in] marketHoursStart  first date market hours are loaded for
+     */
+    TradingCalendar( const QList<QDate>& goodFriday, const QDate& marketHoursStart );
+
+    /// Destructor.
+    ~TradingCalendar() {}
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// Check if calendar holds market hours for date.
+    /**
+     * @param[in] date  date
+     * @return  @c true if market hours were loaded for @a date, @c false otherwise
+     */
+    bool hasMarketHours( const QDate& date ) const {return (( marketHoursStart_.isValid() ) && ( marketHoursStart_ <= date ));}
+
+    /// Check if market is open.
+    /**
+     * @param[in] dt  datetime
+     * @param[in] marketType  market type
+     * @param[in] product  product, or empty string for all products
+     * @param[out] isExtended  set to @c true if exteded hours, @c false otherwise
+     * @return  @c true if open, @c flase otherwise
+     */
+    bool isMarketOpen( const QDateTime& dt, const QString& marketType, const QString& product = QString(), bool *isExtended = nullptr ) const;
+
+    /// Check if date is a trading day.
+    /**
+     * @param[in] date  date
+     * @return  @c true if trading day, @c false otherwise
+     */
+    bool isTradingDay( const QDate& date ) const;
+
+    /// Check if market hours exist.
+    /**
+     * @param[in] date  date
+     * @param[in] marketType  market type, or empty string for any market type
+     * @return  @c true if market hours exist, @c false otherwise
+     */
+    bool marketHoursExist( const QDate& date, const QString& marketType = QString() ) const;
+
+    /// Retrieve first date market hours are loaded for.
+    /**
+     * @return  date
+     */
+    QDate marketHoursStart() const {return marketHoursStart_;}
+
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Add market hours.
+    /**
+     * Only used while building the calendar.
+     * @param[in] date  date
+     * @param[in] marketType  market type
+     * @param[in] product  product
+     * @param[in] isOpen  @c true if market is open, @c false otherwise
+     */
+    void addMarketHours( const QDate& date, const QString& marketType, const QString& product, bool isOpen );
+
+    /// Add session hours.
+    /**
+     * Only used while building the calendar.
+     * @param[in] date  date
+     * @param[in] marketType  market type
+     * @param[in] product  product
+     * @param[in] start  session start
+     * @param[in] end  session end
+     * @param[in] isExtended  @c true if extended hours session, @c false otherwise
+     */
+    void addSessionHours( const QDate& date, const QString& marketType, const QString& product, const QDateTime& start, const QDateTime& end, bool isExtended );
+
+    /// Calculate number of trading days between dates.
+    /**
+     * Every trading day before the end date counts as one day. The end date counts as the
+     * fraction of a 6.5 hour session remaining.
+     * @param[in] start  start date
+     * @param[in] end  end date
+     * @return  number of trading days
+     */
+    double numTradingDaysBetween( const QDateTime& start, const QDateTime& end ) const;
+
+private:
+
+    /// Product hours for one day.
+    struct ProductHours
+    {
+        QString product;                            ///< Product.
+        bool isOpen;                                ///< Market is open.
+    };
+
+    /// Session interval.
+    struct Session
+    {
+        qint64 start;                               ///< Session start (ms since epoch).
+        qint64 end;                                 ///< Session end (ms since epoch).
+        bool isExtended;                            ///< Extended hours session.
+    };
+
+    QList<QDate> goodFriday_;                       ///< Good friday dates.
+
+    QDate first_;                                   ///< First date of index.
+    QDate last_;                                    ///< Last date of index.
+
+    std::vector<int> numTradingDays_;               ///< Number of trading days from first date up to (not including) index date.
+
+    QDate marketHoursStart_;                        ///< First date market hours are loaded for.
+
+    QHash<QDate, QHash<QString, QVector<ProductHours>>> marketHours_;   ///< Product hours by date and market type.
+    QHash<QString, QVector<Session>> sessionHours_; ///< Sessions by date, market type and product.
+
+    /// Count trading days in [start, end).
+    int countTradingDays( const QDate& start, const QDate& end ) const;
+
+    /// Check holiday rules for date.
+    bool isTradingDayRule( const QDate& date ) const;
+
+    /// Check session hours.
+    bool checkSessionHours( const QDateTime& dt, const QString& marketType, const QString& product, bool *isExtended ) const;
+
+    /// Generate session hours key.
+    static QString sessionKey( const QDate& date, const QString& marketType, const QString& product );
+
+    // not implemented
+    TradingCalendar( const _Myt& ) = delete;
+
+    // not implemented
+    TradingCalendar( const _Myt&& ) = delete;
+
+    // not implemented
+    _Myt &operator = ( const _Myt& ) = delete;
+
+    // not implemented
+    _Myt &operator = ( const _Myt&& ) = delete;
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // TRADINGCALENDAR_H
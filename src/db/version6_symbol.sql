@@ -0,0 +1,360 @@
+/* ------------------------------------------------------------------------------------------------
+ * store option chain times as integers
+ *
+ * date times become epoch milliseconds and dates become julian day numbers, this lets lookups and
+ * range scans compare raw column values and use the indexes
+ * ------------------------------------------------------------------------------------------------ */
+
+BEGIN TRANSACTION;
+
+DROP VIEW optionChainBidAskView;
+
+DROP VIEW optionChainView;
+
+DROP INDEX optionChainsIdx;
+
+DROP INDEX optionsIdx;
+
+DROP INDEX optionChainStrikePricesIdx;
+
+ALTER TABLE optionChains RENAME TO optionChainsText;
+
+ALTER TABLE options RENAME TO optionsText;
+
+ALTER TABLE optionChainStrikePrices RENAME TO optionChainStrikePricesText;
+
+
+/* ------------------------------------------------------------------------------------------------
+ * option chains
+ * ------------------------------------------------------------------------------------------------ */
+
+/* option chains */
+CREATE TABLE optionChains(
+    stamp                                           integer not null,       /* epoch ms */
+    underlying                                      text not null,
+    underlyingPrice                                 real,
+    interestRate                                    real,
+    isDelayed                                       boolean,
+    isIndex                                         boolean,
+    numberOfContracts                               integer,
+    volatility                                      real,
+    PRIMARY KEY (stamp, underlying) );
+
+CREATE INDEX optionChainsIdx ON optionChains(underlying);
+
+INSERT INTO optionChains
+    SELECT
+        CAST(ROUND((julianday(stamp,'utc')-2440587.5)*86400000.0) AS INTEGER) AS stamp,
+        underlying,
+        underlyingPrice,
+        interestRate,
+        isDelayed,
+        isIndex,
+        numberOfContracts,
+        volatility
+    FROM optionChainsText;
+
+
+/* ------------------------------------------------------------------------------------------------
+ * options
+ * ------------------------------------------------------------------------------------------------ */
+
+/* options */
+CREATE TABLE options(
+    stamp                                           integer not null,       /* epoch ms */
+    symbol                                          text not null,
+    underlying                                      text not null,
+    type                                            text not null,
+    strikePrice                                     real not null,
+    description                                     text,
+    bidAskSize                                      text,
+    bidPrice                                        real,
+    bidSize                                         integer,
+    askPrice                                        real,
+    askSize                                         integer,
+    lastPrice                                       real,
+    lastSize                                        integer,
+    breakEvenPrice                                  real,
+    intrinsicValue                                  real,
+    openPrice                                       real,
+    highPrice                                       real,
+    lowPrice                                        real,
+    closePrice                                      real,
+    change                                          real,
+    percentChange                                   real,
+    totalVolume                                     integer,
+    quoteTime                                       integer,                /* epoch ms */
+    tradeTime                                       integer,                /* epoch ms */
+    mark                                            real,
+    markChange                                      real,
+    markPercentChange                               real,
+    exchangeName                                    text,
+    volatility                                      real,
+    delta                                           real,
+    gamma                                           real,
+    theta                                           real,
+    vega                                            real,
+    rho                                             real,
+    timeValue                                       real,
+    openInterest                                    integer,
+    isInTheMoney                                    boolean,
+    theoreticalOptionValue                          real,
+    theoreticalVolatility                           real,
+    isMini                                          boolean,
+    isNonStandard                                   boolean,
+    isIndex                                         boolean,
+    isWeekly                                        boolean,
+    isQuarterly                                     boolean,
+    expirationDate                                  integer not null,       /* epoch ms */
+    expirationType                                  text,
+    daysToExpiration                                integer,
+    lastTradingDay                                  integer,                /* epoch ms */
+    multiplier                                      integer,
+    settlementType                                  text,
+    deliverableNote                                 text,
+    PRIMARY KEY (stamp, symbol),
+    FOREIGN KEY (type) REFERENCES optionType(type) );
+
+CREATE INDEX optionsIdx ON options(symbol);
+
+INSERT INTO options
+    SELECT
+        CAST(ROUND((julianday(stamp,'utc')-2440587.5)*86400000.0) AS INTEGER) AS stamp,
+        symbol,
+        underlying,
+        type,
+        strikePrice,
+        description,
+        bidAskSize,
+        bidPrice,
+        bidSize,
+        askPrice,
+        askSize,
+        lastPrice,
+        lastSize,
+        breakEvenPrice,
+        intrinsicValue,
+        openPrice,
+        highPrice,
+        lowPrice,
+        closePrice,
+        change,
+        percentChange,
+        totalVolume,
+        CAST(ROUND((julianday(quoteTime,'utc')-2440587.5)*86400000.0) AS INTEGER) AS quoteTime,
+        CAST(ROUND((julianday(tradeTime,'utc')-2440587.5)*86400000.0) AS INTEGER) AS tradeTime,
+        mark,
+        markChange,
+        markPercentChange,
+        exchangeName,
+        volatility,
+        delta,
+        gamma,
+        theta,
+        vega,
+        rho,
+        timeValue,
+        openInterest,
+        isInTheMoney,
+        theoreticalOptionValue,
+        theoreticalVolatility,
+        isMini,
+        isNonStandard,
+        isIndex,
+        isWeekly,
+        isQuarterly,
+        CAST(ROUND((julianday(expirationDate,'utc')-2440587.5)*86400000.0) AS INTEGER) AS expirationDate,
+        expirationType,
+        daysToExpiration,
+        CAST(ROUND((julianday(lastTradingDay,'utc')-2440587.5)*86400000.0) AS INTEGER) AS lastTradingDay,
+        multiplier,
+        settlementType,
+        deliverableNote
+    FROM optionsText;
+
+
+/* ------------------------------------------------------------------------------------------------
+ * option chain strike prices
+ * ------------------------------------------------------------------------------------------------ */
+
+/* strike prices */
+CREATE TABLE optionChainStrikePrices(
+    stamp                                           integer not null,       /* epoch ms */
+    underlying                                      text not null,
+    expirationDate                                  integer not null,       /* julian day */
+    strikePrice                                     real not null,
+    callStamp                                       integer,                /* epoch ms */
+    callSymbol                                      text,
+    putStamp                                        integer,                /* epoch ms */
+    putSymbol                                       text,
+    volatility                                      real,
+    callVolatility                                  real,
+    putVolatility                                   real,
+    itmProbability                                  real,
+    otmProbability                                  real,
+    PRIMARY KEY (stamp, underlying, expirationDate, strikePrice),
+    FOREIGN KEY (stamp, underlying) REFERENCES optionChains(stamp, underlying),
+    FOREIGN KEY (callStamp, callSymbol) REFERENCES options(stamp, symbol),
+    FOREIGN KEY (putStamp, putSymbol) REFERENCES options(stamp, symbol) );
+
+CREATE INDEX optionChainStrikePricesIdx ON optionChainStrikePrices(stamp, underlying, expirationDate);
+
+CREATE INDEX optionChainStrikePricesExpiryIdx ON optionChainStrikePrices(expirationDate, stamp);
+
+INSERT INTO optionChainStrikePrices
+    SELECT
+        CAST(ROUND((julianday(stamp,'utc')-2440587.5)*86400000.0) AS INTEGER) AS stamp,
+        underlying,
+        CAST(julianday(expirationDate)+0.5 AS INTEGER) AS expirationDate,
+        strikePrice,
+        CAST(ROUND((julianday(callStamp,'utc')-2440587.5)*86400000.0) AS INTEGER) AS callStamp,
+        callSymbol,
+        CAST(ROUND((julianday(putStamp,'utc')-2440587.5)*86400000.0) AS INTEGER) AS putStamp,
+        putSymbol,
+        volatility,
+        callVolatility,
+        putVolatility,
+        itmProbability,
+        otmProbability
+    FROM optionChainStrikePricesText;
+
+
+DROP TABLE optionChainStrikePricesText;
+
+DROP TABLE optionsText;
+
+DROP TABLE optionChainsText;
+
+
+/* option chain bid/ask view */
+CREATE VIEW optionChainBidAskView AS
+    SELECT
+        s.stamp,
+        s.underlying,
+        s.expirationDate,
+        c.isInTheMoney AS callIsInTheMoney,
+        c.bidPrice AS callBidPrice,
+        c.askPrice AS callAskPrice,
+        c.bidAskSize AS callBidAskSize,
+        s.strikePrice,
+        p.bidPrice AS putBidPrice,
+        p.askPrice AS putAskPrice,
+        p.bidAskSize AS putBidAskSize,
+        p.isInTheMoney AS putIsInTheMoney
+    FROM optionChainStrikePrices s
+        LEFT JOIN options c ON s.callStamp=c.stamp AND s.callSymbol=c.symbol
+        LEFT JOIN options p ON s.putStamp=p.stamp AND s.putSymbol=p.symbol
+    ORDER BY s.stamp, s.underlying, s.expirationDate, s.strikePrice;
+
+
+/* option chain view */
+CREATE VIEW optionChainView AS
+    SELECT
+        s.stamp,
+        s.underlying,
+        s.expirationDate,
+        /* CALL */
+        s.callSymbol,
+        c.description AS callDescription,
+        c.bidAskSize AS callBidAskSize,
+        c.bidPrice AS callBidPrice,
+        c.bidSize AS callBidSize,
+        c.askPrice AS callAskPrice,
+        c.askSize AS callAskSize,
+        c.lastPrice AS callLastPrice,
+        c.lastSize AS callLastSize,
+        c.breakEvenPrice AS callBreakEvenPrice,
+        c.intrinsicValue AS callIntrinsicValue,
+        c.openPrice AS callOpenPrice,
+        c.highPrice AS callHighPrice,
+        c.lowPrice AS callLowPrice,
+        c.closePrice AS callClosePrice,
+        c.change AS callChange,
+        c.percentChange AS callPercentChange,
+        c.totalVolume AS callTotalVolume,
+        c.quoteTime AS callQuoteTime,
+        c.tradeTime AS callTradeTime,
+        c.mark AS callMark,
+        c.markChange AS callMarkChange,
+        c.markPercentChange AS callMarkPercentChange,
+        c.exchangeName AS callExchangeName,
+        c.volatility AS callVolatility,
+        c.delta AS callDelta,
+        c.gamma AS callGamma,
+        c.theta AS callTheta,
+        c.vega AS callVega,
+        c.rho AS callRho,
+        c.timeValue AS callTimeValue,
+        c.openInterest AS callOpenInterest,
+        c.isInTheMoney AS callIsInTheMoney,
+        c.theoreticalOptionValue AS callTheoreticalOptionValue,
+        c.theoreticalVolatility AS callTheoreticalVolatility,
+        c.isMini AS callIsMini,
+        c.isNonStandard AS callIsNonStandard,
+        c.isIndex AS callIsIndex,
+        c.isWeekly AS callIsWeekly,
+        c.isQuarterly AS callIsQuarterly,
+        c.expirationDate AS callExpirationDate,
+        c.expirationType AS callExpirationType,
+        c.daysToExpiration AS callDaysToExpiration,
+        c.lastTradingDay AS callLastTradingDay,
+        c.multiplier AS callMultiplier,
+        c.settlementType AS callSettlementType,
+        c.deliverableNote AS callDeliverableNote,
+        /* STRIKE */
+        s.strikePrice,
+        /* PUT */
+        s.putSymbol,
+        p.description AS putDescription,
+        p.bidAskSize AS putBidAskSize,
+        p.bidPrice AS putBidPrice,
+        p.bidSize AS putBidSize,
+        p.askPrice AS putAskPrice,
+        p.askSize AS putAskSize,
+        p.lastPrice AS putLastPrice,
+        p.lastSize AS putLastSize,
+        p.breakEvenPrice AS putBreakEvenPrice,
+        p.intrinsicValue AS putIntrinsicValue,
+        p.openPrice AS putOpenPrice,
+        p.highPrice AS putHighPrice,
+        p.lowPrice AS putLowPrice,
+        p.closePrice AS putClosePrice,
+        p.change AS putChange,
+        p.percentChange AS putPercentChange,
+        p.totalVolume AS putTotalVolume,
+        p.quoteTime AS putQuoteTime,
+        p.tradeTime AS putTradeTime,
+        p.mark AS putMark,
+        p.markChange AS putMarkChange,
+        p.markPercentChange AS putMarkPercentChange,
+        p.exchangeName AS putExchangeName,
+        p.volatility AS putVolatility,
+        p.delta AS putDelta,
+        p.gamma AS putGamma,
+        p.theta AS putTheta,
+        p.vega AS putVega,
+        p.rho AS putRho,
+        p.timeValue AS putTimeValue,
+        p.openInterest AS putOpenInterest,
+        p.isInTheMoney AS putIsInTheMoney,
+        p.theoreticalOptionValue AS putTheoreticalOptionValue,
+        p.theoreticalVolatility AS putTheoreticalVolatility,
+        p.isMini AS putIsMini,
+        p.isNonStandard AS putIsNonStandard,
+        p.isIndex AS putIsIndex,
+        p.isWeekly AS putIsWeekly,
+        p.isQuarterly AS putIsQuarterly,
+        p.expirationDate AS putExpirationDate,
+        p.expirationType AS putExpirationType,
+        p.daysToExpiration AS putDaysToExpiration,
+        p.lastTradingDay AS putLastTradingDay,
+        p.multiplier AS putMultiplier,
+        p.settlementType AS putSettlementType,
+        p.deliverableNote AS putDeliverableNote
+    FROM optionChainStrikePrices s
+        LEFT JOIN options c ON s.callStamp=c.stamp AND s.callSymbol=c.symbol
+        LEFT JOIN options p ON s.putStamp=p.stamp AND s.putSymbol=p.symbol
+    ORDER BY s.stamp, s.underlying, s.expirationDate, s.strikePrice;
+
+
+COMMIT;
@@ -0,0 +1,29 @@
+/* ------------------------------------------------------------------------------------------------
+ * latest option chain snapshot of each expiration
+ *
+ * newest snapshot lookups read this table instead of finding MAX(stamp) over every strike price,
+ * it is maintained by ingest
+ * ------------------------------------------------------------------------------------------------ */
+
+BEGIN TRANSACTION;
+
+CREATE TABLE optionChainLatest(
+    underlying                                      text not null,
+    expirationDate                                  integer not null,       /* julian day */
+    stamp                                           integer not null,       /* epoch ms */
+    PRIMARY KEY (underlying, expirationDate) ) WITHOUT ROWID;
+
+INSERT INTO optionChainLatest
+    SELECT underlying, expirationDate, MAX(stamp)
+    FROM optionChainStrikePrices
+    GROUP BY underlying, expirationDate;
+
+
+/* same columns as primary key */
+DROP INDEX optionChainStrikePricesIdx;
+
+/* analyzed snapshots */
+CREATE INDEX optionChainStrikePricesCurvesIdx ON optionChainStrikePrices(stamp, expirationDate) WHERE volatility IS NOT NULL;
+
+
+COMMIT;
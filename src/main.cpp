@@ -22,9 +22,11 @@
 #include "common.h"
 #include "mainwindow.h"
 #include "networkaccess.h"
+#include "scanreplay.h"
 #include "tddaemon.h"
 
 #include "./db/appdb.h"
+#include "./db/symboldb.h"
 #include "./db/symboldbs.h"
 
 #include "./tda/dbadaptertd.h"
@@ -34,11 +36,15 @@
 #include "./usdot/dbadapterusdot.h"
 
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QDateTime>
 #include <QDir>
+#include <QFile>
+#include <QJsonDocument>
 #include <QMessageBox>
 #include <QPalette>
 #include <QSslSocket>
+#include <QTemporaryDir>
 
 #include <QtConcurrent>
 
@@ -123,6 +129,94 @@ void setStyle( QApplication& a, const QString& theme, const QColor& highlight )
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+#if defined( QT_DEBUG )
+
+/// Replay recorded scan and write report.
+/**
+ * Replayed data never touches the user cache, databases are created in @a cacheDir instead.
+ * @param[in] dir  recorded directory
+ * @param[in] cacheDir  directory for replay databases, temporary directory when empty
+ * @param[in] output  report filename, stdout when empty
+ * @return  exit code
+ */
+int replayScan( const QString& dir, const QString& cacheDir, const QString& output )
+{
+    QTemporaryDir tmp;
+
+    QString cache( cacheDir );
+
+    if ( cache.isEmpty() )
+    {
+        if ( !tmp.isValid() )
+        {
+            LOG_FATAL << "failed to make temporary cache dir";
+            return -1;
+        }
+
+        cache = tmp.path();
+    }
+    else if ( QDir( cache ).absolutePath() == QDir( USER_CACHE_DIR ).absolutePath() )
+    {
+        LOG_FATAL << "refusing to replay into user cache dir " << qPrintable( cache );
+        return -1;
+    }
+    else if (( !QDir( cache ).exists() ) && ( !QDir().mkpath( cache ) ))
+    {
+        LOG_FATAL << "failed to make cache dir " << qPrintable( cache );
+        return -1;
+    }
+
+    // must happen before first database instance
+    SqlDatabase::setCacheDir( cache );
+
+    if ( !AppDatabase::instance()->isReady() )
+    {
+        LOG_FATAL << "db not ready!";
+        return -1;
+    }
+
+    ScanReplay replay( dir );
+
+    if ( !replay.run() )
+        return -1;
+
+    const QByteArray report( QJsonDocument( replay.report() ).toJson() );
+
+    // write report
+    QFile f;
+
+    if ( output.isEmpty() )
+    {
+        if ( !f.open( stdout, QIODevice::WriteOnly ) )
+        {
+            LOG_FATAL << "failed to open stdout";
+            return -1;
+        }
+    }
+    else
+    {
+        f.setFileName( output );
+
+        if ( !f.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+        {
+            LOG_FATAL << "failed to open " << qPrintable( output );
+            return -1;
+        }
+    }
+
+    if (( report.size() != f.write( report ) ) || ( !f.flush() ))
+    {
+        LOG_FATAL << "failed to write report " << qPrintable( f.fileName() );
+        return -1;
+    }
+
+    return 0;
+}
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Application entry point.
 int main( int argc, char *argv[] )
 {
@@ -181,6 +275,25 @@ int main( int argc, char *argv[] )
         return -1;
     }
 
+    // increase thread pool size
+    QThreadPool::globalInstance()->setMaxThreadCount( 2 * QThread::idealThreadCount() );
+
+#if defined( QT_DEBUG )
+    // replay recorded scan without network or window, use -platform offscreen to run headless
+    const QCommandLineOption replayOption( "replay", "Replay recorded scan in <dir> and exit.", "dir" );
+    const QCommandLineOption replayCacheOption( "replay-cache", "Store replayed data in <dir>, a temporary directory when omitted.", "dir" );
+    const QCommandLineOption replayOutputOption( "replay-output", "Write replay report to <file>.", "file" );
+
+    QCommandLineParser parser;
+    parser.addOption( replayOption );
+    parser.addOption( replayCacheOption );
+    parser.addOption( replayOutputOption );
+    parser.parse( a.arguments() );
+
+    if ( parser.isSet( replayOption ) )
+        return replayScan( parser.value( replayOption ), parser.value( replayCacheOption ), parser.value( replayOutputOption ) );
+#endif
+
     // init database
     AppDatabase *db( AppDatabase::instance() );
 
@@ -192,12 +305,14 @@ int main( int argc, char *argv[] )
 
     SymbolDatabases *sdbs( SymbolDatabases::instance() );
 
+#if defined( QT_DEBUG )
+    // check option chain query plans
+    SymbolDatabase::validate();
+#endif
+
     // set app sytle
     setStyle( a, db->palette(), db->paletteHighlight() );
 
-    // increase thread pool size
-    QThreadPool::globalInstance()->setMaxThreadCount( 2 * QThread::idealThreadCount() );
-
     // ---- //
 
     NetworkAccess *net( new NetworkAccess );
@@ -227,6 +342,7 @@ int main( int argc, char *argv[] )
 
     QObject::connect( tdaadapter, &TDAmeritradeDatabaseAdapter::transformComplete, db, &AppDatabase::processData, Qt::DirectConnection );
     QObject::connect( tdaadapter, &TDAmeritradeDatabaseAdapter::transformComplete, sdbs, &SymbolDatabases::processData, Qt::DirectConnection );
+    QObject::connect( tdaadapter, &TDAmeritradeDatabaseAdapter::optionChainTransformComplete, sdbs, &SymbolDatabases::processOptionChain, Qt::DirectConnection );
 
     // setup daemon
     [[maybe_unused]] TDAmeritradeDaemon *daemon( new TDAmeritradeDaemon( tda, usdot ) );
@@ -34,12 +34,16 @@
 
 #include "db/appdb.h"
 #include "db/optiontradingitemmodel.h"
+#include "db/symboldb.h"
+
+#include "tda/dbadaptertd.h"
 
 #include "util/tests.h"
 
 #include <QAction>
 #include <QApplication>
 #include <QComboBox>
+#include <QFileDialog>
 #include <QHBoxLayout>
 #include <QInputDialog>
 #include <QLabel>
@@ -148,8 +152,9 @@ void MainWindow::translate()
     helpMenu_->setTitle( tr( "&Help" ) );
     about_->setText( tr( "&About" ) );
     validate_->setText( tr( "&Validate" ) );
-    testPerf_->setText( tr( "Test &Performance" ) );
     testGreeks_->setText( tr( "Test &Option Pricing Methods" ) );
+    testIngest_->setText( tr( "Test Option Chain &Ingest..." ) );
+    testStream_->setText( tr( "Test Option Chain &Stream..." ) );
 
     accountsLabel_->setText( tr( "Account:" ) );
 }
@@ -635,36 +640,60 @@ void MainWindow::onActionTriggered()
 
         QApplication::setOverrideCursor( Qt::WaitCursor );
         validateOptionPricing();
+        SymbolDatabase::validate();
 
         QApplication::restoreOverrideCursor();
 
         LOG_TRACE << "validation... complete";
     }
 
-    // test performance
-    else if ( testPerf_ == sender() )
+    // test options pricing
+    else if ( testGreeks_ == sender() )
     {
-        LOG_TRACE << "test performance...";
+        LOG_TRACE << "test option pricing...";
 
         QApplication::setOverrideCursor( Qt::WaitCursor );
-        optionPricingPerf( 512 );
+        calculatePartials();
 
         QApplication::restoreOverrideCursor();
 
-        LOG_TRACE << "test performance... complete";
+        LOG_TRACE << "test option pricing... complete";
     }
 
-    // test options pricing
-    else if ( testGreeks_ == sender() )
+    // test option chain ingest
+    else if ( testIngest_ == sender() )
     {
-        LOG_TRACE << "test option pricing...";
+        const QString filename( QFileDialog::getOpenFileName( this, tr( "Option Chain" ), QString(), tr( "JSON Files (*.json)" ) ) );
 
-        QApplication::setOverrideCursor( Qt::WaitCursor );
-        calculatePartials();
+        if ( filename.length() )
+        {
+            LOG_TRACE << "test option chain ingest...";
 
-        QApplication::restoreOverrideCursor();
+            QApplication::setOverrideCursor( Qt::WaitCursor );
+            SymbolDatabase::optionChainIngestPerf( filename, 16 );
 
-        LOG_TRACE << "test option pricing... complete";
+            QApplication::restoreOverrideCursor();
+
+            LOG_TRACE << "test option chain ingest... complete";
+        }
+    }
+
+    // test option chain stream
+    else if ( testStream_ == sender() )
+    {
+        const QString filename( QFileDialog::getOpenFileName( this, tr( "Option Chain" ), QString(), tr( "JSON Files (*.json)" ) ) );
+
+        if ( filename.length() )
+        {
+            LOG_TRACE << "test option chain stream...";
+
+            QApplication::setOverrideCursor( Qt::WaitCursor );
+            TDAmeritradeDatabaseAdapter::optionChainStreamPerf( filename, 16 );
+
+            QApplication::restoreOverrideCursor();
+
+            LOG_TRACE << "test option chain stream... complete";
+        }
     }
 #endif
 }
@@ -841,13 +870,15 @@ void MainWindow::initialize()
     about_ = new QAction( QIcon( ":/res/information.png" ), QString(), this );
 
     validate_ = new QAction( QIcon(), QString(), this );
-    testPerf_ = new QAction( QIcon(), QString(), this );
     testGreeks_ = new QAction( QIcon(), QString(), this );
+    testIngest_ = new QAction( QIcon(), QString(), this );
+    testStream_ = new QAction( QIcon(), QString(), this );
 
     connect( about_, &QAction::triggered, this, &_Myt::onActionTriggered );
     connect( validate_, &QAction::triggered, this, &_Myt::onActionTriggered );
-    connect( testPerf_, &QAction::triggered, this, &_Myt::onActionTriggered );
     connect( testGreeks_, &QAction::triggered, this, &_Myt::onActionTriggered );
+    connect( testIngest_, &QAction::triggered, this, &_Myt::onActionTriggered );
+    connect( testStream_, &QAction::triggered, this, &_Myt::onActionTriggered );
 
     helpMenu_ = menuBar()->addMenu( QString() );
     helpMenu_->addAction( about_ );
@@ -855,16 +886,19 @@ void MainWindow::initialize()
 #if defined( QT_DEBUG )
     helpMenu_->addSeparator();
     helpMenu_->addAction( validate_ );
-    helpMenu_->addAction( testPerf_ );
     helpMenu_->addAction( testGreeks_ );
+    helpMenu_->addAction( testIngest_ );
+    helpMenu_->addAction( testStream_ );
 #else
     helpMenu_->addAction( validate_ );
-    helpMenu_->addAction( testPerf_ );
     helpMenu_->addAction( testGreeks_ );
+    helpMenu_->addAction( testIngest_ );
+    helpMenu_->addAction( testStream_ );
 
     validate_->setVisible( false );
-    testPerf_->setVisible( false );
     testGreeks_->setVisible( false );
+    testIngest_->setVisible( false );
+    testStream_->setVisible( false );
 #endif
 
     // status bar
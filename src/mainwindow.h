@@ -148,8 +148,9 @@ private:
     QMenu *helpMenu_;
     QAction *about_;
     QAction *validate_;
-    QAction *testPerf_;
     QAction *testGreeks_;
+    QAction *testIngest_;
+    QAction *testStream_;
 
     QStatusBar *statusBar_;
     QLabel *connectionState_;
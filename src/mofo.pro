@@ -38,19 +38,24 @@ SOURCES += \
     apibase/serializedjsonapi.cpp \
     apibase/serializedxmlapi.cpp \
     calc/expectedvaluecalc.cpp \
-    calc/montecarlocalc.cpp \
     collapsiblesplitter.cpp \
     configdialog.cpp \
     db/appdb.cpp \
+    db/columnartable.cpp \
     db/fundamentalstablemodel.cpp \
     db/itemmodel.cpp \
+    db/multirowinsert.cpp \
+    db/optionchainsnapshot.cpp \
     db/optionchaintablemodel.cpp \
+    db/optioncontract.cpp \
     db/optiontradingitemmodel.cpp \
     db/quotetablemodel.cpp \
     db/sqldb.cpp \
     db/sqltablemodel.cpp \
     db/symboldb.cpp \
     db/symboldbs.cpp \
+    db/symbolmarketcontext.cpp \
+    db/tradingcalendar.cpp \
     filtereditordialog.cpp \
     filtersdialog.cpp \
     filterselectiondialog.cpp \
@@ -61,6 +66,7 @@ SOURCES += \
     hoveritemdelegate.cpp \
     mainwindow.cpp \
     optionanalyzer.cpp \
+    optionanalyzerscheduler.cpp \
     optionanalyzerthread.cpp \
     optionchainimplvolwidget.cpp \
     optionchainopenintwidget.cpp \
@@ -76,12 +82,14 @@ SOURCES += \
     optionviewerwidget.cpp \
     riskfreeinterestratesdialog.cpp \
     riskfreeinterestrateswidget.cpp \
+    scanreplay.cpp \
     symboldetailsdialog.cpp \
     symbolestmovewidget.cpp \
     symbolimplvolwidget.cpp \
     symbolpricehistorywidget.cpp \
     tableheaderitem.cpp \
     tda/dbadaptertd.cpp \
+    tda/optionchainreadertd.cpp \
     tda/tdapi.cpp \
     tda/tdcredentialsdialog.cpp \
     tda/tdoauthapi.cpp \
@@ -93,6 +101,7 @@ SOURCES += \
     util/abstractoptionpricing.cpp \
     util/alttrinomial.cpp \
     util/baroneadesiwhaley.cpp \
+    util/batchnewtonraphson.cpp \
     util/binomial.cpp \
     util/bjerksundstensland02.cpp \
     util/bjerksundstensland93.cpp \
@@ -102,14 +111,22 @@ SOURCES += \
     util/coxrossrubinstein.cpp \
     util/equalprobbinomial.cpp \
     util/fitpoly.cpp \
+    util/jsonstreamreader.cpp \
     util/kamradritchken.cpp \
+    util/latticeworkspace.cpp \
     util/montecarlo.cpp \
     util/newtonraphson.cpp \
     util/phelimboyle.cpp \
+    util/philox.cpp \
+    util/quasimontecarlo.cpp \
     util/rollgeskewhaley.cpp \
+    util/rollingstats.cpp \
+    util/sobol.cpp \
     util/stats.cpp \
+    util/technicalindicators.cpp \
     util/tests.cpp \
     util/trinomial.cpp \
+    util/yieldcurve.cpp \
     watchlistdialog.cpp \
     watchlistselectiondialog.cpp \
     widgetstatesdialog.cpp
@@ -135,10 +152,14 @@ HEADERS += \
     configdialog.h \
     db/appdb.h \
     db/candledata.h \
+    db/columnartable.h \
     db/fundamentalstablemodel.h \
     db/itemmodel.h \
     db/marketproducthours.h \
+    db/multirowinsert.h \
+    db/optionchainsnapshot.h \
     db/optionchaintablemodel.h \
+    db/optioncontract.h \
     db/optiondata.h \
     db/optiontradingitemmodel.h \
     db/quotetablemodel.h \
@@ -147,6 +168,8 @@ HEADERS += \
     db/stringsdb.h \
     db/symboldb.h \
     db/symboldbs.h \
+    db/symbolmarketcontext.h \
+    db/tradingcalendar.h \
     filtereditordialog.h \
     filtersdialog.h \
     filterselectiondialog.h \
@@ -157,6 +180,7 @@ HEADERS += \
     hoveritemdelegate.h \
     mainwindow.h \
     optionanalyzer.h \
+    optionanalyzerscheduler.h \
     optionanalyzerthread.h \
     optionchainimplvolwidget.h \
     optionchainopenintwidget.h \
@@ -172,12 +196,14 @@ HEADERS += \
     optionviewerwidget.h \
     riskfreeinterestratesdialog.h \
     riskfreeinterestrateswidget.h \
+    scanreplay.h \
     symboldetailsdialog.h \
     symbolestmovewidget.h \
     symbolimplvolwidget.h \
     symbolpricehistorywidget.h \
     tableheaderitem.h \
     tda/dbadaptertd.h \
+    tda/optionchainreadertd.h \
     tda/stringsjson.h \
     tda/stringsoauth.h \
     tda/tdapi.h \
@@ -193,6 +219,7 @@ HEADERS += \
     util/altbisection.h \
     util/alttrinomial.h \
     util/baroneadesiwhaley.h \
+    util/batchnewtonraphson.h \
     util/binomial.h \
     util/bisection.h \
     util/bjerksundstensland02.h \
@@ -202,15 +229,23 @@ HEADERS += \
     util/dualmodeoptionpricing.h \
     util/equalprobbinomial.h \
     util/fitpoly.h \
+    util/jsonstreamreader.h \
     util/kamradritchken.h \
+    util/latticeworkspace.h \
     util/montecarlo.h \
     util/newtonraphson.h \
     util/optiontype.h \
     util/phelimboyle.h \
+    util/philox.h \
+    util/quasimontecarlo.h \
     util/rollgeskewhaley.h \
+    util/rollingstats.h \
+    util/sobol.h \
     util/stats.h \
+    util/technicalindicators.h \
     util/tests.h \
     util/trinomial.h \
+    util/yieldcurve.h \
     watchlistdialog.h \
     watchlistselectiondialog.h \
     widgetstatesdialog.h
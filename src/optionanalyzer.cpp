@@ -22,7 +22,7 @@
 #include "abstractdaemon.h"
 #include "common.h"
 #include "optionanalyzer.h"
-#include "optionanalyzerthread.h"
+#include "optionanalyzerscheduler.h"
 
 #include "db/appdb.h"
 #include "db/optiontradingitemmodel.h"
@@ -39,6 +39,7 @@ OptionAnalyzer::OptionAnalyzer( model_type *model, QObject *parent ) :
     _Mybase( parent ),
     active_( false ),
     analysis_( model ),
+    scheduler_( nullptr ),
     halt_( false ),
     throttle_( false ),
 #ifdef Q_OS_WINDOWS
@@ -46,9 +47,15 @@ OptionAnalyzer::OptionAnalyzer( model_type *model, QObject *parent ) :
     prevKernelTime_( 0 ),
     prevUserTime_( 0 ),
 #endif
-    workers_( 0 ),
-    maxWorkers_( 4 * QThread::idealThreadCount() )
+    numSymbols_( 0 ),
+    numSymbolsComplete_( 0 ),
+    maxQueueDepth_( 4 * QThread::idealThreadCount() )
 {
+    // fixed pool of workers for analysis
+    scheduler_ = new OptionAnalyzerScheduler( analysis_, QThread::idealThreadCount(), this );
+
+    connect( scheduler_, &OptionAnalyzerScheduler::symbolComplete, this, &_Myt::onSymbolComplete );
+
     // connect signals/slots
     connect( AbstractDaemon::instance(), &AbstractDaemon::optionChainBackgroundProcess, this, &_Myt::onOptionChainBackgroundProcess );
     connect( AbstractDaemon::instance(), &AbstractDaemon::optionChainUpdated, this, &_Myt::onOptionChainUpdated );
@@ -71,7 +78,19 @@ QString OptionAnalyzer::filter() const
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool OptionAnalyzer::isActive() const
 {
-    return (( active_ ) || ( numThreadsComplete_ < numThreads_ ) || ( symbols_.length() ));
+    return (( active_ ) || ( numSymbolsComplete_ < numSymbols_ ) || ( symbols_.length() ));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int OptionAnalyzer::numSteals() const
+{
+    return scheduler_->numSteals();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int OptionAnalyzer::queueDepth() const
+{
+    return scheduler_->queueDepth();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -80,14 +99,11 @@ void OptionAnalyzer::halt()
     // set halt flag
     halt_ = true;
 
-    // halt each thread
-    const QList<OptionAnalyzerThread*> workers( findChildren<OptionAnalyzerThread*>() );
+    // halt workers
+    scheduler_->halt();
 
-    foreach ( OptionAnalyzerThread *worker, workers )
-        worker->halt();
-
-    // wait for analysis threads to complete
-    while (( active_ ) || ( numThreadsComplete_ < numThreads_ ))
+    // wait for analysis tasks to drain
+    while (( active_ ) || ( numSymbolsComplete_ < numSymbols_ ))
     {
         static const QEventLoop::ProcessEventsFlags flags( QEventLoop::AllEvents | QEventLoop::WaitForMoreEvents );
 
@@ -114,9 +130,11 @@ void OptionAnalyzer::onOptionChainBackgroundProcess( bool active, const QStringL
         symbolsTotal_ = symbols_.size();
 
         // reset progress
-        numThreads_ = numThreadsComplete_ = 0;
+        numSymbols_ = numSymbolsComplete_ = 0;
         progress_ = 0.0;
 
+        scheduler_->reset();
+
         // record start time
         start_ = QDateTime::currentDateTime();
     }
@@ -160,7 +178,7 @@ void OptionAnalyzer::onOptionChainUpdated( const QString& symbol, const QList<QD
 
     symbols_.removeOne( symbol );
 
-    // create thread(s) for analysis
+    // queue symbol for analysis
     LOG_INFO << "processing " << qPrintable( symbol ) << " " << expiryDates.size() << " chains...";
     LOG_DEBUG << symbols_.size() << " symbols remaining...";
 
@@ -169,33 +187,22 @@ void OptionAnalyzer::onOptionChainUpdated( const QString& symbol, const QList<QD
         updateStatus( false );
     else
     {
-        // create worker thread
-        OptionAnalyzerThread *worker( new OptionAnalyzerThread( symbol, expiryDates, analysis_, this ) );
-        worker->setFilter( filter() );
+        scheduler_->submit( symbol, expiryDates, filter() );
 
-        connect( worker, &QThread::finished, this, &_Myt::onWorkerFinished );
-
-        // start work!
-        worker->start();
-
-        ++numThreads_;
-        ++workers_;
+        ++numSymbols_;
     }
 
-    LOG_DEBUG << "workers started";
+    LOG_DEBUG << "queue depth " << scheduler_->queueDepth();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-void OptionAnalyzer::onWorkerFinished()
+void OptionAnalyzer::onSymbolComplete()
 {
-    sender()->deleteLater();
-    --workers_;
-
-    ++numThreadsComplete_;
+    ++numSymbolsComplete_;
 
     // unthrottle cpu
     if (( THROTTLE ) && ( throttle_ ))
-        if (( workers_ < QThread::idealThreadCount() ) || ( !needToThrottle() ))
+        if (( scheduler_->queueDepth() < scheduler_->numWorkers() ) || ( !needToThrottle() ))
         {
             LOG_TRACE << "restore workers...";
             AbstractDaemon::instance()->setPaused( (throttle_ = false) );
@@ -232,8 +239,9 @@ void OptionAnalyzer::updateStatus( bool force )
 
         const double totalTime( start_.secsTo( stop_ ) / 60.0 );
 
-        LOG_INFO << "scanned " << symbolsTotal_ << " symbols with " << numThreadsComplete_ << " total expirations in " << totalTime << " minutes (" << THROTTLE << ")";
-        LOG_DEBUG << "average time per expiration " << (double) numThreadsComplete_ / start_.secsTo( stop_ ) << " sec (" << THROTTLE << ")";
+        LOG_INFO << "scanned " << symbolsTotal_ << " symbols with " << numSymbolsComplete_ << " analyzed in " << totalTime << " minutes (" << THROTTLE << ")";
+        LOG_DEBUG << "average time per symbol " << (double) numSymbolsComplete_ / start_.secsTo( stop_ ) << " sec (" << THROTTLE << ")";
+        LOG_DEBUG << "workers " << scheduler_->numWorkers() << " steals " << scheduler_->numSteals();
 
         emit statusMessageChanged( message.arg( stop_.toString() ).arg( f ).arg( symbolsTotal_ ).arg( totalTime, 0, 'f', 2 ) );
         emit complete();
@@ -243,7 +251,7 @@ void OptionAnalyzer::updateStatus( bool force )
     else
     {
         double currentProgress( 100.0 );
-        currentProgress = qMin( currentProgress, (100.0 * numThreadsComplete_) / (double) numThreads_ );
+        currentProgress = qMin( currentProgress, (100.0 * numSymbolsComplete_) / (double) numSymbols_ );
         currentProgress = qMin( currentProgress, (100.0 * (symbolsTotal_ - symbols_.size())) / (double) symbolsTotal_ );
 
         // update message
@@ -261,7 +269,9 @@ void OptionAnalyzer::updateStatus( bool force )
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool OptionAnalyzer::needToThrottle() const
 {
-    if ( workers_ < QThread::idealThreadCount() )
+    const int depth( scheduler_->queueDepth() );
+
+    if ( depth < scheduler_->numWorkers() )
         return false;
 
 #ifdef Q_OS_WINDOWS
@@ -269,7 +279,7 @@ bool OptionAnalyzer::needToThrottle() const
         return true;
 #endif
 
-    return ( maxWorkers_ <= workers_ );
+    return ( maxQueueDepth_ <= depth );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -27,6 +27,7 @@
 #include <QList>
 #include <QObject>
 
+class OptionAnalyzerScheduler;
 class OptionTradingItemModel;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -82,6 +83,18 @@ public:
      */
     virtual model_type *model() const {return analysis_;}
 
+    /// Retrieve number of tasks stolen between workers.
+    /**
+     * @return  number of steals
+     */
+    virtual int numSteals() const;
+
+    /// Retrieve number of tasks waiting for a worker.
+    /**
+     * @return  queue depth
+     */
+    virtual int queueDepth() const;
+
     /// Set custom filter.
     /**
      * @param[in] value  filter name
@@ -124,6 +137,7 @@ protected:
     QStringList symbols_;                           ///< Symbols being processed.
 
     model_type *analysis_;                          ///< Trading model.
+    OptionAnalyzerScheduler *scheduler_;            ///< Analysis scheduler.
 
     QString customFilter_;                          ///< Custom filter.
 
@@ -138,8 +152,8 @@ private slots:
     /// Slot for option chain updated.
     void onOptionChainUpdated( const QString& symbol, const QList<QDate>& expiryDates, bool background );
 
-    /// Slot for worker finished.
-    void onWorkerFinished();
+    /// Slot for symbol analysis complete.
+    void onSymbolComplete();
 
 private:
 
@@ -156,13 +170,12 @@ private:
 
     int symbolsTotal_;
 
-    int numThreads_;
-    int numThreadsComplete_;
+    int numSymbols_;
+    int numSymbolsComplete_;
 
     double progress_;
 
-    int workers_;
-    int maxWorkers_;
+    int maxQueueDepth_;
 
     QDateTime start_;
     QDateTime stop_;
@@ -0,0 +1,200 @@
+/**
+ * @file optionanalyzerscheduler.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common.h"
+#include "optionanalyzerscheduler.h"
+#include "optionanalyzerthread.h"
+
+#include "db/appdb.h"
+
+#include <QMutexLocker>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+OptionAnalyzerScheduler::OptionAnalyzerScheduler( model_type *model, int numWorkers, QObject *parent ) :
+    _Mybase( parent ),
+    analysis_( model ),
+    queued_( 0 ),
+    steals_( 0 ),
+    halt_( 0 ),
+    quit_( false ),
+    nextWorker_( 0 ),
+    nextId_( 0 )
+{
+    assert( 0 < numWorkers );
+
+    // create workers
+    for ( int i( 0 ); i < numWorkers; ++i )
+    {
+        queues_.append( new WorkerQueue );
+        workers_.append( new OptionAnalyzerThread( i, this ) );
+    }
+
+    // start work!
+    foreach ( OptionAnalyzerThread *worker, workers_ )
+        worker->start();
+
+    LOG_DEBUG << "started " << numWorkers << " analysis workers";
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+OptionAnalyzerScheduler::~OptionAnalyzerScheduler()
+{
+    halt();
+
+    // wake workers so they exit
+    {
+        QMutexLocker guard( &waitMutex_ );
+
+        quit_ = true;
+        wait_.wakeAll();
+    }
+
+    foreach ( OptionAnalyzerThread *worker, workers_ )
+    {
+        worker->wait();
+        delete worker;
+    }
+
+    qDeleteAll( queues_ );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void OptionAnalyzerScheduler::halt()
+{
+    halt_.storeRelease( 1 );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool OptionAnalyzerScheduler::next( int worker, task_type& task )
+{
+    for ( ;; )
+    {
+        if (( pop( worker, task ) ) || ( steal( worker, task ) ))
+            return true;
+
+        QMutexLocker guard( &waitMutex_ );
+
+        if ( quit_ )
+            return false;
+
+        // nothing queued, sleep until something is pushed
+        if ( !queued_.loadAcquire() )
+            wait_.wait( &waitMutex_ );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void OptionAnalyzerScheduler::push( int worker, const task_type& task )
+{
+    WorkerQueue *q( queues_[worker] );
+
+    {
+        QMutexLocker guard( &q->m );
+        q->tasks.push_back( task );
+    }
+
+    queued_.ref();
+
+    // wake a sleeping worker
+    QMutexLocker guard( &waitMutex_ );
+    wait_.wakeOne();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void OptionAnalyzerScheduler::reset()
+{
+    halt_.storeRelease( 0 );
+    steals_.storeRelease( 0 );
+
+    yieldCurve_ = AppDatabase::instance()->yieldCurve();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int OptionAnalyzerScheduler::submit( const QString& symbol, const QList<QDate>& expiryDates, const QString& filter )
+{
+    task_type task;
+    task.id = nextId_++;
+    task.symbol = symbol;
+    task.filter = filter;
+    task.expiryDates = expiryDates;
+    task.underlying = 0.0;
+    task.yieldCurve = yieldCurve_;
+    task.pending.reset( new QAtomicInt( 1 ) );
+
+    // spread symbols across workers
+    push( nextWorker_, task );
+
+    nextWorker_ = (nextWorker_ + 1) % workers_.size();
+
+    return task.id;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void OptionAnalyzerScheduler::taskComplete( const task_type& task )
+{
+    // last task for symbol
+    if ( !task.pending->deref() )
+        emit symbolComplete( task.symbol, task.id );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool OptionAnalyzerScheduler::pop( int worker, task_type& task )
+{
+    WorkerQueue *q( queues_[worker] );
+
+    QMutexLocker guard( &q->m );
+
+    if ( q->tasks.empty() )
+        return false;
+
+    task = q->tasks.back();
+    q->tasks.pop_back();
+
+    queued_.deref();
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool OptionAnalyzerScheduler::steal( int worker, task_type& task )
+{
+    const int n( queues_.size() );
+
+    for ( int i( 1 ); i < n; ++i )
+    {
+        WorkerQueue *q( queues_[(worker + i) % n] );
+
+        QMutexLocker guard( &q->m );
+
+        if ( q->tasks.empty() )
+            continue;
+
+        task = q->tasks.front();
+        q->tasks.pop_front();
+
+        queued_.deref();
+        steals_.ref();
+
+        return true;
+    }
+
+    return false;
+}
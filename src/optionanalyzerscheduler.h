@@ -0,0 +1,243 @@
+/**
+ * @file optionanalyzerscheduler.h
+ * Work stealing scheduler for stock option analysis.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OPTIONANALYZERSCHEDULER_H
+#define OPTIONANALYZERSCHEDULER_H
+
+#include <QAtomicInt>
+#include <QDate>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <QWaitCondition>
+
+#include <deque>
+
+class OptionAnalyzerThread;
+class OptionProfitCalculatorFilter;
+class OptionTradingItemModel;
+class SymbolMarketContext;
+class YieldCurve;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Unit of option analysis work.
+struct OptionAnalyzerTask
+{
+    int id;                                         ///< Submission id.
+
+    QString symbol;                                 ///< Underlying symbol.
+    QString filter;                                 ///< Filter name.
+
+    QList<QDate> expiryDates;                       ///< Expiration dates (symbol task only).
+    QDate expiryDate;                               ///< Expiration date (expiration task only).
+
+    double underlying;                              ///< Underlying price (expiration task only).
+
+    QSharedPointer<OptionProfitCalculatorFilter> calcFilter;    ///< Loaded filter (expiration task only).
+    QSharedPointer<const SymbolMarketContext> context;  ///< Market data for underlying (expiration task only).
+    QSharedPointer<const YieldCurve> yieldCurve;    ///< Yield curve for analysis (symbol task only).
+    QSharedPointer<QAtomicInt> pending;             ///< Number of outstanding tasks for symbol.
+
+    /// Check for symbol task.
+    /**
+     * @return  @c true if symbol task, @c false if expiration task
+     */
+    bool isSymbolTask() const {return !expiryDate.isValid();}
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Work stealing scheduler for stock option analysis.
+/**
+ * Owns a fixed pool of worker threads, each with its own task deque. A symbol task loads the
+ * quote and filter for a symbol and then pushes one task per expiration date onto the deque of
+ * the worker running it. Workers pop their own deque from the back and steal from the front of
+ * other deques when they run dry.
+ */
+class OptionAnalyzerScheduler : public QObject
+{
+    Q_OBJECT
+
+    using _Myt = OptionAnalyzerScheduler;
+    using _Mybase = QObject;
+
+public:
+
+    /// Model type.
+    using model_type = OptionTradingItemModel;
+
+    /// Task type.
+    using task_type = OptionAnalyzerTask;
+
+    // ========================================================================
+    // CTOR / DTOR
+    // ========================================================================
+
+    /// Constructor.
+    /**
+     * @param[in] model  trading model
+     * @param[in] numWorkers  number of worker threads
+     * @param[in] parent  parent object
+     */
+    OptionAnalyzerScheduler( model_type *model, int numWorkers, QObject *parent = nullptr );
+
+    /// Destructor.
+    virtual ~OptionAnalyzerScheduler();
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// Check if halted.
+    /**
+     * @return  @c true if halted, @c false otherwise
+     */
+    virtual bool isHalted() const {return halt_.loadAcquire();}
+
+    /// Retrieve trading model.
+    /**
+     * @return  model
+     */
+    virtual model_type *model() const {return analysis_;}
+
+    /// Retrieve number of worker threads.
+    /**
+     * @return  number of workers
+     */
+    virtual int numWorkers() const {return workers_.size();}
+
+    /// Retrieve number of steals.
+    /**
+     * @return  number of tasks taken from another worker
+     */
+    virtual int numSteals() const {return steals_.loadAcquire();}
+
+    /// Retrieve queue depth.
+    /**
+     * @return  number of tasks waiting across all workers
+     */
+    virtual int queueDepth() const {return queued_.loadAcquire();}
+
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Halt analysis.
+    /**
+     * Queued tasks are discarded (but still reported as complete).
+     */
+    virtual void halt();
+
+    /// Retrieve next task for worker.
+    /**
+     * Blocks until a task is available or scheduler is shutting down.
+     * @param[in] worker  worker index
+     * @param[out] task  task
+     * @return  @c true if task retrieved, @c false if worker should exit
+     */
+    virtual bool next( int worker, task_type& task );
+
+    /// Push task onto worker deque.
+    /**
+     * @param[in] worker  worker index
+     * @param[in] task  task
+     */
+    virtual void push( int worker, const task_type& task );
+
+    /// Reset halt and statistics for new analysis.
+    /**
+     * Also takes a snapshot of the yield curve so every symbol in the analysis prices with the
+     * same risk free rates.
+     */
+    virtual void reset();
+
+    /// Submit symbol for analysis.
+    /**
+     * @param[in] symbol  underlying symbol
+     * @param[in] expiryDates  expiration dates
+     * @param[in] filter  filter name
+     * @return  submission id, passed along with symbol when complete
+     */
+    virtual int submit( const QString& symbol, const QList<QDate>& expiryDates, const QString& filter );
+
+    /// Mark task complete.
+    /**
+     * @param[in] task  task
+     */
+    virtual void taskComplete( const task_type& task );
+
+signals:
+
+    /// Signal for symbol analysis complete.
+    /**
+     * @param[in] symbol  underlying symbol
+     * @param[in] id  submission id
+     */
+    void symbolComplete( const QString& symbol, int id );
+
+private:
+
+    struct WorkerQueue
+    {
+        QMutex m;
+        std::deque<task_type> tasks;
+    };
+
+    model_type *analysis_;
+
+    QList<OptionAnalyzerThread*> workers_;
+    QList<WorkerQueue*> queues_;
+
+    QMutex waitMutex_;
+    QWaitCondition wait_;
+
+    QAtomicInt queued_;
+    QAtomicInt steals_;
+
+    QAtomicInt halt_;
+    bool quit_;
+
+    int nextWorker_;
+    int nextId_;
+
+    QSharedPointer<const YieldCurve> yieldCurve_;
+
+    /// Pop task from back of own deque.
+    bool pop( int worker, task_type& task );
+
+    /// Steal task from front of another deque.
+    bool steal( int worker, task_type& task );
+
+    // not implemented
+    OptionAnalyzerScheduler( const _Myt& ) = delete;
+
+    // not implemented
+    _Myt &operator = ( const _Myt& ) = delete;
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // OPTIONANALYZERSCHEDULER_H
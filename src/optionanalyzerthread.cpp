@@ -20,6 +20,7 @@
  */
 
 #include "common.h"
+#include "optionanalyzerscheduler.h"
 #include "optionanalyzerthread.h"
 #include "optionprofitcalc.h"
 #include "optionprofitcalcfilter.h"
@@ -29,16 +30,15 @@
 #include "db/optionchaintablemodel.h"
 #include "db/optiontradingitemmodel.h"
 #include "db/quotetablemodel.h"
+#include "db/symbolmarketcontext.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-OptionAnalyzerThread::OptionAnalyzerThread( const QString& symbol, const QList<QDate>& expiryDates, model_type *model, QObject *parent ) :
+OptionAnalyzerThread::OptionAnalyzerThread( int index, scheduler_type *scheduler, QObject *parent ) :
     _Mybase( parent ),
-    analysis_( model ),
-    symbol_( symbol ),
-    expiryDates_( expiryDates ),
-    halt_( false )
+    index_( index ),
+    scheduler_( scheduler )
 {
-    assert( symbol.length() );
+    assert( scheduler );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -47,20 +47,54 @@ OptionAnalyzerThread::~OptionAnalyzerThread()
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-void OptionAnalyzerThread::run()
+void OptionAnalyzerThread::processExpiry( const task_type& task )
 {
-    // create filter for analysis
-    OptionProfitCalculatorFilter calcFilter;
+    LOG_DEBUG << "processing " << qPrintable( task.symbol ) << " " << qPrintable( task.expiryDate.toString() ) << "...";
+
+    // retrieve chain data
+    OptionChainTableModel chains( task.symbol, task.expiryDate );
+
+    if ( !chains.refreshData() )
+    {
+        LOG_WARN << "error refreshing chain table data";
+        return;
+    }
 
-    const QString f( filter() );
+    // create a calculator
+    OptionProfitCalculator *calc( OptionProfitCalculator::create( task.underlying, &chains, scheduler_->model(), task.context ) );
+
+    // no calculator
+    if ( !calc )
+    {
+        LOG_WARN << "no calculator";
+        return;
+    }
+
+    // setup calculator
+    calc->setFilter( *task.calcFilter );
+    calc->setOptionTradeCost( AppDatabase::instance()->optionTradeCost() );
+
+    // analyze
+    calc->analyze( OptionTradingItemModel::SINGLE );
+    calc->analyze( OptionTradingItemModel::VERT_BEAR_CALL );
+    calc->analyze( OptionTradingItemModel::VERT_BULL_PUT );
+
+    OptionProfitCalculator::destroy( calc );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void OptionAnalyzerThread::processSymbol( const task_type& task )
+{
+    // create filter for analysis
+    QSharedPointer<OptionProfitCalculatorFilter> calcFilter( new OptionProfitCalculatorFilter );
 
     // load filter
-    if ( f.length() )
-        calcFilter.restoreState( AppDatabase::instance()->filter( f ) );
+    if ( task.filter.length() )
+        calcFilter->restoreState( AppDatabase::instance()->filter( task.filter ) );
 
     // retrieve quote and fundamentals
-    QuoteTableModel quote( symbol_ );
-    FundamentalsTableModel fundamentals( symbol_ );
+    QuoteTableModel quote( task.symbol );
+    FundamentalsTableModel fundamentals( task.symbol );
 
     if ( !quote.refreshData() )
         LOG_WARN << "error refreshing quote table data";
@@ -68,51 +102,59 @@ void OptionAnalyzerThread::run()
         LOG_WARN << "error refreshing fundamentals table data";
 
     // check filter
-    else if ( !calcFilter.check( &quote, &fundamentals ) )
+    // filter keeps its own copy of underlying values, expirations run after these models are gone
+    else if ( !calcFilter->check( &quote, &fundamentals, task.expiryDates ) )
         LOG_TRACE << "filtered out from underlying";
 
     else
     {
-        foreach ( const QDate& d, expiryDates_ )
+        task_type expiry;
+        expiry.id = task.id;
+        expiry.symbol = task.symbol;
+        expiry.filter = task.filter;
+        expiry.underlying = quote.tableData( QuoteTableModel::MARK ).toDouble();
+        expiry.calcFilter = calcFilter;
+        expiry.pending = task.pending;
+
+        // load market data once for all expirations
+        expiry.context.reset( new SymbolMarketContext( task.symbol, task.expiryDates, task.yieldCurve ) );
+
+        LOG_DEBUG << "market context " << qPrintable( task.symbol ) << " " << expiry.context->numLookups() << " lookups, " <<
+            (SymbolMarketContext::LOOKUPS_PER_EXPIRY * task.expiryDates.size() - expiry.context->numLookups()) << " saved";
+
+        // account for expirations before any can complete
+        task.pending->fetchAndAddOrdered( task.expiryDates.size() );
+
+        // queue expirations locally, idle workers will steal them
+        foreach ( const QDate& d, task.expiryDates )
         {
-            LOG_DEBUG << "processing " << qPrintable( symbol_ ) << " " << qPrintable( d.toString() ) << "...";
+            expiry.expiryDate = d;
+            scheduler_->push( index_, expiry );
+        }
+    }
+}
 
-            // retrieve chain data
-            OptionChainTableModel chains( symbol_, d );
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void OptionAnalyzerThread::run()
+{
+    task_type task;
 
-            if ( !chains.refreshData() )
-                LOG_WARN << "error refreshing chain table data";
+    while ( scheduler_->next( index_, task ) )
+    {
+        // halted tasks are drained but still reported complete
+        if ( !scheduler_->isHalted() )
+        {
+            if ( task.isSymbolTask() )
+                processSymbol( task );
             else
-            {
-                // create a calculator
-                OptionProfitCalculator *calc( OptionProfitCalculator::create( quote.tableData( QuoteTableModel::MARK ).toDouble(), &chains, analysis_ ) );
-
-                // no calculator
-                if ( !calc )
-                    LOG_WARN << "no calculator";
-                else
-                {
-                    // setup calculator
-                    calc->setFilter( calcFilter );
-                    calc->setOptionTradeCost( AppDatabase::instance()->optionTradeCost() );
-
-                    // analyze
-                    calc->analyze( OptionTradingItemModel::SINGLE );
-                    calc->analyze( OptionTradingItemModel::VERT_BEAR_CALL );
-                    calc->analyze( OptionTradingItemModel::VERT_BULL_PUT );
-
-                    OptionProfitCalculator::destroy( calc );
-                }
-            }
-
-            // check need to quit
-            if ( halt_ )
-                break;
+                processExpiry( task );
         }
+
+        scheduler_->taskComplete( task );
     }
 
     // remove app database connection
     AppDatabase::instance()->removeConnection();
 
-    LOG_DEBUG << "processing complete";
+    LOG_DEBUG << "worker " << index_ << " complete";
 }
@@ -1,6 +1,6 @@
 /**
  * @file optionanalyzerthread.h
- * Stock option analysis thread.
+ * Stock option analysis worker thread.
  *
  * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
  *
@@ -23,27 +23,28 @@
 #ifndef OPTIONANALYZERTHREAD_H
 #define OPTIONANALYZERTHREAD_H
 
-#include <QDate>
-#include <QString>
 #include <QThread>
 
-class OptionTradingItemModel;
+class OptionAnalyzerScheduler;
+struct OptionAnalyzerTask;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// Stock option analysis thread.
+/// Stock option analysis worker thread.
 class OptionAnalyzerThread : public QThread
 {
     Q_OBJECT
-    Q_PROPERTY( QString filter READ filter WRITE setFilter )
 
     using _Myt = OptionAnalyzerThread;
     using _Mybase = QThread;
 
 public:
 
-    /// Model type.
-    using model_type = OptionTradingItemModel;
+    /// Scheduler type.
+    using scheduler_type = OptionAnalyzerScheduler;
+
+    /// Task type.
+    using task_type = OptionAnalyzerTask;
 
     // ========================================================================
     // CTOR / DTOR
@@ -51,12 +52,11 @@ public:
 
     /// Constructor.
     /**
-     * @param[in] symbol  underlying symbol
-     * @param[in] expiryDates  expiration dates
-     * @param[in] model  trading model
+     * @param[in] index  worker index
+     * @param[in] scheduler  scheduler that owns this worker
      * @param[in] parent  parent object
      */
-    OptionAnalyzerThread( const QString& symbol, const QList<QDate>& expiryDates, model_type *model, QObject *parent = nullptr );
+    OptionAnalyzerThread( int index, scheduler_type *scheduler, QObject *parent = nullptr );
 
     /// Destructor.
     virtual ~OptionAnalyzerThread();
@@ -65,41 +65,32 @@ public:
     // Properties
     // ========================================================================
 
-    /// Retrieve filter name.
+    /// Retrieve worker index.
     /**
-     * @return  filter name
+     * @return  index
      */
-    virtual QString filter() const {return filter_;}
+    virtual int index() const {return index_;}
 
-    /// Set filter.
-    /**
-     * @param[in] value  filter name
-     */
-    virtual void setFilter( const QString& value ) {filter_ = value;}
+protected:
 
-public slots:
+    int index_;                                     ///< Worker index.
+    scheduler_type *scheduler_;                     ///< Scheduler.
 
     // ========================================================================
     // Methods
     // ========================================================================
 
-    /// Halt analysis.
-    virtual void halt() {halt_ = true;}
-
-protected:
-
-    model_type *analysis_;                          ///< Trading model.
-
-    QString symbol_;                                ///< Symbol.
-    QList<QDate> expiryDates_;                      ///< Expiration dates.
-
-    QString filter_;                                ///< Custom filter.
-
-    bool halt_;                                     ///< Halt flag (for shutdown).
+    /// Process expiration task.
+    /**
+     * @param[in] task  task to process
+     */
+    virtual void processExpiry( const task_type& task );
 
-    // ========================================================================
-    // Methods
-    // ========================================================================
+    /// Process symbol task.
+    /**
+     * @param[in] task  task to process
+     */
+    virtual void processSymbol( const task_type& task );
 
     /// Thread run method.
     virtual void run() override;
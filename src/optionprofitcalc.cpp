@@ -29,14 +29,15 @@
 
 #include "db/appdb.h"
 #include "db/optionchaintablemodel.h"
-#include "db/symboldbs.h"
 
 #include <cmath>
 
 #include <QObject>
 
+static const int RESULT_BATCH_SIZE = 64;
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-OptionProfitCalculator::OptionProfitCalculator( double underlying, const table_model_type *chains, item_model_type *results ) :
+OptionProfitCalculator::OptionProfitCalculator( double underlying, const table_model_type *chains, item_model_type *results, const QSharedPointer<const market_context_type>& context ) :
     valid_( true ),
     underlying_( underlying ),
     histVolatility_( 0.0 ),
@@ -44,13 +45,14 @@ OptionProfitCalculator::OptionProfitCalculator( double underlying, const table_m
     totalDivAmount_( 0.0 ),
     totalDivYield_( 0.0 ),
     chains_( chains ),
+    snapshot_( chains->snapshot() ),
+    context_( context ),
     results_( results ),
     costBasis_( 0.0 ),
     equityTradeCost_( 0.0 ),
-    optionTradeCost_( 0.0 )
+    optionTradeCost_( 0.0 ),
+    filterRow_( -1 )
 {
-    const QDateTime now( AppDatabase::instance()->currentDateTime() );
-
     // validate underlying price
     if ( underlying_ <= 0.0 )
         valid_ = false;
@@ -63,88 +65,64 @@ OptionProfitCalculator::OptionProfitCalculator( double underlying, const table_m
 
     else
     {
-        // historical volatility
-        const int tradingDaysToExpiry( AppDatabase::instance()->numTradingDaysUntil( chains_->expirationDate() ) );
+        const QDate expiryDate( chains_->expirationDate() );
 
-        histVolatility_ = SymbolDatabases::instance()->historicalVolatility( chains_->symbol(), now.date(), tradingDaysToExpiry );
+        // historical volatility
+        histVolatility_ = context_->historicalVolatility( expiryDate );
 
         // risk free rate
         double timeToExpiryYears = daysToExpiry_;
         timeToExpiryYears /= AppDatabase::instance()->numDays();
 
-        riskFreeRate_ = AppDatabase::instance()->riskFreeRate( timeToExpiryYears );
+        riskFreeRate_ = context_->riskFreeRate( expiryDate );
 
         if ( riskFreeRate_ <= 0.0 )
             LOG_WARN << "risk free rate is zero";
 
         // calculate dividends
-        QDate divDate;
-        double divFreq;
-
-        const double divAmount = SymbolDatabases::instance()->dividendAmount( chains_->symbol(), divDate, divFreq );
-        const double divYield = SymbolDatabases::instance()->dividendYield( chains_->symbol() );
-
-        if (( divDate.isValid() ) && ( 0.0 < divFreq ) && ( 0.0 < divYield ))
-        {
-            double timeToDivYears = now.date().daysTo( divDate );
-            timeToDivYears /= AppDatabase::instance()->numDays();
-
-            // make dividend payment in the future
-            if ( timeToDivYears < 0.0 )
-                timeToDivYears += divFreq;
-
-            if ( 0.0 <= timeToDivYears )
-            {
-                // make list of dividend payment dates and yields
-                while ( timeToDivYears < timeToExpiryYears )
-                {
-                    const double yield( divYield * divFreq );
-
-                    divTimes_.push_back( timeToDivYears );
-                    div_.push_back( yield );
-
-                    // accumulate dividend
-                    totalDivAmount_ += (divAmount * divFreq);
-                    totalDivYield_ += yield;
-
-                    // next dividend
-                    timeToDivYears += divFreq;
-                }
-            }
-        }
+        context_->dividendSchedule( timeToExpiryYears, divTimes_, div_, totalDivAmount_, totalDivYield_ );
     }
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 OptionProfitCalculator::~OptionProfitCalculator()
 {
+    flushRowsToItemModel();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-OptionProfitCalculator *OptionProfitCalculator::create( double underlying, const table_model_type *chains, item_model_type *results )
+OptionProfitCalculator *OptionProfitCalculator::create( double underlying, const table_model_type *chains, item_model_type *results, const QSharedPointer<const market_context_type>& c )
 {
     const QString method( AppDatabase::instance()->optionCalcMethod() );
 
+    // load market data when not shared by caller
+    QSharedPointer<const market_context_type> context( c );
+
+    if (( !context ) || ( !context->contains( chains->expirationDate() ) ))
+        context.reset( new market_context_type( chains->symbol(), QList<QDate>() << chains->expirationDate() ) );
+
     if ( "BARONEADESIWHALEY" == method )
-        return new BasicCalculator<BaroneAdesiWhaley>( underlying, chains, results );
+        return new BasicCalculator<BaroneAdesiWhaley>( underlying, chains, results, context );
     else if ( "BINOM" == method )
-        return new BinomialCalculator<CoxRossRubinstein>( underlying, chains, results );
+        return new BinomialCalculator<CoxRossRubinstein>( underlying, chains, results, context );
     else if ( "BINOM_EQPROB" == method )
-        return new BinomialCalculator<EqualProbBinomialTree>( underlying, chains, results );
+        return new BinomialCalculator<EqualProbBinomialTree>( underlying, chains, results, context );
     else if ( "BJERKSUNDSTENSLAND93" == method )
-        return new BasicCalculator<BjerksundStensland1993>( underlying, chains, results );
+        return new BasicCalculator<BjerksundStensland1993>( underlying, chains, results, context );
     else if ( "BJERKSUNDSTENSLAND02" == method )
-        return new BasicCalculator<BjerksundStensland2002>( underlying, chains, results );
+        return new BasicCalculator<BjerksundStensland2002>( underlying, chains, results, context );
     else if ( "BLACKSCHOLES" == method )
-        return new BasicCalculator<BlackScholes>( underlying, chains, results );
+        return new BasicCalculator<BlackScholes>( underlying, chains, results, context );
     else if ( "MONTECARLO" == method )
-        return new MonteCarloCalculator( underlying, chains, results );
+        return new MonteCarloCalculator<MonteCarlo>( underlying, chains, results, context );
+    else if ( "MONTECARLO_QMC" == method )
+        return new MonteCarloCalculator<QuasiMonteCarlo>( underlying, chains, results, context );
     else if ( "TRINOM" == method )
-        return new TrinomialCalculator<PhelimBoyle>( underlying, chains, results );
+        return new TrinomialCalculator<PhelimBoyle>( underlying, chains, results, context );
     else if ( "TRINOM_ALT" == method )
-        return new TrinomialCalculator<AlternativeTrinomialTree>( underlying, chains, results );
+        return new TrinomialCalculator<AlternativeTrinomialTree>( underlying, chains, results, context );
     else if ( "TRINOM_KR" == method )
-        return new TrinomialCalculator<KamradRitchken>( underlying, chains, results );
+        return new TrinomialCalculator<KamradRitchken>( underlying, chains, results, context );
 
     LOG_WARN << "unhandled option calc method " << qPrintable( method );
 
@@ -173,28 +151,45 @@ bool OptionProfitCalculator::isFilteredOut( int row, bool isCall ) const
     if ( isNonStandard( row ) )
         return true;
 
-    if ( !f_.check( chains_, row, isCall ) )
+    // check filter for entire side of chain once
+    QVector<bool>& passed( isCall ? callsPassed_ : putsPassed_ );
+
+    if ( passed.isEmpty() )
+        f_.check( chains_, isCall, passed );
+
+    if (( row < 0 ) || ( passed.size() <= row ) || ( !passed[row] ))
         return true;
 
+    filterRow_ = row;
+
     return false;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 bool OptionProfitCalculator::isNonStandard( int row ) const
 {
-    return (( chains_->tableData( row, table_model_type::CALL_IS_NON_STANDARD ).toBool() ) ||
-            ( chains_->tableData( row, table_model_type::PUT_IS_NON_STANDARD ).toBool() ));
+    return snapshot_->isNonStandard( row );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void OptionProfitCalculator::addRowToItemModel( const item_model_type::ColumnValueMap& result ) const
 {
     // check filter
-    if ( !f_.check( result ) )
+    if ( !f_.check( result, chains_, filterRow_ ) )
         return;
 
-    // add
-    results_->addRow( result );
+    // add to batch
+    pending_.append( item_model_type::toRow( result ) );
+
+    if ( RESULT_BATCH_SIZE <= pending_.size() )
+        flushRowsToItemModel();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void OptionProfitCalculator::flushRowsToItemModel() const
+{
+    if ( pending_.size() )
+        results_->appendRows( pending_ );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
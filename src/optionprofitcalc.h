@@ -25,7 +25,11 @@
 
 #include "optionprofitcalcfilter.h"
 
+#include "db/optionchainsnapshot.h"
 #include "db/optiontradingitemmodel.h"
+#include "db/symbolmarketcontext.h"
+
+#include <QSharedPointer>
 
 class OptionChainTableModel;
 
@@ -44,6 +48,9 @@ public:
     /// Item model type.
     using item_model_type = OptionTradingItemModel;
 
+    /// Market context type.
+    using market_context_type = SymbolMarketContext;
+
     /// Filter type.
     using filter_type = OptionProfitCalculatorFilter;
 
@@ -93,7 +100,7 @@ public:
     /**
      * @param[in] value  filter
      */
-    virtual void setFilter( const filter_type& value ) {f_ = value;}
+    virtual void setFilter( const filter_type& value ) {f_ = value; callsPassed_.clear(); putsPassed_.clear();}
 
     /// Set option trading cost.
     /**
@@ -121,9 +128,10 @@ public:
      * @param[in] underlying  underlying price (i.e. mark)
      * @param[in] chains  chains to evaluate
      * @param[in] results  results
+     * @param[in] context  market data for underlying, or @c nullptr to load data for this expiration only
      * @return  calculator
      */
-    static _Myt *create( double underlying, const table_model_type *chains, item_model_type *results );
+    static _Myt *create( double underlying, const table_model_type *chains, item_model_type *results, const QSharedPointer<const market_context_type>& context = QSharedPointer<const market_context_type>() );
 
     /// Destroy option profic calculator.
     /**
@@ -148,9 +156,13 @@ protected:
     double totalDivYield_;                          ///< Total dividend yield (expected).
 
     const table_model_type *chains_;                ///< Chains for analysis.
+    QSharedPointer<const OptionChainSnapshot> snapshot_;    ///< Typed snapshot of chains.
+    QSharedPointer<const market_context_type> context_; ///< Market data for underlying.
 
     item_model_type *results_;                      ///< Results.
 
+    mutable item_model_type::ColumnValueRows pending_;  ///< Results not yet handed to item model.
+
     // ---- //
 
     std::vector<double> divTimes_;                  ///< Dividend times.
@@ -163,6 +175,11 @@ protected:
 
     filter_type f_;                                 ///< Filter.
 
+    mutable QVector<bool> callsPassed_;             ///< Call rows passing filter.
+    mutable QVector<bool> putsPassed_;              ///< Put rows passing filter.
+
+    mutable int filterRow_;                         ///< Last row passing filter (option chain row of trade).
+
     // ========================================================================
     // CTOR
     // ========================================================================
@@ -172,8 +189,9 @@ protected:
      * @param[in] underlying  underlying price (i.e. mark)
      * @param[in] chains  chains to evaluate
      * @param[in] results  results
+     * @param[in] context  market data for underlying
      */
-    OptionProfitCalculator( double underlying, const table_model_type *chains, item_model_type *results );
+    OptionProfitCalculator( double underlying, const table_model_type *chains, item_model_type *results, const QSharedPointer<const market_context_type>& context );
 
     // ========================================================================
     // Properties
@@ -204,6 +222,9 @@ protected:
      */
     virtual void addRowToItemModel( const item_model_type::ColumnValueMap& result ) const;
 
+    /// Hand pending results to item model.
+    void flushRowsToItemModel() const;
+
     /// Populate result model with put/call information.
     /**
      * @param[in] row  row
@@ -117,6 +117,109 @@ static const QString DOUBLE_VALUE( "D" );
 static const QString TABLE_TYPE( "T" );
 static const QString VALUE_TYPE( "V" );
 
+static const QString OP_EQ( "EQ" );
+static const QString OP_NEQ( "NEQ" );
+static const QString OP_LT( "LT" );
+static const QString OP_LTE( "LTE" );
+static const QString OP_GT( "GT" );
+static const QString OP_GTE( "GTE" );
+
+// ordering of left value to right value
+static const int ORDER_UNORDERED( 0x0 );
+static const int ORDER_LESS( 0x1 );
+static const int ORDER_EQUAL( 0x2 );
+static const int ORDER_GREATER( 0x4 );
+
+/// Retrieve index of charting data, adding it when not found.
+static int chartingIndex( QStringList& charts, QVector<bool>& chartsExpiry, const QString& col )
+{
+    int index( charts.indexOf( col ) );
+
+    if ( index < 0 )
+    {
+        index = charts.size();
+
+        charts.append( col );
+
+        // min/max are over the days until expiration
+        chartsExpiry.append(( col.endsWith( "MIN" ) ) || ( col.endsWith( "MAX" ) ) || ( col.startsWith( "HVDTE" ) ));
+    }
+
+    return index;
+}
+
+/// Retrieve index of option chain column, adding it when not found.
+static int chainIndex( QVector<int>& columns, int col )
+{
+    int index( columns.indexOf( col ) );
+
+    if ( index < 0 )
+    {
+        index = columns.size();
+
+        columns.append( col );
+    }
+
+    return index;
+}
+
+/// Check if value is numeric.
+static bool isNumeric( const QVariant& v )
+{
+    switch ( v.userType() )
+    {
+    case QMetaType::Bool:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Float:
+    case QMetaType::Double:
+        return true;
+    default:
+        break;
+    }
+
+    return false;
+}
+
+/// Compare numeric values.
+static int compareValues( double v0, double v1 )
+{
+    if ( v0 < v1 )
+        return ORDER_LESS;
+    else if ( v1 < v0 )
+        return ORDER_GREATER;
+    else if ( v0 == v1 )
+        return ORDER_EQUAL;
+
+    return ORDER_UNORDERED;
+}
+
+/// Compare values.
+static int compareValues( const QVariant& v0, const QVariant& v1 )
+{
+#if QT_VERSION_CHECK( 6, 0, 0 ) <= QT_VERSION
+    const QPartialOrdering result( QVariant::compare( v0, v1 ) );
+
+    if ( QPartialOrdering::Less == result )
+        return ORDER_LESS;
+    else if ( QPartialOrdering::Greater == result )
+        return ORDER_GREATER;
+    else if ( QPartialOrdering::Equivalent == result )
+        return ORDER_EQUAL;
+
+    return ORDER_UNORDERED;
+#else
+    if ( v0 == v1 )
+        return ORDER_EQUAL;
+    else if ( v0 < v1 )
+        return ORDER_LESS;
+
+    return ORDER_GREATER;
+#endif
+}
+
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 OptionProfitCalculatorFilter::OptionProfitCalculatorFilter() :
@@ -162,10 +265,10 @@ OptionProfitCalculatorFilter::OptionProfitCalculatorFilter() :
     price_( ALL_PRICES ),
     volatility_( ALL_VOLATILITY ),
     vertDepth_( DEFAULT_VERT_DEPTH ),
-    q_( nullptr ),
-    f_( nullptr ),
     oc_( nullptr ),
-    ocr_( 0 ),
+    ocr_( -1 ),
+    ocValuesChain_( nullptr ),
+    ocValuesRows_( 0 ),
     t_( nullptr )
 {
 }
@@ -183,11 +286,33 @@ OptionProfitCalculatorFilter::~OptionProfitCalculatorFilter()
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-bool OptionProfitCalculatorFilter::check( const QuoteTableModel *quote, const FundamentalsTableModel *fundamentals ) const
+bool OptionProfitCalculatorFilter::check( const QuoteTableModel *quote, const FundamentalsTableModel *fundamentals, const QList<QDate>& expiryDates ) const
 {
     // save values for future comparison
-    q_ = quote;
-    f_ = fundamentals;
+    QSharedPointer<UnderlyingValues> underlying( new UnderlyingValues );
+    underlying->symbol = quote->data0( QuoteTableModel::SYMBOL ).toString();
+
+    for ( int col( 0 ); col < quote->columnCount(); ++col )
+        underlying->quote.append( toValue( quote->data0( col ) ) );
+
+    for ( int col( 0 ); col < fundamentals->columnCount(); ++col )
+        underlying->fundamentals.append( toValue( fundamentals->data0( col ) ) );
+
+    underlying_ = underlying;
+
+    // charting data is computed once per quote, expirations only read it
+    charting_.clear();
+
+    for ( int index( 0 ); index < charts_.size(); ++index )
+    {
+        if ( !chartsExpiry_[index] )
+            charting_[chartingKey( index )] = toValue( chartingData( charts_[index], underlying->symbol, QDate() ) );
+        else
+        {
+            foreach ( const QDate& d, expiryDates )
+                charting_[chartingKey( index, d )] = toValue( chartingData( charts_[index], underlying->symbol, d ) );
+        }
+    }
 
     if ( !checkAdvancedFilters() )
     {
@@ -254,8 +379,47 @@ bool OptionProfitCalculatorFilter::check( const OptionChainTableModel *chains, i
         return false;
     }
 
-    // ---- //
+    return checkOptionChain( chains, *chains->snapshot(), row, isCall );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void OptionProfitCalculatorFilter::check( const OptionChainTableModel *chains, bool isCall, QVector<bool>& result ) const
+{
+    const int rows( chains->rowCount() );
+
+    result.fill( false, rows );
+
+    if ( !rows )
+        return;
+
+    // save values for future comparison
+    oc_ = chains;
+    ocr_ = 0;
+
+    // filters that do not depend on chain row
+    if ( !checkAdvancedFilters( ALL_TABLES, OPTION_CHAIN ) )
+    {
+        LOG_TRACE << "failed advanced filters";
+        return;
+    }
 
+    const QSharedPointer<const OptionChainSnapshot> snapshot( chains->snapshot() );
+
+    // check each row
+    for ( int row( 0 ); row < rows; ++row )
+    {
+        ocr_ = row;
+
+        if ( !checkAdvancedFilters( OPTION_CHAIN ) )
+            LOG_TRACE << "failed advanced filters";
+        else
+            result[row] = checkOptionChain( chains, *snapshot, row, isCall );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool OptionProfitCalculatorFilter::checkOptionChain( const OptionChainTableModel *chains, const OptionChainSnapshot& snapshot, int row, bool isCall ) const
+{
     const QDateTime now( AppDatabase::instance()->currentDateTime() );
 
     const double daysToExpiry( now.date().daysTo( chains->expirationDate() ) );
@@ -274,40 +438,28 @@ bool OptionProfitCalculatorFilter::check( const OptionChainTableModel *chains, i
 
     // ---- //
 
-    bool itm;
-    bool otm;
+    const OptionChainSnapshot::Side& side( snapshot.side( isCall ) );
+
+    const bool isInTheMoney( side.flags[row] & OptionChainSnapshot::IN_THE_MONEY );
+
+    const int bidSize( side.bidSize[row] );
+    const int askSize( side.askSize[row] );
 
-    int bidSize;
-    int askSize;
+    const double spread( side.ask[row] - side.bid[row] );
+    const double spreadPercent( spread / side.ask[row] );
 
-    double spread;
-    double spreadPercent;
+    bool itm;
+    bool otm;
 
     if ( isCall )
     {
-        const bool isInTheMoney( chains->tableData( row, OptionChainTableModel::CALL_IS_IN_THE_MONEY ).toBool() );
-
         itm = (( ITM_CALLS & optionTypeFilter() ) && ( isInTheMoney ));
         otm = (( OTM_CALLS & optionTypeFilter() ) && ( !isInTheMoney ));
-
-        bidSize = chains->tableData( row, OptionChainTableModel::CALL_BID_SIZE ).toInt();
-        askSize = chains->tableData( row, OptionChainTableModel::CALL_ASK_SIZE ).toInt();
-
-        spread = chains->tableData( row, OptionChainTableModel::CALL_ASK_PRICE ).toDouble() - chains->tableData( row, OptionChainTableModel::CALL_BID_PRICE ).toDouble();
-        spreadPercent = spread / chains->tableData( row, OptionChainTableModel::CALL_ASK_PRICE ).toDouble();
     }
     else
     {
-        const bool isInTheMoney( chains->tableData( row, OptionChainTableModel::PUT_IS_IN_THE_MONEY ).toBool() );
-
         itm = (( ITM_PUTS & optionTypeFilter() ) && ( isInTheMoney ));
         otm = (( OTM_PUTS & optionTypeFilter() ) && ( !isInTheMoney ));
-
-        bidSize = chains->tableData( row, OptionChainTableModel::PUT_BID_SIZE ).toInt();
-        askSize = chains->tableData( row, OptionChainTableModel::PUT_ASK_SIZE ).toInt();
-
-        spread = chains->tableData( row, OptionChainTableModel::PUT_ASK_PRICE ).toDouble() - chains->tableData( row, OptionChainTableModel::PUT_BID_PRICE ).toDouble();
-        spreadPercent = spread / chains->tableData( row, OptionChainTableModel::PUT_ASK_PRICE ).toDouble();
     }
 
     // check selected
@@ -342,12 +494,15 @@ bool OptionProfitCalculatorFilter::check( const OptionChainTableModel *chains, i
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-bool OptionProfitCalculatorFilter::check( const OptionTradingItemModel::ColumnValueMap& trade ) const
+bool OptionProfitCalculatorFilter::check( const OptionTradingItemModel::ColumnValueMap& trade, const OptionChainTableModel *chain, int row ) const
 {
     // save values for future comparison
+    oc_ = chain;
+    ocr_ = row;
+
     t_ = &trade;
 
-    if ( !checkAdvancedFilters() )
+    if ( !checkAdvancedFilters( OPTION_TRADING ) )
     {
         t_ = nullptr;
 
@@ -746,475 +901,636 @@ void OptionProfitCalculatorFilter::restoreState( const QByteArray& state )
 
     if ( obj.contains( JSON_VERT_DEPTH ) )
         vertDepth_ = obj[JSON_VERT_DEPTH].toInt();
+
+    compileAdvancedFilters();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-bool OptionProfitCalculatorFilter::checkAdvancedFilters() const
+bool OptionProfitCalculatorFilter::checkAdvancedFilters( int tables, int skip ) const
 {
     // check what tables we have available
-    QStringList tables;
+    int available( NO_TABLE );
 
-    if ( q_ )
-    {
-        tables.append( QUOTE_TABLE );
-        tables.append( CHARTING );
-    }
+    if ( underlying_ )
+        available |= QUOTE | FUNDAMENTALS | CHARTING_DATA;
 
-    if ( f_ )
-        tables.append( FUNDAMENTALS_TABLE );
+    if (( oc_ ) && ( 0 <= ocr_ ))
+    {
+        cacheOptionChainValues( oc_ );
 
-    if ( oc_ )
-        tables.append( OPTION_CHAIN_TABLE );
+        if ( ocr_ < ocValuesRows_ )
+            available |= OPTION_CHAIN;
+    }
 
     if ( t_ )
-        tables.append( OPTION_TRADING_TABLE );
+        available |= OPTION_TRADING;
+
+    Value scratch0;
+    Value scratch1;
 
     // check each filter
-    foreach ( const QString& f, advancedFilters_ )
+    foreach ( const AdvancedFilter& f, program_ )
     {
-        const QStringList filter( f.split( "|" ) );
-
-        if ( 3 != filter.size() )
-            continue;
-
-        // retrieve table
-        const QStringList t0( filter[0].split( ":" ) );
-
-        // check we are interested in this table
-        if ( !tables.contains( t0[0] ) )
+        // check we are interested in this filter
+        if (( f.tables & ~available ) || ( !(f.tables & tables) ) || ( f.tables & skip ))
             continue;
 
-        const QVariant v0( tableData( t0[0], t0[1] ) );
+        const Value *v0( operand( f.table0, f.column0, scratch0 ) );
 
-        if ( v0.isNull() )
+        if (( !v0 ) || ( v0->null ))
             continue;
 
-        // retrieve operand
-        const QStringList op( filter[1].split( ":" ) );
+        int order;
 
-        QVariant v1;
-
-        if ( TABLE_TYPE == op[1] )
+        if ( NO_TABLE == f.table1 )
         {
-            const QStringList t1( filter[2].split( ":" ) );
+            if (( f.numeric ) && ( v0->numeric ))
+                order = compareValues( v0->d, f.value );
+            else
+                order = compareValues( v0->v, f.constant );
+        }
+        else
+        {
+            const Value *v1( operand( f.table1, f.column1, scratch1 ) );
 
-            // check we are interested in this table
-            if ( !tables.contains( t1[0] ) )
+            if (( !v1 ) || ( v1->null ))
                 continue;
-
-            v1 = tableData( t1[0], t1[1] );
+            else if (( v0->numeric ) && ( v1->numeric ))
+                order = compareValues( v0->d, v1->d );
+            else
+                order = compareValues( v0->v, v1->v );
         }
-        else if ( STRING_VALUE == t0[2] )
-            v1 = filter[2];
-        else if ( INT_VALUE == t0[2] )
-            v1 = filter[2].toInt();
-        else if ( DOUBLE_VALUE == t0[2] )
-            v1 = filter[2].toDouble();
-
-        if ( v1.isNull() )
-            continue;
 
         // validate
-#if QT_VERSION_CHECK( 6, 0, 0 ) <= QT_VERSION
-        const QPartialOrdering result( QVariant::compare( v0, v1 ) );
-
-        if (( QPartialOrdering::Equivalent == result ) && (( "LT" == op[0] ) || ( "GT" == op[0] ) || ( "NEQ" == op[0] )))
-        {
-            LOG_DEBUG << "advanced filter (eq) failed " << qPrintable( f ) << " " << qPrintable( v0.toString() ) << " " << qPrintable( v1.toString() );
-            return false;
-        }
-        else if (( QPartialOrdering::Less == result ) && (( "GT" == op[0] ) || ( "GTE" == op[0] ) || ( "EQ" == op[0] )))
-        {
-            LOG_DEBUG << "advanced filter (l) failed " << qPrintable( f ) << " " << qPrintable( v0.toString() ) << " " << qPrintable( v1.toString() );
-            return false;
-        }
-        else if (( QPartialOrdering::Greater == result ) && (( "LT" == op[0] ) || ( "LTE" == op[0] ) || ( "EQ" == op[0] )))
-        {
-            LOG_DEBUG << "advanced filter (g) failed " << qPrintable( f ) << " " << qPrintable( v0.toString() ) << " " << qPrintable( v1.toString() );
-            return false;
-        }
-        else if ( QPartialOrdering::Unordered == result )
+        if ( ORDER_UNORDERED == order )
+            LOG_WARN << "advanced filter mismatched types " << qPrintable( f.text );
+        else if ( !(f.pass & order) )
         {
-            LOG_WARN << "advanced filter mismatched types " << qPrintable( f );
-        }
-#else
-        if (( "EQ" == op[0] ) && ( v0 != v1 ))
-        {
-            LOG_DEBUG << "advanced filter (eq) failed " << qPrintable( f ) << " " << qPrintable( v0.toString() ) << " " << qPrintable( v1.toString() );
+            LOG_DEBUG << "advanced filter failed " << qPrintable( f.text ) << " " << qPrintable( v0->v.toString() );
             return false;
         }
-        else if (( "NEQ" == op[0] ) && ( v0 == v1 ))
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void OptionProfitCalculatorFilter::cacheOptionChainValues( const OptionChainTableModel *chains ) const
+{
+    if ( ocValuesChain_ == chains )
+        return;
+
+    ocValuesChain_ = chains;
+    ocValuesRows_ = chains->rowCount();
+
+    ocValues_.resize( chainColumns_.size() * ocValuesRows_ );
+
+    // read each referenced column once for the whole chain
+    for ( int index( 0 ); index < chainColumns_.size(); ++index )
+        for ( int row( 0 ); row < ocValuesRows_; ++row )
+            ocValues_[index * ocValuesRows_ + row] = toValue( chains->data( row, chainColumns_[index] ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void OptionProfitCalculatorFilter::compileAdvancedFilters()
+{
+    program_.clear();
+
+    chainColumns_.clear();
+
+    ocValuesChain_ = nullptr;
+    ocValuesRows_ = 0;
+    ocValues_.clear();
+
+    charts_.clear();
+    chartsExpiry_.clear();
+
+    charting_.clear();
+
+    foreach ( const QString& text, advancedFilters_ )
+    {
+        const QStringList filter( text.split( "|" ) );
+
+        if ( 3 != filter.size() )
+            continue;
+
+        const QStringList t0( filter[0].split( ":" ) );
+        const QStringList op( filter[1].split( ":" ) );
+
+        if (( t0.size() < 2 ) || ( op.size() < 2 ))
         {
-            LOG_DEBUG << "advanced filter (neq) failed " << qPrintable( f ) << " " << qPrintable( v0.toString() ) << " " << qPrintable( v1.toString() );
-            return false;
+            LOG_WARN << "bad advanced filter " << qPrintable( text );
+            continue;
         }
-        else if (( "LT" == op[0] ) && ( v0 >= v1 ))
+
+        AdvancedFilter f;
+        f.text = text;
+        f.table1 = NO_TABLE;
+        f.column1 = 0;
+        f.numeric = false;
+        f.value = 0.0;
+
+        // operator
+        if ( OP_EQ == op[0] )
+            f.pass = ORDER_EQUAL;
+        else if ( OP_NEQ == op[0] )
+            f.pass = ORDER_LESS | ORDER_GREATER;
+        else if ( OP_LT == op[0] )
+            f.pass = ORDER_LESS;
+        else if ( OP_LTE == op[0] )
+            f.pass = ORDER_LESS | ORDER_EQUAL;
+        else if ( OP_GT == op[0] )
+            f.pass = ORDER_GREATER;
+        else if ( OP_GTE == op[0] )
+            f.pass = ORDER_GREATER | ORDER_EQUAL;
+        else
         {
-            LOG_DEBUG << "advanced filter (lt) failed " << qPrintable( f ) << " " << qPrintable( v0.toString() ) << " " << qPrintable( v1.toString() );
-            return false;
+            LOG_WARN << "unknown advanced filter operator " << qPrintable( text );
+            continue;
         }
-        else if (( "LTE" == op[0] ) && ( v0 > v1 ))
+
+        // left operand
+        if ( QUOTE_TABLE == t0[0] )
+            f.table0 = QUOTE;
+        else if ( FUNDAMENTALS_TABLE == t0[0] )
+            f.table0 = FUNDAMENTALS;
+        else if ( OPTION_CHAIN_TABLE == t0[0] )
+            f.table0 = OPTION_CHAIN;
+        else if ( OPTION_TRADING_TABLE == t0[0] )
+            f.table0 = OPTION_TRADING;
+        else if ( CHARTING == t0[0] )
+            f.table0 = CHARTING_DATA;
+        else
+            continue;
+
+        if ( CHARTING_DATA == f.table0 )
+            f.column0 = chartingIndex( charts_, chartsExpiry_, t0[1] );
+        else if ( OPTION_CHAIN == f.table0 )
+            f.column0 = chainIndex( chainColumns_, t0[1].toInt() );
+        else
+            f.column0 = t0[1].toInt();
+
+        // right operand
+        if ( TABLE_TYPE == op[1] )
         {
-            LOG_DEBUG << "advanced filter (lte) failed " << qPrintable( f ) << " " << qPrintable( v0.toString() ) << " " << qPrintable( v1.toString() );
-            return false;
+            const QStringList t1( filter[2].split( ":" ) );
+
+            if ( t1.size() < 2 )
+            {
+                LOG_WARN << "bad advanced filter " << qPrintable( text );
+                continue;
+            }
+
+            if ( QUOTE_TABLE == t1[0] )
+                f.table1 = QUOTE;
+            else if ( FUNDAMENTALS_TABLE == t1[0] )
+                f.table1 = FUNDAMENTALS;
+            else if ( OPTION_CHAIN_TABLE == t1[0] )
+                f.table1 = OPTION_CHAIN;
+            else if ( OPTION_TRADING_TABLE == t1[0] )
+                f.table1 = OPTION_TRADING;
+            else if ( CHARTING == t1[0] )
+                f.table1 = CHARTING_DATA;
+            else
+                continue;
+
+            if ( CHARTING_DATA == f.table1 )
+                f.column1 = chartingIndex( charts_, chartsExpiry_, t1[1] );
+            else if ( OPTION_CHAIN == f.table1 )
+                f.column1 = chainIndex( chainColumns_, t1[1].toInt() );
+            else
+                f.column1 = t1[1].toInt();
         }
-        else if (( "GT" == op[0] ) && ( v0 <= v1 ))
+        else if ( t0.size() < 3 )
+            continue;
+        else if ( STRING_VALUE == t0[2] )
+            f.constant = filter[2];
+        else if ( INT_VALUE == t0[2] )
         {
-            LOG_DEBUG << "advanced filter (gt) failed " << qPrintable( f ) << " " << qPrintable( v0.toString() ) << " " << qPrintable( v1.toString() );
-            return false;
+            f.constant = filter[2].toInt();
+            f.numeric = true;
+            f.value = f.constant.toInt();
         }
-        else if (( "GTE" == op[0] ) && ( v0 < v1 ))
+        else if ( DOUBLE_VALUE == t0[2] )
         {
-            LOG_DEBUG << "advanced filter (gte) failed " << qPrintable( f ) << " " << qPrintable( v0.toString() ) << " " << qPrintable( v1.toString() );
-            return false;
+            f.constant = filter[2].toDouble();
+            f.numeric = true;
+            f.value = f.constant.toDouble();
         }
-#endif
+        else
+            continue;
+
+        f.tables = f.table0 | f.table1;
+
+        program_.append( f );
     }
+}
 
-    return true;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+const OptionProfitCalculatorFilter::Value *OptionProfitCalculatorFilter::operand( AdvancedFilterTable t, int col, Value& scratch ) const
+{
+    if (( QUOTE == t ) && ( underlying_ ))
+    {
+        if (( 0 <= col ) && ( col < underlying_->quote.size() ))
+            return &underlying_->quote[col];
+    }
+    else if (( FUNDAMENTALS == t ) && ( underlying_ ))
+    {
+        if (( 0 <= col ) && ( col < underlying_->fundamentals.size() ))
+            return &underlying_->fundamentals[col];
+    }
+    else if (( OPTION_CHAIN == t ) && ( oc_ ))
+    {
+        if (( 0 <= ocr_ ) && ( ocr_ < ocValuesRows_ ))
+            return &ocValues_[col * ocValuesRows_ + ocr_];
+    }
+    else if (( OPTION_TRADING == t ) && ( t_ ))
+    {
+        scratch = toValue( t_->value( col ) );
+        return &scratch;
+    }
+    else if (( CHARTING_DATA == t ) && ( underlying_ ))
+        return chartingValue( col );
+
+    return nullptr;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-QVariant OptionProfitCalculatorFilter::tableData( const QString& t, const QString& col ) const
+const OptionProfitCalculatorFilter::Value *OptionProfitCalculatorFilter::chartingValue( int index ) const
 {
-    if (( QUOTE_TABLE == t ) && ( q_ ))
-        return q_->data0( col.toInt() );
-    else if (( FUNDAMENTALS_TABLE == t ) && ( f_ ))
-        return f_->data0( col.toInt() );
-    else if (( OPTION_CHAIN_TABLE == t ) && ( oc_ ))
-        return oc_->data( ocr_, col.toInt() );
-    else if (( OPTION_TRADING_TABLE == t ) && ( t_ ))
-        return (*t_)[col.toInt()];
-    else if (( CHARTING == t ) && ( q_ ))
-    {
-        const QDateTime now( AppDatabase::instance()->currentDateTime() );
-
-        const QString symbol( q_->data0( QuoteTableModel::SYMBOL ).toString() );
-        const QDate start( now.date().addDays( -7 ) );
-        const QDate end( now.date() );
-
-        const QDate expiry( oc_ ? QDate::fromString( oc_->data( ocr_, OptionChainTableModel::EXPIRY_DATE ).toString(), Qt::ISODate ) : QDate() );
-
-        QString data( col );
-        bool slope( false );
-        bool vmin( false );
-        bool vmax( false );
-
-        if ( col.endsWith( "SLOPE" ) )
-        {
-            data = col.chopped( 5 );
-            slope = true;
-        }
-        else if ( col.endsWith( "MIN" ) )
-        {
-            data = col.chopped( 3 );
-            vmin = true;
-        }
-        else if ( col.endsWith( "MAX" ) )
-        {
-            data = col.chopped( 3 );
-            vmax = true;
-        }
+    if (( index < 0 ) || ( charts_.size() <= index ))
+        return nullptr;
 
-        // for min/max need valid expiry date
-        if (( vmin ) || ( vmax ))
-            if (( !expiry.isValid() ) || ( expiry < end ))
-                return QVariant();
+    // key on expiration date when value depends on it
+    QDate expiry;
 
-        // exponential moving average (from MACD)
-        if (( "EMA12" == data ) || ( "EMA26" == data ))
-        {
+    if ( chartsExpiry_[index] )
+    {
+        if ( !oc_ )
+            return nullptr;
+
+        expiry = oc_->expirationDate();
+    }
+
+    const QHash<quint64, Value>::const_iterator i( charting_.constFind( chartingKey( index, expiry ) ) );
+
+    if ( charting_.constEnd() == i )
+        return nullptr;
+
+    return &i.value();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QVariant OptionProfitCalculatorFilter::chartingData( const QString& col, const QString& symbol, const QDate& expiry )
+{
+    const QDateTime now( AppDatabase::instance()->currentDateTime() );
+
+    const QDate start( now.date().addDays( -7 ) );
+    const QDate end( now.date() );
+
+    QString data( col );
+    bool slope( false );
+    bool vmin( false );
+    bool vmax( false );
+
+    if ( col.endsWith( "SLOPE" ) )
+    {
+        data = col.chopped( 5 );
+        slope = true;
+    }
+    else if ( col.endsWith( "MIN" ) )
+    {
+        data = col.chopped( 3 );
+        vmin = true;
+    }
+    else if ( col.endsWith( "MAX" ) )
+    {
+        data = col.chopped( 3 );
+        vmax = true;
+    }
+
+    // for min/max need valid expiry date
+    if (( vmin ) || ( vmax ))
+        if (( !expiry.isValid() ) || ( expiry < end ))
+            return QVariant();
+
+    // exponential moving average (from MACD)
+    if (( "EMA12" == data ) || ( "EMA26" == data ))
+    {
 #if QT_VERSION_CHECK( 5, 15, 2 ) <= QT_VERSION
-            const int d( QStringView{ data }.mid( 3 ).toInt() );
+        const int d( QStringView{ data }.mid( 3 ).toInt() );
 #else
-            const int d( data.midRef( 3 ).toInt() );
+        const int d( data.midRef( 3 ).toInt() );
 #endif
 
-            QList<MovingAveragesConvergenceDivergence> values;
-
-            if (( vmin ) || ( vmax ))
-            {
-                const int dte( end.daysTo( expiry ) );
-
-                SymbolDatabases::instance()->movingAveragesConvergenceDivergence( symbol, end.addDays( -dte ), end, values );
+        QList<MovingAveragesConvergenceDivergence> values;
 
-                if ( values.size() )
-                {
-                    double min;
-                    double max( min = values[0].ema[d] );
+        if (( vmin ) || ( vmax ))
+        {
+            const int dte( end.daysTo( expiry ) );
 
-                    foreach ( const MovingAveragesConvergenceDivergence& value, values )
-                    {
-                        min = qMin( min, value.ema[d] );
-                        max = qMax( max, value.ema[d] );
-                    }
+            SymbolDatabases::instance()->movingAveragesConvergenceDivergence( symbol, end.addDays( -dte ), end, values );
 
-                    if ( vmin )
-                        return min;
-                    else if ( vmax )
-                        return max;
-                }
-            }
-            else
+            if ( values.size() )
             {
-                SymbolDatabases::instance()->movingAveragesConvergenceDivergence( symbol, start, end, values );
-
-                const int last( values.size() - 1 );
+                double min;
+                double max( min = values[0].ema[d] );
 
-                if ( slope )
+                foreach ( const MovingAveragesConvergenceDivergence& value, values )
                 {
-                    if ( 1 <= last )
-                        return values[last].ema[d] - values[last-1].ema[d];
+                    min = qMin( min, value.ema[d] );
+                    max = qMax( max, value.ema[d] );
                 }
-                else if ( 0 <= last )
-                    return values[last].ema[d];
+
+                if ( vmin )
+                    return min;
+                else if ( vmax )
+                    return max;
             }
         }
-        // simple moving average
-        // exponential moving average
-        else if (( data.startsWith( "SMA" ) ) || ( data.startsWith( "EMA" ) ))
+        else
         {
+            SymbolDatabases::instance()->movingAveragesConvergenceDivergence( symbol, start, end, values );
+
+            const int last( values.size() - 1 );
+
+            if ( slope )
+            {
+                if ( 1 <= last )
+                    return values[last].ema[d] - values[last-1].ema[d];
+            }
+            else if ( 0 <= last )
+                return values[last].ema[d];
+        }
+    }
+    // simple moving average
+    // exponential moving average
+    else if (( data.startsWith( "SMA" ) ) || ( data.startsWith( "EMA" ) ))
+    {
 #if QT_VERSION_CHECK( 5, 15, 2 ) <= QT_VERSION
-            const int d( QStringView{ data }.mid( 3 ).toInt() );
+        const int d( QStringView{ data }.mid( 3 ).toInt() );
 #else
-            const int d( data.midRef( 3 ).toInt() );
+        const int d( data.midRef( 3 ).toInt() );
 #endif
 
-            QList<MovingAverages> values;
+        QList<MovingAverages> values;
 
-            if (( vmin ) || ( vmax ))
-            {
-                const int dte( end.daysTo( expiry ) );
+        if (( vmin ) || ( vmax ))
+        {
+            const int dte( end.daysTo( expiry ) );
 
-                SymbolDatabases::instance()->movingAverages( symbol, end.addDays( -dte ), end, values );
+            SymbolDatabases::instance()->movingAverages( symbol, end.addDays( -dte ), end, values );
 
-                if ( values.size() )
-                {
-                    double min( 999999.99 );
-                    double max( 0.0 );
+            if ( values.size() )
+            {
+                double min( 999999.99 );
+                double max( 0.0 );
 
-                    foreach ( const MovingAverages& value, values )
+                foreach ( const MovingAverages& value, values )
+                {
+                    if ( data.startsWith( "SMA" ) )
                     {
-                        if ( data.startsWith( "SMA" ) )
-                        {
-                            min = qMin( min, value.sma[d] );
-                            max = qMax( max, value.sma[d] );
-                        }
-                        else if ( data.startsWith( "EMA" ) )
-                        {
-                            min = qMin( min, value.ema[d] );
-                            max = qMax( max, value.ema[d] );
-                        }
+                        min = qMin( min, value.sma[d] );
+                        max = qMax( max, value.sma[d] );
+                    }
+                    else if ( data.startsWith( "EMA" ) )
+                    {
+                        min = qMin( min, value.ema[d] );
+                        max = qMax( max, value.ema[d] );
                     }
-
-                    if ( vmin )
-                        return min;
-                    else if ( vmax )
-                        return max;
                 }
+
+                if ( vmin )
+                    return min;
+                else if ( vmax )
+                    return max;
             }
-            else
-            {
-                SymbolDatabases::instance()->movingAverages( symbol, start, end, values );
+        }
+        else
+        {
+            SymbolDatabases::instance()->movingAverages( symbol, start, end, values );
 
-                const int last( values.size() - 1 );
+            const int last( values.size() - 1 );
 
-                if ( slope )
-                {
-                    if ( 1 <= last )
-                    {
-                        if ( data.startsWith( "SMA" ) )
-                            return values[last].sma[d] - values[last-1].sma[d];
-                        else if ( data.startsWith( "EMA" ) )
-                            return values[last].ema[d] - values[last-1].ema[d];
-                    }
-                }
-                else if ( 0 <= last )
+            if ( slope )
+            {
+                if ( 1 <= last )
                 {
                     if ( data.startsWith( "SMA" ) )
-                        return values[last].sma[d];
+                        return values[last].sma[d] - values[last-1].sma[d];
                     else if ( data.startsWith( "EMA" ) )
-                        return values[last].ema[d];
+                        return values[last].ema[d] - values[last-1].ema[d];
                 }
             }
+            else if ( 0 <= last )
+            {
+                if ( data.startsWith( "SMA" ) )
+                    return values[last].sma[d];
+                else if ( data.startsWith( "EMA" ) )
+                    return values[last].ema[d];
+            }
         }
-        // relative strength index
-        else if ( data.startsWith( "RSI" ) )
-        {
+    }
+    // relative strength index
+    else if ( data.startsWith( "RSI" ) )
+    {
 #if QT_VERSION_CHECK( 5, 15, 2 ) <= QT_VERSION
-            const int d( QStringView{ data }.mid( 3 ).toInt() );
+        const int d( QStringView{ data }.mid( 3 ).toInt() );
 #else
-            const int d( data.midRef( 3 ).toInt() );
+        const int d( data.midRef( 3 ).toInt() );
 #endif
 
-            QList<RelativeStrengthIndexes> values;
+        QList<RelativeStrengthIndexes> values;
 
-            if (( vmin ) || ( vmax ))
-            {
-                const int dte( end.daysTo( expiry ) );
-
-                SymbolDatabases::instance()->relativeStrengthIndex( symbol, end.addDays( -dte ), end, values );
-
-                if ( values.size() )
-                {
-                    double min;
-                    double max( min = values[0].values[d] );
+        if (( vmin ) || ( vmax ))
+        {
+            const int dte( end.daysTo( expiry ) );
 
-                    foreach ( const RelativeStrengthIndexes& value, values )
-                    {
-                        min = qMin( min, value.values[d] );
-                        max = qMax( max, value.values[d] );
-                    }
+            SymbolDatabases::instance()->relativeStrengthIndex( symbol, end.addDays( -dte ), end, values );
 
-                    if ( vmin )
-                        return min;
-                    else if ( vmax )
-                        return max;
-                }
-            }
-            else
+            if ( values.size() )
             {
-                SymbolDatabases::instance()->relativeStrengthIndex( symbol, start, end, values );
-
-                const int last( values.size() - 1 );
+                double min;
+                double max( min = values[0].values[d] );
 
-                if ( slope )
+                foreach ( const RelativeStrengthIndexes& value, values )
                 {
-                    if ( 1 <= last )
-                        return values[last].values[d] - values[last-1].values[d];
+                    min = qMin( min, value.values[d] );
+                    max = qMax( max, value.values[d] );
                 }
-                else if ( 0 <= last )
-                    return values[last].values[d];
+
+                if ( vmin )
+                    return min;
+                else if ( vmax )
+                    return max;
             }
         }
-        // historical volatility (depth of dte)
-        else if ( data.startsWith( "HVDTE" ) )
+        else
         {
-            if (( !expiry.isValid() ) || ( expiry < end ))
-                return QVariant();
+            SymbolDatabases::instance()->relativeStrengthIndex( symbol, start, end, values );
 
-            // depth is trading days to expiry
-            const int d( AppDatabase::instance()->numTradingDaysBetween( end, expiry ) );
+            const int last( values.size() - 1 );
 
-            if (( vmin ) || ( vmax ))
+            if ( slope )
             {
-                const int dte( end.daysTo( expiry ) );
+                if ( 1 <= last )
+                    return values[last].values[d] - values[last-1].values[d];
+            }
+            else if ( 0 <= last )
+                return values[last].values[d];
+        }
+    }
+    // historical volatility (depth of dte)
+    else if ( data.startsWith( "HVDTE" ) )
+    {
+        if (( !expiry.isValid() ) || ( expiry < end ))
+            return QVariant();
 
-                double min;
-                double max;
+        // depth is trading days to expiry
+        const int d( AppDatabase::instance()->numTradingDaysBetween( end, expiry ) );
 
-                SymbolDatabases::instance()->historicalVolatilityRange( symbol, end.addDays( -dte ), end, d, min, max );
+        if (( vmin ) || ( vmax ))
+        {
+            const int dte( end.daysTo( expiry ) );
 
-                if ( vmin )
-                    return 100.0 * min;
-                else if ( vmax )
-                    return 100.0 * max;
-            }
-            else
+            double min;
+            double max;
+
+            SymbolDatabases::instance()->historicalVolatilityRange( symbol, end.addDays( -dte ), end, d, min, max );
+
+            if ( vmin )
+                return 100.0 * min;
+            else if ( vmax )
+                return 100.0 * max;
+        }
+        else
+        {
+            double hvprev( 0.0 );
+
+            // find a recent hv
+            for ( int days( 0 ); days < 10; ++days )
             {
-                double hvprev( 0.0 );
+                const double hv( SymbolDatabases::instance()->historicalVolatility( symbol, end.addDays( -days ), d ) );
 
-                // find a recent hv
-                for ( int days( 0 ); days < 10; ++days )
+                if ( 0.0 < hv )
                 {
-                    const double hv( SymbolDatabases::instance()->historicalVolatility( symbol, end.addDays( -days ), d ) );
-
-                    if ( 0.0 < hv )
-                    {
-                        if ( !slope )
-                            return 100.0 * hv;
-                        else if ( 0.0 < hvprev )
-                            return 100.0 * (hvprev - hv);
+                    if ( !slope )
+                        return 100.0 * hv;
+                    else if ( 0.0 < hvprev )
+                        return 100.0 * (hvprev - hv);
 
-                        hvprev = hv;
-                    }
+                    hvprev = hv;
                 }
             }
         }
-        // historical volatility
-        else if ( data.startsWith( "HV" ) )
-        {
+    }
+    // historical volatility
+    else if ( data.startsWith( "HV" ) )
+    {
 #if QT_VERSION_CHECK( 5, 15, 2 ) <= QT_VERSION
-            const int d( QStringView{ data }.mid( 2 ).toInt() );
+        const int d( QStringView{ data }.mid( 2 ).toInt() );
 #else
-            const int d( data.midRef( 2 ).toInt() );
+        const int d( data.midRef( 2 ).toInt() );
 #endif
 
-            if (( vmin ) || ( vmax ))
-            {
-                const int dte( end.daysTo( expiry ) );
-
-                double min;
-                double max;
-
-                SymbolDatabases::instance()->historicalVolatilityRange( symbol, end.addDays( -dte ), end, d, min, max );
+        if (( vmin ) || ( vmax ))
+        {
+            const int dte( end.daysTo( expiry ) );
 
-                if ( vmin )
-                    return 100.0 * min;
-                else if ( vmax )
-                    return 100.0 * max;
-            }
-            else
-            {
-                QList<HistoricalVolatilities> values;
-                SymbolDatabases::instance()->historicalVolatilities( symbol, start, end, values );
+            double min;
+            double max;
 
-                const int last( values.size() - 1 );
+            SymbolDatabases::instance()->historicalVolatilityRange( symbol, end.addDays( -dte ), end, d, min, max );
 
-                if ( slope )
-                {
-                    if ( 1 <= last )
-                        return 100.0 * (values[last].volatilities[d] - values[last-1].volatilities[d]);
-                }
-                else if ( 0 <= last )
-                    return 100.0 * values[last].volatilities[d];
-            }
+            if ( vmin )
+                return 100.0 * min;
+            else if ( vmax )
+                return 100.0 * max;
         }
-        // macd
-        else if ( data.startsWith( "MACD" ) )
+        else
         {
-            QList<MovingAveragesConvergenceDivergence> values;
-            SymbolDatabases::instance()->movingAveragesConvergenceDivergence( symbol, start, end, values );
+            QList<HistoricalVolatilities> values;
+            SymbolDatabases::instance()->historicalVolatilities( symbol, start, end, values );
 
             const int last( values.size() - 1 );
 
-            if (( "MACDBUYFLAG" == data ) && ( 1 <= last ))
-            {
-                const double pval( values[last-1].histogram );
-                const double val( values[last].histogram );
-
-                return ((( pval < 0.0 ) && ( 0.0 <= val )) ? 1 : 0);
-            }
-            else if (( "MACDSELLFLAG" == data ) && ( 1 <= last ))
-            {
-                const double pval( values[last-1].histogram );
-                const double val( values[last].histogram );
-
-                return ((( 0.0 <= pval ) && ( val < 0.0 )) ? 1 : 0);
-            }
-            else if ( slope )
+            if ( slope )
             {
                 if ( 1 <= last )
-                {
-                    if ( "MACD" == data )
-                        return values[last].macd - values[last-1].macd;
-                    else if ( "MACDSIG" == data )
-                        return values[last].signal - values[last-1].signal;
-                    else if ( "MACDH" == data )
-                        return values[last].histogram - values[last-1].histogram;
-                }
+                    return 100.0 * (values[last].volatilities[d] - values[last-1].volatilities[d]);
             }
             else if ( 0 <= last )
+                return 100.0 * values[last].volatilities[d];
+        }
+    }
+    // macd
+    else if ( data.startsWith( "MACD" ) )
+    {
+        QList<MovingAveragesConvergenceDivergence> values;
+        SymbolDatabases::instance()->movingAveragesConvergenceDivergence( symbol, start, end, values );
+
+        const int last( values.size() - 1 );
+
+        if (( "MACDBUYFLAG" == data ) && ( 1 <= last ))
+        {
+            const double pval( values[last-1].histogram );
+            const double val( values[last].histogram );
+
+            return ((( pval < 0.0 ) && ( 0.0 <= val )) ? 1 : 0);
+        }
+        else if (( "MACDSELLFLAG" == data ) && ( 1 <= last ))
+        {
+            const double pval( values[last-1].histogram );
+            const double val( values[last].histogram );
+
+            return ((( 0.0 <= pval ) && ( val < 0.0 )) ? 1 : 0);
+        }
+        else if ( slope )
+        {
+            if ( 1 <= last )
             {
                 if ( "MACD" == data )
-                    return values[last].macd;
+                    return values[last].macd - values[last-1].macd;
                 else if ( "MACDSIG" == data )
-                    return values[last].signal;
+                    return values[last].signal - values[last-1].signal;
                 else if ( "MACDH" == data )
-                    return values[last].histogram;
+                    return values[last].histogram - values[last-1].histogram;
             }
         }
+        else if ( 0 <= last )
+        {
+            if ( "MACD" == data )
+                return values[last].macd;
+            else if ( "MACDSIG" == data )
+                return values[last].signal;
+            else if ( "MACDH" == data )
+                return values[last].histogram;
+        }
     }
 
     return QVariant();
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+OptionProfitCalculatorFilter::Value OptionProfitCalculatorFilter::toValue( const QVariant& v )
+{
+    Value result;
+    result.v = v;
+    result.null = v.isNull();
+    result.numeric = isNumeric( v );
+    result.d = result.numeric ? v.toDouble() : 0.0;
+
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+quint64 OptionProfitCalculatorFilter::chartingKey( int index, const QDate& expiry )
+{
+    quint64 key( index );
+    key <<= 32;
+
+    if ( expiry.isValid() )
+        key |= (quint32) expiry.toJulianDay();
+
+    return key;
+}
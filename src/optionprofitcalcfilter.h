@@ -26,8 +26,14 @@
 #include <db/optiontradingitemmodel.h>
 
 #include <QByteArray>
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <QSharedPointer>
+#include <QVector>
 
 class FundamentalsTableModel;
+class OptionChainSnapshot;
 class OptionChainTableModel;
 class QuoteTableModel;
 
@@ -603,7 +609,7 @@ public:
     /**
      * @param[in] value  advanced filter list
      */
-    virtual void setAdvancedFilters( const QStringList& value ) {advancedFilters_ = value;}
+    virtual void setAdvancedFilters( const QStringList& value ) {advancedFilters_ = value; compileAdvancedFilters();}
 
     /// Retrieve advanced filters.
     /**
@@ -629,11 +635,15 @@ public:
 
     /// Check data against filter.
     /**
+     * Values advanced filters need are copied out of @a quote and @a fundamentals, neither needs
+     * to outlive this call. Charting data is computed here for every date of @a expiryDates, later
+     * checks of option chains only read it.
      * @param[in] quote  quote
      * @param[in] fundamentals  fundamentals data
+     * @param[in] expiryDates  expiration dates that will be checked
      * @return  @c true if passes filter, @c false otherwise
      */
-    virtual bool check( const QuoteTableModel *quote, const FundamentalsTableModel *fundamentals ) const;
+    virtual bool check( const QuoteTableModel *quote, const FundamentalsTableModel *fundamentals, const QList<QDate>& expiryDates = QList<QDate>() ) const;
 
     /// Check data against filter.
     /**
@@ -646,10 +656,24 @@ public:
 
     /// Check data against filter.
     /**
+     * Every row of the chain is checked. Advanced filters that do not reference the option chain
+     * are checked once for the whole chain.
+     * @param[in] chain  chain information
+     * @param[in] isCall  @c true to check calls, @c false to check puts
+     * @param[out] result  for each row, @c true if passes filter, @c false otherwise
+     */
+    virtual void check( const OptionChainTableModel *chain, bool isCall, QVector<bool>& result ) const;
+
+    /// Check data against filter.
+    /**
+     * Only advanced filters that reference the trade are checked, the others were already checked
+     * against the underlying and option chain.
      * @param[in] trade  trade information
+     * @param[in] chain  chain information of trade, or @c nullptr when not available
+     * @param[in] row  row of @a chain the trade was built from
      * @return  @c true if passes filter, @c false otherwise
      */
-    virtual bool check( const OptionTradingItemModel::ColumnValueMap& trade ) const;
+    virtual bool check( const OptionTradingItemModel::ColumnValueMap& trade, const OptionChainTableModel *chain = nullptr, int row = -1 ) const;
 
     /// Save filter state.
     /**
@@ -738,19 +762,129 @@ private:
 
     static constexpr int DEFAULT_VERT_DEPTH = 3;
 
-    mutable const QuoteTableModel *q_;
-    mutable const FundamentalsTableModel *f_;
+    /// Advanced filter tables.
+    enum AdvancedFilterTable
+    {
+        NO_TABLE = 0x0,                                     ///< No table (constant value).
+        QUOTE = 0x1,                                        ///< Quote table.
+        FUNDAMENTALS = 0x2,                                 ///< Fundamentals table.
+        OPTION_CHAIN = 0x4,                                 ///< Option chain table.
+        OPTION_TRADING = 0x8,                               ///< Option trading table.
+        CHARTING_DATA = 0x10,                               ///< Charting data.
+
+        ALL_TABLES = 0xff,                                  ///< All tables.
+    };
+
+    /// Compiled advanced filter.
+    struct AdvancedFilter
+    {
+        QString text;                                       ///< Filter text (for logging).
+
+        int tables;                                         ///< Tables referenced by filter.
+        int pass;                                           ///< Orderings of left value to right value that pass filter.
+
+        AdvancedFilterTable table0;                         ///< Left table.
+        int column0;                                        ///< Left column (or index into charting data or option chain values).
+
+        AdvancedFilterTable table1;                         ///< Right table, or @c NO_TABLE for constant.
+        int column1;                                        ///< Right column (or index into charting data or option chain values).
+
+        QVariant constant;                                  ///< Right constant value.
+
+        bool numeric;                                       ///< Right constant value is numeric.
+        double value;                                       ///< Right constant value (numeric).
+    };
+
+    /// Advanced filter operand value.
+    struct Value
+    {
+        QVariant v;                                         ///< Value.
+        double d;                                           ///< Value (numeric).
+
+        bool null;                                          ///< Value is null.
+        bool numeric;                                       ///< Value is numeric.
+    };
+
+    QVector<AdvancedFilter> program_;                           ///< Compiled advanced filters.
+
+    QVector<int> chainColumns_;                                 ///< Option chain columns referenced by advanced filters.
+
+    QStringList charts_;                                        ///< Charting data referenced by advanced filters.
+    QVector<bool> chartsExpiry_;                                ///< Charting data depends on expiration date.
+
+    mutable QHash<quint64, Value> charting_;                    ///< Charting data values for current quote by index and expiration date.
+
+    /// Underlying values.
+    struct UnderlyingValues
+    {
+        QString symbol;                                     ///< Underlying symbol.
+
+        QVector<Value> quote;                               ///< Quote values by column.
+        QVector<Value> fundamentals;                        ///< Fundamentals values by column.
+    };
+
+    mutable QSharedPointer<const UnderlyingValues> underlying_; ///< Underlying values for current quote.
 
     mutable const OptionChainTableModel *oc_;
     mutable int ocr_;
 
+    mutable const OptionChainTableModel *ocValuesChain_;        ///< Chain of cached option chain values.
+    mutable int ocValuesRows_;                                  ///< Number of rows of cached option chain values.
+    mutable QVector<Value> ocValues_;                           ///< Option chain values by index and row.
+
     mutable const OptionTradingItemModel::ColumnValueMap *t_;
 
     /// Check advanced filters.
-    bool checkAdvancedFilters() const;
+    /**
+     * @param[in] tables  only check filters referencing one of these tables
+     * @param[in] skip  do not check filters referencing any of these tables
+     * @return  @c true if passes filters, @c false otherwise
+     */
+    bool checkAdvancedFilters( int tables = ALL_TABLES, int skip = NO_TABLE ) const;
+
+    /// Cache option chain values referenced by advanced filters.
+    /**
+     * @param[in] chains  chain information
+     */
+    void cacheOptionChainValues( const OptionChainTableModel *chains ) const;
+
+    /// Check option chain data against filter (excluding advanced filters).
+    bool checkOptionChain( const OptionChainTableModel *chains, const OptionChainSnapshot& snapshot, int row, bool isCall ) const;
+
+    /// Compile advanced filters.
+    void compileAdvancedFilters();
+
+    /// Retrieve advanced filter operand value.
+    /**
+     * @param[in] t  table
+     * @param[in] col  column (or index into charting data or option chain values)
+     * @param[out] scratch  storage for values that are not cached
+     * @return  pointer to value, or @c nullptr if table not available
+     */
+    const Value *operand( AdvancedFilterTable t, int col, Value& scratch ) const;
+
+    /// Retrieve charting data value.
+    /**
+     * @param[in] col  charting data
+     * @param[in] symbol  underlying symbol
+     * @param[in] expiry  expiration date (for data that depends on it)
+     * @return  value
+     */
+    static QVariant chartingData( const QString& col, const QString& symbol, const QDate& expiry );
+
+    /// Retrieve charting data value (cached).
+    /**
+     * Values are computed by check() of the quote and shared between copies of this filter.
+     * @param[in] index  index into charting data
+     * @return  pointer to value, or @c nullptr if not computed
+     */
+    const Value *chartingValue( int index ) const;
+
+    /// Generate charting data cache key.
+    static quint64 chartingKey( int index, const QDate& expiry = QDate() );
 
-    /// Retrieve table data value.
-    QVariant tableData( const QString& t, const QString& col ) const;
+    /// Convert to advanced filter operand value.
+    static Value toValue( const QVariant& v );
 
 };
 
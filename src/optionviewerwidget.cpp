@@ -34,6 +34,7 @@
 #include "db/optionchaintablemodel.h"
 #include "db/optiontradingitemmodel.h"
 #include "db/quotetablemodel.h"
+#include "db/symbolmarketcontext.h"
 
 #include <QApplication>
 #include <QHBoxLayout>
@@ -162,6 +163,18 @@ void OptionViewerWidget::onButtonClicked()
                 calcFilter.restoreState( AppDatabase::instance()->filter( f ) );
         }
 
+        // expirations to analyze
+        QList<QDate> dates;
+
+        for ( int i( 0 ); i < expiryDates_->count(); ++i )
+        {
+            const OptionChainView *view( qobject_cast<const OptionChainView*>( expiryDates_->widget( i ) ) );
+
+            if (( view ) && ( view->model() ))
+                if (( analysisOne_ != sender() ) || ( expiryDates_->currentWidget() == view ))
+                    dates.append( view->model()->expirationDate() );
+        }
+
         // retrieve fundamentals
         FundamentalsTableModel fundamentals( symbol() );
 
@@ -170,7 +183,7 @@ void OptionViewerWidget::onButtonClicked()
             LOG_WARN << "error refreshing fundamentals table data";
             return;
         }
-        else if ( !calcFilter.check( model_, &fundamentals ) )
+        else if ( !calcFilter.check( model_, &fundamentals, dates ) )
         {
             LOG_DEBUG << "filtered out from underlying";
             return;
@@ -185,6 +198,9 @@ void OptionViewerWidget::onButtonClicked()
         {
             QFutureSynchronizer<void> calcs;
 
+            // load market data once for all expirations
+            const QSharedPointer<const SymbolMarketContext> context( new SymbolMarketContext( symbol(), dates ) );
+
             for ( int i( 0 ); i < expiryDates_->count(); ++i )
             {
                 // retrieve chains
@@ -214,7 +230,7 @@ void OptionViewerWidget::onButtonClicked()
                     }
 
                 // create a calculator
-                OptionProfitCalculator *calc( OptionProfitCalculator::create( model_->tableData( QuoteTableModel::MARK ).toDouble(), viewModel, tradingModel_ ) );
+                OptionProfitCalculator *calc( OptionProfitCalculator::create( model_->tableData( QuoteTableModel::MARK ).toDouble(), viewModel, tradingModel_, context ) );
 
                 if ( !calc )
                     LOG_WARN << "no calculator";
@@ -0,0 +1,470 @@
+/**
+ * @file scanreplay.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common.h"
+#include "optionanalyzerscheduler.h"
+#include "scanreplay.h"
+
+#include "db/appdb.h"
+#include "db/optiontradingitemmodel.h"
+#include "db/symboldbs.h"
+
+#include "tda/dbadaptertd.h"
+#include "tda/tdapi.h"
+
+#include "usdot/dbadapterusdot.h"
+#include "usdot/usdotapi.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QDomDocument>
+#include <QFile>
+#include <QJsonDocument>
+#include <QMutexLocker>
+#include <QThread>
+
+#include <algorithm>
+
+// price history is replayed as the full history request of the daemon
+static const int PRICE_HISTORY_YEARS( 5 );
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+static double percentile( const QVector<qint64>& sorted, double p )
+{
+    if ( sorted.isEmpty() )
+        return 0.0;
+
+    const int i( p * sorted.size() );
+
+    return sorted[(i < sorted.size()) ? i : sorted.size() - 1];
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+ScanReplay::ScanReplay( const QString& dir, QObject *parent ) :
+    _Mybase( parent ),
+    dir_( dir ),
+    type_( MARKET_HOURS ),
+    parsed_( false ),
+    transformed_( false ),
+    numDocuments_( 0 ),
+    numFailures_( 0 ),
+    numBytes_( 0 ),
+    numChainBytes_( 0 ),
+    numRows_( 0 ),
+    analyzeStart_( 0 ),
+    analyzeStop_( 0 ),
+    elapsed_( 0 ),
+    numSymbols_( 0 ),
+    numSymbolsComplete_( 0 )
+{
+    SymbolDatabases *sdbs( SymbolDatabases::instance() );
+    AppDatabase *db( AppDatabase::instance() );
+
+    api_ = new TDAmeritrade( this );
+    apiAdapter_ = new TDAmeritradeDatabaseAdapter( this );
+
+    usdot_ = new DeptOfTheTreasury( this );
+    usdotAdapter_ = new DeptOfTheTreasuryDatabaseAdapter( this );
+
+    model_ = new OptionTradingItemModel( this );
+    scheduler_ = new OptionAnalyzerScheduler( model_, QThread::idealThreadCount(), this );
+
+    // same pipeline as the application, with a timing slot ahead of each stage so slots are
+    // invoked in connection order
+
+    // parse -> transform
+    connect( api_, &TDAmeritrade::marketHoursReceived, this, &_Myt::onParsed, Qt::DirectConnection );
+    connect( api_, &TDAmeritrade::optionChainReceived, this, &_Myt::onParsed, Qt::DirectConnection );
+    connect( api_, &TDAmeritrade::priceHistoryReceived, this, &_Myt::onParsed, Qt::DirectConnection );
+    connect( api_, &TDAmeritrade::quotesReceived, this, &_Myt::onParsed, Qt::DirectConnection );
+    connect( usdot_, &DeptOfTheTreasury::dailyTreasuryBillRatesReceived, this, &_Myt::onParsed, Qt::DirectConnection );
+    connect( usdot_, &DeptOfTheTreasury::dailyTreasuryYieldCurveRatesReceived, this, &_Myt::onParsed, Qt::DirectConnection );
+
+    connect( api_, &TDAmeritrade::marketHoursReceived, apiAdapter_, &TDAmeritradeDatabaseAdapter::transformMarketHours, Qt::DirectConnection );
+    connect( api_, &TDAmeritrade::optionChainReceived, apiAdapter_, &TDAmeritradeDatabaseAdapter::transformOptionChain, Qt::DirectConnection );
+    connect( api_, &TDAmeritrade::priceHistoryReceived, apiAdapter_, &TDAmeritradeDatabaseAdapter::transformPriceHistory, Qt::DirectConnection );
+    connect( api_, &TDAmeritrade::quotesReceived, apiAdapter_, &TDAmeritradeDatabaseAdapter::transformQuotes, Qt::DirectConnection );
+    connect( usdot_, &DeptOfTheTreasury::dailyTreasuryBillRatesReceived, usdotAdapter_, &DeptOfTheTreasuryDatabaseAdapter::transformDailyTreasuryBillRates, Qt::DirectConnection );
+    connect( usdot_, &DeptOfTheTreasury::dailyTreasuryYieldCurveRatesReceived, usdotAdapter_, &DeptOfTheTreasuryDatabaseAdapter::transformDailyTreasuryYieldCurveRates, Qt::DirectConnection );
+
+    // transform -> ingest
+    connect( apiAdapter_, &TDAmeritradeDatabaseAdapter::transformComplete, this, &_Myt::onTransformed, Qt::DirectConnection );
+    connect( apiAdapter_, &TDAmeritradeDatabaseAdapter::optionChainTransformComplete, this, &_Myt::onTransformed, Qt::DirectConnection );
+    connect( usdotAdapter_, &DeptOfTheTreasuryDatabaseAdapter::transformComplete, this, &_Myt::onTransformed, Qt::DirectConnection );
+
+    connect( apiAdapter_, &TDAmeritradeDatabaseAdapter::transformComplete, db, &AppDatabase::processData, Qt::DirectConnection );
+    connect( apiAdapter_, &TDAmeritradeDatabaseAdapter::transformComplete, sdbs, &SymbolDatabases::processData, Qt::DirectConnection );
+    connect( apiAdapter_, &TDAmeritradeDatabaseAdapter::optionChainTransformComplete, sdbs, &SymbolDatabases::processOptionChain, Qt::DirectConnection );
+    connect( usdotAdapter_, &DeptOfTheTreasuryDatabaseAdapter::transformComplete, db, &AppDatabase::processData, Qt::DirectConnection );
+
+    // ingest -> analyze
+    connect( sdbs, &SymbolDatabases::optionChainChanged, this, &_Myt::onOptionChainChanged, Qt::DirectConnection );
+
+    // analyze -> result insert
+    connect( scheduler_, &OptionAnalyzerScheduler::symbolComplete, this, &_Myt::onSymbolComplete, Qt::DirectConnection );
+
+    connect( model_, &OptionTradingItemModel::rowsAboutToBeInserted, this, &_Myt::onRowsAboutToBeInserted, Qt::DirectConnection );
+    connect( model_, &OptionTradingItemModel::rowsInserted, this, &_Myt::onRowsInserted, Qt::DirectConnection );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+ScanReplay::~ScanReplay()
+{
+    // stop workers before the model goes away
+    delete scheduler_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QJsonObject ScanReplay::report() const
+{
+    QMutexLocker guard( &m_ );
+
+    QJsonObject stages;
+
+    for ( int s( 0 ); s < _NUM_STAGES; ++s )
+    {
+        QVector<qint64> sorted( nsecs_[s] );
+        std::sort( sorted.begin(), sorted.end() );
+
+        qint64 total( 0 );
+
+        foreach ( qint64 t, sorted )
+            total += t;
+
+        // symbols are analyzed in parallel, so throughput comes from the wall clock
+        const qint64 busy( (ANALYZE == s) ? (analyzeStop_ - analyzeStart_) : total );
+
+        QJsonObject stage;
+        stage["count"] = sorted.size();
+        stage["totalMs"] = total / 1.0e6;
+        stage["perSec"] = (0 < busy) ? sorted.size() * 1.0e9 / busy : 0.0;
+        stage["meanUs"] = sorted.size() ? total / (1.0e3 * sorted.size()) : 0.0;
+        stage["p50Us"] = percentile( sorted, 0.50 ) / 1.0e3;
+        stage["p95Us"] = percentile( sorted, 0.95 ) / 1.0e3;
+        stage["p99Us"] = percentile( sorted, 0.99 ) / 1.0e3;
+        stage["maxUs"] = sorted.size() ? sorted.last() / 1.0e3 : 0.0;
+
+        // chain bytes are only counted against the stage that parses them
+        if (( PARSE == s ) && ( 0 < busy ))
+            stage["mbPerSec"] = (numBytes_ - numChainBytes_) * 1.0e9 / (1024.0 * 1024.0 * busy);
+        else if (( CHAIN_PARSE_TRANSFORM == s ) && ( 0 < busy ))
+            stage["mbPerSec"] = numChainBytes_ * 1.0e9 / (1024.0 * 1024.0 * busy);
+        else if (( RESULT_INSERT == s ) && ( 0 < busy ))
+            stage["rowsPerSec"] = numRows_ * 1.0e9 / busy;
+
+        stages[stageName( (Stage) s )] = stage;
+    }
+
+    QJsonObject result;
+    result["dir"] = dir_;
+    result["documents"] = numDocuments_;
+    result["failures"] = numFailures_;
+    result["bytes"] = numBytes_;
+    result["symbols"] = numSymbols_;
+    result["rows"] = numRows_;
+    result["workers"] = scheduler_->numWorkers();
+    result["steals"] = scheduler_->numSteals();
+    result["wallTimeSec"] = elapsed_ / 1.0e9;
+    result["stages"] = stages;
+
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool ScanReplay::run()
+{
+#if !defined( QT_DEBUG )
+    LOG_ERROR << "scan replay requires a debug build";
+    return false;
+#else
+    if ( !QDir( dir_ ).exists() )
+    {
+        LOG_ERROR << "no such directory " << qPrintable( dir_ );
+        return false;
+    }
+
+    LOG_INFO << "replay " << qPrintable( dir_ ) << "...";
+
+    clock_.start();
+
+    // reference data first, analysis depends on it
+    replay( "marketHours", "*.json", MARKET_HOURS );
+    replay( "treasury", "billRates*.xml", BILL_RATES );
+    replay( "treasury", "yieldCurve*.xml", YIELD_CURVE );
+    replay( "quotes", "*.json", QUOTES );
+    replay( "priceHistory", "*.json", PRICE_HISTORY );
+
+    // snapshot yield curve now that rates are loaded
+    scheduler_->reset();
+    filter_ = AppDatabase::instance()->optionAnalysisFilter();
+
+    // symbols are analyzed while remaining chains are ingested, the same as a scan
+    replay( "optionChains", "*.json", OPTION_CHAIN );
+
+    // wait for analysis to drain
+    for ( ;; )
+    {
+        {
+            QMutexLocker guard( &m_ );
+
+            if ( numSymbols_ <= numSymbolsComplete_ )
+                break;
+        }
+
+        QCoreApplication::processEvents( QEventLoop::AllEvents | QEventLoop::WaitForMoreEvents, WAIT_TIME );
+    }
+
+    // results are queued for insert before symbol completes
+    QCoreApplication::processEvents();
+
+    elapsed_ = clock_.nsecsElapsed();
+
+    // ---- //
+
+    const QJsonObject r( report() );
+    const QJsonObject stages( r["stages"].toObject() );
+
+    LOG_INFO << "replayed " << numDocuments_ << " documents (" << numFailures_ << " failed) " << numSymbols_ << " symbols " << numRows_ << " results in " << (elapsed_ / 1.0e9) << " sec";
+
+    for ( int s( 0 ); s < _NUM_STAGES; ++s )
+    {
+        const QString name( stageName( (Stage) s ) );
+        const QJsonObject stage( stages[name].toObject() );
+
+        LOG_INFO << qPrintable( name ) << " " << stage["count"].toInt() << " @ " << stage["perSec"].toDouble() << "/s" <<
+            " mean " << stage["meanUs"].toDouble() << " us" <<
+            " p95 " << stage["p95Us"].toDouble() << " us" <<
+            " max " << stage["maxUs"].toDouble() << " us";
+    }
+
+    return true;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QString ScanReplay::stageName( Stage stage )
+{
+    switch ( stage )
+    {
+    case PARSE:
+        return "parse";
+    case TRANSFORM:
+        return "transform";
+    case CHAIN_PARSE_TRANSFORM:
+        return "chainParseTransform";
+    case INGEST:
+        return "ingest";
+    case ANALYZE:
+        return "analyze";
+    case RESULT_INSERT:
+        return "resultInsert";
+    default:
+        break;
+    }
+
+    return QString();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ScanReplay::onParsed()
+{
+    if ( parsed_ )
+        return;
+
+    parsed_ = true;
+
+    // option chain is parsed by transform, keep timing
+    if ( OPTION_CHAIN != type_ )
+        mark( PARSE );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ScanReplay::onTransformed()
+{
+    if (( !parsed_ ) || ( transformed_ ))
+        return;
+
+    transformed_ = true;
+    mark( (OPTION_CHAIN == type_) ? CHAIN_PARSE_TRANSFORM : TRANSFORM );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ScanReplay::onOptionChainChanged( const QString& symbol, const QList<QDate>& expiryDates )
+{
+    // nothing to analyze
+    if ( expiryDates.isEmpty() )
+        return;
+
+    const qint64 now( clock_.nsecsElapsed() );
+
+    // hold lock across submit so completion cannot be reported before it is recorded
+    QMutexLocker guard( &m_ );
+
+    if ( !numSymbols_ )
+        analyzeStart_ = now;
+
+    submitted_[scheduler_->submit( symbol, expiryDates, filter_ )] = now;
+    ++numSymbols_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ScanReplay::onSymbolComplete( const QString& symbol, int id )
+{
+    Q_UNUSED( symbol )
+
+    // invoked from worker thread
+    const qint64 now( clock_.nsecsElapsed() );
+
+    QMutexLocker guard( &m_ );
+
+    // symbol can repeat across chain files, so match on submission
+    const QHash<int, qint64>::iterator i( submitted_.find( id ) );
+
+    if ( submitted_.end() != i )
+    {
+        nsecs_[ANALYZE].append( now - i.value() );
+        submitted_.erase( i );
+    }
+
+    analyzeStop_ = now;
+    ++numSymbolsComplete_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ScanReplay::onRowsAboutToBeInserted()
+{
+    insert_.start();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ScanReplay::onRowsInserted( const QModelIndex& parent, int first, int last )
+{
+    Q_UNUSED( parent )
+
+    const qint64 t( insert_.nsecsElapsed() );
+
+    QMutexLocker guard( &m_ );
+
+    nsecs_[RESULT_INSERT].append( t );
+    numRows_ += last - first + 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ScanReplay::replay( const QString& subdir, const QString& pattern, Document type )
+{
+    const QDir d( dir_ + "/" + subdir );
+
+    // every directory is optional
+    if ( !d.exists() )
+        return;
+
+    foreach ( const QString& filename, d.entryList( QStringList() << pattern, QDir::Files, QDir::Name ) )
+        if ( !replayFile( d.filePath( filename ), type ) )
+        {
+            LOG_WARN << "failed to replay " << qPrintable( d.filePath( filename ) );
+            ++numFailures_;
+        }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool ScanReplay::replayFile( const QString& filename, Document type )
+{
+#if defined( QT_DEBUG )
+    QFile f( filename );
+
+    if ( !f.open( QIODevice::ReadOnly ) )
+        return false;
+
+    type_ = type;
+
+    parsed_ = false;
+    transformed_ = false;
+
+    stage_.start();
+
+    const QByteArray data( f.readAll() );
+
+    ++numDocuments_;
+    numBytes_ += data.size();
+
+    if ( OPTION_CHAIN == type )
+        numChainBytes_ += data.size();
+
+    // option chains are streamed straight from response
+    if ( OPTION_CHAIN == type )
+        api_->simulateOptionChain( data );
+
+    else if (( BILL_RATES == type ) || ( YIELD_CURVE == type ))
+    {
+        QDomDocument doc;
+
+        if ( !doc.setContent( data ) )
+            return false;
+
+        if ( BILL_RATES == type )
+            usdot_->simulateDailyTreasuryBillRates( doc );
+        else
+            usdot_->simulateDailyTreasuryYieldCurveRates( doc );
+    }
+
+    else
+    {
+        QJsonParseError error;
+
+        const QJsonDocument doc( QJsonDocument::fromJson( data, &error ) );
+
+        if ( QJsonParseError::NoError != error.error )
+            return false;
+
+        if ( MARKET_HOURS == type )
+            api_->simulateMarketHours( doc );
+        else if ( QUOTES == type )
+            api_->simulateQuotes( doc );
+        else if ( PRICE_HISTORY == type )
+            api_->simulatePriceHistory( doc, PRICE_HISTORY_YEARS, "year", 1, "daily" );
+    }
+
+    // response rejected before reaching database
+    if ( !transformed_ )
+        return parsed_;
+
+    mark( INGEST );
+    return true;
+#else
+    Q_UNUSED( filename )
+    Q_UNUSED( type )
+
+    return false;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void ScanReplay::mark( Stage stage )
+{
+    const qint64 t( stage_.nsecsElapsed() );
+
+    {
+        QMutexLocker guard( &m_ );
+        nsecs_[stage].append( t );
+    }
+
+    stage_.start();
+}
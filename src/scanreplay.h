@@ -0,0 +1,234 @@
+/**
+ * @file scanreplay.h
+ * Offline replay of a recorded scan.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCANREPLAY_H
+#define SCANREPLAY_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QDate>
+#include <QJsonObject>
+#include <QList>
+#include <QModelIndex>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+class DeptOfTheTreasury;
+class DeptOfTheTreasuryDatabaseAdapter;
+class OptionAnalyzerScheduler;
+class OptionTradingItemModel;
+class TDAmeritrade;
+class TDAmeritradeDatabaseAdapter;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Offline replay of a recorded scan.
+/**
+ * Pushes recorded API responses through the same adapters, databases and analysis workers the
+ * daemon uses, as fast as they will go and without any network. Each document is timed through
+ * every stage it passes so a full scan can be profiled reproducibly.
+ *
+ * Recorded directory layout, files in each directory are replayed in name order:
+ * @verbatim
+   marketHours    market hours responses (json)
+   treasury       daily treasury bill rates (billRates*.xml) and par yield curve rates
+                  (yieldCurve*.xml)
+   quotes         quote responses (json)
+   priceHistory   daily price history responses (json)
+   optionChains   option chain responses, one per symbol (json)
+   @endverbatim
+ *
+ * Option chains are parsed while they are transformed by the streaming reader, so they are timed
+ * as a single stage and kept out of the parse throughput.
+ *
+ * Replayed data is written to the databases in SqlDatabase::cacheDir(), so point it somewhere
+ * disposable before the first database instance.
+ *
+ * @note
+ * Requires a debug build, the simulate hooks of the APIs are only available there.
+ */
+class ScanReplay : public QObject
+{
+    Q_OBJECT
+
+    using _Myt = ScanReplay;
+    using _Mybase = QObject;
+
+public:
+
+    /// Replay stages.
+    enum Stage
+    {
+        PARSE,                                      ///< Read and parse response (except option chains).
+        TRANSFORM,                                  ///< Transform response for database (except option chains).
+        CHAIN_PARSE_TRANSFORM,                      ///< Read, parse and transform option chain.
+        INGEST,                                     ///< Write transformed data to database.
+        ANALYZE,                                    ///< Analyze symbol, from submit to complete.
+        RESULT_INSERT,                              ///< Insert analysis results into model.
+        _NUM_STAGES,
+    };
+
+    // ========================================================================
+    // CTOR / DTOR
+    // ========================================================================
+
+    /// Constructor.
+    /**
+     * @param[in] dir  recorded directory
+     * @param[in] parent  parent object
+     */
+    ScanReplay( const QString& dir, QObject *parent = nullptr );
+
+    /// Destructor.
+    virtual ~ScanReplay();
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// Retrieve replay report.
+    /**
+     * Parse throughput excludes option chains, they are reported by the chain parse transform stage.
+     * @return  per stage throughput and latency
+     */
+    virtual QJsonObject report() const;
+
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Replay recorded directory.
+    /**
+     * Returns once every replayed symbol has been analyzed.
+     * @return  @c true upon success, @c false otherwise
+     */
+    virtual bool run();
+
+    // ========================================================================
+    // Static Methods
+    // ========================================================================
+
+    /// Retrieve stage name.
+    /**
+     * @param[in] stage  stage
+     * @return  name
+     */
+    static QString stageName( Stage stage );
+
+private slots:
+
+    /// Slot for response parsed.
+    void onParsed();
+
+    /// Slot for response transformed.
+    void onTransformed();
+
+    /// Slot for option chain stored.
+    void onOptionChainChanged( const QString& symbol, const QList<QDate>& expiryDates );
+
+    /// Slot for symbol analysis complete.
+    void onSymbolComplete( const QString& symbol, int id );
+
+    /// Slot for analysis results about to be inserted.
+    void onRowsAboutToBeInserted();
+
+    /// Slot for analysis results inserted.
+    void onRowsInserted( const QModelIndex& parent, int first, int last );
+
+private:
+
+    static constexpr int WAIT_TIME = 50;
+
+    /// Recorded document types.
+    enum Document
+    {
+        MARKET_HOURS,
+        BILL_RATES,
+        YIELD_CURVE,
+        QUOTES,
+        PRICE_HISTORY,
+        OPTION_CHAIN,
+    };
+
+    QString dir_;
+
+    TDAmeritrade *api_;
+    DeptOfTheTreasury *usdot_;
+
+    TDAmeritradeDatabaseAdapter *apiAdapter_;
+    DeptOfTheTreasuryDatabaseAdapter *usdotAdapter_;
+
+    OptionTradingItemModel *model_;
+    OptionAnalyzerScheduler *scheduler_;
+
+    QString filter_;
+
+    QElapsedTimer clock_;
+    QElapsedTimer stage_;
+    QElapsedTimer insert_;
+
+    Document type_;
+
+    bool parsed_;
+    bool transformed_;
+
+    int numDocuments_;
+    int numFailures_;
+    qint64 numBytes_;
+    qint64 numChainBytes_;
+    qint64 numRows_;
+
+    qint64 analyzeStart_;
+    qint64 analyzeStop_;
+    qint64 elapsed_;
+
+    mutable QMutex m_;
+
+    QVector<qint64> nsecs_[_NUM_STAGES];
+
+    int numSymbols_;
+    int numSymbolsComplete_;
+
+    QHash<int, qint64> submitted_;
+
+    /// Replay every matching file in a directory.
+    void replay( const QString& subdir, const QString& pattern, Document type );
+
+    /// Replay one file.
+    bool replayFile( const QString& filename, Document type );
+
+    /// Record time spent on stage and start timing next one.
+    void mark( Stage stage );
+
+    // not implemented
+    ScanReplay( const _Myt& ) = delete;
+
+    // not implemented
+    _Myt &operator = ( const _Myt& ) = delete;
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SCANREPLAY_H
@@ -25,13 +25,20 @@
 
 #include "../db/stringsdb.h"
 
+#include <QElapsedTimer>
 #include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
-#include <QMutex>
 
-#include <QtConcurrent>
+#if defined( QT_DEBUG )
+#if defined( Q_OS_WINDOWS )
+#include <Windows.h>
+#include <psapi.h>
+#elif defined( Q_OS_UNIX )
+#include <sys/resource.h>
+#endif
+#endif
 
 // uncomment to debug content data
 //#define DEBUG_JSON
@@ -49,32 +56,41 @@ static const QString PUT( "PUT" );
 
 static const QString NULL_STR( "NULL" );
 
+#if defined( QT_DEBUG )
+static qint64 peakMemoryUsage();
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 TDAmeritradeDatabaseAdapter::TDAmeritradeDatabaseAdapter( QObject *parent ) :
     _Mybase( parent )
 {
+    QStringList dateColumns;
+    QStringList dateTimeColumns;
+
+    QStringList dateTimeColumnsISO;
+
     // date columns
-    dateColumns_.append( JSON_DIV_DATE );
-    dateColumns_.append( JSON_DIVIDEND_DATE );
-    dateColumns_.append( JSON_DIVIDEND_PAY_DATE );
-    dateColumns_.append( JSON_SETTLEMENT_DATE );
+    dateColumns.append( JSON_DIV_DATE );
+    dateColumns.append( JSON_DIVIDEND_DATE );
+    dateColumns.append( JSON_DIVIDEND_PAY_DATE );
+    dateColumns.append( JSON_SETTLEMENT_DATE );
 
     // date time columns
-    dateTimeColumns_.append( JSON_BOND_MATURITY_DATE );
-    dateTimeColumns_.append( JSON_DATETIME );
-    dateTimeColumns_.append( JSON_EXPIRY_DATE );
-    dateTimeColumns_.append( JSON_LAST_TRADING_DAY );
-    dateTimeColumns_.append( JSON_MATURITY_DATE );
-    dateTimeColumns_.append( JSON_QUOTE_TIME );
-    dateTimeColumns_.append( JSON_REG_MARKET_TRADE_TIME );
-    dateTimeColumns_.append( JSON_TRADE_TIME );
-
-    dateTimeColumnsISO_.append( JSON_DIV_DATE );
-    dateTimeColumnsISO_.append( JSON_DIVIDEND_DATE );
-    dateTimeColumnsISO_.append( JSON_DIVIDEND_PAY_DATE );
-    dateTimeColumnsISO_.append( JSON_OPTION_EXPIRY_DATE );
-    dateTimeColumnsISO_.append( JSON_ORDER_DATE );
-    dateTimeColumnsISO_.append( JSON_TRANS_DATE );
+    dateTimeColumns.append( JSON_BOND_MATURITY_DATE );
+    dateTimeColumns.append( JSON_DATETIME );
+    dateTimeColumns.append( JSON_EXPIRY_DATE );
+    dateTimeColumns.append( JSON_LAST_TRADING_DAY );
+    dateTimeColumns.append( JSON_MATURITY_DATE );
+    dateTimeColumns.append( JSON_QUOTE_TIME );
+    dateTimeColumns.append( JSON_REG_MARKET_TRADE_TIME );
+    dateTimeColumns.append( JSON_TRADE_TIME );
+
+    dateTimeColumnsISO.append( JSON_DIV_DATE );
+    dateTimeColumnsISO.append( JSON_DIVIDEND_DATE );
+    dateTimeColumnsISO.append( JSON_DIVIDEND_PAY_DATE );
+    dateTimeColumnsISO.append( JSON_OPTION_EXPIRY_DATE );
+    dateTimeColumnsISO.append( JSON_ORDER_DATE );
+    dateTimeColumnsISO.append( JSON_TRANS_DATE );
 
     // quotes
     quoteFields_[JSON_52_WK_HIGH] = DB_FIFTY_TWO_WEEK_HIGH;
@@ -432,6 +448,33 @@ TDAmeritradeDatabaseAdapter::TDAmeritradeDatabaseAdapter( QObject *parent ) :
     transactionItem_[JSON_SYMBOL] = DB_SYMBOL;
     transactionItem_[JSON_TYPE] = DB_ASSET_SUB_TYPE;
     transactionItem_[JSON_UNDERLYING_SYMBOL] = DB_UNDERLYING_SYMBOL;
+
+    // compile field maps
+    compile( accountFields_, dateColumns, dateTimeColumns, dateTimeColumnsISO );
+    compile( instrumentFields_, dateColumns, dateTimeColumns, dateTimeColumnsISO );
+    compile( marketHoursFields_, dateColumns, dateTimeColumns, dateTimeColumnsISO );
+    compile( optionChainFields_, dateColumns, dateTimeColumns, dateTimeColumnsISO );
+    compile( positionFields_, dateColumns, dateTimeColumns, dateTimeColumnsISO );
+    compile( priceHistoryFields_, dateColumns, dateTimeColumns, dateTimeColumnsISO );
+    compile( quoteFields_, dateColumns, dateTimeColumns, dateTimeColumnsISO );
+    compile( transactionFields_, dateColumns, dateTimeColumns, dateTimeColumnsISO );
+    compile( transactionItem_, dateColumns, dateTimeColumns, dateTimeColumnsISO );
+
+    // option contracts (resolved once so the chain reader never touches strings)
+    for ( FieldMap::const_iterator f( quoteFields_.constBegin() ); f != quoteFields_.constEnd(); ++f )
+    {
+        int field( -1 );
+
+        if ( CONVERT_IGNORE != f->conversion )
+            for ( int i( 0 ); i < OptionContract::NUM_FIELDS; ++i )
+                if ( f->column == OptionContract::columnName( (OptionContract::Field) i ) )
+                {
+                    field = i;
+                    break;
+                }
+
+        optionContractFields_[f.key().toLatin1()] = field;
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -504,8 +547,15 @@ bool TDAmeritradeDatabaseAdapter::transformMarketHours( const QJsonObject& tdobj
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-bool TDAmeritradeDatabaseAdapter::transformOptionChain( const QJsonObject& tdobj ) const
+bool TDAmeritradeDatabaseAdapter::transformOptionChain( const QByteArray& data ) const
 {
+    TDAmeritradeOptionChainReader contracts( data, optionContractFields_ );
+
+    if ( !contracts.readHeader() )
+        return false;
+
+    const QJsonObject& tdobj( contracts.header() );
+
     // validate
     const QJsonObject::const_iterator status( tdobj.constFind( JSON_STATUS ) );
     const QJsonObject::const_iterator strategy( tdobj.constFind( JSON_STRATEGY ) );
@@ -553,35 +603,6 @@ bool TDAmeritradeDatabaseAdapter::transformOptionChain( const QJsonObject& tdobj
 
     LOG_DEBUG << "transform option chain for " << qPrintable( symbol->toString() ) << "...";
 
-    const QJsonObject::const_iterator calls( tdobj.constFind( JSON_CALL_EXP_DATE_MAP ) );
-    const QJsonObject::const_iterator puts( tdobj.constFind( JSON_PUT_EXP_DATE_MAP ) );
-
-    const double underlyingPrice( tdobj[JSON_UNDERLYING_PRICE].toDouble() );
-
-    // parse out calls and puts
-    QJsonArray options;
-    QMutex m;
-
-    QFutureSynchronizer<void> f;
-
-    if (( tdobj.constEnd() != calls ) && ( calls->isObject() ))
-    {
-#if QT_VERSION_CHECK( 6, 2, 0 ) <= QT_VERSION
-        f.addFuture( QtConcurrent::run( &_Myt::parseOptionChain, this, calls, underlyingPrice, &options, &m ) );
-#else
-        f.addFuture( QtConcurrent::run( this, &_Myt::parseOptionChain, calls, underlyingPrice, &options, &m ) );
-#endif
-    }
-
-    if (( tdobj.constEnd() != puts ) && ( puts->isObject() ))
-    {
-#if QT_VERSION_CHECK( 6, 2, 0 ) <= QT_VERSION
-        f.addFuture( QtConcurrent::run( &_Myt::parseOptionChain, this, puts, underlyingPrice, &options, &m ) );
-#else
-        f.addFuture( QtConcurrent::run( this, &_Myt::parseOptionChain, puts, underlyingPrice, &options, &m ) );
-#endif
-    }
-
     // transform!
     QJsonObject optionChain;
     transform( tdobj, optionChainFields_, optionChain );
@@ -597,18 +618,15 @@ bool TDAmeritradeDatabaseAdapter::transformOptionChain( const QJsonObject& tdobj
         optionChain[DB_QUOTES] = quotes;
     }
 
-    // wait for completion
-    f.waitForFinished();
-
-    optionChain[DB_OPTIONS] = options;
-
-    QJsonObject obj;
-    obj[DB_OPTION_CHAIN] = optionChain;
+#ifdef DEBUG_JSON
+    saveObject( optionChain, "transform.json" );
+#endif
 
-    complete( obj );
+    // contracts are decoded as they are consumed
+    emit optionChainTransformComplete( optionChain, &contracts );
 
-    LOG_TRACE << "done";
-    return true;
+    LOG_TRACE << "done " << contracts.numContracts() << " contracts " << contracts.numSkipped() << " skipped";
+    return !contracts.hasError();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -701,58 +719,153 @@ bool TDAmeritradeDatabaseAdapter::transformTransactions( const QJsonArray& a ) c
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-void TDAmeritradeDatabaseAdapter::transform( const QJsonObject& obj, const FieldMap& fieldMap, QJsonObject& result ) const
+#if defined( QT_DEBUG )
+
+void TDAmeritradeDatabaseAdapter::optionChainStreamPerf( const QString& filename, int loops )
 {
-    // iterate all json fields
-    for ( QJsonObject::const_iterator f( obj.constBegin() ); f != obj.constEnd(); ++f )
+    QFile f( filename );
+
+    if ( !f.open( QIODevice::ReadOnly ) )
     {
-        if ( f->isNull() )
-            continue;
+        LOG_WARN << "failed to open " << qPrintable( filename );
+        return;
+    }
 
-        // determine key name
-        const QString key( f.key() );
+    const QByteArray data( f.readAll() );
+    const double mb( data.size() / (1024.0 * 1024.0) );
 
-        QString keyAlt( key );
+    const _Myt adapter;
 
-        if ( key.endsWith( "InDouble" ) )
-            keyAlt.remove( "InDouble" );
-        else if ( key.endsWith( "InLong" ) )
-            keyAlt.remove( "InLong" );
+    QElapsedTimer t;
 
-        // determine mapping of this field
-        FieldMap::const_iterator mapping( fieldMap.constFind( keyAlt ) );
+    // stream every contract
+    qint64 streamNsecs( 0 );
+    qint64 streamPeak( peakMemoryUsage() );
 
-        if ( fieldMap.constEnd() == mapping )
+    int contracts( 0 );
+
+    for ( int n( loops ); n--; )
+    {
+        t.start();
+
+        TDAmeritradeOptionChainReader reader( data, adapter.optionContractFields_ );
+        OptionContract contract;
+
+        if ( reader.readHeader() )
+            while ( reader.readNext( contract ) )
+                continue;
+
+        streamNsecs += t.nsecsElapsed();
+
+        if ( reader.hasError() )
         {
-            LOG_WARN << "unhandled field " << qPrintable( key );
-            continue;
+            LOG_WARN << "failed to read " << qPrintable( filename );
+            return;
         }
 
-        const QString mappedKey( mapping.value() );
+        contracts = reader.numContracts();
+    }
 
-        if ( mappedKey.isEmpty() )
+    streamPeak = peakMemoryUsage() - streamPeak;
+
+    // parse whole document
+    qint64 docNsecs( 0 );
+    qint64 docPeak( peakMemoryUsage() );
+
+    for ( int n( loops ); n--; )
+    {
+        t.start();
+
+        const QJsonDocument doc( QJsonDocument::fromJson( data ) );
+
+        docNsecs += t.nsecsElapsed();
+
+        if ( !doc.isObject() )
+        {
+            LOG_WARN << "failed to parse " << qPrintable( filename );
+            return;
+        }
+    }
+
+    docPeak = peakMemoryUsage() - docPeak;
+
+    LOG_INFO << "read " << contracts << " contracts (" << mb << " MB) " << loops << " times";
+
+    if ( 0 < streamNsecs )
+        LOG_INFO << "stream " << (loops * mb * 1.0e9 / streamNsecs) << " MB/s, peak memory growth " << (streamPeak / 1024) << " KB";
+
+    if ( 0 < docNsecs )
+        LOG_INFO << "document " << (loops * mb * 1.0e9 / docNsecs) << " MB/s, peak memory growth " << (docPeak / 1024) << " KB";
+}
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void TDAmeritradeDatabaseAdapter::compile( FieldMap& fieldMap, const QStringList& dateColumns, const QStringList& dateTimeColumns, const QStringList& dateTimeColumnsISO )
+{
+    const FieldMap fields( fieldMap );
+
+    for ( FieldMap::const_iterator f( fields.constBegin() ); f != fields.constEnd(); ++f )
+    {
+        FieldMapping mapping( f.value() );
+
+        // determine conversion
+        if ( CONVERT_IGNORE != mapping.conversion )
+        {
+            if ( dateTimeColumnsISO.contains( f.key() ) )
+                mapping.conversion = dateColumns.contains( f.key() ) ? CONVERT_ISO_DATE : CONVERT_ISO_DATETIME;
+            else if ( dateTimeColumns.contains( f.key() ) )
+                mapping.conversion = dateColumns.contains( f.key() ) ? CONVERT_EPOCH_DATE : CONVERT_EPOCH_DATETIME;
+        }
+
+        // same field is sometimes sent with a type suffix
+        fieldMap[f.key()] = mapping;
+
+        if ( !fields.contains( f.key() + "InDouble" ) )
+            fieldMap[f.key() + "InDouble"] = mapping;
+
+        if ( !fields.contains( f.key() + "InLong" ) )
+            fieldMap[f.key() + "InLong"] = mapping;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void TDAmeritradeDatabaseAdapter::transform( const QJsonObject& obj, const FieldMap& fieldMap, QJsonObject& result ) const
+{
+    // iterate all json fields
+    for ( QJsonObject::const_iterator f( obj.constBegin() ); f != obj.constEnd(); ++f )
+    {
+        if ( f->isNull() )
             continue;
 
-        // datetime
-        if (( dateTimeColumns_.contains( keyAlt ) ) || ( dateTimeColumnsISO_.contains( keyAlt ) ))
+        // determine mapping of this field
+        const FieldMap::const_iterator mapping( fieldMap.constFind( f.key() ) );
+
+        if ( fieldMap.constEnd() == mapping )
         {
-            QDateTime dt;
-
-            // iso datetime -or-
-            // epoch time
-            if ( dateTimeColumnsISO_.contains( keyAlt ) )
-                dt = QDateTime::fromString( f->toString(), Qt::ISODate );
-            else
-                dt = QDateTime::fromMSecsSinceEpoch( f->toVariant().toLongLong() );
-
-            if ( dateColumns_.contains( keyAlt ) )
-                result[ mappedKey ] = dt.date().toString( Qt::ISODate );
-            else
-                result[ mappedKey ] = dt.toString( Qt::ISODateWithMs );
+            LOG_WARN << "unhandled field " << qPrintable( f.key() );
+            continue;
         }
-        else
+
+        switch ( mapping->conversion )
         {
-            result[ mappedKey ] = f.value();
+        case CONVERT_IGNORE:
+            break;
+        case CONVERT_EPOCH_DATE:
+            result[mapping->column] = QDateTime::fromMSecsSinceEpoch( (qint64) f->toDouble() ).date().toString( Qt::ISODate );
+            break;
+        case CONVERT_EPOCH_DATETIME:
+            result[mapping->column] = QDateTime::fromMSecsSinceEpoch( (qint64) f->toDouble() ).toString( Qt::ISODateWithMs );
+            break;
+        case CONVERT_ISO_DATE:
+            result[mapping->column] = QDateTime::fromString( f->toString(), Qt::ISODate ).date().toString( Qt::ISODate );
+            break;
+        case CONVERT_ISO_DATETIME:
+            result[mapping->column] = QDateTime::fromString( f->toString(), Qt::ISODate ).toString( Qt::ISODateWithMs );
+            break;
+        default:
+            result[mapping->column] = f.value();
+            break;
         }
     }
 }
@@ -774,7 +887,7 @@ QJsonObject TDAmeritradeDatabaseAdapter::parseAccount( const QJsonObject& obj )
     transform( obj, accountFields_, result );
 
     // balances
-    for ( FieldMap::const_iterator balance( balances_.constBegin() ); balance != balances_.constEnd(); ++balance )
+    for ( NameMap::const_iterator balance( balances_.constBegin() ); balance != balances_.constEnd(); ++balance )
     {
         const QJsonObject::const_iterator it( obj.constFind( balance.key() ) );
 
@@ -896,71 +1009,6 @@ void TDAmeritradeDatabaseAdapter::parseMarketHours( const QJsonObject& market, Q
 
 }
 
-///////////////////////////////////////////////////////////////////////////////////////////////////
-void TDAmeritradeDatabaseAdapter::parseOptionChain( const QJsonObject::const_iterator& it, double underlyingPrice, QJsonArray *result, QMutex *m ) const
-{
-    QStringList checkForBadValues;
-    checkForBadValues.append( DB_VOLATILITY );
-    checkForBadValues.append( DB_DELTA );
-    checkForBadValues.append( DB_GAMMA );
-    checkForBadValues.append( DB_THETA );
-    checkForBadValues.append( DB_VEGA );
-    checkForBadValues.append( DB_RHO );
-    checkForBadValues.append( DB_THEO_OPTION_VALUE );
-
-    // iterate all expirations
-    foreach ( const QJsonValue& expiry, it->toObject() )
-        if ( expiry.isObject() )
-        {
-            // iterate all strike prices
-            foreach ( const QJsonValue& strikes, expiry.toObject() )
-                if ( strikes.isArray() )
-                {
-                    // process array (for some reason they embed the option within an array)
-                    foreach ( const QJsonValue& strikeVal, strikes.toArray() )
-                        if ( strikeVal.isObject() )
-                        {
-                            const QJsonObject strike( strikeVal.toObject() );
-
-                            // check for bad/invalid option
-                            const int bidSize( strike[JSON_BID_SIZE].toInt() );
-                            const int askSize( strike[JSON_ASK_SIZE].toInt() );
-                            const qint64 quoteTime( strike[JSON_QUOTE_TIME_IN_LONG].toVariant().toLongLong() );
-
-                            if (( !bidSize ) && ( !askSize ) && ( !quoteTime ))
-                                continue;
-
-                            // transform!
-                            QJsonObject obj;
-                            transform( strike, quoteFields_, obj );
-
-                            const QString desc( strike[JSON_DESC].toString() );
-                            const QString type( strike[JSON_PUT_CALL].toString() );
-
-                            obj[DB_STAMP] = obj[DB_QUOTE_TIME];
-                            obj[DB_BID_ASK_SIZE] = QString::number( bidSize ) + " x " + QString::number( askSize );
-                            obj[DB_IS_WEEKLY] = desc.contains( "(Weekly)" );
-                            obj[DB_IS_QUARTERLY] = desc.contains( "(Quarterly)" );
-
-                            if ( CALL == type )
-                                obj[DB_INTRINSIC_VALUE] = underlyingPrice - strike[JSON_STRIKE_PRICE].toDouble();
-                            else if ( PUT == type )
-                                obj[DB_INTRINSIC_VALUE] = strike[JSON_STRIKE_PRICE].toDouble() - underlyingPrice;
-
-                            // fixup bad values
-                            foreach ( const QString& f, checkForBadValues )
-                                if (( "NaN" == obj[f].toString() ) ||
-                                    ( -999.0 == obj[f].toDouble() ) ||
-                                    ( -1.0 == obj[f].toDouble() && DB_THEO_OPTION_VALUE == f ))
-                                    obj[f] = QJsonValue();
-
-                            QMutexLocker guard( m );
-                            result->append( obj );
-                        }
-                }
-        }
-}
-
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 QJsonArray TDAmeritradeDatabaseAdapter::parsePriceHistory( const QJsonArray& a ) const
 {
@@ -1196,3 +1244,27 @@ void TDAmeritradeDatabaseAdapter::saveObject( const QJsonObject& obj, const QStr
 #endif
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#if defined( QT_DEBUG )
+qint64 peakMemoryUsage()
+{
+#if defined( Q_OS_WINDOWS )
+    PROCESS_MEMORY_COUNTERS pmc;
+
+    if ( GetProcessMemoryInfo( GetCurrentProcess(), &pmc, sizeof( pmc ) ) )
+        return pmc.PeakWorkingSetSize;
+#elif defined( Q_OS_UNIX )
+    struct rusage usage;
+
+    // linux reports kilobytes, mac reports bytes
+    if ( 0 == getrusage( RUSAGE_SELF, &usage ) )
+#if defined( Q_OS_MACOS )
+        return usage.ru_maxrss;
+#else
+        return 1024 * (qint64) usage.ru_maxrss;
+#endif
+#endif
+
+    return 0;
+}
+#endif
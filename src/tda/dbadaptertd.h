@@ -23,13 +23,14 @@
 #ifndef DBADAPTERTD_H
 #define DBADAPTERTD_H
 
+#include "optionchainreadertd.h"
+
 #include <QDateTime>
+#include <QHash>
 #include <QJsonObject>
 #include <QMap>
 #include <QObject>
 
-class QMutex;
-
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// TD Ameritrade database adpater.
@@ -52,6 +53,15 @@ signals:
      */
     void transformComplete( const QJsonObject& obj ) const;
 
+    /// Signal for option chain transform complete.
+    /**
+     * Chain header is in database format; contracts are read one at a time from @a contracts,
+     * which is only valid for the duration of the signal.
+     * @param[in] obj  option chain header
+     * @param[in] contracts  option chain contracts
+     */
+    void optionChainTransformComplete( const QJsonObject& obj, OptionContractReader *contracts ) const;
+
 public:
 
     // ========================================================================
@@ -96,10 +106,11 @@ public slots:
 
     /// Transform option chain to database format.
     /**
-     * @param[in] obj  data
+     * Contracts are decoded straight out of @a data as the database consumes them.
+     * @param[in] data  option chain response (json)
      * @return  @c true upon success, @c false otherwise
      */
-    virtual bool transformOptionChain( const QJsonObject& obj ) const;
+    virtual bool transformOptionChain( const QByteArray& data ) const;
 
     /// Transform price history to database format.
     /**
@@ -122,15 +133,54 @@ public slots:
      */
     virtual bool transformTransactions( const QJsonArray& a ) const;
 
+public:
+
+    // ========================================================================
+    // Static Methods
+    // ========================================================================
+
+#if defined( QT_DEBUG )
+    /// Measure option chain stream performance.
+    /**
+     * Compares decoding every contract with the streaming reader against parsing the whole
+     * response into a document.
+     * @param[in] filename  recorded option chain response (json)
+     * @param[in] loops  number of times to decode chain
+     */
+    static void optionChainStreamPerf( const QString& filename, int loops );
+#endif
+
 private:
 
-    /// Field map type.
-    using FieldMap = QMap<QString, QString>;
+    /// Field conversions.
+    enum FieldConversion
+    {
+        CONVERT_COPY,                               ///< Copy value as is.
+        CONVERT_IGNORE,                             ///< Field not stored.
+        CONVERT_EPOCH_DATE,                         ///< Epoch time to date.
+        CONVERT_EPOCH_DATETIME,                     ///< Epoch time to date time.
+        CONVERT_ISO_DATE,                           ///< ISO date time to date.
+        CONVERT_ISO_DATETIME,                       ///< ISO date time to date time.
+    };
+
+    /// Field mapping.
+    struct FieldMapping
+    {
+        QString column;                             ///< Database column.
+        FieldConversion conversion;                 ///< Conversion of value.
+
+        /// Constructor.
+        FieldMapping( const QString& c = QString() ) : column( c ), conversion( c.isEmpty() ? CONVERT_IGNORE : CONVERT_COPY ) {}
 
-    QStringList dateColumns_;
-    QStringList dateTimeColumns_;
+        /// Constructor.
+        FieldMapping( const char *c ) : FieldMapping( QString( c ) ) {}
+    };
 
-    QStringList dateTimeColumnsISO_;
+    /// Field map type (keyed by json field name).
+    using FieldMap = QHash<QString, FieldMapping>;
+
+    /// Name map type.
+    using NameMap = QMap<QString, QString>;
 
     FieldMap accountFields_;
     FieldMap instrumentFields_;
@@ -141,10 +191,16 @@ private:
     FieldMap quoteFields_;
     FieldMap transactionFields_;
 
-    FieldMap balances_;
-    FieldMap sessionHours_;
+    TDAmeritradeOptionChainReader::FieldIndexMap optionContractFields_;
+
+    NameMap balances_;
+    NameMap sessionHours_;
+
     FieldMap transactionItem_;
 
+    /// Compile field map.
+    static void compile( FieldMap& fieldMap, const QStringList& dateColumns, const QStringList& dateTimeColumns, const QStringList& dateTimeColumnsISO );
+
     /// Transform json object.
     void transform( const QJsonObject& obj, const FieldMap& mapping, QJsonObject& result ) const;
 
@@ -160,9 +216,6 @@ private:
     /// Parse market hours.
     void parseMarketHours( const QJsonObject& obj, QJsonArray *result ) const;
 
-    /// Parse options (concurrent version).
-    void parseOptionChain( const QJsonObject::const_iterator& it, double underlyingPrice, QJsonArray *result, QMutex *m ) const;
-
     /// Parse price history.
     QJsonArray parsePriceHistory( const QJsonArray& a ) const;
 
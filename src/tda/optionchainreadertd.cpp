@@ -0,0 +1,424 @@
+/**
+ * @file optionchainreadertd.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "common.h"
+#include "optionchainreadertd.h"
+#include "stringsjson.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+
+static const QString CALL( "CALL" );
+static const QString PUT( "PUT" );
+
+static const QString WEEKLY( "(Weekly)" );
+static const QString QUARTERLY( "(Quarterly)" );
+
+static const double BAD_VALUE = -999.0;
+static const double BAD_THEO_OPTION_VALUE = -1.0;
+
+static bool readBool( const JsonStreamReader& r, bool& value );
+static bool readDouble( const JsonStreamReader& r, double& value );
+static bool readInt( const JsonStreamReader& r, int& value );
+static bool readLong( const JsonStreamReader& r, qint64& value );
+static bool readText( const JsonStreamReader& r, QString& value );
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+TDAmeritradeOptionChainReader::TDAmeritradeOptionChainReader( const QByteArray& data, const FieldIndexMap& fields ) :
+    data_( data ),
+    fields_( fields ),
+    underlyingPrice_( 0.0 ),
+    readerOpen_( false ),
+    numContracts_( 0 ),
+    numSkipped_( 0 )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+TDAmeritradeOptionChainReader::~TDAmeritradeOptionChainReader()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool TDAmeritradeOptionChainReader::readHeader()
+{
+    JsonStreamReader r( data_ );
+
+    if ( JsonStreamReader::StartObject != r.readNext() )
+    {
+        setError( r.hasError() ? r.errorString() : "not an object" );
+        return false;
+    }
+
+    while ( JsonStreamReader::Name == r.readNext() )
+    {
+        const QString key( r.toString() );
+        const JsonStreamReader::TokenType type( r.readNext() );
+
+        if (( JsonStreamReader::StartObject == type ) || ( JsonStreamReader::StartArray == type ))
+        {
+            const qint64 start( r.tokenOffset() );
+
+            if ( !r.skipCurrentElement() )
+                break;
+
+            // expiration date maps are streamed later, everything else is small
+            if (( JSON_CALL_EXP_DATE_MAP == key ) || ( JSON_PUT_EXP_DATE_MAP == key ))
+                maps_.append( start );
+            else
+            {
+                const QJsonDocument doc( QJsonDocument::fromJson( data_.mid( start, r.offset() - start ) ) );
+
+                if ( doc.isArray() )
+                    header_[key] = doc.array();
+                else
+                    header_[key] = doc.object();
+            }
+        }
+        else if ( JsonStreamReader::String == type )
+            header_[key] = r.toString();
+        else if ( JsonStreamReader::Number == type )
+            header_[key] = r.toDouble();
+        else if ( JsonStreamReader::Bool == type )
+            header_[key] = r.toBool();
+        else if ( JsonStreamReader::Null == type )
+            header_[key] = QJsonValue();
+        else
+            break;
+    }
+
+    if ( JsonStreamReader::EndObject != r.tokenType() )
+    {
+        setError( r.hasError() ? r.errorString() : "bad option chain" );
+        return false;
+    }
+
+    underlyingPrice_ = header_[JSON_UNDERLYING_PRICE].toDouble();
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool TDAmeritradeOptionChainReader::readNext( OptionContract& contract )
+{
+    while ( !hasError() )
+    {
+        // open next expiration date map
+        if ( !readerOpen_ )
+        {
+            if ( maps_.isEmpty() )
+                break;
+
+            reader_ = JsonStreamReader( data_, maps_.takeFirst() );
+            readerOpen_ = true;
+        }
+
+        const JsonStreamReader::TokenType type( reader_.readNext() );
+
+        if ( JsonStreamReader::Invalid == type )
+            setError( reader_.errorString() );
+        else if ( JsonStreamReader::EndDocument == type )
+            readerOpen_ = false;
+
+        // for some reason they embed each option within an array
+        else if (( JsonStreamReader::StartObject == type ) && ( CONTRACT_DEPTH == reader_.depth() ))
+        {
+            if ( !readContract( contract ) )
+                break;
+
+            // check for bad/invalid option
+            const bool noBidSize(( !contract.has( OptionContract::BID_SIZE ) ) || ( !contract.bidSize ));
+            const bool noAskSize(( !contract.has( OptionContract::ASK_SIZE ) ) || ( !contract.askSize ));
+            const bool noQuoteTime(( !contract.has( OptionContract::QUOTE_TIME ) ) || ( !contract.quoteTime ));
+
+            if (( noBidSize ) && ( noAskSize ) && ( noQuoteTime ))
+            {
+                ++numSkipped_;
+                continue;
+            }
+
+            ++numContracts_;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool TDAmeritradeOptionChainReader::readContract( OptionContract& contract )
+{
+    static const OptionContract::Field checkForBadValues[] =
+    {
+        OptionContract::VOLATILITY,
+        OptionContract::DELTA,
+        OptionContract::GAMMA,
+        OptionContract::THETA,
+        OptionContract::VEGA,
+        OptionContract::RHO,
+        OptionContract::THEO_OPTION_VALUE,
+    };
+
+    contract.clear();
+
+    while ( JsonStreamReader::Name == reader_.readNext() )
+    {
+        const QByteArray key( reader_.rawText() );
+        const JsonStreamReader::TokenType type( reader_.readNext() );
+
+        if ( JsonStreamReader::Invalid == type )
+            break;
+
+        // nested values (i.e. deliverables) are not stored
+        if (( JsonStreamReader::StartObject == type ) || ( JsonStreamReader::StartArray == type ))
+            if ( !reader_.skipCurrentElement() )
+                break;
+
+        // determine mapping of this field
+        const FieldIndexMap::const_iterator mapping( fields_.constFind( key ) );
+
+        if ( fields_.constEnd() == mapping )
+            LOG_WARN << "unhandled field " << qPrintable( QString::fromLatin1( key ) );
+        else if ( 0 <= mapping.value() )
+        {
+            const OptionContract::Field f( (OptionContract::Field) mapping.value() );
+
+            // values of the wrong type (i.e. "NaN") are left missing
+            if ( readField( contract, f ) )
+                contract.set( f );
+        }
+    }
+
+    if ( JsonStreamReader::EndObject != reader_.tokenType() )
+    {
+        setError( reader_.hasError() ? reader_.errorString() : "bad option" );
+        return false;
+    }
+
+    // fixup bad values
+    for ( size_t i( 0 ); i < sizeof( checkForBadValues ) / sizeof( checkForBadValues[0] ); ++i )
+    {
+        const OptionContract::Field f( checkForBadValues[i] );
+
+        if (( contract.has( f ) ) && ( BAD_VALUE == contract.value( f ).toDouble() ))
+            contract.unset( f );
+    }
+
+    if (( contract.has( OptionContract::THEO_OPTION_VALUE ) ) && ( BAD_THEO_OPTION_VALUE == contract.theoOptionValue ))
+        contract.unset( OptionContract::THEO_OPTION_VALUE );
+
+    // intrinsic value
+    if ( contract.has( OptionContract::STRIKE_PRICE ) )
+    {
+        if ( CALL == contract.type )
+        {
+            contract.intrinsicValue = underlyingPrice_ - contract.strikePrice;
+            contract.set( OptionContract::INTRINSIC_VALUE );
+        }
+        else if ( PUT == contract.type )
+        {
+            contract.intrinsicValue = contract.strikePrice - underlyingPrice_;
+            contract.set( OptionContract::INTRINSIC_VALUE );
+        }
+    }
+
+    contract.isWeekly = contract.description.contains( WEEKLY );
+    contract.set( OptionContract::IS_WEEKLY );
+
+    contract.isQuarterly = contract.description.contains( QUARTERLY );
+    contract.set( OptionContract::IS_QUARTERLY );
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool TDAmeritradeOptionChainReader::readField( OptionContract& contract, OptionContract::Field f ) const
+{
+    switch ( f )
+    {
+    case OptionContract::SYMBOL:
+        return readText( reader_, contract.symbol );
+    case OptionContract::TYPE:
+        return readText( reader_, contract.type );
+    case OptionContract::STRIKE_PRICE:
+        return readDouble( reader_, contract.strikePrice );
+    case OptionContract::DESCRIPTION:
+        return readText( reader_, contract.description );
+    case OptionContract::BID_PRICE:
+        return readDouble( reader_, contract.bidPrice );
+    case OptionContract::BID_SIZE:
+        return readInt( reader_, contract.bidSize );
+    case OptionContract::ASK_PRICE:
+        return readDouble( reader_, contract.askPrice );
+    case OptionContract::ASK_SIZE:
+        return readInt( reader_, contract.askSize );
+    case OptionContract::LAST_PRICE:
+        return readDouble( reader_, contract.lastPrice );
+    case OptionContract::LAST_SIZE:
+        return readInt( reader_, contract.lastSize );
+    case OptionContract::INTRINSIC_VALUE:
+        return readDouble( reader_, contract.intrinsicValue );
+    case OptionContract::OPEN_PRICE:
+        return readDouble( reader_, contract.openPrice );
+    case OptionContract::HIGH_PRICE:
+        return readDouble( reader_, contract.highPrice );
+    case OptionContract::LOW_PRICE:
+        return readDouble( reader_, contract.lowPrice );
+    case OptionContract::CLOSE_PRICE:
+        return readDouble( reader_, contract.closePrice );
+    case OptionContract::CHANGE:
+        return readDouble( reader_, contract.change );
+    case OptionContract::PERCENT_CHANGE:
+        return readDouble( reader_, contract.percentChange );
+    case OptionContract::TOTAL_VOLUME:
+        return readLong( reader_, contract.totalVolume );
+    case OptionContract::QUOTE_TIME:
+        return readLong( reader_, contract.quoteTime );
+    case OptionContract::TRADE_TIME:
+        return readLong( reader_, contract.tradeTime );
+    case OptionContract::MARK:
+        return readDouble( reader_, contract.mark );
+    case OptionContract::MARK_CHANGE:
+        return readDouble( reader_, contract.markChange );
+    case OptionContract::MARK_PERCENT_CHANGE:
+        return readDouble( reader_, contract.markPercentChange );
+    case OptionContract::EXCHANGE_NAME:
+        return readText( reader_, contract.exchangeName );
+    case OptionContract::VOLATILITY:
+        return readDouble( reader_, contract.volatility );
+    case OptionContract::DELTA:
+        return readDouble( reader_, contract.delta );
+    case OptionContract::GAMMA:
+        return readDouble( reader_, contract.gamma );
+    case OptionContract::THETA:
+        return readDouble( reader_, contract.theta );
+    case OptionContract::VEGA:
+        return readDouble( reader_, contract.vega );
+    case OptionContract::RHO:
+        return readDouble( reader_, contract.rho );
+    case OptionContract::TIME_VALUE:
+        return readDouble( reader_, contract.timeValue );
+    case OptionContract::OPEN_INTEREST:
+        return readLong( reader_, contract.openInterest );
+    case OptionContract::IS_IN_THE_MONEY:
+        return readBool( reader_, contract.isInTheMoney );
+    case OptionContract::THEO_OPTION_VALUE:
+        return readDouble( reader_, contract.theoOptionValue );
+    case OptionContract::THEO_VOLATILITY:
+        return readDouble( reader_, contract.theoVolatility );
+    case OptionContract::IS_MINI:
+        return readBool( reader_, contract.isMini );
+    case OptionContract::IS_NON_STANDARD:
+        return readBool( reader_, contract.isNonStandard );
+    case OptionContract::IS_INDEX:
+        return readBool( reader_, contract.isIndex );
+    case OptionContract::IS_WEEKLY:
+        return readBool( reader_, contract.isWeekly );
+    case OptionContract::IS_QUARTERLY:
+        return readBool( reader_, contract.isQuarterly );
+    case OptionContract::EXPIRY_DATE:
+        return readLong( reader_, contract.expiryDate );
+    case OptionContract::EXPIRY_TYPE:
+        return readText( reader_, contract.expiryType );
+    case OptionContract::DAYS_TO_EXPIRY:
+        return readInt( reader_, contract.daysToExpiry );
+    case OptionContract::LAST_TRADING_DAY:
+        return readLong( reader_, contract.lastTradingDay );
+    case OptionContract::MULTIPLIER:
+        return readInt( reader_, contract.multiplier );
+    case OptionContract::SETTLEMENT_TYPE:
+        return readText( reader_, contract.settlementType );
+    case OptionContract::DELIVERABLE_NOTE:
+        return readText( reader_, contract.deliverableNote );
+    default:
+        break;
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void TDAmeritradeOptionChainReader::setError( const QString& message )
+{
+    LOG_WARN << "error reading option chain " << qPrintable( message );
+    errorString_ = message;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool readBool( const JsonStreamReader& r, bool& value )
+{
+    if ( JsonStreamReader::Bool != r.tokenType() )
+        return false;
+
+    value = r.toBool();
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool readDouble( const JsonStreamReader& r, double& value )
+{
+    if ( JsonStreamReader::Number != r.tokenType() )
+        return false;
+
+    bool ok;
+    value = r.toDouble( &ok );
+
+    return ok;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool readInt( const JsonStreamReader& r, int& value )
+{
+    qint64 v;
+
+    if ( !readLong( r, v ) )
+        return false;
+
+    value = (int) v;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool readLong( const JsonStreamReader& r, qint64& value )
+{
+    if ( JsonStreamReader::Number != r.tokenType() )
+        return false;
+
+    bool ok;
+    value = r.toLongLong( &ok );
+
+    // fractional (i.e. 1.0) or exponent notation
+    if ( !ok )
+        value = (qint64) r.toDouble( &ok );
+
+    return ok;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool readText( const JsonStreamReader& r, QString& value )
+{
+    if ( JsonStreamReader::String != r.tokenType() )
+        return false;
+
+    value = r.toString();
+    return true;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file optionchainreadertd.h
+ * TD Ameritrade option chain reader.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OPTIONCHAINREADERTD_H
+#define OPTIONCHAINREADERTD_H
+
+#include "../db/optioncontract.h"
+
+#include "../util/jsonstreamreader.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// TD Ameritrade option chain reader.
+/**
+ * Decodes contracts straight out of an option chain response one at a time. The chain header
+ * (everything but the expiration date maps) is read up front; the call and put maps are then
+ * streamed without ever building a document for them.
+ */
+class TDAmeritradeOptionChainReader : public OptionContractReader
+{
+    using _Myt = TDAmeritradeOptionChainReader;
+    using _Mybase = OptionContractReader;
+
+public:
+
+    /// Field index map type (json key to contract field, negative to ignore).
+    using FieldIndexMap = QHash<QByteArray, int>;
+
+    // ========================================================================
+    // CTOR / DTOR
+    // ========================================================================
+
+    /// Constructor.
+    /**
+     * @param[in] data  option chain response (json)
+     * @param[in] fields  contract field of each json key
+     */
+    TDAmeritradeOptionChainReader( const QByteArray& data, const FieldIndexMap& fields );
+
+    /// Destructor.
+    virtual ~TDAmeritradeOptionChainReader();
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// Retrieve error message.
+    /**
+     * @return  error message
+     */
+    QString errorString() const {return errorString_;}
+
+    /// Check for error.
+    /**
+     * @return  @c true if response failed to decode, @c false otherwise
+     */
+    virtual bool hasError() const override {return !errorString_.isEmpty();}
+
+    /// Retrieve chain header.
+    /**
+     * @return  top level fields of chain (minus expiration date maps)
+     */
+    const QJsonObject& header() const {return header_;}
+
+    /// Retrieve number of contracts read.
+    /**
+     * @return  number of contracts
+     */
+    int numContracts() const {return numContracts_;}
+
+    /// Retrieve number of contracts skipped.
+    /**
+     * @return  number of contracts
+     */
+    int numSkipped() const {return numSkipped_;}
+
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Read chain header.
+    /**
+     * @return  @c true upon success, @c false otherwise
+     */
+    bool readHeader();
+
+    /// Read next contract.
+    /**
+     * Contracts with no bid size, ask size, or quote time are skipped.
+     * @param[out] contract  contract
+     * @return  @c true if contract read, @c false when no more contracts (or error)
+     */
+    virtual bool readNext( OptionContract& contract ) override;
+
+private:
+
+    static constexpr int CONTRACT_DEPTH = 4;        // map -> expiry -> strike -> contract
+
+    QByteArray data_;
+    const FieldIndexMap& fields_;
+
+    QJsonObject header_;
+    double underlyingPrice_;
+
+    QList<qint64> maps_;
+
+    JsonStreamReader reader_;
+    bool readerOpen_;
+
+    QString errorString_;
+
+    int numContracts_;
+    int numSkipped_;
+
+    /// Read contract.
+    bool readContract( OptionContract& contract );
+
+    /// Read contract field value.
+    bool readField( OptionContract& contract, OptionContract::Field f ) const;
+
+    /// Set error.
+    void setError( const QString& message );
+
+    // not implemented
+    TDAmeritradeOptionChainReader( const _Myt& ) = delete;
+
+    // not implemented
+    TDAmeritradeOptionChainReader( const _Myt&& ) = delete;
+
+    // not implemented
+    _Myt& operator = ( const _Myt& ) = delete;
+
+    // not implemented
+    _Myt& operator = ( const _Myt&& ) = delete;
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // OPTIONCHAINREADERTD_H
@@ -411,7 +411,15 @@ void TDAmeritrade::simulateMarketHours( const QJsonDocument& doc )
 #if defined( QT_DEBUG )
 void TDAmeritrade::simulateOptionChain( const QJsonDocument& doc )
 {
-    parseOptionChainDoc( doc );
+    parseOptionChainData( doc.toJson( QJsonDocument::Compact ) );
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#if defined( QT_DEBUG )
+void TDAmeritrade::simulateOptionChain( const QByteArray& data )
+{
+    parseOptionChainData( data );
 }
 #endif
 
@@ -447,6 +455,32 @@ void TDAmeritrade::simulateTransactions( const QJsonDocument& doc )
 }
 #endif
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void TDAmeritrade::handleProcessDocument( const QUuid& uuid, const QByteArray& request, const QString& requestType, int status, const QByteArray& response, const QString& responseType )
+{
+    bool optionChain( false );
+
+    {
+        QMutexLocker guard( &m_ );
+
+        const PendingRequestsMap::const_iterator i( pendingRequests_.constFind( uuid ) );
+
+        if (( pendingRequests_.constEnd() != i ) && ( GET_OPTION_CHAIN == i.value() ))
+        {
+            pendingRequests_.remove( uuid );
+            optionChain = true;
+        }
+    }
+
+    // option chains skip the document parse, they get streamed from the raw response
+    if ( !optionChain )
+        _Mybase::handleProcessDocument( uuid, request, requestType, status, response, responseType );
+    else if ( 200 != status )
+        LOG_WARN << "bad response " << qPrintable( uuid.toString() ) << " " << status;
+    else
+        parseOptionChainData( response );
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void TDAmeritrade::onProcessDocumentJson( const QUuid& uuid, const QByteArray& request, const QString& requestType, int status, const QJsonDocument& response )
 {
@@ -487,7 +521,7 @@ void TDAmeritrade::onProcessDocumentJson( const QUuid& uuid, const QByteArray& r
         parseMarketHoursDoc( response );
         break;
     case GET_OPTION_CHAIN:
-        parseOptionChainDoc( response );
+        parseOptionChainData( response.toJson( QJsonDocument::Compact ) );
         break;
     case GET_PRICE_HISTORY:
         parsePriceHistoryDoc( priceHistoryRequests_[uuid], response );
@@ -572,27 +606,16 @@ void TDAmeritrade::parseMarketHoursDoc( const QJsonDocument& doc )
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-void TDAmeritrade::parseOptionChainDoc( const QJsonDocument& doc )
+void TDAmeritrade::parseOptionChainData( const QByteArray& data )
 {
-    if ( !doc.isObject() )
-    {
-        LOG_WARN << "not an object";
-        return;
-    }
-
-    const QJsonObject obj( doc.object() );
-
-    const QString symbol( obj[JSON_SYMBOL].toString() );
-
-    // validate
-    if ( symbol.isEmpty() )
+    if ( data.isEmpty() )
     {
-        LOG_WARN << "missing symbol";
+        LOG_WARN << "empty option chain";
         return;
     }
 
     // emit
-    emit optionChainReceived( obj );
+    emit optionChainReceived( data );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
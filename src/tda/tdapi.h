@@ -64,9 +64,10 @@ signals:
 
     /// Signal for option chain received.
     /**
-     * @param[in] obj  data
+     * Chains are large so they are passed along undecoded.
+     * @param[in] data  data (json)
      */
-    void optionChainReceived( const QJsonObject& obj );
+    void optionChainReceived( const QByteArray& data );
 
     /// Signal for price history received.
     /**
@@ -249,6 +250,13 @@ public:
      */
     virtual void simulateOptionChain( const QJsonDocument& doc );
 
+    /// Simulate option chain.
+    /**
+     * Passes raw response straight to the streaming reader, the same as a network response.
+     * @param[in] data  data (json)
+     */
+    virtual void simulateOptionChain( const QByteArray& data );
+
     /// Simulate price history.
     /**
      * @param[in] doc  document
@@ -274,6 +282,23 @@ public:
     virtual void simulateTransactions( const QJsonDocument& doc );
 #endif
 
+protected:
+
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Handle process document.
+    /**
+     * @param[in] uuid  request id
+     * @param[in] request  request
+     * @param[in] requestType  request type
+     * @param[in] status  request status
+     * @param[in] response  response
+     * @param[in] responseType  response type
+     */
+    virtual void handleProcessDocument( const QUuid& uuid, const QByteArray& request, const QString& requestType, int status, const QByteArray& response, const QString& responseType ) override;
+
 private slots:
 
     /// Slot to process document.
@@ -338,7 +363,7 @@ private:
     void parseMarketHoursDoc( const QJsonDocument& doc );
 
     /// Parse option chain.
-    void parseOptionChainDoc( const QJsonDocument& doc );
+    void parseOptionChainData( const QByteArray& data );
 
     /// Parse price history.
     void parsePriceHistoryDoc( const PriceHistoryRequest& request, const QJsonDocument& doc );
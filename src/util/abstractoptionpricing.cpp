@@ -39,6 +39,20 @@ double AbstractOptionPricing::calcImplVolSeedValue( double X ) const
     return sqrt( std::fabs( log( S_ / X ) + r_ * T_ ) * (2.0 / T_) );
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void AbstractOptionPricing::batchOptionPrice( const OptionType *types, const double *X, double *prices, size_t n ) const
+{
+    for ( size_t i( 0 ); i < n; ++i )
+        prices[i] = optionPrice( types[i], X[i] );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void AbstractOptionPricing::batchPartials( const OptionType *types, const double *X, double *delta, double *gamma, double *theta, double *vega, double *rho, size_t n ) const
+{
+    for ( size_t i( 0 ); i < n; ++i )
+        partials( types[i], X[i], delta[i], gamma[i], theta[i], vega[i], rho[i] );
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void AbstractOptionPricing::copy( const _Myt& other )
 {
@@ -26,6 +26,7 @@
 #include "optiontype.h"
 
 #include <cmath>
+#include <cstddef>
 #include <utility>
 #include <vector>
 
@@ -81,12 +82,30 @@ public:
      */
     virtual double sigma() const {return sigma_;}
 
+    /// Retrieve cost-of-carry rate.
+    /**
+     * @return  cost-of-carry rate of holding underlying
+     */
+    virtual double costOfCarry() const {return b_;}
+
+    /// Retrieve risk-free interest rate.
+    /**
+     * @return  risk-free interest rate
+     */
+    virtual double riskFreeRate() const {return r_;}
+
     /// Retrieve spot (underlying) price.
     /**
      * @return  spot price of underlying
      */
     virtual double spotPrice() const {return S_;}
 
+    /// Retrieve time to expiration.
+    /**
+     * @return  time to expiration (years)
+     */
+    virtual double timeToExpiry() const {return T_;}
+
     /// Compute vega greek.
     /**
      * @param[in] type  option type
@@ -106,6 +125,28 @@ public:
      */
     virtual double calcImplVolSeedValue( double X ) const;
 
+    /// Compute option prices for a ladder of strikes.
+    /**
+     * @param[in] types  option types
+     * @param[in] X  strike prices
+     * @param[out] prices  option prices
+     * @param[in] n  number of options
+     */
+    virtual void batchOptionPrice( const OptionType *types, const double *X, double *prices, size_t n ) const;
+
+    /// Compute partials for a ladder of strikes.
+    /**
+     * @param[in] types  option types
+     * @param[in] X  strike prices
+     * @param[out] delta  partials with respect to underlying price
+     * @param[out] gamma  second partials with respect to underlying price
+     * @param[out] theta  partials with respect to time
+     * @param[out] vega  partials with respect to sigma
+     * @param[out] rho  partials with respect to rate
+     * @param[in] n  number of options
+     */
+    virtual void batchPartials( const OptionType *types, const double *X, double *delta, double *gamma, double *theta, double *vega, double *rho, size_t n ) const;
+
     /// Compute partials.
     /**
      * @param[in] type  option type
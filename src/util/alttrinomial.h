@@ -94,6 +94,16 @@ public:
      */
     virtual double optionPrice( OptionType type, double X ) const override;
 
+    /// Compute option prices for a ladder of strikes.
+    /**
+     * All strikes share one tree.
+     * @param[in] types  option types
+     * @param[in] X  strike prices
+     * @param[out] prices  option prices
+     * @param[in] n  number of options
+     */
+    virtual void batchOptionPrice( const OptionType *types, const double *X, double *prices, size_t n ) const override;
+
     /// Compute partials.
     /**
      * @param[in] type  option type
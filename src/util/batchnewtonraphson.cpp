@@ -0,0 +1,234 @@
+/**
+ * @file batchnewtonraphson.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "batchnewtonraphson.h"
+#include "coxrossrubinstein.h"
+
+#include <algorithm>
+#include <cmath>
+
+static const double sqrt2pi = 2.50662827463100050242;
+
+/// Power of two (square) function.
+#define pow2(n) ((n) * (n))
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void BatchNewtonRaphson::calcImplVolBlackScholes( const AbstractOptionPricing *pricing, const OptionType *types, const double *X, const double *prices, double *vi, bool *okay, size_t n )
+{
+    double T[BLOCK_SIZE];
+    std::fill( T, T + BLOCK_SIZE, pricing->timeToExpiry() );
+
+    for ( size_t i( 0 ); i < n; i += BLOCK_SIZE )
+        calcImplVolBlackScholesBlock( pricing->spotPrice(), pricing->riskFreeRate(), pricing->costOfCarry(), types + i, X + i, T, prices + i, vi + i, okay + i, std::min( BLOCK_SIZE, n - i ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void BatchNewtonRaphson::calcImplVolBlackScholes( double S, double r, double b, const OptionType *types, const double *X, const double *T, const double *prices, double *vi, bool *okay, size_t n )
+{
+    for ( size_t i( 0 ); i < n; i += BLOCK_SIZE )
+        calcImplVolBlackScholesBlock( S, r, b, types + i, X + i, T + i, prices + i, vi + i, okay + i, std::min( BLOCK_SIZE, n - i ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+double BatchNewtonRaphson::calcImplVolSeedValue( const AbstractOptionPricing *pricing, OptionType type, double X, double price )
+{
+    return calcImplVolSeedValue( pricing->spotPrice(), pricing->riskFreeRate(), pricing->costOfCarry(), pricing->timeToExpiry(), type, X, price );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+double BatchNewtonRaphson::calcImplVolSeedValue( double S, double r, double b, double T, OptionType type, double X, double price )
+{
+    // discounted underlying and strike
+    const double Sd( S * exp( (b - r) * T ) );
+    const double K( X * exp( -r * T ) );
+
+    // use put/call parity to operate on call price
+    const double c( (OptionType::Call == type) ? price : price + Sd - K );
+    const double h( c - (Sd - K) / 2.0 );
+
+    // Corrado-Miller, negative discriminant is clamped to zero
+    const double disc( pow2( h ) - pow2( Sd - K ) / M_PI );
+
+    const double result( sqrt2pi / (Sd + K) * (h + sqrt( (disc < 0.0) ? 0.0 : disc )) / sqrt( T ) );
+
+    // fall back to Manaster and Koehler
+    if (( std::isinf( result ) ) || ( std::isnan( result ) ) || ( result <= 0.0 ))
+        return sqrt( std::fabs( log( S / X ) + r * T ) * (2.0 / T) );
+
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void BatchNewtonRaphson::calcImplVolBlackScholesBlock( double S, double r, double b, const OptionType *types, const double *X, const double *T, const double *prices, double *vi, bool *okay, size_t n )
+{
+    static const double VOLATILITY_MIN = 0.0000001;
+    static const double VOLATILITY_MAX = 1000.0 - VOLATILITY_MIN;
+    static const double EPSILON = 0.001;
+
+    Q_ASSERT( n <= BLOCK_SIZE );
+
+    double ci[BLOCK_SIZE];
+    double vegai[BLOCK_SIZE];
+
+    bool active[BLOCK_SIZE];
+
+    size_t remaining( 0 );
+
+    for ( size_t i( 0 ); i < n; ++i )
+    {
+        vi[i] = calcImplVolSeedValue( S, r, b, T[i], types[i], X[i], prices[i] );
+        okay[i] = false;
+
+        if (( active[i] = (( VOLATILITY_MIN <= vi[i] ) && ( vi[i] <= VOLATILITY_MAX )) ))
+            ++remaining;
+        else
+            vi[i] = 0.0;
+    }
+
+    // iterate all options together, finished ones just ride along
+    for ( size_t maxloops( MAX_LOOPS ); (remaining) && (maxloops--); )
+    {
+        BlackScholes::batchOptionPriceVega( S, r, b, types, X, T, vi, ci, vegai, n );
+
+        for ( size_t i( 0 ); i < n; ++i )
+        {
+            if ( !active[i] )
+                continue;
+
+            const double diff( ci[i] - prices[i] );
+
+            if ( std::fabs( diff ) <= EPSILON )
+            {
+                okay[i] = true;
+                active[i] = false;
+                --remaining;
+
+                continue;
+            }
+
+            vi[i] -= diff / vegai[i];
+
+            if (( std::isinf( vi[i] ) ) || ( std::isnan( vi[i] ) ) || ( vi[i] < VOLATILITY_MIN ) || ( vi[i] > VOLATILITY_MAX ))
+            {
+                vi[i] = 0.0;
+                active[i] = false;
+                --remaining;
+            }
+        }
+    }
+
+    // failed to converge
+    for ( size_t i( 0 ); i < n; ++i )
+        if ( active[i] )
+            vi[i] = 0.0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#if defined( QT_DEBUG )
+
+void BatchNewtonRaphson::validate()
+{
+    static const size_t LADDER = 15;
+
+    OptionType types[LADDER];
+    double X[LADDER], prices[LADDER], vi[LADDER];
+    bool okay[LADDER];
+
+    // european
+    {
+        const double S = 100.0;
+        const double r = 0.08;
+        const double sigma = 0.20;
+        const double T = 0.5;
+
+        BlackScholes bs( S, r, r, sigma, T );
+
+        for ( size_t i( 0 ); i < LADDER; ++i )
+        {
+            types[i] = (i % 2) ? OptionType::Put : OptionType::Call;
+            X[i] = 86.0 + 2.0 * i;
+            prices[i] = bs.optionPrice( types[i], X[i] );
+        }
+
+        _Myt::calcImplVol( &bs, types, X, prices, vi, okay, LADDER );
+
+        for ( size_t i( 0 ); i < LADDER; ++i )
+        {
+            Q_ASSERT( okay[i] );
+
+            // compare price, vega is too small away from the money to compare vi
+            bs.setSigma( vi[i] );
+            Q_ASSERT( std::fabs( bs.optionPrice( types[i], X[i] ) - prices[i] ) <= 0.001 );
+        }
+    }
+
+    // european, each option with its own expiration
+    {
+        const double S = 100.0;
+        const double r = 0.05;
+        const double b = 0.03;
+        const double sigma = 0.30;
+
+        double T[LADDER];
+
+        for ( size_t i( 0 ); i < LADDER; ++i )
+        {
+            types[i] = (i % 2) ? OptionType::Put : OptionType::Call;
+            X[i] = 90.0 + 2.0 * i;
+            T[i] = 0.1 + 0.1 * i;
+            prices[i] = BlackScholes( S, r, b, sigma, T[i] ).optionPrice( types[i], X[i] );
+        }
+
+        _Myt::calcImplVolBlackScholes( S, r, b, types, X, T, prices, vi, okay, LADDER );
+
+        for ( size_t i( 0 ); i < LADDER; ++i )
+        {
+            Q_ASSERT( okay[i] );
+            Q_ASSERT( std::fabs( BlackScholes( S, r, b, vi[i], T[i] ).optionPrice( types[i], X[i] ) - prices[i] ) <= 0.001 );
+        }
+    }
+
+    // american
+    {
+        const double S = 75.0;
+        const double r = 0.10;
+        const double sigma = 0.35;
+        const double T = 0.5;
+
+        CoxRossRubinstein crr( S, r, r, sigma, T, 128 );
+
+        for ( size_t i( 0 ); i < LADDER; ++i )
+        {
+            types[i] = (i % 2) ? OptionType::Put : OptionType::Call;
+            X[i] = 68.0 + i;
+            prices[i] = crr.optionPrice( types[i], X[i] );
+        }
+
+        _Myt::calcImplVol( &crr, types, X, prices, vi, okay, LADDER );
+
+        for ( size_t i( 0 ); i < LADDER; ++i )
+        {
+            Q_ASSERT( okay[i] );
+            Q_ASSERT( std::fabs( vi[i] - sigma ) < 0.001 );
+        }
+    }
+}
+#endif
@@ -0,0 +1,167 @@
+/**
+ * @file batchnewtonraphson.h
+ * Batch Newton-Raphson Implied Volatility methods.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BATCHNEWTONRAPHSON_H
+#define BATCHNEWTONRAPHSON_H
+
+#include "abstractoptionpricing.h"
+#include "blackscholes.h"
+#include "newtonraphson.h"
+
+#include <QtGlobal>
+
+#include <typeinfo>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Batch Newton-Raphson Implied Volatility methods.
+/**
+ * Solves implied volatility for many (price, strike, type) tuples of the same underlying at once.
+ * Against the closed form Black-Scholes model all options are iterated in lock-step, a block at a
+ * time, from a Corrado-Miller initial guess. For any other pricing model the Corrado-Miller guess
+ * seeds a regular Newton-Raphson solve per option.
+ */
+class BatchNewtonRaphson
+{
+    using _Myt = BatchNewtonRaphson;
+
+public:
+
+    // ========================================================================
+    // Static Methods
+    // ========================================================================
+
+    /// Calculate implied volatilities.
+    /**
+     * @warning
+     * Volatility of @a pricing is undefined upon return.
+     * @tparam T  option pricing class
+     * @param[in,out] pricing  option pricing
+     * @param[in] types  option types
+     * @param[in] X  strike prices
+     * @param[in] prices  option prices
+     * @param[out] vi  implied volatilities
+     * @param[out] okay  @c true if calculation okay, @c false otherwise
+     * @param[in] n  number of options
+     */
+    template <class T>
+    static void calcImplVol( T *pricing, const OptionType *types, const double *X, const double *prices, double *vi, bool *okay, size_t n );
+
+    /// Calculate implied volatilities using closed form Black-Scholes model.
+    /**
+     * @param[in] pricing  option pricing (supplies underlying, rates, and time to expiration)
+     * @param[in] types  option types
+     * @param[in] X  strike prices
+     * @param[in] prices  option prices
+     * @param[out] vi  implied volatilities
+     * @param[out] okay  @c true if calculation okay, @c false otherwise
+     * @param[in] n  number of options
+     */
+    static void calcImplVolBlackScholes( const AbstractOptionPricing *pricing, const OptionType *types, const double *X, const double *prices, double *vi, bool *okay, size_t n );
+
+    /// Calculate implied volatilities using closed form Black-Scholes model.
+    /**
+     * Options share underlying price and rates, each option has its own time to expiration.
+     * @param[in] S  underlying (spot) price
+     * @param[in] r  risk-free interest rate
+     * @param[in] b  cost-of-carry rate of holding underlying
+     * @param[in] types  option types
+     * @param[in] X  strike prices
+     * @param[in] T  times to expiration (years)
+     * @param[in] prices  option prices
+     * @param[out] vi  implied volatilities
+     * @param[out] okay  @c true if calculation okay, @c false otherwise
+     * @param[in] n  number of options
+     */
+    static void calcImplVolBlackScholes( double S, double r, double b, const OptionType *types, const double *X, const double *T, const double *prices, double *vi, bool *okay, size_t n );
+
+    /// Calculate the Corrado-Miller seed value.
+    /**
+     * @param[in] pricing  option pricing (supplies underlying, rates, and time to expiration)
+     * @param[in] type  option type
+     * @param[in] X  strike price
+     * @param[in] price  option price
+     * @return  seed value for implied volatility
+     */
+    static double calcImplVolSeedValue( const AbstractOptionPricing *pricing, OptionType type, double X, double price );
+
+    /// Calculate the Corrado-Miller seed value.
+    /**
+     * @param[in] S  underlying (spot) price
+     * @param[in] r  risk-free interest rate
+     * @param[in] b  cost-of-carry rate of holding underlying
+     * @param[in] T  time to expiration (years)
+     * @param[in] type  option type
+     * @param[in] X  strike price
+     * @param[in] price  option price
+     * @return  seed value for implied volatility
+     */
+    static double calcImplVolSeedValue( double S, double r, double b, double T, OptionType type, double X, double price );
+
+#if defined( QT_DEBUG )
+    /// Validate methods.
+    static void validate();
+#endif
+
+private:
+
+    static const size_t MAX_LOOPS = 512;
+    static const size_t BLOCK_SIZE = 64;
+
+    /// Calculate implied volatilities of at most BLOCK_SIZE options using closed form Black-Scholes model.
+    static void calcImplVolBlackScholesBlock( double S, double r, double b, const OptionType *types, const double *X, const double *T, const double *prices, double *vi, bool *okay, size_t n );
+
+    // not implemented
+    BatchNewtonRaphson() = delete;
+
+    // not implemented
+    BatchNewtonRaphson( _Myt& ) = delete;
+
+    // not implemented
+    BatchNewtonRaphson( _Myt&& ) = delete;
+
+    // not implemented
+    _Myt& operator = ( _Myt& ) = delete;
+
+    // not implemented
+    _Myt& operator = ( _Myt&& ) = delete;
+
+};
+
+template <class T>
+inline void BatchNewtonRaphson::calcImplVol( T *pricing, const OptionType *types, const double *X, const double *prices, double *vi, bool *okay, size_t n )
+{
+    // closed form model solves every option together
+    if ( typeid( *pricing ) == typeid( BlackScholes ) )
+    {
+        calcImplVolBlackScholes( pricing, types, X, prices, vi, okay, n );
+        return;
+    }
+
+    // solve against actual pricing model
+    for ( size_t i( 0 ); i < n; ++i )
+        vi[i] = NewtonRaphson::calcImplVol( pricing, types[i], X[i], prices[i], calcImplVolSeedValue( pricing, types[i], X[i], prices[i] ), &okay[i] );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // BATCHNEWTONRAPHSON_H
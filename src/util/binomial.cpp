@@ -28,6 +28,7 @@
  */
 
 #include "binomial.h"
+#include "latticeworkspace.h"
 
 #include <cmath>
 
@@ -64,6 +65,25 @@ double BinomialTree::calcOptionPrice( bool isCall, double S, double K, double u,
     return calcOptionPriceImpl( isCall, S, K, u, d, pu, pd, Df );
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void BinomialTree::calcOptionPrices( const OptionType *types, const double *X, double *prices, size_t n, double S, double u, double d, double pu, double pd, double Df ) const
+{
+    if ( !n )
+        return;
+
+    // payoff sign for each strike
+    double *z( LatticeWorkspace::local().buffer( LatticeWorkspace::PAYOFF_SIGN, n ) );
+
+    for ( size_t k( 0 ); k < n; ++k )
+        z[k] = (OptionType::Call == types[k]) ? 1.0 : -1.0;
+
+    // dividends exist
+    if ( divTimes_.size() )
+        calcOptionPricesImpl( X, prices, n, S, u, d, pu, pd, Df, divTimes_, div_ );
+    else
+        calcOptionPricesImpl( X, prices, n, S, u, d, pu, pd, Df );
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 double BinomialTree::calcOptionPriceImpl( bool isCall, double S, double K, double u, double d, double pu, double pd, double Df ) const
 {
@@ -75,25 +95,23 @@ double BinomialTree::calcOptionPriceImpl( bool isCall, double S, double K, doubl
     //Q_ASSERT( 1.0 <= u );
     //Q_ASSERT( (0.0 < d) && (d <= 1.0) );
 
-    // create pow tables
-    std::vector<double> spowu;
-    spowu.reserve( N_+1 );
+    LatticeWorkspace& ws( LatticeWorkspace::local() );
 
-    std::vector<double> powd;
-    powd.reserve( N_+1 );
+    // create pow tables
+    double *spowu( ws.buffer( LatticeWorkspace::SPOT_POW_UP, N_+1 ) );
+    double *powd( ws.buffer( LatticeWorkspace::POW_DOWN, N_+1 ) );
 
     for ( size_t i( 0 ); i <= N_; ++i )
     {
-        spowu.push_back( S * pow( u, (double)i ) );
-        powd.push_back( pow( d, (double)i ) );
+        spowu[i] = S * pow( u, (double)i );
+        powd[i] = pow( d, (double)i );
     }
 
     // init vector
-    std::vector<double> val;
-    val.reserve( N_+1 );
+    double *val( ws.buffer( LatticeWorkspace::VALUES, N_+1 ) );
 
     for ( size_t i = 0; i <= N_; ++i )
-        val.push_back( fmax( 0.0, z * (spowu[i] * powd[N_ - i] - K) ) );
+        val[i] = fmax( 0.0, z * (spowu[i] * powd[N_ - i] - K) );
 
     // backward recursion through the tree
     for ( size_t j = N_; j--; )
@@ -143,35 +161,28 @@ double BinomialTree::calcOptionPriceImpl( bool isCall, double S, double K, doubl
     // sum dividends
     const size_t ndiv( divTimes.size() );
 
-    std::vector<size_t> divSteps;
-    divSteps.reserve( ndiv );
-
     double sumDiv( 1.0 );
 
     for ( size_t i( 0 ); i < ndiv; ++i )
-    {
-        divSteps.push_back( (divTimes[i] * N_) / T_ );
         sumDiv *= (1.0 - div[i]);
-    }
 
     // init vector
-    std::vector<double> St;
-    St.reserve( N_+1 );
+    LatticeWorkspace& ws( LatticeWorkspace::local() );
 
-    std::vector<double> val;
-    val.reserve( N_+1 );
+    double *St( ws.buffer( LatticeWorkspace::SPOT_POW_UP, N_+1 ) );
+    double *val( ws.buffer( LatticeWorkspace::VALUES, N_+1 ) );
 
     for ( size_t i = 0; i <= N_; ++i )
     {
-        St.push_back( S * pow( u, i ) * pow( d, (N_ - i) ) * sumDiv );
-        val.push_back( fmax( 0.0, z * (St[i] - K) ) );
+        St[i] = S * pow( u, i ) * pow( d, (N_ - i) ) * sumDiv;
+        val[i] = fmax( 0.0, z * (St[i] - K) );
     }
 
     // backward recursion through the tree
     for ( size_t j = N_; j--; )
     {
         for ( size_t m( ndiv ); m--; )
-            if ( j == divSteps[m] )
+            if ( j == (size_t)((divTimes[m] * N_) / T_) )
             {
                 for ( size_t i = 0; i <= j; ++i )
                     St[i] /= (1.0 - div[m]);
@@ -200,6 +211,130 @@ double BinomialTree::calcOptionPriceImpl( bool isCall, double S, double K, doubl
     return val[0];
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void BinomialTree::calcOptionPricesImpl( const double *X, double *prices, size_t n, double S, double u, double d, double pu, double pd, double Df ) const
+{
+    const bool american( isAmerican() );
+
+    LatticeWorkspace& ws( LatticeWorkspace::local() );
+
+    const double *z( ws.buffer( LatticeWorkspace::PAYOFF_SIGN, n ) );
+
+    // create pow tables, shared by all strikes
+    double *spowu( ws.buffer( LatticeWorkspace::SPOT_POW_UP, N_+1 ) );
+    double *powd( ws.buffer( LatticeWorkspace::POW_DOWN, N_+1 ) );
+
+    for ( size_t i( 0 ); i <= N_; ++i )
+    {
+        spowu[i] = S * pow( u, (double)i );
+        powd[i] = pow( d, (double)i );
+    }
+
+    // init values, strikes are interleaved for each node
+    double *val( ws.buffer( LatticeWorkspace::VALUES, (N_+1) * n ) );
+
+    for ( size_t i = 0; i <= N_; ++i )
+    {
+        const double St( spowu[i] * powd[N_ - i] );
+
+        double *v( val + i * n );
+
+        for ( size_t k( 0 ); k < n; ++k )
+            v[k] = fmax( 0.0, z[k] * (St - X[k]) );
+    }
+
+    // backward recursion through the tree
+    for ( size_t j = N_; j--; )
+    {
+        for ( size_t i = 0; i <= j; ++i )
+        {
+            double *v( val + i * n );
+            const double *vu( v + n );
+
+            for ( size_t k( 0 ); k < n; ++k )
+                v[k] = Df * (pu * vu[k] + pd * v[k]);
+
+            // check early exercise
+            if ( american )
+            {
+                const double St( spowu[i] * powd[j - i] );
+
+                for ( size_t k( 0 ); k < n; ++k )
+                    v[k] = fmax( v[k], z[k] * (St - X[k]) );
+            }
+        }
+    }
+
+    // option prices
+    for ( size_t k( 0 ); k < n; ++k )
+        prices[k] = val[k];
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void BinomialTree::calcOptionPricesImpl( const double *X, double *prices, size_t n, double S, double u, double d, double pu, double pd, double Df, const std::vector<double>& divTimes, const std::vector<double>& div ) const
+{
+    const bool american( isAmerican() );
+
+    // sum dividends
+    const size_t ndiv( divTimes.size() );
+
+    double sumDiv( 1.0 );
+
+    for ( size_t i( 0 ); i < ndiv; ++i )
+        sumDiv *= (1.0 - div[i]);
+
+    LatticeWorkspace& ws( LatticeWorkspace::local() );
+
+    const double *z( ws.buffer( LatticeWorkspace::PAYOFF_SIGN, n ) );
+
+    // init values, underlying price nodes are shared by all strikes
+    double *St( ws.buffer( LatticeWorkspace::SPOT_POW_UP, N_+1 ) );
+    double *val( ws.buffer( LatticeWorkspace::VALUES, (N_+1) * n ) );
+
+    for ( size_t i = 0; i <= N_; ++i )
+    {
+        St[i] = S * pow( u, i ) * pow( d, (N_ - i) ) * sumDiv;
+
+        double *v( val + i * n );
+
+        for ( size_t k( 0 ); k < n; ++k )
+            v[k] = fmax( 0.0, z[k] * (St[i] - X[k]) );
+    }
+
+    // backward recursion through the tree
+    for ( size_t j = N_; j--; )
+    {
+        for ( size_t m( ndiv ); m--; )
+            if ( j == (size_t)((divTimes[m] * N_) / T_) )
+            {
+                for ( size_t i = 0; i <= j; ++i )
+                    St[i] /= (1.0 - div[m]);
+            }
+
+        for ( size_t i = 0; i <= j; ++i )
+        {
+            St[i] = d * St[i + 1];
+
+            double *v( val + i * n );
+            const double *vu( v + n );
+
+            for ( size_t k( 0 ); k < n; ++k )
+                v[k] = Df * (pu * vu[k] + pd * v[k]);
+
+            // check early exercise
+            if ( american )
+            {
+                for ( size_t k( 0 ); k < n; ++k )
+                    v[k] = fmax( v[k], z[k] * (St[i] - X[k]) );
+            }
+        }
+    }
+
+    // option prices
+    for ( size_t k( 0 ); k < n; ++k )
+        prices[k] = val[k];
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void BinomialTree::calcPartials( double u, double d, double& delta, double& gamma, double& theta ) const
 {
@@ -134,6 +134,25 @@ protected:
      */
     virtual double calcOptionPrice( bool isCall, double S, double K, double u, double d, double pu, double pd, double Df ) const;
 
+    /// Calculate option prices for a ladder of strikes using binomial pricing.
+    /**
+     * Underlying price nodes are shared and all strikes are walked backward through the tree
+     * together.
+     * @note
+     * Values for partials calculation are not tracked.
+     * @param[in] types  option types
+     * @param[in] X  strike prices
+     * @param[out] prices  option prices
+     * @param[in] n  number of options
+     * @param[in] S  underlying (spot) price
+     * @param[in] u  upward amount
+     * @param[in] d  downward amount
+     * @param[in] pu  probability up
+     * @param[in] pd  probability down
+     * @param[in] Df  discount factor
+     */
+    virtual void calcOptionPrices( const OptionType *types, const double *X, double *prices, size_t n, double S, double u, double d, double pu, double pd, double Df ) const;
+
     /// Calculate partials.
     /**
      * @param[in] u  upward amount
@@ -212,6 +231,12 @@ private:
     /// Calculate option price.
     double calcOptionPriceImpl( bool isCall, double S, double K, double u, double d, double pu, double pd, double Df, const std::vector<double>& divTimes, const std::vector<double>& divYields ) const;
 
+    /// Calculate option prices.
+    void calcOptionPricesImpl( const double *X, double *prices, size_t n, double S, double u, double d, double pu, double pd, double Df ) const;
+
+    /// Calculate option prices.
+    void calcOptionPricesImpl( const double *X, double *prices, size_t n, double S, double u, double d, double pu, double pd, double Df, const std::vector<double>& divTimes, const std::vector<double>& divYields ) const;
+
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
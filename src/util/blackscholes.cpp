@@ -27,6 +27,7 @@
 #include "blackscholes.h"
 
 #include <cmath>
+#include <typeinfo>
 
 static const double one_div_sqrt2pi = 0.39894228040143270286;
 
@@ -39,6 +40,25 @@ static const double one_div_sqrt2pi = 0.39894228040143270286;
 /// Continuous normal distribution function.
 double cnd( double x );
 
+/// Continuous normal distribution function (branch free).
+/**
+ * Same approximation as cnd() but without early outs so loops over contiguous arrays can be
+ * vectorized by the compiler.
+ * @param[in] x  value
+ * @return  cumulative normal distribution of @p x
+ */
+static inline double cndv( double x )
+{
+    const double L( std::fabs( x ) );
+    const double K( 1.0 / (1.0 + (0.2316419 * L)) );
+
+    const double a12345k( K * (0.31938153 + K * (-0.356563782 + K * (1.781477937 + K * (-1.821255978 + K * 1.330274429)))) );
+
+    const double result( 1.0 - normdist( L ) * a12345k );
+
+    return (x < 0.0) ? 1.0 - result : result;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 BlackScholes::BlackScholes( double S, double r, double b, double sigma, double T ) :
     _Mybase( S, r, b, sigma, T )
@@ -126,6 +146,118 @@ double BlackScholes::vega( OptionType /*type*/, double X ) const
     return (S_ * ebrt_ * normdist_d1 * st_);
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void BlackScholes::batchOptionPrice( const OptionType *types, const double *X, double *prices, size_t n ) const
+{
+    // derived models override optionPrice(), closed form kernel only applies to us
+    if ( typeid( *this ) != typeid( _Myt ) )
+    {
+        _Mybase::batchOptionPrice( types, X, prices, n );
+        return;
+    }
+
+    // hoist everything that does not depend on strike
+    const double logS( log( S_ ) );
+    const double drift( (b_ + pow2( sigma_ ) / 2.0) * T_ );
+    const double vstinv( 1.0 / vst_ );
+
+    for ( size_t i( 0 ); i < n; ++i )
+    {
+        const double d1( (logS - log( X[i] ) + drift) * vstinv );
+        const double d2( d1 - vst_ );
+
+        // +1 for calls, -1 for puts
+        const double phi( (OptionType::Call == types[i]) ? 1.0 : -1.0 );
+
+        prices[i] = phi * (sbrt_ * cndv( phi * d1 ) - X[i] * ert_ * cndv( phi * d2 ));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void BlackScholes::batchPartials( const OptionType *types, const double *X, double *delta, double *gamma, double *theta, double *vega, double *rho, size_t n ) const
+{
+    // derived models override partials(), closed form kernel only applies to us
+    if ( typeid( *this ) != typeid( _Myt ) )
+    {
+        _Mybase::batchPartials( types, X, delta, gamma, theta, vega, rho, n );
+        return;
+    }
+
+    // hoist everything that does not depend on strike
+    const double logS( log( S_ ) );
+    const double drift( (b_ + pow2( sigma_ ) / 2.0) * T_ );
+    const double vstinv( 1.0 / vst_ );
+
+    const double gammaf( ebrt_ / (S_ * vst_) );
+    const double vegaf( sbrt_ * st_ );
+    const double thetaf( -sbrt_ * sigma_ / (2.0 * st_) );
+    const double bmr( (b_ - r_) * sbrt_ );
+
+    for ( size_t i( 0 ); i < n; ++i )
+    {
+        const double d1( (logS - log( X[i] ) + drift) * vstinv );
+        const double d2( d1 - vst_ );
+
+        const double normdist_d1( normdist( d1 ) );
+
+        // +1 for calls, -1 for puts
+        const double phi( (OptionType::Call == types[i]) ? 1.0 : -1.0 );
+
+        const double cnd_d1( cndv( phi * d1 ) );
+        const double xert_cnd_d2( X[i] * ert_ * cndv( phi * d2 ) );
+
+        delta[i] = phi * ebrt_ * cnd_d1;
+        gamma[i] = gammaf * normdist_d1;
+        theta[i] = thetaf * normdist_d1 - phi * (bmr * cnd_d1 + r_ * xert_cnd_d2);
+        vega[i] = vegaf * normdist_d1;
+        rho[i] = phi * T_ * xert_cnd_d2;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void BlackScholes::batchOptionPriceVega( const OptionType *types, const double *X, const double *sigma, double *prices, double *vega, size_t n ) const
+{
+    const double logS( log( S_ ) );
+
+    for ( size_t i( 0 ); i < n; ++i )
+    {
+        const double vst( sigma[i] * st_ );
+
+        const double d1( (logS - log( X[i] ) + (b_ + pow2( sigma[i] ) / 2.0) * T_) / vst );
+        const double d2( d1 - vst );
+
+        // +1 for calls, -1 for puts
+        const double phi( (OptionType::Call == types[i]) ? 1.0 : -1.0 );
+
+        prices[i] = phi * (sbrt_ * cndv( phi * d1 ) - X[i] * ert_ * cndv( phi * d2 ));
+        vega[i] = sbrt_ * normdist( d1 ) * st_;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void BlackScholes::batchOptionPriceVega( double S, double r, double b, const OptionType *types, const double *X, const double *T, const double *sigma, double *prices, double *vega, size_t n )
+{
+    const double logS( log( S ) );
+
+    for ( size_t i( 0 ); i < n; ++i )
+    {
+        const double st( sqrt( T[i] ) );
+        const double vst( sigma[i] * st );
+
+        const double sbrt( S * exp( (b - r) * T[i] ) );
+        const double ert( exp( -r * T[i] ) );
+
+        const double d1( (logS - log( X[i] ) + (b + pow2( sigma[i] ) / 2.0) * T[i]) / vst );
+        const double d2( d1 - vst );
+
+        // +1 for calls, -1 for puts
+        const double phi( (OptionType::Call == types[i]) ? 1.0 : -1.0 );
+
+        prices[i] = phi * (sbrt * cndv( phi * d1 ) - X[i] * ert * cndv( phi * d2 ));
+        vega[i] = sbrt * normdist( d1 ) * st;
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void BlackScholes::copy( const _Myt& other )
 {
@@ -243,6 +375,35 @@ void BlackScholes::validate()
     const double bisect_price = bisect_test1.optionPrice( OptionType::Put, 70.0 );
 
     Q_ASSERT_DOUBLE( Bisection::calcImplVol( &bisect_test1, OptionType::Put, 70.0, bisect_price ), bisect_vi );
+
+    // batch (strike ladder) matches single strike pricing
+    static const size_t LADDER = 21;
+
+    _Myt batch_test1( 100.0, 0.05, 0.03, 0.30, 0.5 );
+
+    OptionType types[LADDER];
+    double X[LADDER], prices[LADDER], deltas[LADDER], gammas[LADDER], thetas[LADDER], vegas[LADDER], rhos[LADDER];
+
+    for ( size_t i( 0 ); i < LADDER; ++i )
+    {
+        types[i] = (i % 2) ? OptionType::Put : OptionType::Call;
+        X[i] = 75.0 + 2.5 * i;
+    }
+
+    batch_test1.batchOptionPrice( types, X, prices, LADDER );
+    batch_test1.batchPartials( types, X, deltas, gammas, thetas, vegas, rhos, LADDER );
+
+    for ( size_t i( 0 ); i < LADDER; ++i )
+    {
+        Q_ASSERT_DOUBLE( batch_test1.optionPrice( types[i], X[i] ), prices[i] );
+
+        batch_test1.partials( types[i], X[i], delta, gamma, theta, vega, rho );
+        Q_ASSERT_DOUBLE( delta, deltas[i] );
+        Q_ASSERT_DOUBLE( gamma, gammas[i] );
+        Q_ASSERT_DOUBLE( theta, thetas[i] );
+        Q_ASSERT_DOUBLE( vega, vegas[i] );
+        Q_ASSERT_DOUBLE( rho, rhos[i] );
+    }
 }
 #endif
 
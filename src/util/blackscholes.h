@@ -130,10 +130,62 @@ public:
      */
     virtual double vega( OptionType type, double X ) const override;
 
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Compute option prices for a ladder of strikes.
+    /**
+     * @param[in] types  option types
+     * @param[in] X  strike prices
+     * @param[out] prices  option prices
+     * @param[in] n  number of options
+     */
+    virtual void batchOptionPrice( const OptionType *types, const double *X, double *prices, size_t n ) const override;
+
+    /// Compute partials for a ladder of strikes.
+    /**
+     * @param[in] types  option types
+     * @param[in] X  strike prices
+     * @param[out] delta  partials with respect to underlying price
+     * @param[out] gamma  second partials with respect to underlying price
+     * @param[out] theta  partials with respect to time
+     * @param[out] vega  partials with respect to sigma
+     * @param[out] rho  partials with respect to rate
+     * @param[in] n  number of options
+     */
+    virtual void batchPartials( const OptionType *types, const double *X, double *delta, double *gamma, double *theta, double *vega, double *rho, size_t n ) const override;
+
+    /// Compute option prices and vegas for a ladder of strikes, each with its own volatility.
+    /**
+     * @param[in] types  option types
+     * @param[in] X  strike prices
+     * @param[in] sigma  volatilities of underlying
+     * @param[out] prices  option prices
+     * @param[out] vega  partials with respect to sigma
+     * @param[in] n  number of options
+     */
+    void batchOptionPriceVega( const OptionType *types, const double *X, const double *sigma, double *prices, double *vega, size_t n ) const;
+
     // ========================================================================
     // Static Methods
     // ========================================================================
 
+    /// Compute option prices and vegas, each option with its own volatility and time to expiration.
+    /**
+     * @param[in] S  underlying (spot) price
+     * @param[in] r  risk-free interest rate
+     * @param[in] b  cost-of-carry rate of holding underlying
+     * @param[in] types  option types
+     * @param[in] X  strike prices
+     * @param[in] T  times to expiration (years)
+     * @param[in] sigma  volatilities of underlying
+     * @param[out] prices  option prices
+     * @param[out] vega  partials with respect to sigma
+     * @param[in] n  number of options
+     */
+    static void batchOptionPriceVega( double S, double r, double b, const OptionType *types, const double *X, const double *T, const double *sigma, double *prices, double *vega, size_t n );
+
 #if defined( QT_DEBUG )
     /// Validate methods.
     static void validate();
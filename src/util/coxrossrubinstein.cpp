@@ -62,6 +62,21 @@ double CoxRossRubinstein::optionPrice( OptionType type, double X ) const
     return calcOptionPrice( (OptionType::Call == type), S_, X, u_, d_, pu, pd, Df );
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void CoxRossRubinstein::batchOptionPrice( const OptionType *types, const double *X, double *prices, size_t n ) const
+{
+    // quantities for the tree
+    const double dt = T_ / N_;
+
+    const double pu = (exp( b_ * dt ) - d_) / (u_ - d_);
+    const double pd = 1.0 - pu;
+
+    const double Df = exp( -r_ * dt );
+
+    // calc!
+    calcOptionPrices( types, X, prices, n, S_, u_, d_, pu, pd, Df );
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void CoxRossRubinstein::partials( OptionType type, double X, double& delta, double& gamma, double& theta, double& veg, double& rh ) const
 {
@@ -290,5 +305,44 @@ void CoxRossRubinstein::validate()
         Q_ASSERT_DOUBLE( crr.optionPrice( OptionType::Call, X ), 6.8194 );
         Q_ASSERT_DOUBLE( crr.optionPrice( OptionType::Put, X ), 12.9060 );
     }
+
+    {
+        // strike ladder priced with one tree
+        const double S = 100;
+        const double r = 0.1;
+        const double sigma = 0.3;
+        const double T = 6.0 / 12.0;
+        const size_t N = 200;
+
+        static const size_t LADDER = 9;
+
+        OptionType types[LADDER];
+        double X[LADDER], prices[LADDER];
+
+        for ( size_t i( 0 ); i < LADDER; ++i )
+        {
+            types[i] = (i % 2) ? OptionType::Put : OptionType::Call;
+            X[i] = 80.0 + 5.0 * i;
+        }
+
+        std::vector<double> divTimes;
+        divTimes.push_back( 0.25 );
+
+        std::vector<double> divYields;
+        divYields.push_back( 0.1 );
+
+        _Myt crr( S, r, r, sigma, T, N );
+        _Myt crr_div( S, r, r, sigma, T, N, divTimes, divYields );
+
+        crr.batchOptionPrice( types, X, prices, LADDER );
+
+        for ( size_t i( 0 ); i < LADDER; ++i )
+            Q_ASSERT_DOUBLE( crr.optionPrice( types[i], X[i] ), prices[i] );
+
+        crr_div.batchOptionPrice( types, X, prices, LADDER );
+
+        for ( size_t i( 0 ); i < LADDER; ++i )
+            Q_ASSERT_DOUBLE( crr_div.optionPrice( types[i], X[i] ), prices[i] );
+    }
 }
 #endif
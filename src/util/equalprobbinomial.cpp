@@ -64,6 +64,24 @@ double EqualProbBinomialTree::optionPrice( OptionType type, double X ) const
     return calcOptionPrice( (OptionType::Call == type), S_, X, u, d, 0.5, 0.5, Df );
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void EqualProbBinomialTree::batchOptionPrice( const OptionType *types, const double *X, double *prices, size_t n ) const
+{
+    // quantities for the tree
+    const double dt = T_ / N_;
+
+    const double bv2dt = (b_ - 0.5 * pow2( sigma_ )) * dt;
+    const double vsdt = sigma_ * sqrt( dt );
+
+    const double u = exp( bv2dt + vsdt );
+    const double d = exp( bv2dt - vsdt );
+
+    const double Df = exp( -r_ * dt );
+
+    // calc!
+    calcOptionPrices( types, X, prices, n, S_, u, d, 0.5, 0.5, Df );
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void EqualProbBinomialTree::partials( OptionType type, double X, double& delta, double& gamma, double& theta, double& veg, double& rh ) const
 {
@@ -0,0 +1,534 @@
+/**
+ * @file jsonstreamreader.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "jsonstreamreader.h"
+
+#include <cstring>
+
+// largest integer mantissa a double holds exactly
+static const qint64 MAX_EXACT_MANTISSA( Q_INT64_C( 9007199254740992 ) );
+
+// powers of ten a double holds exactly
+static const double POW10[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+    1e21, 1e22
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+JsonStreamReader::JsonStreamReader( const QByteArray& data, qint64 offset ) :
+    buffer_( data ),
+    data_( buffer_.constData() ),
+    size_( buffer_.size() ),
+    pos_( qBound( Q_INT64_C( 0 ), offset, size_ ) ),
+    state_( EXPECT_VALUE ),
+    type_( NoToken ),
+    tokenOffset_( pos_ ),
+    tokenStart_( pos_ ),
+    tokenSize_( 0 ),
+    escaped_( false ),
+    boolValue_( false )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+double JsonStreamReader::toDouble( bool *ok ) const
+{
+    if ( ok )
+        *ok = false;
+
+    if ( Number != type_ )
+        return 0.0;
+
+    const char *p( data_ + tokenStart_ );
+    const char *end( p + tokenSize_ );
+
+    const bool neg( '-' == *p );
+
+    if ( neg )
+        ++p;
+
+    qint64 mantissa( 0 );
+    int digits( 0 );
+    int scale( 0 );
+
+    bool fraction( false );
+
+    // fast path for plain decimals, exact mantissa and power of ten give a correctly rounded result
+    for ( ; p < end; ++p )
+    {
+        if (( '0' <= *p ) && ( *p <= '9' ))
+        {
+            mantissa = 10 * mantissa + (*p - '0');
+
+            if ( fraction )
+                ++scale;
+
+            if (( mantissa ) && ( 18 < ++digits ))
+                break;
+        }
+        else if (( '.' == *p ) && ( !fraction ))
+            fraction = true;
+        else
+            break;
+    }
+
+    if (( end == p ) && ( mantissa <= MAX_EXACT_MANTISSA ) && ( scale <= 22 ))
+    {
+        if ( ok )
+            *ok = true;
+
+        const double result( mantissa / POW10[scale] );
+
+        return neg ? -result : result;
+    }
+
+    // exponents and long mantissas
+    return rawText().toDouble( ok );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+qint64 JsonStreamReader::toLongLong( bool *ok ) const
+{
+    if ( ok )
+        *ok = false;
+
+    if ( Number != type_ )
+        return 0;
+
+    const char *p( data_ + tokenStart_ );
+    const char *end( p + tokenSize_ );
+
+    const bool neg( '-' == *p );
+
+    if ( neg )
+        ++p;
+
+    qint64 result( 0 );
+
+    for ( ; p < end; ++p )
+    {
+        if (( *p < '0' ) || ( '9' < *p ) || ( MAX_EXACT_MANTISSA < result ))
+            return (qint64) toDouble( ok );
+
+        result = 10 * result + (*p - '0');
+    }
+
+    if ( ok )
+        *ok = true;
+
+    return neg ? -result : result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QString JsonStreamReader::toString() const
+{
+    const char *p( data_ + tokenStart_ );
+    const char *end( p + tokenSize_ );
+
+    if (( Name != type_ ) && ( String != type_ ))
+        return QString::fromLatin1( p, (int) tokenSize_ );
+    else if ( !escaped_ )
+        return QString::fromUtf8( p, (int) tokenSize_ );
+
+    QString result;
+    result.reserve( (int) tokenSize_ );
+
+    while ( p < end )
+    {
+        const char *run( p );
+
+        while (( p < end ) && ( '\\' != *p ))
+            ++p;
+
+        result.append( QString::fromUtf8( run, (int)(p - run) ) );
+
+        if (( end <= p ) || ( end <= ++p ))
+            break;
+
+        switch ( *p++ )
+        {
+        case 'b':
+            result.append( QChar( '\b' ) );
+            break;
+        case 'f':
+            result.append( QChar( '\f' ) );
+            break;
+        case 'n':
+            result.append( QChar( '\n' ) );
+            break;
+        case 'r':
+            result.append( QChar( '\r' ) );
+            break;
+        case 't':
+            result.append( QChar( '\t' ) );
+            break;
+        case 'u':
+            if ( 4 <= (end - p) )
+            {
+                bool valid;
+
+                const ushort u( QByteArray::fromRawData( p, 4 ).toUShort( &valid, 16 ) );
+
+                if ( valid )
+                    result.append( QChar( u ) );
+
+                p += 4;
+            }
+            break;
+        default:
+            result.append( QChar( *(p-1) ) );
+            break;
+        }
+    }
+
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+JsonStreamReader::TokenType JsonStreamReader::readNext()
+{
+    if (( Invalid == type_ ) || ( EndDocument == type_ ))
+        return type_;
+
+    skipWhitespace();
+
+    tokenOffset_ = tokenStart_ = pos_;
+    tokenSize_ = 0;
+    escaped_ = false;
+
+    if ( DONE == state_ )
+        return (type_ = EndDocument);
+    else if ( size_ <= pos_ )
+        return error( "unexpected end of document" );
+
+    char c( data_[pos_] );
+
+    // separator between values
+    if ( EXPECT_COMMA_OR_END == state_ )
+    {
+        if (( '}' == c ) || ( ']' == c ))
+            return readEnd( c );
+        else if ( ',' != c )
+            return error( "expected separator" );
+
+        state_ = ('{' == stack_.back()) ? EXPECT_NAME : EXPECT_VALUE;
+
+        ++pos_;
+        skipWhitespace();
+
+        if ( size_ <= pos_ )
+            return error( "unexpected end of document" );
+
+        tokenOffset_ = tokenStart_ = pos_;
+        c = data_[pos_];
+    }
+
+    // end of empty container
+    if ((( EXPECT_NAME_OR_END == state_ ) && ( '}' == c )) || (( EXPECT_VALUE_OR_END == state_ ) && ( ']' == c )))
+        return readEnd( c );
+
+    // member name
+    if (( EXPECT_NAME == state_ ) || ( EXPECT_NAME_OR_END == state_ ))
+    {
+        if (( '"' != c ) || ( !readString() ))
+            return error( "expected name" );
+
+        skipWhitespace();
+
+        if (( size_ <= pos_ ) || ( ':' != data_[pos_] ))
+            return error( "expected name separator" );
+
+        ++pos_;
+        state_ = EXPECT_VALUE;
+
+        return (type_ = Name);
+    }
+
+    // value
+    switch ( c )
+    {
+    case '{':
+        ++pos_;
+        stack_.push_back( c );
+        state_ = EXPECT_NAME_OR_END;
+        return (type_ = StartObject);
+    case '[':
+        ++pos_;
+        stack_.push_back( c );
+        state_ = EXPECT_VALUE_OR_END;
+        return (type_ = StartArray);
+    case '"':
+        if ( !readString() )
+            return error( "unterminated string" );
+
+        valueComplete();
+        return (type_ = String);
+    case 't':
+        return readLiteral( "true", 4, Bool, true );
+    case 'f':
+        return readLiteral( "false", 5, Bool, false );
+    case 'n':
+        return readLiteral( "null", 4, Null, false );
+    default:
+        break;
+    }
+
+    if (( '-' == c ) || (( '0' <= c ) && ( c <= '9' )))
+        return readNumber();
+
+    return error( "unexpected character" );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool JsonStreamReader::skipCurrentElement()
+{
+    if (( StartObject != type_ ) && ( StartArray != type_ ))
+        return false;
+
+    int level( 1 );
+
+    while ( pos_ < size_ )
+    {
+        const char c( data_[pos_] );
+
+        if ( '"' == c )
+        {
+            // skip over string
+            for ( ++pos_; pos_ < size_; ++pos_ )
+                if ( '\\' == data_[pos_] )
+                    ++pos_;
+                else if ( '"' == data_[pos_] )
+                    break;
+        }
+        else if (( '{' == c ) || ( '[' == c ))
+            ++level;
+        else if ((( '}' == c ) || ( ']' == c )) && ( !--level ))
+        {
+            tokenOffset_ = tokenStart_ = pos_;
+            tokenSize_ = 0;
+
+            return (Invalid != readEnd( c ));
+        }
+
+        ++pos_;
+    }
+
+    error( "unexpected end of document" );
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+JsonStreamReader::TokenType JsonStreamReader::error( const QString& message )
+{
+    error_ = QString( "%1 at offset %2" ).arg( message ).arg( pos_ );
+    return (type_ = Invalid);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+JsonStreamReader::TokenType JsonStreamReader::readEnd( char c )
+{
+    const char start( ('}' == c) ? '{' : '[' );
+
+    if (( stack_.empty() ) || ( start != stack_.back() ))
+        return error( "mismatched end of container" );
+
+    stack_.pop_back();
+
+    ++pos_;
+    valueComplete();
+
+    return (type_ = (('{' == start) ? EndObject : EndArray));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+JsonStreamReader::TokenType JsonStreamReader::readLiteral( const char *literal, int len, TokenType type, bool value )
+{
+    if (( size_ - pos_ < len ) || ( 0 != memcmp( data_ + pos_, literal, len ) ))
+        return error( "invalid literal" );
+
+    pos_ += len;
+    tokenSize_ = len;
+
+    boolValue_ = value;
+
+    valueComplete();
+    return (type_ = type);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+JsonStreamReader::TokenType JsonStreamReader::readNumber()
+{
+    while ( pos_ < size_ )
+    {
+        const char c( data_[pos_] );
+
+        if ((( '0' <= c ) && ( c <= '9' )) || ( '.' == c ) || ( '-' == c ) || ( '+' == c ) || ( 'e' == c ) || ( 'E' == c ))
+            ++pos_;
+        else
+            break;
+    }
+
+    tokenSize_ = pos_ - tokenStart_;
+
+    valueComplete();
+    return (type_ = Number);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool JsonStreamReader::readString()
+{
+    tokenStart_ = ++pos_;
+
+    while ( pos_ < size_ )
+    {
+        const char c( data_[pos_] );
+
+        if ( '"' == c )
+        {
+            tokenSize_ = pos_++ - tokenStart_;
+            return true;
+        }
+        else if ( '\\' == c )
+        {
+            escaped_ = true;
+            ++pos_;
+        }
+
+        ++pos_;
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void JsonStreamReader::skipWhitespace()
+{
+    while (( pos_ < size_ ) && (( ' ' == data_[pos_] ) || ( '\n' == data_[pos_] ) || ( '\r' == data_[pos_] ) || ( '\t' == data_[pos_] )))
+        ++pos_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#if defined( QT_DEBUG )
+
+#define Q_ASSERT_DOUBLE( fn, v ) {const double result = fn; Q_ASSERT( v-0.0001 <= result && result <= v+0.0001 );}
+
+/// Read document to end.
+static bool readToEnd( JsonStreamReader& r )
+{
+    while (( JsonStreamReader::Invalid != r.readNext() ) && ( JsonStreamReader::EndDocument != r.tokenType() ))
+        ;
+
+    return !r.hasError();
+}
+
+void JsonStreamReader::validate()
+{
+    {
+        const QByteArray doc( " {\"a\": [1, -2.5, 3e2], \"b\\\"c\": \"x\\ny\\u0041\", \"d\": {}, \"e\": [], \"f\": true, \"g\": null} " );
+
+        _Myt r( doc );
+
+        Q_ASSERT( StartObject == r.readNext() );
+        Q_ASSERT( 1 == r.depth() );
+        Q_ASSERT( Name == r.readNext() );
+        Q_ASSERT( "a" == r.rawText() );
+        Q_ASSERT( StartArray == r.readNext() );
+        Q_ASSERT( 2 == r.depth() );
+        Q_ASSERT( Number == r.readNext() );
+        Q_ASSERT( 1 == r.toLongLong() );
+        Q_ASSERT( Number == r.readNext() );
+        Q_ASSERT_DOUBLE( r.toDouble(), -2.5 );
+        Q_ASSERT( -2 == r.toLongLong() );
+        Q_ASSERT( Number == r.readNext() );
+        Q_ASSERT_DOUBLE( r.toDouble(), 300.0 );
+        Q_ASSERT( EndArray == r.readNext() );
+        Q_ASSERT( 1 == r.depth() );
+        Q_ASSERT( Name == r.readNext() );
+        Q_ASSERT( "b\"c" == r.toString() );
+        Q_ASSERT( String == r.readNext() );
+        Q_ASSERT( "x\nyA" == r.toString() );
+        Q_ASSERT( Name == r.readNext() );
+        Q_ASSERT( StartObject == r.readNext() );
+        Q_ASSERT( EndObject == r.readNext() );
+        Q_ASSERT( Name == r.readNext() );
+        Q_ASSERT( StartArray == r.readNext() );
+        Q_ASSERT( EndArray == r.readNext() );
+        Q_ASSERT( Name == r.readNext() );
+        Q_ASSERT( Bool == r.readNext() );
+        Q_ASSERT( r.toBool() );
+        Q_ASSERT( Name == r.readNext() );
+        Q_ASSERT( Null == r.readNext() );
+        Q_ASSERT( EndObject == r.readNext() );
+        Q_ASSERT( EndDocument == r.readNext() );
+        Q_ASSERT( !r.hasError() );
+    }
+
+    {
+        // skip nested value, then read from its offset
+        const QByteArray doc( "{\"skip\": {\"x\": [\"]}\", {\"y\": 1}]}, \"z\": 1611349200000}" );
+
+        _Myt r( doc );
+
+        Q_ASSERT( StartObject == r.readNext() );
+        Q_ASSERT( Name == r.readNext() );
+        Q_ASSERT( StartObject == r.readNext() );
+
+        const qint64 offset( r.tokenOffset() );
+
+        Q_ASSERT( r.skipCurrentElement() );
+        Q_ASSERT( EndObject == r.tokenType() );
+        Q_ASSERT( Name == r.readNext() );
+        Q_ASSERT( "z" == r.rawText() );
+        Q_ASSERT( Number == r.readNext() );
+        Q_ASSERT( Q_INT64_C( 1611349200000 ) == r.toLongLong() );
+        Q_ASSERT( EndObject == r.readNext() );
+
+        _Myt nested( doc, offset );
+
+        int tokens( 0 );
+
+        while ( EndDocument != nested.readNext() )
+        {
+            Q_ASSERT( !nested.hasError() );
+            ++tokens;
+        }
+
+        Q_ASSERT( 10 == tokens );
+    }
+
+    {
+        // errors
+        _Myt r1( "[1,]" );
+        _Myt r2( "{\"a\" 1}" );
+        _Myt r3( "[1}" );
+        _Myt r4( "{\"a\": \"b" );
+
+        Q_ASSERT( !readToEnd( r1 ) );
+        Q_ASSERT( !readToEnd( r2 ) );
+        Q_ASSERT( !readToEnd( r3 ) );
+        Q_ASSERT( !readToEnd( r4 ) );
+    }
+}
+
+#endif
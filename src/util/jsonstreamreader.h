@@ -0,0 +1,232 @@
+/**
+ * @file jsonstreamreader.h
+ * Streaming (pull) JSON tokenizer.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef JSONSTREAMREADER_H
+#define JSONSTREAMREADER_H
+
+#include <QByteArray>
+#include <QString>
+
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Streaming (pull) JSON tokenizer.
+/**
+ * Walks a JSON document one token at a time in the spirit of QXmlStreamReader. No document tree
+ * is built; tokens refer back into the source bytes so memory use does not depend on the size of
+ * the document. Reading stops after the first complete value, which allows a reader to be started
+ * at the offset of any value nested inside a larger document.
+ */
+class JsonStreamReader
+{
+    using _Myt = JsonStreamReader;
+
+public:
+
+    /// Token types.
+    enum TokenType
+    {
+        NoToken,                                    ///< Nothing read yet.
+        Invalid,                                    ///< Error in document.
+        StartObject,                                ///< Object begin '{'.
+        EndObject,                                  ///< Object end '}'.
+        StartArray,                                 ///< Array begin '['.
+        EndArray,                                   ///< Array end ']'.
+        Name,                                       ///< Object member name.
+        String,                                     ///< String value.
+        Number,                                     ///< Number value.
+        Bool,                                       ///< Boolean value.
+        Null,                                       ///< Null value.
+        EndDocument,                                ///< First value complete.
+    };
+
+    // ========================================================================
+    // CTOR / DTOR
+    // ========================================================================
+
+    /// Constructor.
+    /**
+     * @param[in] data  document
+     * @param[in] offset  offset of value to read
+     */
+    JsonStreamReader( const QByteArray& data = QByteArray(), qint64 offset = 0 );
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// Retrieve depth of current token.
+    /**
+     * @return  number of enclosing containers (including container started by current token)
+     */
+    int depth() const {return (int) stack_.size();}
+
+    /// Retrieve error message.
+    /**
+     * @return  error message
+     */
+    QString errorString() const {return error_;}
+
+    /// Check for error.
+    /**
+     * @return  @c true if error, @c false otherwise
+     */
+    bool hasError() const {return (Invalid == type_);}
+
+    /// Retrieve offset of next unread byte.
+    /**
+     * @return  offset
+     */
+    qint64 offset() const {return pos_;}
+
+    /// Retrieve raw token bytes.
+    /**
+     * Strings and names are returned without quotes and with escapes intact. Returned array
+     * references the document and is only valid while the document is.
+     * @return  raw token
+     */
+    QByteArray rawText() const {return QByteArray::fromRawData( data_ + tokenStart_, (int) tokenSize_ );}
+
+    /// Retrieve boolean value.
+    /**
+     * @return  value
+     */
+    bool toBool() const {return boolValue_;}
+
+    /// Retrieve numeric value.
+    /**
+     * @param[out] ok  @c true upon success, @c false otherwise
+     * @return  value
+     */
+    double toDouble( bool *ok = nullptr ) const;
+
+    /// Retrieve integer value.
+    /**
+     * Fractional values are truncated.
+     * @param[out] ok  @c true upon success, @c false otherwise
+     * @return  value
+     */
+    qint64 toLongLong( bool *ok = nullptr ) const;
+
+    /// Retrieve string value.
+    /**
+     * @return  string or name with escapes decoded
+     */
+    QString toString() const;
+
+    /// Retrieve offset of current token.
+    /**
+     * @return  offset
+     */
+    qint64 tokenOffset() const {return tokenOffset_;}
+
+    /// Retrieve current token type.
+    /**
+     * @return  token type
+     */
+    TokenType tokenType() const {return type_;}
+
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Read next token.
+    /**
+     * @return  token type
+     */
+    TokenType readNext();
+
+    /// Skip to end of current container.
+    /**
+     * When the current token starts an object or array, bytes are scanned up to the matching end
+     * token without tokenizing the contents. Current token becomes the end token.
+     * @return  @c true upon success, @c false otherwise
+     */
+    bool skipCurrentElement();
+
+    // ========================================================================
+    // Static Methods
+    // ========================================================================
+
+#if defined( QT_DEBUG )
+    /// Validate methods.
+    static void validate();
+#endif
+
+private:
+
+    enum State
+    {
+        EXPECT_VALUE,
+        EXPECT_VALUE_OR_END,
+        EXPECT_NAME,
+        EXPECT_NAME_OR_END,
+        EXPECT_COMMA_OR_END,
+        DONE,
+    };
+
+    QByteArray buffer_;                             ///< Document (keeps bytes alive).
+
+    const char *data_;                              ///< Document bytes.
+    qint64 size_;                                   ///< Document size.
+    qint64 pos_;                                    ///< Next unread byte.
+
+    std::vector<char> stack_;                       ///< Open containers.
+    State state_;                                   ///< Parser state.
+
+    TokenType type_;                                ///< Current token type.
+    qint64 tokenOffset_;                            ///< Offset of current token.
+    qint64 tokenStart_;                             ///< Offset of current token text.
+    qint64 tokenSize_;                              ///< Size of current token text.
+    bool escaped_;                                  ///< Current string contains escapes.
+    bool boolValue_;                                ///< Current boolean value.
+
+    QString error_;                                 ///< Error message.
+
+    /// Set error.
+    TokenType error( const QString& message );
+
+    /// Read end of container.
+    TokenType readEnd( char c );
+
+    /// Read literal (true, false, null).
+    TokenType readLiteral( const char *literal, int len, TokenType type, bool value );
+
+    /// Read number.
+    TokenType readNumber();
+
+    /// Read string.
+    bool readString();
+
+    /// Skip whitespace.
+    void skipWhitespace();
+
+    /// Value complete.
+    void valueComplete() {state_ = stack_.empty() ? DONE : EXPECT_COMMA_OR_END;}
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // JSONSTREAMREADER_H
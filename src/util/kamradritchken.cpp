@@ -62,6 +62,13 @@ double KamradRitchken::optionPrice( OptionType type, double X ) const
     return calcOptionPrice( (OptionType::Call == type), S_, X, u_, d_, pu_, pd_, pm_, Df_ );
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void KamradRitchken::batchOptionPrice( const OptionType *types, const double *X, double *prices, size_t n ) const
+{
+    // calc!
+    calcOptionPrices( types, X, prices, n, S_, u_, d_, pu_, pd_, pm_, Df_ );
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void KamradRitchken::copy( const _Myt& other )
 {
@@ -1,5 +1,5 @@
 /**
- * @file montecarlocalc.cpp
+ * @file latticeworkspace.cpp
  *
  * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
  *
@@ -19,24 +19,41 @@
  * not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "montecarlocalc.h"
+#include "latticeworkspace.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-MonteCarloCalculator::MonteCarloCalculator( double underlying, const table_model_type *chains, item_model_type *results ) :
-    _Mybase( underlying, chains, results ),
-    rng_( std::random_device{}() )
+LatticeWorkspace::LatticeWorkspace() :
+    requests_( 0 ),
+    allocations_( 0 )
 {
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-MonteCarloCalculator::~MonteCarloCalculator()
+double *LatticeWorkspace::buffer( Buffer b, size_t size )
 {
+    std::vector<double>& buf( buffers_[b] );
+
+    ++requests_;
+
+    if ( buf.size() < size )
+    {
+        buf.resize( size );
+        ++allocations_;
+    }
+
+    return buf.data();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-AbstractOptionPricing *MonteCarloCalculator::createPricingMethod( double S, double r, double b, double sigma, double T, bool european ) const
+void LatticeWorkspace::clear()
 {
-    Q_UNUSED( european )
+    for ( size_t i( 0 ); i < _NUM_BUFFERS; ++i )
+        std::vector<double>().swap( buffers_[i] );
+}
 
-    return new pricing_method_type( S, r, b, sigma, T, NUM_SIMULATIONS, rng_ );
+///////////////////////////////////////////////////////////////////////////////////////////////////
+LatticeWorkspace& LatticeWorkspace::local()
+{
+    static thread_local _Myt ws;
+    return ws;
 }
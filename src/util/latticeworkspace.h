@@ -0,0 +1,125 @@
+/**
+ * @file latticeworkspace.h
+ * Reusable storage for lattice (tree) option pricing.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LATTICEWORKSPACE_H
+#define LATTICEWORKSPACE_H
+
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Reusable storage for lattice (tree) option pricing.
+/**
+ * Each thread owns one workspace. Buffers only ever grow, so repeated pricing at the same (or
+ * smaller) tree depth performs no heap allocations.
+ * @warning
+ * Buffers are only valid until the next call to buffer() for the same slot on the same thread.
+ */
+class LatticeWorkspace
+{
+    using _Myt = LatticeWorkspace;
+
+public:
+
+    /// Buffer slots.
+    enum Buffer
+    {
+        SPOT_POW_UP,                                ///< Spot price times powers of up movement.
+        POW_DOWN,                                   ///< Powers of down movement.
+        VALUES,                                     ///< Option values.
+        PAYOFF_SIGN,                                ///< Payoff sign per strike (+1 call, -1 put).
+        _NUM_BUFFERS
+    };
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// Retrieve number of buffer requests.
+    /**
+     * @return  number of requests on this thread
+     */
+    size_t numRequests() const {return requests_;}
+
+    /// Retrieve number of heap allocations.
+    /**
+     * @return  number of allocations on this thread
+     */
+    size_t numAllocations() const {return allocations_;}
+
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Retrieve buffer.
+    /**
+     * @param[in] b  buffer slot
+     * @param[in] size  minimum number of elements
+     * @return  pointer to buffer of at least @p size elements (contents undefined)
+     */
+    double *buffer( Buffer b, size_t size );
+
+    /// Release all buffers held by this thread.
+    void clear();
+
+    // ========================================================================
+    // Static Methods
+    // ========================================================================
+
+    /// Retrieve workspace of calling thread.
+    /**
+     * @return  workspace
+     */
+    static _Myt& local();
+
+private:
+
+    std::vector<double> buffers_[_NUM_BUFFERS];
+
+    size_t requests_;
+    size_t allocations_;
+
+    // ========================================================================
+    // CTOR / DTOR
+    // ========================================================================
+
+    /// Constructor.
+    LatticeWorkspace();
+
+    // not implemented
+    LatticeWorkspace( const _Myt& ) = delete;
+
+    // not implemented
+    LatticeWorkspace( const _Myt&& ) = delete;
+
+    // not implemented
+    _Myt& operator = ( const _Myt& ) = delete;
+
+    // not implemented
+    _Myt& operator = ( const _Myt&& ) = delete;
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // LATTICEWORKSPACE_H
@@ -25,9 +25,9 @@
 
 #include "montecarlo.h"
 
+#include <algorithm>
 #include <cmath>
-#include <list>
-#include <numeric>
+#include <random>
 #include <thread>
 
 static const double pi = 3.14159265358979323846;
@@ -54,86 +54,68 @@ MonteCarlo::MonteCarlo( double S, double r, double b, double sigma, double T, si
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 double MonteCarlo::optionPrice( OptionType type, double X ) const
 {
-    const double z( (OptionType::Call == type) ? 1.0 : -1.0 );
-
-    const double drift( (b_ - pow2( sigma_ ) / 2.0) * T_ );
-
-    rng_engine_type rng( rng_ );
-    std::uniform_real_distribution<double> dist( 0.0, 1.0 );
+    // antithetic pairs
+    const size_t pairs( std::max<size_t>( 1, (N_ + 1) / 2 ) );
 
-    size_t n( N_ );
+    const size_t numBlocks( (pairs + BLOCK_SIZE - 1) / BLOCK_SIZE );
+    const size_t numChunks( (numBlocks + CHUNK_SIZE - 1) / CHUNK_SIZE );
 
-    double sum( 0.0 );
+    Sums sums = {};
 
-    double deltaSum( 0.0 );
-    double gammaSum( 0.0 );
-
-    do
+    if ( 1 == numChunks )
+        simulateChunk( type, X, 0, pairs, sums );
+    else
     {
-        // Independent uniform random variables
-        // Floor u1 to avoid errors with log function
-        const double u1 = std::fmax( dist( rng ), 1.0e-10 );
-        const double u2 = dist( rng );
-
-        // Z ~ N(0,1) by Box-Muller transformation
-        // Haug, chapter 8.3, for two values instead of one
-        const double T = tan( pi * u2 );
-        const double L = sqrt( -2.0 * log( u1 ) );
+        // split chunks across threads
+        // chunk sums are always added in the same order so results do not depend on thread count
+        const size_t numThreads( std::max<size_t>( 1, std::min<size_t>( std::thread::hardware_concurrency(), numChunks ) ) );
 
-        const double Z0 = L * (1.0 - pow2( T )) / (1.0 + pow2( T ));
-        const double Z1 = L * 2.0 * T / (1.0 + pow2( T ));
+        SumsList chunks( numChunks );
+        std::vector<std::thread> threads;
 
-        // unroll loop for processing of Z0 and Z1
+        for ( size_t t( 1 ); t < numThreads; ++t )
+            threads.emplace_back( &_Myt::simulateChunks, this, type, X, t, numThreads, pairs, &chunks );
 
-        {
-            // Simulated terminal price S(T)
-            const double ST = S_ * exp( drift + vst_ * Z0 );
-
-            sum += std::fmax( 0.0, z * (ST - X) );
-
-            if ( 0.0 < z )
-            {
-                if ( X < ST )
-                    deltaSum += ST;
-            }
-            else if ( ST < X )
-                deltaSum += ST;
-
-            if ( std::fabs( ST - X ) < 2.0 )
-                gammaSum += 1.0;
-        }
+        simulateChunks( type, X, 0, numThreads, pairs, &chunks );
 
-        if ( 0 == --n )
-            break;
+        for ( std::thread& t : threads )
+            t.join();
 
+        for ( const Sums& chunk : chunks )
         {
-            // Simulated terminal price S(T)
-            const double ST = S_ * exp( drift + vst_ * Z1 );
-
-            sum += std::fmax( 0.0, z * (ST - X) );
-
-            if ( 0.0 < z )
-            {
-                if ( X < ST )
-                    deltaSum += ST;
-            }
-            else if ( ST < X )
-                deltaSum += ST;
-
-            if ( std::fabs( ST - X ) < 2.0 )
-                gammaSum += 1.0;
+            sums.payoff += chunk.payoff;
+            sums.control += chunk.control;
+            sums.payoffControl += chunk.payoffControl;
+            sums.controlSq += chunk.controlSq;
+
+            sums.delta += chunk.delta;
+            sums.gamma += chunk.gamma;
+            sums.vega += chunk.vega;
         }
+    }
 
-    } while ( --n );
+    estimate( type, sums, pairs );
 
-    price_ = ert_ * sum / N_;
+    return price_;
+}
 
-    delta_ = (z * ert_ * deltaSum) / (N_ * S_);
-    gamma_ = (ert_ * pow2( X / S_ ) * gammaSum) / (4.0 * N_);
-    theta_ = (r_ * price_) - (b_ * S_ * delta_) - (0.5 * pow2( sigma_ ) * pow2( S_ ) * gamma_);
-    vega_ = gamma_ * sigma_ * pow2( S_ ) * T_;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void MonteCarlo::batchOptionPrice( const OptionType *types, const double *X, double *prices, size_t n ) const
+{
+    // simulate (do not use closed form from base class)
+    for ( size_t i( 0 ); i < n; ++i )
+        prices[i] = optionPrice( types[i], X[i] );
+}
 
-    return price_;
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void MonteCarlo::batchPartials( const OptionType *types, const double *X, double *delta, double *gamma, double *theta, double *vega, double *rho, size_t n ) const
+{
+    // partials come from simulation, so each strike needs its own
+    for ( size_t i( 0 ); i < n; ++i )
+    {
+        optionPrice( types[i], X[i] );
+        partials( types[i], X[i], delta[i], gamma[i], theta[i], vega[i], rho[i] );
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -153,11 +135,11 @@ void MonteCarlo::partials( OptionType type, double X, double& delta, double& gam
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 double MonteCarlo::rho( OptionType type, double X ) const
 {
-    // rho
-    const double diff( 0.01 );
+    Q_UNUSED( type )
+    Q_UNUSED( X )
 
-    _Myt calc( S_, r_+diff, b_+diff, sigma_, T_, N_, rng_ );
-    return (calc.optionPrice( type, X ) - price_) / diff;
+    // rho
+    return rho_;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -180,6 +162,33 @@ void MonteCarlo::copy( const _Myt& other )
     rng_ = other.rng_;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void MonteCarlo::estimate( OptionType type, const Sums& sums, size_t pairs ) const
+{
+    const double z( (OptionType::Call == type) ? 1.0 : -1.0 );
+
+    // control variate, expected terminal price is known exactly
+    const double meanPayoff( sums.payoff / pairs );
+    const double meanControl( sums.control / pairs );
+
+    const double cov( sums.payoffControl / pairs - meanPayoff * meanControl );
+    const double var( sums.controlSq / pairs - pow2( meanControl ) );
+
+    const double beta( (0.0 < var) ? (cov / var) : 0.0 );
+
+    price_ = ert_ * (meanPayoff - beta * (meanControl - sbrt_ / ert_));
+
+    // pathwise delta and vega, likelihood ratio gamma
+    delta_ = (z * ert_ * sums.delta) / (pairs * S_);
+    gamma_ = (z * ert_ * sums.gamma) / (pairs * pow2( S_ ));
+    vega_ = (z * ert_ * sums.vega) / pairs;
+
+    theta_ = (r_ * price_) - (b_ * S_ * delta_) - (0.5 * pow2( sigma_ ) * pow2( S_ ) * gamma_);
+
+    // rate and carry both move with rho
+    rho_ = T_ * (S_ * delta_ - price_);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void MonteCarlo::move( const _Myt&& other )
 {
@@ -190,10 +199,109 @@ void MonteCarlo::move( const _Myt&& other )
     rng_ = std::move( other.rng_ );
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void MonteCarlo::normals( size_t block, double Z[BLOCK_SIZE] ) const
+{
+    static constexpr size_t HALF = BLOCK_SIZE / 2;
+    static constexpr size_t COUNTERS = BLOCK_SIZE / rng_engine_type::BLOCK_SIZE;
+
+    // uniforms for block
+    double u[BLOCK_SIZE];
+
+    for ( size_t i( 0 ); i < COUNTERS; ++i )
+    {
+        uint32_t r[rng_engine_type::BLOCK_SIZE];
+        rng_.generate( block * COUNTERS + i, r );
+
+        for ( size_t j( 0 ); j < rng_engine_type::BLOCK_SIZE; ++j )
+            u[i * rng_engine_type::BLOCK_SIZE + j] = rng_engine_type::toUniform( r[j] );
+    }
+
+    // Z ~ N(0,1) by Box-Muller transformation
+    for ( size_t i( 0 ); i < HALF; ++i )
+    {
+        const double L( sqrt( -2.0 * log( u[i] ) ) );
+        const double theta( 2.0 * pi * u[i + HALF] );
+
+        Z[i] = L * cos( theta );
+        Z[i + HALF] = L * sin( theta );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void MonteCarlo::simulate( OptionType type, double X, size_t block, size_t n, Sums& sums ) const
+{
+    const double z( (OptionType::Call == type) ? 1.0 : -1.0 );
+
+    // forward price, antithetic path is fwd^2 / ST
+    const double drift( (b_ - pow2( sigma_ ) / 2.0) * T_ );
+    const double fwd( S_ * exp( drift ) );
+
+    double Z[BLOCK_SIZE];
+    normals( block, Z );
+
+    // simulated terminal prices S(T)
+    double ST[BLOCK_SIZE];
+
+    for ( size_t i( 0 ); i < n; ++i )
+        ST[i] = fwd * exp( vst_ * Z[i] );
+
+    const double gammaScale( (0.0 < vst_) ? (1.0 / vst_) : 0.0 );
+    const double vegaDrift( sigma_ * T_ );
+
+    for ( size_t i( 0 ); i < n; ++i )
+    {
+        const double up( ST[i] );
+        const double down( pow2( fwd ) / up );
+
+        const double payoffUp( std::fmax( 0.0, z * (up - X) ) );
+        const double payoffDown( std::fmax( 0.0, z * (down - X) ) );
+
+        const double payoff( 0.5 * (payoffUp + payoffDown) );
+        const double control( 0.5 * (up + down) );
+
+        sums.payoff += payoff;
+        sums.control += control;
+        sums.payoffControl += payoff * control;
+        sums.controlSq += pow2( control );
+
+        // partials only pick up paths that finish in the money
+        const double itmUp( (0.0 < payoffUp) ? up : 0.0 );
+        const double itmDown( (0.0 < payoffDown) ? down : 0.0 );
+
+        sums.delta += 0.5 * (itmUp + itmDown);
+        sums.gamma += 0.5 * (itmUp * (Z[i] * gammaScale - 1.0) + itmDown * (-Z[i] * gammaScale - 1.0));
+        sums.vega += 0.5 * (itmUp * (Z[i] * st_ - vegaDrift) + itmDown * (-Z[i] * st_ - vegaDrift));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void MonteCarlo::simulateChunk( OptionType type, double X, size_t chunk, size_t pairs, Sums& sums ) const
+{
+    sums = Sums();
+
+    for ( size_t block( chunk * CHUNK_SIZE ); block < (chunk + 1) * CHUNK_SIZE; ++block )
+    {
+        const size_t first( block * BLOCK_SIZE );
+
+        if ( pairs <= first )
+            break;
+
+        simulate( type, X, block, std::min( BLOCK_SIZE, pairs - first ), sums );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void MonteCarlo::simulateChunks( OptionType type, double X, size_t first, size_t step, size_t pairs, SumsList *sums ) const
+{
+    for ( size_t chunk( first ); chunk < sums->size(); chunk += step )
+        simulateChunk( type, X, chunk, pairs, (*sums)[chunk] );
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 #if defined( QT_DEBUG )
 
-#define Q_ASSERT_DOUBLE( fn, v ) {const double result = fn; Q_ASSERT( v-0.02 <= result && result <= v+0.02 );}
+#define Q_ASSERT_DOUBLE( fn, v, e ) {const double result = fn; Q_ASSERT( v-e <= result && result <= v+e );}
 
 void MonteCarlo::validate()
 {
@@ -211,13 +319,48 @@ void MonteCarlo::validate()
         const double p0 = 5.5735;
         const double p1 = mc.optionPrice( OptionType::Put, K );
 
-        Q_ASSERT_DOUBLE( p0, p1 );
+        Q_ASSERT_DOUBLE( p0, p1, 0.02 );
 
         const double c0 = 10.4506;
         const double c1 = mc.optionPrice( OptionType::Call, K );
 
-        Q_ASSERT_DOUBLE( c0, c1 );
+        Q_ASSERT_DOUBLE( c0, c1, 0.02 );
+    }
+
+    {
+        // partials against closed form
+        const double S = 100.0;
+        const double r = 0.03;
+        const double q = 0.01;
+        const double v = 0.3;
+        const double T = 0.5;
+
+        BlackScholes bs( S, r, r-q, v, T );
+        _Myt mc( S, r, r-q, v, T, 1024*1024, rng_engine_type( 42 ) );
+
+        for ( OptionType type : {OptionType::Call, OptionType::Put} )
+            for ( double X : {90.0, 100.0, 110.0} )
+            {
+                double delta0, gamma0, theta0, vega0, rho0;
+                double delta1, gamma1, theta1, vega1, rho1;
+
+                const double p0 = bs.optionPrice( type, X );
+                bs.partials( type, X, delta0, gamma0, theta0, vega0, rho0 );
+
+                const double p1 = mc.optionPrice( type, X );
+                mc.partials( type, X, delta1, gamma1, theta1, vega1, rho1 );
+
+                Q_ASSERT_DOUBLE( p0, p1, 0.02 );
+                Q_ASSERT_DOUBLE( delta0, delta1, 0.002 );
+                Q_ASSERT_DOUBLE( gamma0, gamma1, 0.0005 );
+                Q_ASSERT_DOUBLE( theta0, theta1, 0.1 );
+                Q_ASSERT_DOUBLE( vega0, vega1, 0.2 );
+                Q_ASSERT_DOUBLE( rho0, rho1, 0.2 );
+
+                // same key, same paths
+                _Myt mc2( S, r, r-q, v, T, 1024*1024, rng_engine_type( 42 ) );
+                Q_ASSERT( p1 == mc2.optionPrice( type, X ) );
+            }
     }
 }
 #endif
-
@@ -24,12 +24,19 @@
 #define MONTECARLO_H
 
 #include "blackscholes.h"
-
-#include <random>
+#include "philox.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Monte Carlo Simulation for Option Pricing
+/**
+ * Paths are drawn in antithetic pairs from a counter based generator, and the price uses the
+ * terminal underlying price as a control variate. Partials come from pathwise (delta, vega, rho)
+ * and likelihood ratio (gamma) estimators over the same paths, so nothing is simulated twice.
+ *
+ * Paths are simulated in fixed blocks that each have their own generator counters and sums, so
+ * results are identical however blocks are split across threads.
+ */
 class MonteCarlo : public BlackScholes
 {
     using _Myt = MonteCarlo;
@@ -38,7 +45,7 @@ class MonteCarlo : public BlackScholes
 public:
 
     /// Random number generator engine type.
-    using rng_engine_type = std::mt19937_64;
+    using rng_engine_type = Philox4x32;
 
     // ========================================================================
     // CTOR / DTOR
@@ -65,7 +72,7 @@ public:
      * @param[in] sigma  volatility of underlying
      * @param[in] T  time to expiration (years)
      * @param[in] N  number of simulations
-     * @param[in] rng  random number generator
+     * @param[in] rng  random number generator (paths are a function of its key only)
      */
     MonteCarlo( double S, double r, double b, double sigma, double T, size_t N, const rng_engine_type& rng );
 
@@ -111,6 +118,30 @@ public:
      */
     virtual double optionPrice( OptionType type, double X ) const override;
 
+    /// Compute option prices for a ladder of strikes.
+    /**
+     * Each strike is simulated over the same paths.
+     * @param[in] types  option types
+     * @param[in] X  strike prices
+     * @param[out] prices  option prices
+     * @param[in] n  number of options
+     */
+    virtual void batchOptionPrice( const OptionType *types, const double *X, double *prices, size_t n ) const override;
+
+    /// Compute partials for a ladder of strikes.
+    /**
+     * Each strike is simulated over the same paths.
+     * @param[in] types  option types
+     * @param[in] X  strike prices
+     * @param[out] delta  partials with respect to underlying price
+     * @param[out] gamma  second partials with respect to underlying price
+     * @param[out] theta  partials with respect to time
+     * @param[out] vega  partials with respect to sigma
+     * @param[out] rho  partials with respect to rate
+     * @param[in] n  number of options
+     */
+    virtual void batchPartials( const OptionType *types, const double *X, double *delta, double *gamma, double *theta, double *vega, double *rho, size_t n ) const override;
+
     /// Compute partials.
     /**
      * @note
@@ -159,8 +190,40 @@ public:
 
 protected:
 
+    static constexpr size_t BLOCK_SIZE = 64;        ///< Antithetic pairs per block.
+
+    /// Sums over simulated paths.
+    struct Sums
+    {
+        double payoff;                              ///< Payoff.
+        double control;                             ///< Control variate (terminal price).
+        double payoffControl;                       ///< Payoff times control variate.
+        double controlSq;                           ///< Control variate squared.
+
+        double delta;                               ///< Pathwise delta.
+        double gamma;                               ///< Likelihood ratio gamma.
+        double vega;                                ///< Pathwise vega.
+    };
+
     size_t N_;                                      ///< Number of simulations.
 
+    mutable double price_;                          ///< Option price.
+
+    mutable double delta_;                          ///< Delta.
+    mutable double gamma_;                          ///< Gamma.
+    mutable double theta_;                          ///< Theta.
+    mutable double vega_;                           ///< Vega.
+    mutable double rho_;                            ///< Rho.
+
+    rng_engine_type rng_;                           ///< Random number generator.
+
+    // ========================================================================
+    // CTOR / DTOR
+    // ========================================================================
+
+    /// Constructor.
+    MonteCarlo() {}
+
     // ========================================================================
     // Methods
     // ========================================================================
@@ -172,6 +235,14 @@ protected:
      */
     void copy( const _Myt& other );
 
+    /// Compute option price and partials from sums.
+    /**
+     * @param[in] type  option type
+     * @param[in] sums  sums over simulated paths
+     * @param[in] pairs  number of antithetic pairs in @a sums
+     */
+    void estimate( OptionType type, const Sums& sums, size_t pairs ) const;
+
     /// Move object.
     /**
      * @param[in] other  object to move
@@ -179,16 +250,49 @@ protected:
      */
     void move( const _Myt&& other );
 
+    /// Generate standard normal variates for block.
+    /**
+     * @param[in] block  block index
+     * @param[out] Z  normal variates
+     */
+    virtual void normals( size_t block, double Z[BLOCK_SIZE] ) const;
+
+    /// Simulate block of antithetic path pairs.
+    /**
+     * @param[in] type  option type
+     * @param[in] X  strike price
+     * @param[in] block  block index
+     * @param[in] n  number of pairs to use from block
+     * @param[in,out] sums  sums to add block to
+     */
+    void simulate( OptionType type, double X, size_t block, size_t n, Sums& sums ) const;
+
 private:
 
-    mutable double price_;
+    static constexpr size_t CHUNK_SIZE = 256;       // blocks per chunk of work
+
+    using SumsList = std::vector<Sums>;
 
-    mutable double delta_;
-    mutable double gamma_;
-    mutable double theta_;
-    mutable double vega_;
+    /// Simulate chunk of blocks.
+    /**
+     * @param[in] type  option type
+     * @param[in] X  strike price
+     * @param[in] chunk  chunk index
+     * @param[in] pairs  total number of pairs
+     * @param[out] sums  sums over chunk
+     */
+    void simulateChunk( OptionType type, double X, size_t chunk, size_t pairs, Sums& sums ) const;
 
-    rng_engine_type rng_;
+    /// Simulate every n-th chunk.
+    /**
+     * @param[in] type  option type
+     * @param[in] X  strike price
+     * @param[in] first  first chunk index
+     * @param[in] step  chunk index increment
+     * @param[in] pairs  total number of pairs
+     * @param[out] sums  sums of each chunk
+     */
+    void simulateChunks( OptionType type, double X, size_t first, size_t step, size_t pairs, SumsList *sums ) const;
 
 };
 
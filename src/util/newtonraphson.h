@@ -55,6 +55,20 @@ public:
     template <class T>
     static double calcImplVol( T *pricing, OptionType type, double X, double price, bool *okay = nullptr );
 
+    /// Calculate implied volatility.
+    /**
+     * @tparam T  option pricing class
+     * @param[in,out] pricing  option pricing
+     * @param[in] type  option type
+     * @param[in] X  strike price
+     * @param[in] price  option price
+     * @param[in] seed  initial volatility guess
+     * @param[out] okay  @c true if calculation okay, @c false otherwise
+     * @return  implied volatility of @a pricing
+     */
+    template <class T>
+    static double calcImplVol( T *pricing, OptionType type, double X, double price, double seed, bool *okay = nullptr );
+
 #if defined( QT_DEBUG )
     /// Validate methods.
     static void validate();
@@ -83,6 +97,13 @@ private:
 
 template <class T>
 inline double NewtonRaphson::calcImplVol( T *pricing, OptionType type, double X, double price, bool *okay )
+{
+    // Compute the Manaster and Koehler seed value (vi)
+    return calcImplVol( pricing, type, X, price, pricing->calcImplVolSeedValue( X ), okay );
+}
+
+template <class T>
+inline double NewtonRaphson::calcImplVol( T *pricing, OptionType type, double X, double price, double seed, bool *okay )
 {
     static const double VOLATILITY_MIN = 0.0000001;
     static const double VOLATILITY_MAX = 1000.0 - VOLATILITY_MIN;
@@ -90,8 +111,7 @@ inline double NewtonRaphson::calcImplVol( T *pricing, OptionType type, double X,
 
     size_t maxloops( MAX_LOOPS );
 
-    // Compute the Manaster and Koehler seed value (vi)
-    double vi = pricing->calcImplVolSeedValue( X );
+    double vi = seed;
 
     pricing->setSigma( vi );
 
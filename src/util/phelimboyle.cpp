@@ -62,6 +62,13 @@ double PhelimBoyle::optionPrice( OptionType type, double X ) const
     return calcOptionPrice( (OptionType::Call == type), S_, X, u_, d_, pu_, pd_, pm_, Df_ );
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void PhelimBoyle::batchOptionPrice( const OptionType *types, const double *X, double *prices, size_t n ) const
+{
+    // calc!
+    calcOptionPrices( types, X, prices, n, S_, u_, d_, pu_, pd_, pm_, Df_ );
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void PhelimBoyle::copy( const _Myt& other )
 {
@@ -167,6 +174,33 @@ void PhelimBoyle::validate()
 
         Q_ASSERT_DOUBLE( cm0, cm1 );
     }
+
+    // strike ladder priced with one tree
+    {
+        const double S = 100.0;
+        const double r = 0.1;
+        const double b = 0.1;
+        const double sigma = 0.27;
+        const double T = 0.5;
+
+        static const size_t LADDER = 9;
+
+        OptionType types[LADDER];
+        double X[LADDER], prices[LADDER];
+
+        for ( size_t i( 0 ); i < LADDER; ++i )
+        {
+            types[i] = (i % 2) ? OptionType::Put : OptionType::Call;
+            X[i] = 80.0 + 5.0 * i;
+        }
+
+        _Myt pb( S, r, b, sigma, T, 100 );
+
+        pb.batchOptionPrice( types, X, prices, LADDER );
+
+        for ( size_t i( 0 ); i < LADDER; ++i )
+            Q_ASSERT_DOUBLE( pb.optionPrice( types[i], X[i] ), prices[i] );
+    }
 }
 #endif
 
@@ -0,0 +1,73 @@
+/**
+ * @file philox.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "philox.h"
+
+#include <QtGlobal>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#if defined( QT_DEBUG )
+void Philox4x32::validate()
+{
+    // known answers from Random123 (kat_vectors)
+    {
+        const uint32_t ctr[BLOCK_SIZE] = {0x00000000, 0x00000000, 0x00000000, 0x00000000};
+
+        uint32_t result[BLOCK_SIZE];
+        _Myt( 0 ).generate( ctr, result );
+
+        Q_ASSERT( 0x6627e8d5 == result[0] );
+        Q_ASSERT( 0xe169c58d == result[1] );
+        Q_ASSERT( 0xbc57ac4c == result[2] );
+        Q_ASSERT( 0x9b00dbd8 == result[3] );
+    }
+
+    {
+        const uint32_t ctr[BLOCK_SIZE] = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+
+        uint32_t result[BLOCK_SIZE];
+        _Myt( 0xffffffffffffffff ).generate( ctr, result );
+
+        Q_ASSERT( 0x408f276d == result[0] );
+        Q_ASSERT( 0x41c83b0e == result[1] );
+        Q_ASSERT( 0xa20bc7c6 == result[2] );
+        Q_ASSERT( 0x6d5451fd == result[3] );
+    }
+
+    {
+        const uint32_t ctr[BLOCK_SIZE] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+
+        uint32_t result[BLOCK_SIZE];
+        _Myt( 0x299f31d0a4093822 ).generate( ctr, result );
+
+        Q_ASSERT( 0xd16cfe09 == result[0] );
+        Q_ASSERT( 0x94fdcceb == result[1] );
+        Q_ASSERT( 0x5001e420 == result[2] );
+        Q_ASSERT( 0x24126ea1 == result[3] );
+    }
+
+    {
+        // uniforms stay inside open interval
+        Q_ASSERT( 0.0 < toUniform( 0 ) );
+        Q_ASSERT( toUniform( 0xffffffff ) < 1.0 );
+    }
+}
+#endif
@@ -0,0 +1,154 @@
+/**
+ * @file philox.h
+ * Philox counter based random number generator.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include <cstddef>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Philox4x32-10 counter based random number generator.
+/**
+ * Output is a pure function of key and counter, so any block of random numbers can be generated
+ * directly without stepping through the ones before it. Work can be split across threads in any
+ * way and still draw exactly the same numbers.
+ *
+ * @see  Salmon, Moraes, Dror, Shaw, "Parallel Random Numbers: As Easy as 1, 2, 3", SC11
+ */
+class Philox4x32
+{
+    using _Myt = Philox4x32;
+
+public:
+
+    /// Number of random values generated per counter.
+    static constexpr size_t BLOCK_SIZE = 4;
+
+    // ========================================================================
+    // CTOR / DTOR
+    // ========================================================================
+
+    /// Constructor.
+    /**
+     * @param[in] seed  key
+     */
+    Philox4x32( uint64_t seed = 0 ) :
+        k0_( static_cast<uint32_t>( seed ) ),
+        k1_( static_cast<uint32_t>( seed >> 32 ) )
+    {
+    }
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// Retrieve key.
+    /**
+     * @return  key
+     */
+    uint64_t seed() const {return (static_cast<uint64_t>( k1_ ) << 32) | k0_;}
+
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Generate random values for counter.
+    /**
+     * @param[in] ctr  counter
+     * @param[out] result  random values
+     */
+    void generate( const uint32_t ctr[BLOCK_SIZE], uint32_t result[BLOCK_SIZE] ) const;
+
+    /// Generate random values for counter.
+    /**
+     * @param[in] ctr  counter
+     * @param[out] result  random values
+     */
+    void generate( uint64_t ctr, uint32_t result[BLOCK_SIZE] ) const
+    {
+        const uint32_t c[BLOCK_SIZE] = {static_cast<uint32_t>( ctr ), static_cast<uint32_t>( ctr >> 32 ), 0, 0};
+        generate( c, result );
+    }
+
+    // ========================================================================
+    // Static Methods
+    // ========================================================================
+
+    /// Convert random value to uniform.
+    /**
+     * @param[in] value  random value
+     * @return  uniform value in open interval (0, 1)
+     */
+    static constexpr double toUniform( uint32_t value ) {return (value + 0.5) / 4294967296.0;}
+
+#if defined( QT_DEBUG )
+    /// Validate methods.
+    static void validate();
+#endif
+
+private:
+
+    static constexpr size_t ROUNDS = 10;
+
+    static constexpr uint32_t M0 = 0xD2511F53;
+    static constexpr uint32_t M1 = 0xCD9E8D57;
+
+    static constexpr uint32_t W0 = 0x9E3779B9;
+    static constexpr uint32_t W1 = 0xBB67AE85;
+
+    uint32_t k0_;
+    uint32_t k1_;
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+inline void Philox4x32::generate( const uint32_t ctr[BLOCK_SIZE], uint32_t result[BLOCK_SIZE] ) const
+{
+    uint32_t c0( ctr[0] ), c1( ctr[1] ), c2( ctr[2] ), c3( ctr[3] );
+    uint32_t k0( k0_ ), k1( k1_ );
+
+    for ( size_t round( ROUNDS ); round--; )
+    {
+        const uint64_t p0( static_cast<uint64_t>( M0 ) * c0 );
+        const uint64_t p1( static_cast<uint64_t>( M1 ) * c2 );
+
+        c0 = static_cast<uint32_t>( p1 >> 32 ) ^ c1 ^ k0;
+        c1 = static_cast<uint32_t>( p1 );
+        c2 = static_cast<uint32_t>( p0 >> 32 ) ^ c3 ^ k1;
+        c3 = static_cast<uint32_t>( p0 );
+
+        // bump key
+        k0 += W0;
+        k1 += W1;
+    }
+
+    result[0] = c0;
+    result[1] = c1;
+    result[2] = c2;
+    result[3] = c3;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // PHILOX_H
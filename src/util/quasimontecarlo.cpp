@@ -0,0 +1,252 @@
+/**
+ * @file quasimontecarlo.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "quasimontecarlo.h"
+
+#include <cmath>
+
+/// Power of two (square) function.
+#define pow2(n) ((n) * (n))
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Inverse of continuous normal distribution function.
+/**
+ * Acklam's rational approximation, relative error below 1.15e-9.
+ * @param[in] p  probability in open interval (0, 1)
+ * @return  standard normal variate
+ */
+static double invcnd( double p )
+{
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02, 1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02, 6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00, -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00, 3.754408661907416e+00};
+
+    static const double P_LOW = 0.02425;
+
+    if ( p < P_LOW )
+    {
+        const double q( sqrt( -2.0 * log( p ) ) );
+        return (((((c[0]*q + c[1])*q + c[2])*q + c[3])*q + c[4])*q + c[5]) / ((((d[0]*q + d[1])*q + d[2])*q + d[3])*q + 1.0);
+    }
+    else if ( p <= 1.0 - P_LOW )
+    {
+        const double q( p - 0.5 );
+        const double r( q * q );
+        return (((((a[0]*r + a[1])*r + a[2])*r + a[3])*r + a[4])*r + a[5])*q / (((((b[0]*r + b[1])*r + b[2])*r + b[3])*r + b[4])*r + 1.0);
+    }
+
+    const double q( sqrt( -2.0 * log( 1.0 - p ) ) );
+    return -(((((c[0]*q + c[1])*q + c[2])*q + c[3])*q + c[4])*q + c[5]) / ((((d[0]*q + d[1])*q + d[2])*q + d[3])*q + 1.0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QuasiMonteCarlo::QuasiMonteCarlo( double S, double r, double b, double sigma, double T, size_t N ) :
+    _Mybase( S, r, b, sigma, T, N ),
+    stdErr_( 0.0 )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QuasiMonteCarlo::QuasiMonteCarlo( double S, double r, double b, double sigma, double T, size_t N, const rng_engine_type& rng ) :
+    _Mybase( S, r, b, sigma, T, N, rng ),
+    stdErr_( 0.0 )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+double QuasiMonteCarlo::optionPrice( OptionType type, double X ) const
+{
+    const size_t pairs( pairsPerReplicate() );
+    const size_t blocks( blocksPerReplicate() );
+
+    double price( 0.0 );
+    double priceSq( 0.0 );
+
+    double delta( 0.0 );
+    double gamma( 0.0 );
+    double theta( 0.0 );
+    double vega( 0.0 );
+    double rho( 0.0 );
+
+    // each replicate is an independent estimate
+    for ( size_t rep( 0 ); rep < REPLICATES; ++rep )
+    {
+        Sums sums = {};
+
+        for ( size_t block( 0 ); block < blocks; ++block )
+            simulate( type, X, rep * blocks + block, std::min( BLOCK_SIZE, pairs - block * BLOCK_SIZE ), sums );
+
+        estimate( type, sums, pairs );
+
+        price += price_;
+        priceSq += pow2( price_ );
+
+        delta += delta_;
+        gamma += gamma_;
+        theta += theta_;
+        vega += vega_;
+        rho += rho_;
+    }
+
+    price_ = price / REPLICATES;
+
+    delta_ = delta / REPLICATES;
+    gamma_ = gamma / REPLICATES;
+    theta_ = theta / REPLICATES;
+    vega_ = vega / REPLICATES;
+    rho_ = rho / REPLICATES;
+
+    // standard error of mean
+    const double var( (priceSq / REPLICATES - pow2( price_ )) * REPLICATES / (REPLICATES - 1) );
+
+    stdErr_ = sqrt( std::fmax( 0.0, var ) / REPLICATES );
+
+    return price_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void QuasiMonteCarlo::copy( const _Myt& other )
+{
+    _Mybase::copy( other );
+
+    sobol_ = other.sobol_;
+
+    stdErr_ = other.stdErr_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void QuasiMonteCarlo::move( const _Myt&& other )
+{
+    _Mybase::move( std::move( other ) );
+
+    sobol_ = std::move( other.sobol_ );
+
+    stdErr_ = std::move( other.stdErr_ );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void QuasiMonteCarlo::normals( size_t block, double Z[BLOCK_SIZE] ) const
+{
+    const size_t blocks( blocksPerReplicate() );
+
+    const size_t rep( block / blocks );
+    const size_t first( (block % blocks) * BLOCK_SIZE );
+
+    // scramble for replicate
+    uint32_t seed[rng_engine_type::BLOCK_SIZE];
+    rng_.generate( rep, seed );
+
+    uint32_t x[BLOCK_SIZE];
+    sobol_.generate( static_cast<uint32_t>( first ), BLOCK_SIZE, x );
+
+    for ( size_t i( 0 ); i < BLOCK_SIZE; ++i )
+        Z[i] = invcnd( rng_engine_type::toUniform( Sobol::scramble( x[i], seed[0] ) ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+size_t QuasiMonteCarlo::pairsPerReplicate() const
+{
+    // sobol points are best balanced in powers of two
+    size_t pairs( 1 );
+
+    while ( pairs * REPLICATES * 2 < N_ )
+        pairs <<= 1;
+
+    return pairs;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#if defined( QT_DEBUG )
+
+#define Q_ASSERT_DOUBLE( fn, v, e ) {const double result = fn; Q_ASSERT( v-e <= result && result <= v+e );}
+
+void QuasiMonteCarlo::validate()
+{
+    {
+        // inverse normal
+        Q_ASSERT_DOUBLE( invcnd( 0.5 ), 0.0, 1.0e-12 );
+        Q_ASSERT_DOUBLE( invcnd( 0.975 ), 1.959963984540054, 1.0e-8 );
+        Q_ASSERT_DOUBLE( invcnd( 0.001 ), -3.090232306167814, 1.0e-8 );
+        Q_ASSERT_DOUBLE( invcnd( 1.0e-9 ), -5.997807015007686, 1.0e-8 );
+    }
+
+    {
+        double S = 100.0;       // Spot Price
+        double K = 100.0;       // Strike Price
+        double T = 1;           // Maturity in Years
+        double r = 0.05;        // Interest Rate
+        double q = 0;           // Dividend yeild
+        double v = 0.2;         // Volatility
+
+        _Myt qmc( S, r, r-q, v, T, 64*1024 );
+
+        const double p0 = 5.5735;
+        const double p1 = qmc.optionPrice( OptionType::Put, K );
+
+        Q_ASSERT_DOUBLE( p0, p1, 0.002 );
+        Q_ASSERT( qmc.standardError() < 0.002 );
+
+        const double c0 = 10.4506;
+        const double c1 = qmc.optionPrice( OptionType::Call, K );
+
+        Q_ASSERT_DOUBLE( c0, c1, 0.002 );
+        Q_ASSERT( qmc.standardError() < 0.002 );
+    }
+
+    {
+        // partials against closed form
+        const double S = 100.0;
+        const double r = 0.03;
+        const double q = 0.01;
+        const double v = 0.3;
+        const double T = 0.5;
+
+        BlackScholes bs( S, r, r-q, v, T );
+        _Myt qmc( S, r, r-q, v, T, 64*1024, rng_engine_type( 42 ) );
+
+        for ( OptionType type : {OptionType::Call, OptionType::Put} )
+            for ( double X : {90.0, 100.0, 110.0} )
+            {
+                double delta0, gamma0, theta0, vega0, rho0;
+                double delta1, gamma1, theta1, vega1, rho1;
+
+                const double p0 = bs.optionPrice( type, X );
+                bs.partials( type, X, delta0, gamma0, theta0, vega0, rho0 );
+
+                const double p1 = qmc.optionPrice( type, X );
+                qmc.partials( type, X, delta1, gamma1, theta1, vega1, rho1 );
+
+                Q_ASSERT_DOUBLE( p0, p1, 0.005 );
+                Q_ASSERT_DOUBLE( delta0, delta1, 0.001 );
+                Q_ASSERT_DOUBLE( gamma0, gamma1, 0.0002 );
+                Q_ASSERT_DOUBLE( theta0, theta1, 0.05 );
+                Q_ASSERT_DOUBLE( vega0, vega1, 0.1 );
+                Q_ASSERT_DOUBLE( rho0, rho1, 0.1 );
+
+                // same key, same scrambles
+                _Myt qmc2( S, r, r-q, v, T, 64*1024, rng_engine_type( 42 ) );
+                Q_ASSERT( p1 == qmc2.optionPrice( type, X ) );
+            }
+    }
+}
+#endif
@@ -0,0 +1,182 @@
+/**
+ * @file quasimontecarlo.h
+ * Quasi Monte Carlo Simulation for Option Pricing.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUASIMONTECARLO_H
+#define QUASIMONTECARLO_H
+
+#include "montecarlo.h"
+#include "sobol.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Quasi Monte Carlo Simulation for Option Pricing
+/**
+ * Same estimators as MonteCarlo, with normals drawn from a scrambled Sobol sequence instead of a
+ * pseudo random generator. Error falls off close to 1/N instead of 1/sqrt(N).
+ *
+ * Paths are split into independently scrambled replicates. The price is the mean of the
+ * replicates and their spread gives the standard error. Scrambles are keyed by the random number
+ * generator, so the same generator always gives the same result.
+ *
+ * Payoffs only depend on the terminal price, so Brownian bridge construction reduces to drawing
+ * the terminal point from the first (best distributed) dimension of the sequence.
+ */
+class QuasiMonteCarlo : public MonteCarlo
+{
+    using _Myt = QuasiMonteCarlo;
+    using _Mybase = MonteCarlo;
+
+public:
+
+    // ========================================================================
+    // CTOR / DTOR
+    // ========================================================================
+
+    /// Constructor.
+    /**
+     * @param[in] S  underlying price
+     * @param[in] r  risk-free interest rate
+     * @param[in] b  cost-of-carry rate of holding underlying
+     * @param[in] sigma  volatility of underlying
+     * @param[in] T  time to expiration (years)
+     * @param[in] N  number of simulations (rounded up to fill replicates)
+     */
+    QuasiMonteCarlo( double S, double r, double b, double sigma, double T, size_t N );
+
+    /// Constructor.
+    /**
+     * @param[in] S  underlying price
+     * @param[in] r  risk-free interest rate
+     * @param[in] b  cost-of-carry rate of holding underlying
+     * @param[in] sigma  volatility of underlying
+     * @param[in] T  time to expiration (years)
+     * @param[in] N  number of simulations (rounded up to fill replicates)
+     * @param[in] rng  random number generator (scrambles are a function of its key only)
+     */
+    QuasiMonteCarlo( double S, double r, double b, double sigma, double T, size_t N, const rng_engine_type& rng );
+
+    /// Constructor.
+    /**
+     * @param[in] other  object to copy
+     */
+    QuasiMonteCarlo( const _Myt& other ) : _Mybase() {copy( other );}
+
+    /// Constructor.
+    /**
+     * @param[in] other  object to move
+     */
+    QuasiMonteCarlo( const _Myt&& other ) : _Mybase() {move( std::move( other ) );}
+
+    // ========================================================================
+    // Operators
+    // ========================================================================
+
+    /// Assignment operator.
+    /**
+     * @param[in] rhs  object to copy
+     * @return  reference to this
+     */
+    _Myt& operator = ( const _Myt& rhs ) {copy( rhs ); return *this;}
+
+    /// Move operator.
+    /**
+     * @param[in] rhs  object to move
+     * @return  reference to this
+     */
+    _Myt& operator = ( const _Myt&& rhs ) {move( std::move( rhs ) ); return *this;}
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// Compute option price.
+    /**
+     * @param[in] type  option type
+     * @param[in] X  strike price
+     * @return  option price
+     */
+    virtual double optionPrice( OptionType type, double X ) const override;
+
+    /// Retrieve standard error of option price.
+    /**
+     * @note
+     * Assumes you calculated the option price prior to calling this.
+     * @return  standard error across replicates
+     * @sa  optionPrice()
+     */
+    double standardError() const {return stdErr_;}
+
+    // ========================================================================
+    // Static Methods
+    // ========================================================================
+
+#if defined( QT_DEBUG )
+    /// Validate methods.
+    static void validate();
+#endif
+
+protected:
+
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Copy object.
+    /**
+     * @param[in] other  object to copy
+     * @return  reference to this
+     */
+    void copy( const _Myt& other );
+
+    /// Move object.
+    /**
+     * @param[in] other  object to move
+     * @return  reference to this
+     */
+    void move( const _Myt&& other );
+
+    /// Generate standard normal variates for block.
+    /**
+     * @param[in] block  block index
+     * @param[out] Z  normal variates
+     */
+    virtual void normals( size_t block, double Z[BLOCK_SIZE] ) const override;
+
+private:
+
+    static constexpr size_t REPLICATES = 16;
+
+    Sobol sobol_;
+
+    mutable double stdErr_;
+
+    /// Retrieve number of antithetic pairs per replicate.
+    size_t pairsPerReplicate() const;
+
+    /// Retrieve number of blocks per replicate.
+    size_t blocksPerReplicate() const {return (pairsPerReplicate() + BLOCK_SIZE - 1) / BLOCK_SIZE;}
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // QUASIMONTECARLO_H
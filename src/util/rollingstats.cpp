@@ -0,0 +1,171 @@
+/**
+ * @file rollingstats.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "rollingstats.h"
+#include "stats.h"
+
+#include <cmath>
+
+#include <QDataStream>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+RollingStats::RollingStats( int depth ) :
+    depth_( (depth < 1) ? 1 : depth ),
+    window_( depth_, 0.0 )
+{
+    clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+double RollingStats::stdDeviation() const
+{
+    if ( !count_ )
+        return 0.0;
+
+    // guard against rounding below zero
+    return sqrt( fmax( m2_, 0.0 ) / count_ );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void RollingStats::add( double value )
+{
+    // grow window
+    if ( count_ < depth_ )
+    {
+        ++count_;
+
+        const double delta( value - mean_ );
+
+        mean_ += delta / count_;
+        m2_ += delta * (value - mean_);
+    }
+
+    // slide window
+    else
+    {
+        const double oldest( window_[next_] );
+        const double oldMean( mean_ );
+
+        mean_ += (value - oldest) / depth_;
+        m2_ += (value - oldest) * (value - mean_ + oldest - oldMean);
+    }
+
+    window_[next_] = value;
+    next_ = (next_ + 1) % depth_;
+
+    // once per full turn of the window, recompute from scratch so rounding errors from sliding
+    // do not accumulate (amortized constant time)
+    if (( !next_ ) && ( isFull() ))
+    {
+        double sum( 0.0 );
+
+        for ( double v : window_ )
+            sum += v;
+
+        mean_ = sum / depth_;
+        m2_ = 0.0;
+
+        for ( double v : window_ )
+            m2_ += (v - mean_) * (v - mean_);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void RollingStats::clear()
+{
+    count_ = 0;
+    next_ = 0;
+
+    mean_ = 0.0;
+    m2_ = 0.0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool RollingStats::restoreState( QDataStream& stream )
+{
+    qint32 depth, count, next;
+
+    stream >> depth >> count >> next >> mean_ >> m2_;
+
+    if (( QDataStream::Ok != stream.status() ) || ( depth < 1 ) || ( count < 0 ) || ( depth < count ) || ( next < 0 ) || ( depth <= next ))
+        return false;
+
+    depth_ = depth;
+    count_ = count;
+    next_ = next;
+
+    window_.resize( depth_ );
+
+    for ( double& v : window_ )
+        stream >> v;
+
+    return (QDataStream::Ok == stream.status());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void RollingStats::saveState( QDataStream& stream ) const
+{
+    stream << (qint32) depth_ << (qint32) count_ << (qint32) next_ << mean_ << m2_;
+
+    for ( double v : window_ )
+        stream << v;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#if defined( QT_DEBUG )
+
+#define Q_ASSERT_DOUBLE( fn, v ) {const double result = fn; Q_ASSERT( v-0.0000001 <= result && result <= v+0.0000001 );}
+
+void RollingStats::validate()
+{
+    // log returns of a made up price series
+    QVector<double> r;
+    double price( 100.0 );
+
+    for ( int i( 0 ); i < 1000; ++i )
+    {
+        const double next( price * (1.0 + 0.02 * sin( 0.37 * i ) + 0.001 * ((i * 7919) % 13 - 6)) );
+
+        r.append( log( next / price ) );
+        price = next;
+    }
+
+    static const int depths[] = {1, 5, 20, 240};
+
+    for ( int d : depths )
+    {
+        _Myt stats( d );
+
+        for ( int i( 0 ); i < r.size(); ++i )
+        {
+            stats.add( r[i] );
+
+            const QVector<double> window( r.mid( qMax( 0, i + 1 - d ), qMin( i + 1, d ) ) );
+
+            Q_ASSERT( stats.count() == window.size() );
+            Q_ASSERT_DOUBLE( stats.mean(), Stats::calcMean( window ) );
+            Q_ASSERT_DOUBLE( stats.stdDeviation(), Stats::calcStdDeviation( window ) );
+        }
+    }
+}
+
+#endif
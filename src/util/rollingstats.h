@@ -0,0 +1,139 @@
+/**
+ * @file rollingstats.h
+ * Rolling window statistics.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ROLLINGSTATS_H
+#define ROLLINGSTATS_H
+
+#include <vector>
+
+class QDataStream;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Rolling window statistics.
+/**
+ * Mean and standard deviation of the last @c depth values, updated in constant time per value
+ * using Welford's method (sliding variant once the window is full).
+ */
+class RollingStats
+{
+    using _Myt = RollingStats;
+
+public:
+
+    // ========================================================================
+    // CTOR / DTOR
+    // ========================================================================
+
+    /// Constructor.
+    /**
+     * @param[in] depth  window size
+     */
+    RollingStats( int depth = 1 );
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// Retrieve number of values in window.
+    /**
+     * @return  number of values
+     */
+    int count() const {return count_;}
+
+    /// Retrieve window size.
+    /**
+     * @return  window size
+     */
+    int depth() const {return depth_;}
+
+    /// Check if window is full.
+    /**
+     * @return  @c true if full, @c false otherwise
+     */
+    bool isFull() const {return (depth_ == count_);}
+
+    /// Retrieve mean of window.
+    /**
+     * @return  mean
+     */
+    double mean() const {return mean_;}
+
+    /// Retrieve standard deviation (population) of window.
+    /**
+     * @return  standard deviation
+     */
+    double stdDeviation() const;
+
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Add value to window.
+    /**
+     * Oldest value is dropped when window is full.
+     * @param[in] value  value to add
+     */
+    void add( double value );
+
+    /// Remove all values from window.
+    void clear();
+
+    /// Restore state.
+    /**
+     * @param[in,out] stream  stream to read from
+     * @return  @c true upon success, @c false otherwise
+     */
+    bool restoreState( QDataStream& stream );
+
+    /// Save state.
+    /**
+     * @param[in,out] stream  stream to write to
+     */
+    void saveState( QDataStream& stream ) const;
+
+    // ========================================================================
+    // Static Methods
+    // ========================================================================
+
+#if defined( QT_DEBUG )
+    /// Validate methods.
+    static void validate();
+#endif
+
+private:
+
+    int depth_;                                     ///< Window size.
+    int count_;                                     ///< Number of values in window.
+
+    std::vector<double> window_;                    ///< Window values (ring buffer).
+    int next_;                                      ///< Next ring buffer position.
+
+    double mean_;                                   ///< Mean of window.
+    double m2_;                                     ///< Sum of squared differences from mean.
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // ROLLINGSTATS_H
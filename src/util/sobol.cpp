@@ -0,0 +1,204 @@
+/**
+ * @file sobol.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sobol.h"
+
+#include <cassert>
+
+#include <QtGlobal>
+
+/// Primitive polynomial and initial direction numbers of a dimension.
+struct DirectionNumbers
+{
+    uint32_t s;                                     ///< Degree.
+    uint32_t a;                                     ///< Polynomial coefficients.
+    uint32_t m[5];                                  ///< Initial direction numbers.
+};
+
+// from new-joe-kuo-6.21201, first dimension is van der Corput
+static const DirectionNumbers directionNumbers[Sobol::MAX_DIMENSIONS-1] =
+{
+    {1, 0, {1}},
+    {2, 1, {1, 3}},
+    {3, 1, {1, 3, 1}},
+    {3, 2, {1, 1, 1}},
+    {4, 1, {1, 1, 3, 3}},
+    {4, 4, {1, 3, 5, 13}},
+    {5, 2, {1, 1, 5, 5, 17}},
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+Sobol::Sobol( size_t dim ) :
+    dim_( dim )
+{
+    assert( dim_ < MAX_DIMENSIONS );
+
+    if ( 0 == dim_ )
+    {
+        for ( size_t i( 0 ); i < BITS; ++i )
+            v_[i] = 1u << (BITS - 1 - i);
+
+        return;
+    }
+
+    const DirectionNumbers& d( directionNumbers[dim_-1] );
+
+    for ( size_t i( 0 ); i < BITS; ++i )
+    {
+        if ( i < d.s )
+            v_[i] = d.m[i] << (BITS - 1 - i);
+        else
+        {
+            v_[i] = v_[i-d.s] ^ (v_[i-d.s] >> d.s);
+
+            for ( size_t k( 1 ); k < d.s; ++k )
+                if ( (d.a >> (d.s - 1 - k)) & 1 )
+                    v_[i] ^= v_[i-k];
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint32_t Sobol::point( uint32_t index ) const
+{
+    uint32_t result( 0 );
+
+    // gray code of index selects direction numbers
+    uint32_t gray( index ^ (index >> 1) );
+
+    for ( size_t i( 0 ); gray; ++i, gray >>= 1 )
+        if ( gray & 1 )
+            result ^= v_[i];
+
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void Sobol::generate( uint32_t first, size_t n, uint32_t *result ) const
+{
+    if ( !n )
+        return;
+
+    uint32_t x( point( first ) );
+    result[0] = x;
+
+    // consecutive gray codes differ in the lowest set bit of index
+    for ( size_t i( 1 ); i < n; ++i )
+    {
+        size_t c( 0 );
+
+        for ( uint32_t k( first + i ); !(k & 1); k >>= 1 )
+            ++c;
+
+        x ^= v_[c];
+        result[i] = x;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint32_t Sobol::scramble( uint32_t value, uint32_t seed )
+{
+    // hash based nested uniform scramble (Laine-Karras permutation of reversed bits)
+    uint32_t x( reverse( value ) );
+
+    x += seed;
+    x ^= x * 0x6c50b47c;
+    x ^= x * 0xb82f1e52;
+    x ^= x * 0xc7afe638;
+    x ^= x * 0x8d22f6e6;
+
+    return reverse( x );
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint32_t Sobol::reverse( uint32_t value )
+{
+    value = ((value >> 1) & 0x55555555) | ((value & 0x55555555) << 1);
+    value = ((value >> 2) & 0x33333333) | ((value & 0x33333333) << 2);
+    value = ((value >> 4) & 0x0f0f0f0f) | ((value & 0x0f0f0f0f) << 4);
+    value = ((value >> 8) & 0x00ff00ff) | ((value & 0x00ff00ff) << 8);
+
+    return (value >> 16) | (value << 16);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#if defined( QT_DEBUG )
+void Sobol::validate()
+{
+    static const double SCALE = 4294967296.0;
+
+    {
+        // first points of first two dimensions
+        static const double x0[] = {0.0, 0.5, 0.75, 0.25, 0.375, 0.875, 0.625, 0.125};
+        static const double x1[] = {0.0, 0.5, 0.25, 0.75, 0.375, 0.875, 0.125, 0.625};
+
+        const _Myt d0( 0 );
+        const _Myt d1( 1 );
+
+        for ( uint32_t i( 0 ); i < 8; ++i )
+        {
+            Q_ASSERT( x0[i] == d0.point( i ) / SCALE );
+            Q_ASSERT( x1[i] == d1.point( i ) / SCALE );
+        }
+    }
+
+    {
+        // every dimension, scrambled or not, puts one of the first 2^m points in each interval of width 2^-m
+        static const size_t M = 10;
+        static const size_t COUNT = 1 << M;
+
+        static const uint32_t seeds[] = {0, 0x9e3779b9};
+
+        uint32_t points[COUNT];
+
+        for ( size_t dim( 0 ); dim < MAX_DIMENSIONS; ++dim )
+        {
+            const _Myt d( dim );
+            d.generate( 0, COUNT, points );
+
+            for ( uint32_t seed : seeds )
+            {
+                bool hit[COUNT] = {};
+
+                for ( size_t i( 0 ); i < COUNT; ++i )
+                {
+                    const uint32_t x( seed ? scramble( points[i], seed ) : points[i] );
+                    const size_t bucket( x >> (BITS - M) );
+
+                    Q_ASSERT( !hit[bucket] );
+                    hit[bucket] = true;
+                }
+            }
+        }
+    }
+
+    {
+        // generating from an offset matches direct computation
+        const _Myt d( 3 );
+
+        uint32_t points[16];
+        d.generate( 1000, 16, points );
+
+        for ( uint32_t i( 0 ); i < 16; ++i )
+            Q_ASSERT( d.point( 1000 + i ) == points[i] );
+    }
+}
+#endif
@@ -0,0 +1,124 @@
+/**
+ * @file sobol.h
+ * Sobol low discrepancy sequence generator.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SOBOL_H
+#define SOBOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Sobol low discrepancy sequence generator.
+/**
+ * Generates one dimension of a Sobol sequence, in Gray code order, using the direction numbers
+ * of Joe and Kuo. Points can be generated starting at any index.
+ *
+ * Points can be randomized with nested uniform (Owen) scrambling, which keeps the low discrepancy
+ * of the sequence while making every point uniformly distributed. Independent scrambles give
+ * independent estimates, whose spread is an error estimate.
+ *
+ * @see  Joe, Kuo, "Constructing Sobol sequences with better two-dimensional projections", 2008
+ * @see  Burley, "Practical Hash-based Owen Scrambling", JCGT 2020
+ */
+class Sobol
+{
+    using _Myt = Sobol;
+
+public:
+
+    /// Number of dimensions supported.
+    static constexpr size_t MAX_DIMENSIONS = 8;
+
+    /// Number of bits per point.
+    static constexpr size_t BITS = 32;
+
+    // ========================================================================
+    // CTOR / DTOR
+    // ========================================================================
+
+    /// Constructor.
+    /**
+     * @param[in] dim  dimension (zero based, less than MAX_DIMENSIONS)
+     */
+    Sobol( size_t dim = 0 );
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// Retrieve dimension.
+    /**
+     * @return  dimension
+     */
+    size_t dimension() const {return dim_;}
+
+    /// Retrieve point.
+    /**
+     * @param[in] index  point index
+     * @return  point (scaled by 2^32)
+     */
+    uint32_t point( uint32_t index ) const;
+
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Generate consecutive points.
+    /**
+     * @param[in] first  index of first point
+     * @param[in] n  number of points
+     * @param[out] result  points (scaled by 2^32)
+     */
+    void generate( uint32_t first, size_t n, uint32_t *result ) const;
+
+    // ========================================================================
+    // Static Methods
+    // ========================================================================
+
+    /// Scramble point.
+    /**
+     * @param[in] value  point (scaled by 2^32)
+     * @param[in] seed  scramble seed
+     * @return  scrambled point (scaled by 2^32)
+     */
+    static uint32_t scramble( uint32_t value, uint32_t seed );
+
+#if defined( QT_DEBUG )
+    /// Validate methods.
+    static void validate();
+#endif
+
+private:
+
+    size_t dim_;
+
+    uint32_t v_[BITS];
+
+    /// Reverse bits.
+    static uint32_t reverse( uint32_t value );
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SOBOL_H
@@ -0,0 +1,506 @@
+/**
+ * @file technicalindicators.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "stats.h"
+#include "technicalindicators.h"
+
+#include <cmath>
+
+#include <QDataStream>
+#include <QIODevice>
+
+static const qint32 STATE_VERSION = 1;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+TechnicalIndicators::TechnicalIndicators() :
+    fast_( FAST_DEPTH ),
+    slow_( SLOW_DEPTH ),
+    signalSeed_( SIGNAL_DEPTH )
+{
+    foreach ( int d, historicalVolatilityDepths() )
+        hv_.append( RollingStats( d ) );
+
+    foreach ( int d, movingAverageDepths() )
+        sma_.append( RollingStats( d ) );
+
+    foreach ( int d, relativeStrengthIndexDepths() )
+    {
+        gain_.append( RollingStats( d ) );
+        loss_.append( RollingStats( d ) );
+    }
+
+    ema_.fill( 0.0, sma_.size() );
+
+    avgGain_.fill( 0.0, gain_.size() );
+    avgLoss_.fill( 0.0, loss_.size() );
+
+    clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+double TechnicalIndicators::relativeStrengthIndex( int i ) const
+{
+    const double rs( avgGain_[i] / std::fmax( avgLoss_[i], 1.0e-10 ) );
+
+    double index( 100.0 - 100.0 / (1.0+rs) );
+    index = std::fmin( index, 100.0 );
+    index = std::fmax( index, 0.0 );
+
+    return index;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void TechnicalIndicators::add( double close )
+{
+    return_ = (( 0.0 < close ) && ( 0.0 < prevClose_ ));
+    close_ = ( 0.0 < close );
+
+    // returns
+    if ( return_ )
+    {
+        ++numReturns_;
+
+        // historical volatility
+        const double r( log( close / prevClose_ ) );
+
+        for ( int i( 0 ); i < hv_.size(); ++i )
+            hv_[i].add( r );
+
+        // relative strength index
+        const double current( close - prevClose_ );
+
+        for ( int i( 0 ); i < gain_.size(); ++i )
+        {
+            const int d( gain_[i].depth() );
+
+            // seed with simple average
+            if ( numReturns_ <= d )
+            {
+                gain_[i].add( (current < 0.0) ? 0.0 : current );
+                loss_[i].add( (current < 0.0) ? std::fabs( current ) : 0.0 );
+
+                if ( numReturns_ == d )
+                {
+                    avgGain_[i] = gain_[i].mean();
+                    avgLoss_[i] = loss_[i].mean();
+
+                    // no longer needed
+                    gain_[i].clear();
+                    loss_[i].clear();
+                }
+            }
+
+            // loss
+            else if ( current < 0.0 )
+            {
+                avgGain_[i] = avgGain_[i]*(d-1) / d;
+                avgLoss_[i] = (avgLoss_[i]*(d-1) + std::fabs( current )) / d;
+            }
+
+            // gain
+            else
+            {
+                avgGain_[i] = (avgGain_[i]*(d-1) + current) / d;
+                avgLoss_[i] = avgLoss_[i]*(d-1) / d;
+            }
+        }
+    }
+
+    // closes
+    if ( close_ )
+    {
+        ++numCloses_;
+
+        // moving averages
+        for ( int i( 0 ); i < sma_.size(); ++i )
+        {
+            const int d( sma_[i].depth() );
+
+            sma_[i].add( close );
+
+            // seed with simple average
+            if ( numCloses_ == d )
+                ema_[i] = sma_[i].mean();
+            else if ( d < numCloses_ )
+                ema_[i] = calcEma( close, ema_[i], d );
+        }
+
+        // macd
+        if ( numCloses_ <= FAST_DEPTH )
+        {
+            fast_.add( close );
+            emaFast_ = fast_.mean();
+        }
+        else
+        {
+            emaFast_ = calcEma( close, emaFast_, FAST_DEPTH );
+        }
+
+        if ( numCloses_ <= SLOW_DEPTH )
+        {
+            slow_.add( close );
+            emaSlow_ = slow_.mean();
+        }
+        else
+        {
+            emaSlow_ = calcEma( close, emaSlow_, SLOW_DEPTH );
+        }
+
+        if ( SLOW_DEPTH <= numCloses_ )
+        {
+            ++numMacd_;
+
+            // seed with simple average
+            if ( numMacd_ <= SIGNAL_DEPTH )
+            {
+                signalSeed_.add( macd() );
+                signal_ = signalSeed_.mean();
+            }
+            else
+            {
+                signal_ = calcEma( macd(), signal_, SIGNAL_DEPTH );
+            }
+        }
+    }
+
+    prevClose_ = close;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void TechnicalIndicators::clear()
+{
+    close_ = false;
+    return_ = false;
+
+    numCloses_ = 0;
+    numReturns_ = 0;
+
+    prevClose_ = 0.0;
+
+    for ( int i( 0 ); i < hv_.size(); ++i )
+        hv_[i].clear();
+
+    for ( int i( 0 ); i < sma_.size(); ++i )
+    {
+        sma_[i].clear();
+        ema_[i] = 0.0;
+    }
+
+    for ( int i( 0 ); i < gain_.size(); ++i )
+    {
+        gain_[i].clear();
+        loss_[i].clear();
+
+        avgGain_[i] = 0.0;
+        avgLoss_[i] = 0.0;
+    }
+
+    fast_.clear();
+    slow_.clear();
+    signalSeed_.clear();
+
+    emaFast_ = 0.0;
+    emaSlow_ = 0.0;
+    signal_ = 0.0;
+
+    numMacd_ = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool TechnicalIndicators::restoreState( const QByteArray& state )
+{
+    QDataStream stream( state );
+
+    qint32 version;
+    stream >> version;
+
+    if ( STATE_VERSION != version )
+        return false;
+
+    qint32 numCloses, numReturns, numMacd;
+
+    stream >> close_ >> return_ >> numCloses >> numReturns >> prevClose_;
+
+    numCloses_ = numCloses;
+    numReturns_ = numReturns;
+
+    bool okay( QDataStream::Ok == stream.status() );
+
+    for ( int i( 0 ); (( okay ) && ( i < hv_.size() )); ++i )
+        okay = hv_[i].restoreState( stream );
+
+    for ( int i( 0 ); (( okay ) && ( i < sma_.size() )); ++i )
+    {
+        okay = sma_[i].restoreState( stream );
+        stream >> ema_[i];
+    }
+
+    for ( int i( 0 ); (( okay ) && ( i < gain_.size() )); ++i )
+    {
+        okay = (( gain_[i].restoreState( stream ) ) && ( loss_[i].restoreState( stream ) ));
+        stream >> avgGain_[i] >> avgLoss_[i];
+    }
+
+    if ( okay )
+        okay = (( fast_.restoreState( stream ) ) && ( slow_.restoreState( stream ) ) && ( signalSeed_.restoreState( stream ) ));
+
+    stream >> emaFast_ >> emaSlow_ >> signal_ >> numMacd;
+
+    numMacd_ = numMacd;
+
+    okay = (( okay ) && ( QDataStream::Ok == stream.status() ));
+
+    // do not leave partial state behind
+    if ( !okay )
+        clear();
+
+    return okay;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+QByteArray TechnicalIndicators::saveState() const
+{
+    QByteArray state;
+
+    QDataStream stream( &state, QIODevice::WriteOnly );
+
+    stream << STATE_VERSION;
+    stream << close_ << return_ << (qint32) numCloses_ << (qint32) numReturns_ << prevClose_;
+
+    for ( int i( 0 ); i < hv_.size(); ++i )
+        hv_[i].saveState( stream );
+
+    for ( int i( 0 ); i < sma_.size(); ++i )
+    {
+        sma_[i].saveState( stream );
+        stream << ema_[i];
+    }
+
+    for ( int i( 0 ); i < gain_.size(); ++i )
+    {
+        gain_[i].saveState( stream );
+        loss_[i].saveState( stream );
+        stream << avgGain_[i] << avgLoss_[i];
+    }
+
+    fast_.saveState( stream );
+    slow_.saveState( stream );
+    signalSeed_.saveState( stream );
+
+    stream << emaFast_ << emaSlow_ << signal_ << (qint32) numMacd_;
+
+    return state;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+const QVector<int>& TechnicalIndicators::historicalVolatilityDepths()
+{
+    static const QVector<int> depths = {
+        5,      // 5d
+        10,     // 10d
+        20,     // 20d
+        30,     // 1m
+        60,     // 2m
+        90,     // 3m
+        120,    // 4m
+        240,    // 8m
+        480,    // 16m
+    };
+
+    return depths;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+const QVector<int>& TechnicalIndicators::movingAverageDepths()
+{
+    static const QVector<int> depths = {5, 10, 15, 20, 30, 50, 100, 200};
+
+    return depths;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+const QVector<int>& TechnicalIndicators::relativeStrengthIndexDepths()
+{
+    static const QVector<int> depths = {2, 3, 4, 5, 6, 10, 14, 20, 50};
+
+    return depths;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+double TechnicalIndicators::calcEma( double value, double prev, int depth )
+{
+    const double w( 2.0 / (1.0 + depth) );
+
+    return value*w + prev*(1.0 - w);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#if defined( QT_DEBUG )
+
+#define Q_ASSERT_DOUBLE( fn, v ) {const double result = fn; Q_ASSERT( v-0.0000001 <= result && result <= v+0.0000001 );}
+
+void TechnicalIndicators::validate()
+{
+    // made up closing prices, with a few bad bars
+    QVector<double> closes;
+
+    for ( int i( 0 ); i < 700; ++i )
+        closes.append( (( 100 == i ) || ( 350 == i )) ? 0.0 : 50.0 + 10.0 * sin( 0.05 * i ) + 0.1 * ((i * 7919) % 17) );
+
+    // reference, recomputed from scratch for every bar
+    QVector<double> a;
+    QVector<double> r;
+    QVector<double> d;
+
+    _Myt ti;
+    _Myt resumed;
+
+    double prevClose( 0.0 );
+
+    for ( int i( 0 ); i < closes.size(); ++i )
+    {
+        const double close( closes[i] );
+
+        ti.add( close );
+
+        // resume from saved state half way through
+        if ( i < 400 )
+            resumed.add( close );
+        else if ( 400 == i )
+        {
+            Q_ASSERT( resumed.restoreState( ti.saveState() ) );
+        }
+        else
+        {
+            resumed.add( close );
+
+            Q_ASSERT( resumed.saveState() == ti.saveState() );
+        }
+
+        if ( 0.0 < close )
+            a.append( close );
+
+        if (( 0.0 < close ) && ( 0.0 < prevClose ))
+        {
+            r.append( log( close / prevClose ) );
+            d.append( close - prevClose );
+        }
+
+        prevClose = close;
+
+        Q_ASSERT( ti.numCloses() == a.size() );
+        Q_ASSERT( ti.numReturns() == r.size() );
+        Q_ASSERT( ti.hasMovingAverageConvergenceDivergence() == ((SLOW_DEPTH + SIGNAL_DEPTH - 1) <= a.size()) );
+
+        for ( int k( 0 ); k < historicalVolatilityDepths().size(); ++k )
+        {
+            const int depth( historicalVolatilityDepths()[k] );
+
+            if ( depth <= r.size() )
+                Q_ASSERT_DOUBLE( ti.historicalVolatility( k ), Stats::calcStdDeviation( r.mid( r.size() - depth ) ) );
+        }
+
+        for ( int k( 0 ); k < movingAverageDepths().size(); ++k )
+        {
+            const int depth( movingAverageDepths()[k] );
+
+            if ( depth <= a.size() )
+                Q_ASSERT_DOUBLE( ti.simpleMovingAverage( k ), Stats::calcMean( a.mid( a.size() - depth ) ) );
+        }
+    }
+
+    // exponential moving average and rsi of last bar
+    for ( int k( 0 ); k < movingAverageDepths().size(); ++k )
+    {
+        const int depth( movingAverageDepths()[k] );
+        const double w( 2.0 / (1.0 + depth) );
+
+        double ema( Stats::calcMean( a.mid( 0, depth ) ) );
+
+        for ( int i( depth ); i < a.size(); ++i )
+            ema = a[i]*w + ema*(1.0 - w);
+
+        Q_ASSERT_DOUBLE( ti.exponentialMovingAverage( k ), ema );
+    }
+
+    for ( int k( 0 ); k < relativeStrengthIndexDepths().size(); ++k )
+    {
+        const int depth( relativeStrengthIndexDepths()[k] );
+
+        double gain( 0.0 );
+        double loss( 0.0 );
+
+        for ( int i( 0 ); i < depth; ++i )
+        {
+            if ( d[i] < 0.0 )
+                loss -= d[i];
+            else
+                gain += d[i];
+        }
+
+        gain /= depth;
+        loss /= depth;
+
+        for ( int i( depth ); i < d.size(); ++i )
+        {
+            gain = (gain*(depth-1) + ((d[i] < 0.0) ? 0.0 : d[i])) / depth;
+            loss = (loss*(depth-1) + ((d[i] < 0.0) ? -d[i] : 0.0)) / depth;
+        }
+
+        const double rsi( 100.0 - 100.0 / (1.0 + gain / std::fmax( loss, 1.0e-10 )) );
+
+        Q_ASSERT_DOUBLE( ti.relativeStrengthIndex( k ), rsi );
+    }
+
+    // macd of last bar
+    double ema12( Stats::calcMean( a.mid( 0, FAST_DEPTH ) ) );
+    double ema26( Stats::calcMean( a.mid( 0, SLOW_DEPTH ) ) );
+
+    QVector<double> macdVals;
+    double signal( 0.0 );
+
+    for ( int i( FAST_DEPTH ); i < a.size(); ++i )
+    {
+        ema12 = calcEma( a[i], ema12, FAST_DEPTH );
+
+        if ( i < (SLOW_DEPTH - 1) )
+            continue;
+        else if ( SLOW_DEPTH <= i )
+            ema26 = calcEma( a[i], ema26, SLOW_DEPTH );
+
+        if ( macdVals.size() < SIGNAL_DEPTH )
+        {
+            macdVals.append( ema12 - ema26 );
+            signal = Stats::calcMean( macdVals );
+        }
+        else
+        {
+            signal = calcEma( ema12 - ema26, signal, SIGNAL_DEPTH );
+        }
+    }
+
+    Q_ASSERT_DOUBLE( ti.macdFast(), ema12 );
+    Q_ASSERT_DOUBLE( ti.macdSlow(), ema26 );
+    Q_ASSERT_DOUBLE( ti.macdSignal(), signal );
+}
+
+#endif
@@ -0,0 +1,240 @@
+/**
+ * @file technicalindicators.h
+ * Incremental technical indicators.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TECHNICALINDICATORS_H
+#define TECHNICALINDICATORS_H
+
+#include "rollingstats.h"
+
+#include <QByteArray>
+#include <QVector>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Incremental technical indicators.
+/**
+ * Daily closing prices are added one bar at a time and every indicator (historical volatility,
+ * simple and exponential moving averages, relative strength index and MACD) is updated in
+ * constant time. State can be saved and restored so later updates only need to add new bars.
+ *
+ * Closing prices that are not positive are skipped, and the bar after one does not produce a
+ * return.
+ */
+class TechnicalIndicators
+{
+    using _Myt = TechnicalIndicators;
+
+public:
+
+    // ========================================================================
+    // CTOR / DTOR
+    // ========================================================================
+
+    /// Constructor.
+    TechnicalIndicators();
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// Check if last bar had a valid closing price.
+    /**
+     * @return  @c true if valid, @c false otherwise
+     */
+    bool hasClose() const {return close_;}
+
+    /// Check if last bar produced a return.
+    /**
+     * @return  @c true if return, @c false otherwise
+     */
+    bool hasReturn() const {return return_;}
+
+    /// Retrieve number of valid closing prices.
+    /**
+     * @return  number of closes
+     */
+    int numCloses() const {return numCloses_;}
+
+    /// Retrieve number of returns.
+    /**
+     * @return  number of returns
+     */
+    int numReturns() const {return numReturns_;}
+
+    /// Retrieve historical volatility (not annualized).
+    /**
+     * Valid when numReturns() is at least the depth.
+     * @param[in] i  index into historicalVolatilityDepths()
+     * @return  standard deviation of log returns
+     */
+    double historicalVolatility( int i ) const {return hv_[i].stdDeviation();}
+
+    /// Retrieve simple moving average.
+    /**
+     * Valid when numCloses() is at least the depth.
+     * @param[in] i  index into movingAverageDepths()
+     * @return  average
+     */
+    double simpleMovingAverage( int i ) const {return sma_[i].mean();}
+
+    /// Retrieve exponential moving average.
+    /**
+     * Valid when numCloses() is at least the depth.
+     * @param[in] i  index into movingAverageDepths()
+     * @return  average
+     */
+    double exponentialMovingAverage( int i ) const {return ema_[i];}
+
+    /// Retrieve relative strength index.
+    /**
+     * Valid when numReturns() is at least the depth.
+     * @param[in] i  index into relativeStrengthIndexDepths()
+     * @return  index (0 - 100)
+     */
+    double relativeStrengthIndex( int i ) const;
+
+    /// Check if MACD is available.
+    /**
+     * @return  @c true if available, @c false otherwise
+     */
+    bool hasMovingAverageConvergenceDivergence() const {return (SIGNAL_DEPTH <= numMacd_);}
+
+    /// Retrieve MACD fast (12 day) exponential moving average.
+    /**
+     * @return  average
+     */
+    double macdFast() const {return emaFast_;}
+
+    /// Retrieve MACD slow (26 day) exponential moving average.
+    /**
+     * @return  average
+     */
+    double macdSlow() const {return emaSlow_;}
+
+    /// Retrieve MACD value.
+    /**
+     * @return  value
+     */
+    double macd() const {return (emaFast_ - emaSlow_);}
+
+    /// Retrieve MACD signal (9 day exponential moving average of MACD).
+    /**
+     * @return  value
+     */
+    double macdSignal() const {return signal_;}
+
+    // ========================================================================
+    // Methods
+    // ========================================================================
+
+    /// Add bar.
+    /**
+     * @param[in] close  closing price
+     */
+    void add( double close );
+
+    /// Remove all bars.
+    void clear();
+
+    /// Restore state.
+    /**
+     * @param[in] state  state
+     * @return  @c true upon success, @c false otherwise
+     */
+    bool restoreState( const QByteArray& state );
+
+    /// Save state.
+    /**
+     * @return  state
+     */
+    QByteArray saveState() const;
+
+    // ========================================================================
+    // Static Methods
+    // ========================================================================
+
+    /// Retrieve historical volatility depths.
+    /**
+     * @return  depths (days)
+     */
+    static const QVector<int>& historicalVolatilityDepths();
+
+    /// Retrieve moving average depths.
+    /**
+     * @return  depths (days)
+     */
+    static const QVector<int>& movingAverageDepths();
+
+    /// Retrieve relative strength index depths.
+    /**
+     * @return  depths (days)
+     */
+    static const QVector<int>& relativeStrengthIndexDepths();
+
+#if defined( QT_DEBUG )
+    /// Validate methods.
+    static void validate();
+#endif
+
+private:
+
+    static const int FAST_DEPTH = 12;
+    static const int SLOW_DEPTH = 26;
+    static const int SIGNAL_DEPTH = 9;
+
+    bool close_;                                    ///< Last bar had valid close.
+    bool return_;                                   ///< Last bar produced a return.
+
+    int numCloses_;                                 ///< Number of valid closes.
+    int numReturns_;                                ///< Number of returns.
+
+    double prevClose_;                              ///< Previous close.
+
+    QVector<RollingStats> hv_;                      ///< Log returns by depth.
+
+    QVector<RollingStats> sma_;                     ///< Closes by depth.
+    QVector<double> ema_;                           ///< Exponential moving averages by depth.
+
+    QVector<RollingStats> gain_;                    ///< Gains by depth (until average seeded).
+    QVector<RollingStats> loss_;                    ///< Losses by depth (until average seeded).
+    QVector<double> avgGain_;                       ///< Average gain by depth.
+    QVector<double> avgLoss_;                       ///< Average loss by depth.
+
+    RollingStats fast_;                             ///< Closes for MACD fast average seed.
+    RollingStats slow_;                             ///< Closes for MACD slow average seed.
+    RollingStats signalSeed_;                       ///< MACD values for signal seed.
+
+    double emaFast_;                                ///< MACD fast average.
+    double emaSlow_;                                ///< MACD slow average.
+    double signal_;                                 ///< MACD signal.
+
+    int numMacd_;                                   ///< Number of MACD values.
+
+    /// Update exponential moving average.
+    static double calcEma( double value, double prev, int depth );
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // TECHNICALINDICATORS_H
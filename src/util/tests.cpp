@@ -22,22 +22,29 @@
 #include "altbisection.h"
 #include "alttrinomial.h"
 #include "baroneadesiwhaley.h"
+#include "batchnewtonraphson.h"
 #include "bisection.h"
 #include "bjerksundstensland02.h"
 #include "bjerksundstensland93.h"
 #include "blackscholes.h"
 #include "coxrossrubinstein.h"
 #include "equalprobbinomial.h"
+#include "jsonstreamreader.h"
 #include "kamradritchken.h"
 #include "montecarlo.h"
 #include "newtonraphson.h"
 #include "phelimboyle.h"
+#include "philox.h"
+#include "quasimontecarlo.h"
 #include "rollgeskewhaley.h"
+#include "rollingstats.h"
+#include "sobol.h"
+#include "technicalindicators.h"
 #include "tests.h"
+#include "yieldcurve.h"
 
 #include <common.h>
 
-#include <QDateTime>
 #include <QStringList>
 
 #if defined( QT_DEBUG )
@@ -51,17 +58,25 @@ void validateOptionPricing()
 
     AlternativeTrinomialTree::validate();
     BaroneAdesiWhaley::validate();
+    BatchNewtonRaphson::validate();
     BjerksundStensland1993::validate();
     BjerksundStensland2002::validate();
     BinomialTree::validate();
     BlackScholes::validate();
     CoxRossRubinstein::validate();
     EqualProbBinomialTree::validate();
+    JsonStreamReader::validate();
     KamradRitchken::validate();
     MonteCarlo::validate();
     NewtonRaphson::validate();
     PhelimBoyle::validate();
+    Philox4x32::validate();
+    QuasiMonteCarlo::validate();
     RollGeskeWhaley::validate();
+    RollingStats::validate();
+    Sobol::validate();
+    TechnicalIndicators::validate();
+    YieldCurve::validate();
 
     double S = 9.98;                // Spot Price
     double K0 = 9.5;                // Strike Price
@@ -482,50 +497,6 @@ void validateOptionPricing()
         LOG_ERROR << qPrintable( result );
 }
 
-///////////////////////////////////////////////////////////////////////////////////////////////////
-void optionPricingPerf( size_t loops )
-{
-    double S = 9.98;             // Spot Price
-    double K0 = 9.5;             // Strike Price
-    double T = 9.0 / 365.25;     // Years to maturity
-    double r = 0.01;             // Risk Free Rate
-    double q = 0.0;
-
-    double v_call = 0.3569;
-    //double op_call = 0.55;
-
-    double v_put = 0.3788;
-    //double op_put = 0.08;
-
-    QDateTime dt;
-
-    dt = QDateTime::currentDateTime();
-
-    for ( size_t n( loops ); n--; )
-    {
-        CoxRossRubinstein crr_call( S, r, r-q, v_call, T, 500 );
-        crr_call.optionPrice( OptionType::Call, K0 );
-
-        CoxRossRubinstein crr_put( S, r, r-q, v_put, T, 500 );
-        crr_put.optionPrice( OptionType::Put, K0 );
-    }
-
-    LOG_ERROR << "time N=500 " << dt.msecsTo( QDateTime::currentDateTime() );
-
-    dt = QDateTime::currentDateTime();
-
-    for ( size_t n( loops ); n--; )
-    {
-        CoxRossRubinstein crr_call( S, r, r-q, v_call, T, 10'000 );
-        crr_call.optionPrice( OptionType::Call, K0 );
-
-        CoxRossRubinstein crr_put( S, r, r-q, v_put, T, 10'000 );
-        crr_put.optionPrice( OptionType::Put, K0 );
-    }
-
-    LOG_ERROR << "time N=10k " << dt.msecsTo( QDateTime::currentDateTime() );
-}
-
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void calculatePartials()
 {
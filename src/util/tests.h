@@ -32,9 +32,6 @@
 /// Run validation suite on each class.
 void validateOptionPricing();
 
-/// Run performance testing.
-void optionPricingPerf( size_t loops );
-
 /// Calculate partials.
 void calculatePartials();
 
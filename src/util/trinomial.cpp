@@ -27,6 +27,7 @@
  * https://sites.google.com/view/vinegarhill-financelabs/binomial-lattice-framework/cox-ross-and-rubinstein/optimizing-cox-ross-and-rubinstein
  */
 
+#include "latticeworkspace.h"
 #include "trinomial.h"
 
 #include <algorithm>
@@ -52,24 +53,22 @@ double TrinomialTree::calcOptionPrice( bool isCall, double S, double K, double u
 
     const size_t N2( 2 * N_ );
 
-    // create pow tables
-    std::vector<double> spowu;
-    spowu.reserve( N2 + 1 );
+    LatticeWorkspace& ws( LatticeWorkspace::local() );
 
-    std::vector<double> powd;
-    powd.reserve( N2 + 1 );
+    // create pow tables
+    double *spowu( ws.buffer( LatticeWorkspace::SPOT_POW_UP, N2 + 1 ) );
+    double *powd( ws.buffer( LatticeWorkspace::POW_DOWN, N2 + 1 ) );
 
     for ( size_t i( 0 ); i <= N2; ++i )
     {
         const double exp( std::fmax( 0.0, (double)i - N_ ) );
 
-        spowu.push_back( S * pow( u, exp ) );
-        powd.push_back( pow( d, exp ) );
+        spowu[i] = S * pow( u, exp );
+        powd[i] = pow( d, exp );
     }
 
     // init vector
-    std::vector<double> val;
-    val.reserve( N2 + 1 );
+    double *val( ws.buffer( LatticeWorkspace::VALUES, N2 + 1 ) );
 
     for ( size_t i = 0; i <= N2; ++i )
     {
@@ -80,7 +79,7 @@ double TrinomialTree::calcOptionPrice( bool isCall, double S, double K, double u
         static const double ERROR = 0.000001;
         assert(( (val0 - ERROR) <= val1 ) && ( val1 <= (val0 + ERROR) ));
 #endif
-        val.push_back( fmax( 0.0, z * (spowu[i] * powd[N2-i] - K) ) );
+        val[i] = fmax( 0.0, z * (spowu[i] * powd[N2-i] - K) );
     }
 
     // backward recursion through the tree
@@ -118,6 +117,79 @@ double TrinomialTree::calcOptionPrice( bool isCall, double S, double K, double u
     return val[0];
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void TrinomialTree::calcOptionPrices( const OptionType *types, const double *X, double *prices, size_t n, double S, double u, double d, double pu, double pd, double pm, double Df ) const
+{
+    if ( !n )
+        return;
+
+    const bool american( isAmerican() );
+
+    const size_t N2( 2 * N_ );
+
+    LatticeWorkspace& ws( LatticeWorkspace::local() );
+
+    // payoff sign for each strike
+    double *z( ws.buffer( LatticeWorkspace::PAYOFF_SIGN, n ) );
+
+    for ( size_t k( 0 ); k < n; ++k )
+        z[k] = (OptionType::Call == types[k]) ? 1.0 : -1.0;
+
+    // create pow tables, shared by all strikes
+    double *spowu( ws.buffer( LatticeWorkspace::SPOT_POW_UP, N2 + 1 ) );
+    double *powd( ws.buffer( LatticeWorkspace::POW_DOWN, N2 + 1 ) );
+
+    for ( size_t i( 0 ); i <= N2; ++i )
+    {
+        const double exp( std::fmax( 0.0, (double)i - N_ ) );
+
+        spowu[i] = S * pow( u, exp );
+        powd[i] = pow( d, exp );
+    }
+
+    // init values, strikes are interleaved for each node
+    double *val( ws.buffer( LatticeWorkspace::VALUES, (N2 + 1) * n ) );
+
+    for ( size_t i = 0; i <= N2; ++i )
+    {
+        const double St( spowu[i] * powd[N2-i] );
+
+        double *v( val + i * n );
+
+        for ( size_t k( 0 ); k < n; ++k )
+            v[k] = fmax( 0.0, z[k] * (St - X[k]) );
+    }
+
+    // backward recursion through the tree
+    for ( size_t j = N_; j--; )
+    {
+        const size_t j2( 2 * j );
+
+        for ( size_t i = 0; i <= j2; ++i )
+        {
+            double *v( val + i * n );
+            const double *vm( v + n );
+            const double *vu( v + 2 * n );
+
+            for ( size_t k( 0 ); k < n; ++k )
+                v[k] = Df * ((pu * vu[k]) + (pm * vm[k]) + (pd * v[k]));
+
+            // check early exercise
+            if ( american )
+            {
+                const double St( spowu[N_+i-j] * powd[N_+j-i] );
+
+                for ( size_t k( 0 ); k < n; ++k )
+                    v[k] = fmax( v[k], z[k] * (St - X[k]) );
+            }
+        }
+    }
+
+    // option prices
+    for ( size_t k( 0 ); k < n; ++k )
+        prices[k] = val[k];
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void TrinomialTree::calcPartials( double u, double d, double& delta, double& gamma, double& theta ) const
 {
@@ -0,0 +1,143 @@
+/**
+ * @file yieldcurve.cpp
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "yieldcurve.h"
+
+#include <algorithm>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+YieldCurve::YieldCurve( const QDate& date, const std::vector<double>& terms, const std::vector<double>& rates ) :
+    date_( date )
+{
+    if ( terms.empty() )
+        return;
+
+    // anchor curve at zero
+    terms_.reserve( terms.size() + 1 );
+    rates_.reserve( rates.size() + 1 );
+
+    terms_.push_back( 0.0 );
+    rates_.push_back( 0.0 );
+
+    terms_.insert( terms_.end(), terms.begin(), terms.end() );
+    rates_.insert( rates_.end(), rates.begin(), rates.end() );
+
+    // natural spline second derivatives (tridiagonal solve)
+    const size_t n( terms_.size() );
+
+    m_.assign( n, 0.0 );
+
+    if ( n < 3 )
+        return;
+
+    std::vector<double> c( n, 0.0 );
+    std::vector<double> d( n, 0.0 );
+
+    for ( size_t i( 1 ); i < n-1; ++i )
+    {
+        const double h0( terms_[i] - terms_[i-1] );
+        const double h1( terms_[i+1] - terms_[i] );
+
+        const double a( h0 / 6.0 );
+        const double b( (h0 + h1) / 3.0 );
+        const double r( (rates_[i+1] - rates_[i]) / h1 - (rates_[i] - rates_[i-1]) / h0 );
+
+        const double denom( b - a * c[i-1] );
+
+        c[i] = (h1 / 6.0) / denom;
+        d[i] = (r - a * d[i-1]) / denom;
+    }
+
+    for ( size_t i( n-1 ); i-- > 1; )
+        m_[i] = d[i] - c[i] * m_[i+1];
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+double YieldCurve::rate( double term, Interpolation method ) const
+{
+    if ( terms_.size() < 2 )
+        return 0.0;
+
+    // first point at or past term, skipping zero anchor
+    const std::vector<double>::const_iterator upper( std::lower_bound( terms_.begin() + 1, terms_.end(), term ) );
+
+    if ( terms_.end() == upper )
+        return 0.0;
+
+    const size_t i( upper - terms_.begin() );
+
+    const double h( terms_[i] - terms_[i-1] );
+
+    const double b( (term - terms_[i-1]) / h );
+    const double a( 1.0 - b );
+
+    double result( a * rates_[i-1] + b * rates_[i] );
+
+    if ( CUBIC == method )
+        result += ((a*a*a - a) * m_[i-1] + (b*b*b - b) * m_[i]) * (h*h) / 6.0;
+
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#if defined( QT_DEBUG )
+
+#define Q_ASSERT_DOUBLE( fn, v ) {const double result = fn; Q_ASSERT( v-0.0000001 <= result && result <= v+0.0000001 );}
+
+void YieldCurve::validate()
+{
+    const std::vector<double> terms = { 1.0 / 12.0, 0.25, 0.5, 1.0, 2.0, 5.0, 10.0, 30.0 };
+    const std::vector<double> rates = { 0.0010, 0.0015, 0.0020, 0.0030, 0.0050, 0.0100, 0.0140, 0.0190 };
+
+    const _Myt curve( QDate( 2021, 6, 1 ), terms, rates );
+
+    // no rate past end of curve
+    Q_ASSERT_DOUBLE( curve.rate( 31.0 ), 0.0 );
+    Q_ASSERT_DOUBLE( curve.rate( 31.0, CUBIC ), 0.0 );
+
+    // short end interpolates towards zero
+    Q_ASSERT_DOUBLE( curve.rate( 0.0 ), 0.0 );
+    Q_ASSERT_DOUBLE( curve.rate( 1.0 / 24.0 ), 0.0005 );
+
+    for ( size_t i( 0 ); i < terms.size(); ++i )
+    {
+        // both methods pass through every point
+        Q_ASSERT_DOUBLE( curve.rate( terms[i] ), rates[i] );
+        Q_ASSERT_DOUBLE( curve.rate( terms[i], CUBIC ), rates[i] );
+
+        // linear is midpoint of neighbours
+        if ( i )
+            Q_ASSERT_DOUBLE( curve.rate( (terms[i-1] + terms[i]) / 2.0 ), (rates[i-1] + rates[i]) / 2.0 );
+    }
+
+    // straight line stays straight with spline
+    const std::vector<double> line = { 0.0025, 0.0075, 0.0150 };
+    const _Myt straight( QDate( 2021, 6, 1 ), std::vector<double>( { 0.25, 0.75, 1.5 } ), std::vector<double>( line ) );
+
+    for ( double t( 0.05 ); t < 1.5; t += 0.05 )
+        Q_ASSERT_DOUBLE( straight.rate( t, CUBIC ), 0.01 * t );
+
+    // empty curve
+    Q_ASSERT_DOUBLE( _Myt().rate( 1.0 ), 0.0 );
+}
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * @file yieldcurve.h
+ * Risk free interest rate curve.
+ *
+ * @copyright Copyright (C) 2021 Randy Blankley. All rights reserved.
+ *
+ * @section LICENSE
+ *
+ * This file is part of mofo.
+ *
+ * Money4Options is free software: you can redistribute it and/or modify it under the terms of the
+ * GNU General Public License as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See
+ * the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef YIELDCURVE_H
+#define YIELDCURVE_H
+
+#include <QDate>
+
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Risk free interest rate curve.
+/**
+ * Rates for one date, interpolated by term. The curve is anchored at a zero rate for a zero term.
+ * Terms beyond the last point have no rate. Curve is immutable once built and can be shared
+ * read-only between threads.
+ */
+class YieldCurve
+{
+    using _Myt = YieldCurve;
+
+public:
+
+    /// Interpolation methods.
+    enum Interpolation
+    {
+        LINEAR,                                     ///< Linear between points.
+        CUBIC,                                      ///< Natural cubic spline through points.
+    };
+
+    // ========================================================================
+    // CTOR / DTOR
+    // ========================================================================
+
+    /// Constructor.
+    /**
+     * @warning
+     * Passed in @c vector classes @a terms and @a rates are assumed to have equal sizes and be
+     * sorted by term.
+     * @param[in] date  date of rates
+     * @param[in] terms  terms (years)
+     * @param[in] rates  interest rates
+     */
+    YieldCurve( const QDate& date, const std::vector<double>& terms, const std::vector<double>& rates );
+
+    /// Constructor.
+    YieldCurve() {}
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// Retrieve date of rates.
+    /**
+     * @return  date
+     */
+    QDate date() const {return date_;}
+
+    /// Check if curve has no points.
+    /**
+     * @return  @c true if empty, @c false otherwise
+     */
+    bool isEmpty() const {return terms_.empty();}
+
+    /// Retrieve interest rate.
+    /**
+     * @param[in] term  term (years)
+     * @param[in] method  interpolation method
+     * @return  interest rate, or zero if @a term is past the end of the curve
+     */
+    double rate( double term, Interpolation method = LINEAR ) const;
+
+    // ========================================================================
+    // Static Methods
+    // ========================================================================
+
+#if defined( QT_DEBUG )
+    /// Validate methods.
+    static void validate();
+#endif
+
+private:
+
+    QDate date_;                                    ///< Date of rates.
+
+    std::vector<double> terms_;                     ///< Terms, including zero anchor.
+    std::vector<double> rates_;                     ///< Rates, including zero anchor.
+
+    std::vector<double> m_;                         ///< Spline second derivatives.
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // YIELDCURVE_H